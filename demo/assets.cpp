@@ -6,10 +6,13 @@
 #include <limitless/fx/emitters/mesh_emitter.hpp>
 #include <limitless/fx/emitters/beam_emitter.hpp>
 #include <limitless/loaders/texture_loader.hpp>
+#include <limitless/loaders/texture_compressor.hpp>
 #include <limitless/loaders/asset_manager.hpp>
 #include <limitless/models/skeletal_model.hpp>
 #include <limitless/skybox/skybox.hpp>
 #include <limitless/text/font_atlas.hpp>
+#include <limitless/core/program_binary_cache.hpp>
+#include <limitless/core/shader_compiler.hpp>
 #include <iostream>
 
 using namespace Limitless::ms;
@@ -1009,8 +1012,23 @@ DemoAssets::DemoAssets(::Context& ctx, ::Renderer& renderer, const fs::path& pat
 
         ctx.setWindowIcon(TextureLoader::loadGLFWImage(*this, assets_dir / "icons/demo.png"));
 
+        // textures requesting compression are encoded once and loaded as dds afterwards
+        TextureLoader::setCompressor(std::make_shared<TextureCompressor>(fs::temp_directory_path() / "limitless_texture_cache"));
+
         loadAssets();
 
+        // second start links programs from binaries saved by the first one
+        auto cache = std::make_shared<ProgramBinaryCache>(fs::temp_directory_path() / "limitless_shader_cache");
+        ShaderCompiler::setBinaryCache(cache);
+
         compileShaders(ctx, renderer.getSettings());
+
+        const auto stats = cache->getStats();
+        std::cout << "programs from cache: " << stats.hits << " in " << std::chrono::duration_cast<std::chrono::milliseconds>(stats.warm_time).count() << "ms, "
+                  << "compiled: " << stats.misses << " in " << std::chrono::duration_cast<std::chrono::milliseconds>(stats.cold_time).count() << "ms" << std::endl;
+
+        const auto sharing = ms::MaterialBuilder::getShaderSharing();
+        std::cout << "materials: " << sharing.materials << ", shader variants: " << sharing.shaders
+                  << " (" << static_cast<double>(sharing.materials) / std::max(sharing.shaders, uint64_t {1}) << " materials per program)" << std::endl;
     }
 }
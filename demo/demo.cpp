@@ -82,6 +82,10 @@ public:
         if (key == GLFW_KEY_GRAVE_ACCENT && state == InputState::Released) {
             hidden_text = !hidden_text;
         }
+
+        if (key == GLFW_KEY_F5 && state == InputState::Pressed) {
+            assets.reloadChangedShaders(context, render.getSettings());
+        }
     }
 
     void onFramebufferChange(glm::uvec2 size) override {
@@ -126,6 +130,7 @@ public:
                              "Press 'TAB' to switch scene.\n"
                              "Hold 'SPACE' to boost camera speed.\n"
                              "Press '~' to hide this text.\n"
+                             "Press 'F5' to reload edited shaders.\n"
                              "Press 'ESC' to quit.", start, assets.fonts.at("nunito")};
         helper.setSize(glm::vec2{0.3f});
         helper.draw(context, assets);
@@ -76,11 +76,7 @@ LightingScene::LightingScene(Limitless::Context& ctx, const Limitless::Assets& a
 void LightingScene::update(Limitless::Context& context, const Limitless::Camera& camera) {
     Limitless::Scene::update(context, camera);
 
-    using namespace std::chrono;
-    auto current_time = steady_clock::now();
-    static auto last_time = steady_clock::now();
-    auto delta_time = duration_cast<duration<float>>(current_time - last_time).count();
-    last_time = current_time;
+    const auto delta_time = getTime().getDelta();
 
     std::default_random_engine e {std::random_device{}()};
     std::uniform_real_distribution<> dis_direction(-1.0, 1.0);
@@ -4,6 +4,7 @@
 #include <limitless/shader_storage.hpp>
 #include <limitless/util/filesystem.hpp>
 #include <limitless/loaders/texture_loader.hpp>
+#include <mutex>
 
 namespace Limitless::ms {
     class Material;
@@ -18,11 +19,32 @@ namespace Limitless {
     class FontAtlas;
     class Context;
     class RenderSettings;
+    class AssetPack;
+    class ByteSource;
+    class ThreadPool;
+    class VirtualTexture;
 
     class Assets {
     protected:
         fs::path base_dir;
         fs::path shader_dir;
+
+        // modification times of files compiled programs were preprocessed from
+        std::map<fs::path, fs::file_time_type> shader_timestamps;
+
+        // mounted pack is searched first by path relative to assets directory
+        std::shared_ptr<AssetPack> pack;
+
+        // property textures of materials built from these assets are paged into it when set
+        std::shared_ptr<VirtualTexture> virtual_texture;
+
+        // created on first use
+        mutable std::unique_ptr<ThreadPool> workers;
+        mutable std::once_flag workers_created;
+
+        void compileFallbacks(Context& ctx, const RenderSettings& settings);
+        void submitMaterials(Context& ctx, const RenderSettings& settings);
+        void updateShaderTimestamps();
     public:
         ShaderStorage shaders;
         ResourceContainer<AbstractModel> models;
@@ -36,7 +58,7 @@ namespace Limitless {
         explicit Assets(const fs::path& base_dir) noexcept;
         Assets(fs::path base_dir, fs::path shader_dir) noexcept;
 
-        virtual ~Assets() = default;
+        virtual ~Assets();
 
         virtual void load(Context& context);
         // initializes default shaders for assets
@@ -44,6 +66,11 @@ namespace Limitless {
 
         void reloadTextures(const TextureLoaderFlags& settings);
 
+        // files of assets and files they reference are read from mounted pack when it contains them
+        void mount(std::shared_ptr<AssetPack> pack);
+        [[nodiscard]] bool isPacked(const fs::path& path) const;
+        [[nodiscard]] std::unique_ptr<ByteSource> open(const fs::path& path) const;
+
         static PassShaders getRequiredPassShaders(const RenderSettings& settings);
         void compileMaterial(Context& ctx, const RenderSettings& settings, const std::shared_ptr<ms::Material>& material);
         void compileEffect(Context& ctx, const RenderSettings& settings, const std::shared_ptr<EffectInstance>& effect);
@@ -51,12 +78,27 @@ namespace Limitless {
 
         void recompileMaterial(Context& ctx, const RenderSettings& settings, const std::shared_ptr<ms::Material>& material);
 
+        // material variants are compiled asynchronously and drawn with default material until they are ready
         virtual void compileShaders(Context& ctx, const RenderSettings& settings);
+        // compiles only programs that depend on changed settings and those that are missing
         void recompileShaders(Context& ctx, const RenderSettings& settings);
+        // compiles again programs that were preprocessed from file
+        void reloadShaders(Context& ctx, const RenderSettings& settings, const fs::path& file);
+        // reloads programs whose files were modified since they were compiled
+        void reloadChangedShaders(Context& ctx, const RenderSettings& settings);
 
         void add(const Assets& other);
 
         [[nodiscard]] const auto& getBaseDir() const noexcept { return base_dir; }
         [[nodiscard]] const auto& getShaderDir() const noexcept { return shader_dir; }
+        [[nodiscard]] const auto& getPack() const noexcept { return pack; }
+
+        // affects only materials built afterwards
+        void setVirtualTexture(std::shared_ptr<VirtualTexture> _virtual_texture) noexcept { virtual_texture = std::move(_virtual_texture); }
+        [[nodiscard]] const auto& getVirtualTexture() const noexcept { return virtual_texture; }
+
+        // CPU workers shared by engine jobs the calling thread waits for, e.g. preprocessing of material sources;
+        // jobs must not wait for other jobs of the same pool
+        [[nodiscard]] ThreadPool& getWorkers() const;
     };
 }
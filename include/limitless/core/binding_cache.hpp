@@ -0,0 +1,61 @@
+#pragma once
+
+#include <limitless/core/buffer.hpp>
+#include <algorithm>
+#include <vector>
+#include <array>
+
+namespace Limitless {
+    struct BindingPoint {
+        Buffer::Type target;
+        GLuint point;
+    };
+    bool operator<(const BindingPoint& a, const BindingPoint& b) noexcept;
+
+    // last buffer bound to every target, looked up by dense target index
+    class BufferTargetCache final {
+    private:
+        std::array<GLuint, Buffer::TYPE_COUNT> ids {};
+    public:
+        GLuint& operator[](Buffer::Type target) noexcept { return ids[Buffer::getTypeIndex(target)]; }
+        GLuint operator[](Buffer::Type target) const noexcept { return ids[Buffer::getTypeIndex(target)]; }
+
+        // forgets buffer wherever it is bound
+        void reset(GLuint id) noexcept {
+            std::replace(ids.begin(), ids.end(), id, 0u);
+        }
+    };
+
+    // last buffer bound to every indexed binding point, kept in flat array per target
+    class BindingPointCache final {
+    private:
+        std::array<std::vector<GLuint>, Buffer::TYPE_COUNT> ids;
+    public:
+        void reserve(Buffer::Type target, size_t count) {
+            auto& points = ids[Buffer::getTypeIndex(target)];
+            points.resize(std::max(points.size(), count));
+        }
+
+        GLuint& operator[](const BindingPoint& binding) {
+            auto& points = ids[Buffer::getTypeIndex(binding.target)];
+            if (binding.point >= points.size()) {
+                points.resize(binding.point + 1);
+            }
+            return points[binding.point];
+        }
+
+        // forgets buffer wherever it is bound; returns whether it was bound to any point
+        bool reset(GLuint id) noexcept {
+            bool bound {};
+            for (auto& points : ids) {
+                for (auto& point : points) {
+                    if (point == id) {
+                        point = 0;
+                        bound = true;
+                    }
+                }
+            }
+            return bound;
+        }
+    };
+}
@@ -3,6 +3,7 @@
 #include <limitless/core/context_debug.hpp>
 #include <stdexcept>
 #include <variant>
+#include <string>
 
 namespace Limitless {
     struct buffer_error : public std::runtime_error {
@@ -18,9 +19,29 @@ namespace Limitless {
             ShaderStorage = GL_SHADER_STORAGE_BUFFER,
             AtomicCounter = GL_ATOMIC_COUNTER_BUFFER,
             IndirectDraw = GL_DRAW_INDIRECT_BUFFER,
-            IndirectDispatch = GL_DISPATCH_INDIRECT_BUFFER
+            IndirectDispatch = GL_DISPATCH_INDIRECT_BUFFER,
+            PixelUnpack = GL_PIXEL_UNPACK_BUFFER,
+            PixelPack = GL_PIXEL_PACK_BUFFER
         };
 
+        static constexpr size_t TYPE_COUNT = 9;
+
+        // dense index of target for flat per-target tables
+        static constexpr size_t getTypeIndex(Type type) noexcept {
+            switch (type) {
+                case Type::Array: return 0;
+                case Type::Element: return 1;
+                case Type::Uniform: return 2;
+                case Type::ShaderStorage: return 3;
+                case Type::AtomicCounter: return 4;
+                case Type::IndirectDraw: return 5;
+                case Type::IndirectDispatch: return 6;
+                case Type::PixelUnpack: return 7;
+                case Type::PixelPack: return 8;
+            }
+            return 0;
+        }
+
         enum class Usage {
             StaticDraw = GL_STATIC_DRAW,
             StaticRead = GL_STATIC_READ,
@@ -81,6 +102,9 @@ namespace Limitless {
 
         virtual void resize(size_t bytes) noexcept = 0;
 
+        // names buffer in GPU memory statistics
+        virtual void setName(std::string name) = 0;
+
         virtual void fence() noexcept = 0;
         virtual void waitFence() noexcept = 0;
 
@@ -15,7 +15,9 @@ namespace Limitless {
         Focused = GLFW_FOCUSED,
         AutoIconify = GLFW_AUTO_ICONIFY,
         Maximized = GLFW_MAXIMIZED,
-        Samples = GLFW_SAMPLES
+        Samples = GLFW_SAMPLES,
+        // GLFW_NATIVE_CONTEXT_API, GLFW_EGL_CONTEXT_API or GLFW_OSMESA_CONTEXT_API
+        ContextCreationApi = GLFW_CONTEXT_CREATION_API
     };
     using WindowHints = std::vector<std::pair<WindowHint, int>>;
 
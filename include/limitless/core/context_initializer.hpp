@@ -12,6 +12,8 @@ namespace Limitless {
         GLint shader_storage_max_count;
         GLint max_texture_units;
         GLint max_tess_level;
+        GLint uniform_buffer_offset_alignment {256};
+        GLint shader_storage_buffer_offset_alignment {256};
 
         GLfloat anisotropic_max {0.0f};
     };
@@ -3,18 +3,18 @@
 #include <limitless/core/context_debug.hpp>
 #include <limitless/core/indexed_buffer.hpp>
 #include <limitless/core/buffer.hpp>
+#include <limitless/core/binding_cache.hpp>
+#include <limitless/core/texture_binder.hpp>
+#include <limitless/core/frame_ring.hpp>
+#include <limitless/core/shared_samplers.hpp>
 #include <unordered_map>
 #include <glm/glm.hpp>
+#include <atomic>
+#include <vector>
 #include <mutex>
 #include <map>
 
 namespace Limitless {
-    struct BindingPoint {
-        Buffer::Type target;
-        GLuint point;
-    };
-    bool operator<(const BindingPoint& a, const BindingPoint& b) noexcept;
-
     enum class Clear {
         Color = GL_COLOR_BUFFER_BIT,
         Depth = GL_DEPTH_BUFFER_BIT,
@@ -108,6 +108,15 @@ namespace Limitless {
     class Context;
 
     class ContextState {
+    public:
+        struct Stats {
+            // draw commands issued to driver
+            uint64_t draw_calls {};
+            // fixed-function state changed by setters
+            uint64_t state_changes {};
+            // programs, vertex arrays and framebuffers bound
+            uint64_t binds {};
+        };
     protected:
         std::unordered_map<Capabilities, bool> capability_map;
         glm::uvec2 viewport {};
@@ -136,27 +145,44 @@ namespace Limitless {
         GLuint framebuffer_id {};
 
         // contains [target, last buffer id]
-        std::unordered_map<Buffer::Type, GLuint> buffer_target;
+        BufferTargetCache buffer_target;
         // contains [binding point, last_buffer_id]
-        std::map<BindingPoint, GLuint> buffer_point;
+        BindingPointCache buffer_point;
 
         IndexedBuffer indexed_buffers;
 
         GLuint active_texture {};
-        // contains [texture_image_unit, texture_id]
-        std::map<GLuint, GLuint> texture_bound;
+        // contains texture id of every texture image unit
+        std::vector<GLuint> texture_bound;
         // contains [texture_handle, resident]
         std::map<GLuint64, bool> texture_resident;
+        // assigns units to program samplers over texture_bound
+        TextureBinder texture_binder;
+        // per-frame dynamic data
+        std::unique_ptr<FrameRing> frame_ring;
+        // per-pass samplers applied to every program
+        SharedSamplers shared_samplers;
 
         // pixel store
         PixelStore pixel_pack {};
         GLint pixel_param {};
 
+        Stats frame_stats;
+        Stats last_frame_stats;
+
         ContextState() = default;
         void init() noexcept;
 
         static inline std::unordered_map<GLFWwindow*, ContextState*> state_map;
         static inline std::mutex mutex;
+
+        // state of window last looked up on this thread, valid while generation of state map is the same
+        static inline thread_local GLFWwindow* current_window {};
+        static inline thread_local ContextState* current_state {};
+        static inline thread_local uint64_t current_generation {};
+        // changes whenever state map does
+        static inline std::atomic<uint64_t> generation {1};
+
         void swapStateMap(Context& lhs, Context& rhs) noexcept;
         void unregisterState(GLFWwindow* window) noexcept;
         void registerState(GLFWwindow* window) noexcept;
@@ -168,9 +194,11 @@ namespace Limitless {
         friend class StateTexture;
         friend class NamedTexture;
         friend class BindlessTexture;
-        friend class TextureBinder;
         friend class Framebuffer;
         friend class DefaultFramebuffer;
+        friend class UploadStaging;
+        friend class FrameRing;
+        friend class HiZPass;
     public:
         virtual ~ContextState() = default;
 
@@ -203,7 +231,18 @@ namespace Limitless {
         void setStencilMask(int32_t mask) noexcept;
         void setPixelStore(PixelStore name, GLint param) noexcept;
 
+        // counts draw call issued on current context
+        static void onDrawCall() noexcept;
+        // closes statistics of current frame
+        void onFrame() noexcept;
+
+        [[nodiscard]] const auto& getFrameStats() const noexcept { return frame_stats; }
+        [[nodiscard]] const auto& getLastFrameStats() const noexcept { return last_frame_stats; }
+
         auto& getIndexedBuffers() noexcept { return indexed_buffers; }
+        auto& getTextureBinder() noexcept { return texture_binder; }
+        auto& getFrameRing() noexcept { return *frame_ring; }
+        auto& getSharedSamplers() noexcept { return shared_samplers; }
 
         const auto& getViewPort() const noexcept { return viewport; }
         const auto& getClearColor() const noexcept { return clear_color; }
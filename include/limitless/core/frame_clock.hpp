@@ -0,0 +1,73 @@
+#pragma once
+
+#include <optional>
+#include <chrono>
+#include <cstdint>
+
+namespace Limitless {
+    /*
+     * simulation time of one frame, passed to everything updated by scene
+     */
+    struct FrameTime {
+        // simulated time elapsed since previous frame
+        std::chrono::duration<float> delta {};
+        // simulated time since clock start
+        std::chrono::duration<double> time {};
+        // index of frame, first one is 0
+        uint64_t frame {};
+        // fixed steps covered by delta; 0 when clock is not stepped
+        uint32_t steps {};
+        // part of step left in accumulator, for interpolating between steps
+        float alpha {};
+
+        [[nodiscard]] float getDelta() const noexcept { return delta.count(); }
+    };
+
+    /*
+     * advances simulation time once per frame
+     *
+     * steady clock is sampled only by tick(), so simulation is reproducible when frame delta is set or advance() is used
+     * with fixed step, elapsed time is accumulated and delta is always whole number of steps
+     */
+    class FrameClock final {
+    public:
+        using Clock = std::chrono::steady_clock;
+        using Duration = std::chrono::duration<float>;
+    private:
+        FrameTime current;
+        std::optional<Clock::time_point> last_tick;
+
+        std::optional<Duration> step;
+        std::optional<Duration> frame_delta;
+        Duration accumulator {};
+        // longer frames are clamped, so simulation does not jump after stalls
+        Duration max_delta {0.25f};
+        float scale {1.0f};
+        bool paused {};
+        bool started {};
+    public:
+        FrameClock() noexcept = default;
+
+        // measures time since previous tick, first tick has zero delta
+        const FrameTime& tick() noexcept;
+        // advances by delta without sampling steady clock
+        const FrameTime& advance(Duration delta) noexcept;
+
+        // starts again from zero time and frame
+        void reset() noexcept;
+
+        // fixed simulation step; empty for variable step
+        void setStep(std::optional<Duration> step) noexcept;
+        // delta used by every tick instead of measured one
+        void setFrameDelta(std::optional<Duration> delta) noexcept;
+        void setMaxDelta(Duration delta) noexcept;
+        void setScale(float scale) noexcept;
+        void setPaused(bool paused) noexcept;
+
+        [[nodiscard]] const auto& getTime() const noexcept { return current; }
+        [[nodiscard]] const auto& getStep() const noexcept { return step; }
+        [[nodiscard]] const auto& getFrameDelta() const noexcept { return frame_delta; }
+        [[nodiscard]] auto getScale() const noexcept { return scale; }
+        [[nodiscard]] auto isPaused() const noexcept { return paused; }
+    };
+}
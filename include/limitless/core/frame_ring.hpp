@@ -0,0 +1,92 @@
+#pragma once
+
+#include <limitless/core/buffer.hpp>
+#include <chrono>
+#include <memory>
+#include <vector>
+#include <array>
+
+namespace Limitless {
+    /*
+     * persistently mapped buffer used as ring of per-frame segments for data rewritten every frame
+     *
+     * allocations are taken linearly from current segment, written in place and bound by range
+     * onFrame() fences current segment; next segment is reused only when its fence is signaled
+     * when segment is out of space, ring is replaced by bigger one and old buffer is kept until GPU is done with it
+     * without persistent mapping, allocations live in client memory and are uploaded when bound
+     */
+    class FrameRing final {
+    public:
+        static constexpr uint32_t FRAME_COUNT = 3;
+
+        struct Allocation {
+            std::byte* data {};
+            GLintptr offset {};
+            size_t size {};
+            GLuint buffer {};
+            // frame allocation was made in, it is invalid in later ones
+            uint64_t frame {};
+
+            template<typename T>
+            [[nodiscard]] T* as() const noexcept { return reinterpret_cast<T*>(data); }
+        };
+
+        struct Stats {
+            size_t uploaded {};
+            uint32_t allocations {};
+            // times segment was not yet released by GPU
+            uint32_t stalls {};
+            std::chrono::microseconds stall_time {};
+            // times segment was too small for frame
+            uint32_t growths {};
+        };
+    private:
+        struct Retired {
+            std::unique_ptr<Buffer> buffer;
+            std::vector<std::byte> staging;
+            GLsync fence;
+        };
+
+        std::unique_ptr<Buffer> buffer;
+        std::array<GLsync, FRAME_COUNT> fences {};
+        std::byte* memory {};
+        // client memory of ring without persistent mapping
+        std::vector<std::byte> staging;
+        bool persistent {};
+        size_t segment_size;
+        uint32_t segment {};
+        size_t offset {};
+        uint64_t frame {1};
+
+        std::vector<Retired> retired;
+
+        Stats frame_stats;
+        Stats last_frame_stats;
+
+        void create(size_t size);
+        void grow(size_t required);
+        void wait(GLsync fence);
+    public:
+        explicit FrameRing(size_t segment_size = 4 * 1024 * 1024);
+        ~FrameRing();
+
+        FrameRing(const FrameRing&) = delete;
+        FrameRing& operator=(const FrameRing&) = delete;
+
+        // returns memory of current frame aligned for binding as target
+        [[nodiscard]] Allocation allocate(Buffer::Type target, size_t size);
+        [[nodiscard]] Allocation allocate(size_t size, size_t alignment);
+
+        // binds allocation to indexed binding point; data has to be written before
+        void bind(const Allocation& allocation, Buffer::Type target, GLuint index);
+
+        [[nodiscard]] bool isCurrent(const Allocation& allocation) const noexcept { return allocation.buffer != 0 && allocation.frame == frame; }
+
+        // fences current segment and waits for the next one; should be called once per frame
+        void onFrame();
+
+        [[nodiscard]] const auto& getFrameStats() const noexcept { return frame_stats; }
+        [[nodiscard]] const auto& getLastFrameStats() const noexcept { return last_frame_stats; }
+        [[nodiscard]] auto getSegmentSize() const noexcept { return segment_size; }
+    };
+}
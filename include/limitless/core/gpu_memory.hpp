@@ -0,0 +1,120 @@
+#pragma once
+
+#include <functional>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace Limitless {
+    /*
+     * accounts GPU memory held by buffers and textures
+     *
+     * every allocation is tagged with category, name and its estimated size;
+     * current and peak bytes are kept per category, allocations, frees and orphaning uploads per frame
+     *
+     * when budget is set, budget listeners are notified on every frame that ends over it, until they free enough;
+     * warning is printed once each time budget is crossed
+     * TextureStreamer registers its trim to drop high mips
+     */
+    class GpuMemory final {
+    public:
+        enum class Category {
+            VertexBuffer,
+            IndexBuffer,
+            UniformBuffer,
+            StorageBuffer,
+            Buffer,
+            Texture,
+            RenderTarget
+        };
+
+        static constexpr size_t CATEGORY_COUNT = 7;
+
+        struct Usage {
+            size_t bytes {};
+            size_t peak {};
+            // live allocations
+            uint32_t count {};
+        };
+
+        struct Churn {
+            uint32_t allocations {};
+            uint32_t frees {};
+            // uploads that let driver orphan whole buffer
+            uint32_t orphanings {};
+            size_t allocated_bytes {};
+            size_t freed_bytes {};
+            size_t orphaned_bytes {};
+        };
+
+        struct Allocation {
+            Category category;
+            std::string name;
+            size_t bytes;
+        };
+
+        // called with bytes over budget and budget itself
+        using BudgetListener = std::function<void(size_t excess, size_t budget)>;
+        // identifies registered listener for removal
+        using ListenerId = uint64_t;
+    private:
+        friend class GpuAllocation;
+        static uint64_t allocate(Category category, size_t bytes);
+        static void update(uint64_t id, Category category, size_t bytes);
+        static void setName(uint64_t id, std::string name);
+        static std::string getName(uint64_t id);
+        static void release(uint64_t id) noexcept;
+    public:
+        GpuMemory() = delete;
+
+        static void orphan(size_t bytes) noexcept;
+
+        [[nodiscard]] static Usage getUsage(Category category) noexcept;
+        [[nodiscard]] static size_t getTotal() noexcept;
+        [[nodiscard]] static size_t getPeak() noexcept;
+
+        [[nodiscard]] static Churn getFrameChurn() noexcept;
+        [[nodiscard]] static Churn getLastFrameChurn() noexcept;
+
+        // live allocations, biggest first
+        [[nodiscard]] static std::vector<Allocation> getAllocations();
+
+        static void setBudget(size_t bytes) noexcept;
+        [[nodiscard]] static size_t getBudget() noexcept;
+        static ListenerId addBudgetListener(BudgetListener listener);
+        // owner of listener has to remove it before it is destroyed
+        static void removeBudgetListener(ListenerId id) noexcept;
+
+        // closes churn of current frame and notifies listeners when over budget; should be called once per frame
+        static void onFrame();
+
+        [[nodiscard]] static const char* getCategoryName(Category category) noexcept;
+    };
+
+    // registration of one GPU allocation, released with its owner
+    class GpuAllocation final {
+    private:
+        uint64_t id {};
+    public:
+        GpuAllocation() = default;
+        ~GpuAllocation();
+
+        GpuAllocation(const GpuAllocation&) = delete;
+        GpuAllocation& operator=(const GpuAllocation&) = delete;
+
+        GpuAllocation(GpuAllocation&& rhs) noexcept;
+        GpuAllocation& operator=(GpuAllocation&& rhs) noexcept;
+
+        // registers allocation or records reallocation with new size
+        void set(GpuMemory::Category category, size_t bytes);
+        void setName(std::string name);
+        [[nodiscard]] std::string getName() const;
+        void reset() noexcept;
+
+        [[nodiscard]] explicit operator bool() const noexcept { return id != 0; }
+
+        friend void swap(GpuAllocation& lhs, GpuAllocation& rhs) noexcept;
+    };
+
+    void swap(GpuAllocation& lhs, GpuAllocation& rhs) noexcept;
+}
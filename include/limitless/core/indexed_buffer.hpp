@@ -30,6 +30,8 @@ namespace Limitless {
         void add(std::string_view name, std::shared_ptr<Buffer> buffer) noexcept;
         void remove(const std::string& name, const std::shared_ptr<Buffer>& buffer);
         std::shared_ptr<Buffer> get(std::string_view name);
+        // returns nullptr when buffer is not set or name is ambiguous; for blocks bound by range elsewhere
+        [[nodiscard]] Buffer* find(std::string_view name) const noexcept;
     };
 
     struct IndexedBufferData {
@@ -50,6 +50,8 @@ namespace Limitless {
 
             glDrawElements(static_cast<GLenum>(draw_mode), indices.size(), GL_UNSIGNED_INT, nullptr);
 
+            ContextState::onDrawCall();
+
             this->vertex_buffer->fence();
             indices_buffer->fence();
         }
@@ -63,6 +65,8 @@ namespace Limitless {
 
             glDrawElementsInstanced(static_cast<GLenum>(mode), indices.size(), GL_UNSIGNED_INT, nullptr, count);
 
+            ContextState::onDrawCall();
+
             this->vertex_buffer->fence();
             indices_buffer->fence();
         }
@@ -1,29 +1,151 @@
 #pragma once
 
-#include <limitless/core/time_query.hpp>
-#include <limitless/text/text_instance.hpp>
-#include <map>
+#include <limitless/core/context_debug.hpp>
+
+#include <unordered_map>
+#include <string_view>
+#include <optional>
+#include <ostream>
+#include <chrono>
+#include <string>
+#include <vector>
+#include <deque>
+#include <array>
+#include <mutex>
+#include <atomic>
+#include <thread>
 
 namespace Limitless {
+    class Context;
+    class Assets;
+
+    /*
+     * CPU and GPU timings of nested scopes grouped by frames
+     *
+     * GPU timestamps are written into ring of FRAME_LATENCY frames and read back only when driver has them ready,
+     * so profiler never waits for GPU; frame whose timestamps are not ready when its slot is reused loses GPU timings
+     * scopes may be opened on any thread, GPU is timed only on thread calling onFrame()
+     * last HISTORY_SIZE finished frames are kept for export
+     */
     class Profiler final {
+    public:
+        using Clock = std::chrono::steady_clock;
+
+        struct Scope {
+            std::string name;
+            // names of enclosing scopes and scope joined by '/'
+            std::string path;
+            uint32_t depth {};
+            // index of thread in order of first use
+            uint32_t thread {};
+            // relative to creation of profiler
+            std::chrono::nanoseconds cpu_begin {};
+            std::chrono::nanoseconds cpu_end {};
+            // aligned to CPU begin of frame; empty when GPU was not timed
+            std::optional<std::chrono::nanoseconds> gpu_begin;
+            std::optional<std::chrono::nanoseconds> gpu_end;
+        };
+
+        struct Frame {
+            uint64_t index {};
+            std::chrono::nanoseconds begin {};
+            std::chrono::nanoseconds end {};
+            std::vector<Scope> scopes;
+        };
+
+        static constexpr uint32_t FRAME_LATENCY = 4;
+        static constexpr uint32_t HISTORY_SIZE = 120;
     private:
-        std::map<std::string, TimeQuery> queries;
+        static constexpr uint32_t NO_QUERY = ~0u;
+
+        struct Slot {
+            Frame frame;
+            std::vector<GLuint> queries;
+            // first of start/stop query pair of every scope
+            std::vector<uint32_t> scope_queries;
+            uint32_t used_queries {};
+            bool pending {};
+        };
+
+        struct Open {
+            const Profiler* profiler;
+            std::string name;
+            std::string path;
+            Clock::time_point begin;
+            uint32_t query;
+        };
+
+        std::array<Slot, FRAME_LATENCY> slots;
+        uint32_t current {};
+        std::deque<Frame> history;
+
+        std::unordered_map<std::thread::id, uint32_t> threads;
+        // thread that calls onFrame(); default id until first frame, it never matches a running thread
+        std::atomic<std::thread::id> gl_thread {};
+        const Clock::time_point origin {Clock::now()};
+        bool gpu;
+        // scopes are not recorded until enabled, e.g. by Renderer from RenderSettings::profiler
+        std::atomic<bool> enabled {false};
+
+        mutable std::mutex mutex;
+
+        static std::vector<Open>& getOpenScopes();
+
+        uint32_t getThread(std::thread::id id);
+        uint32_t allocateQueries(Slot& slot);
+        void push(Scope scope, uint32_t query);
+
+        // moves frame of slot to history if its GPU timestamps are ready
+        bool resolve(Slot& slot);
+        void finish(Slot& slot);
     public:
-        Profiler() = default;
-        ~Profiler() = default;
+        explicit Profiler(bool gpu = true) noexcept;
+        // queries are deleted only while context is current, global profiler outlives it; see release()
+        ~Profiler();
 
-        void draw(Context& ctx, const Assets& assets);
+        Profiler(const Profiler&) = delete;
+        Profiler& operator=(const Profiler&) = delete;
+
+        // ends current frame and collects frames GPU has finished; has to be called outside of scopes
+        void onFrame();
+
+        void begin(std::string_view name);
+        void end();
+
+        // adds finished CPU scope, e.g. job executed by worker
+        void add(std::string_view name, Clock::time_point begin, Clock::time_point end);
 
-        TimeQuery& operator[] (const std::string& name);
+        // drops history and frames in flight
+        void clear();
+        // deletes GPU queries; has to be called before context is destroyed to free them
+        void release();
+
+        void setEnabled(bool enabled) noexcept;
+        [[nodiscard]] bool isEnabled() const noexcept { return enabled; }
+
+        // copy of finished frames, oldest first
+        [[nodiscard]] std::deque<Frame> getFrames() const;
+
+        // trace events of finished frames loadable by chrome://tracing or Perfetto
+        void exportChromeTrace(std::ostream& stream) const;
+        // count, average and maximum of CPU and GPU time per scope path in milliseconds
+        void exportCsv(std::ostream& stream) const;
+
+        // draws timings of last finished frame
+        void draw(Context& ctx, const Assets& assets);
     };
 
     inline Profiler profiler;
 
     class ProfilerScope final {
     private:
-        TimeQuery& query;
+        Profiler& profiler;
     public:
-        explicit ProfilerScope(const std::string& name);
+        explicit ProfilerScope(std::string_view name);
+        ProfilerScope(Profiler& profiler, std::string_view name);
         ~ProfilerScope();
+
+        ProfilerScope(const ProfilerScope&) = delete;
+        ProfilerScope& operator=(const ProfilerScope&) = delete;
     };
 }
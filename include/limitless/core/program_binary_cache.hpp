@@ -0,0 +1,59 @@
+#pragma once
+
+#include <limitless/core/context_debug.hpp>
+#include <limitless/util/filesystem.hpp>
+#include <chrono>
+#include <atomic>
+
+namespace Limitless {
+    /*
+     * on-disk cache of linked program binaries
+     *
+     * binaries are keyed by hash of fully preprocessed shader sources, so render settings defines
+     * and material snippets are part of the key; driver identity is stored in every entry
+     * entries that do not match or are rejected by driver are removed and program is compiled again
+     */
+    class ProgramBinaryCache final {
+    public:
+        struct Stats {
+            uint32_t hits {};
+            uint32_t misses {};
+            // entries that were found but did not match driver or failed to link
+            uint32_t rejected {};
+            // time spent creating programs from binaries
+            std::chrono::nanoseconds warm_time {};
+            // time spent compiling and linking programs from sources
+            std::chrono::nanoseconds cold_time {};
+        };
+    private:
+        fs::path directory;
+        uint64_t driver {};
+        bool supported {};
+
+        // programs are loaded and saved by compiler workers concurrently
+        std::atomic<uint32_t> hits {};
+        std::atomic<uint32_t> misses {};
+        std::atomic<uint32_t> rejected {};
+        std::atomic<std::chrono::nanoseconds::rep> warm_time {};
+        std::atomic<std::chrono::nanoseconds::rep> cold_time {};
+
+        [[nodiscard]] fs::path getEntryPath(uint64_t key) const;
+    public:
+        explicit ProgramBinaryCache(fs::path directory);
+
+        // returns linked program or 0 if there is no valid entry
+        GLuint load(uint64_t key);
+        // should be called before linking to let driver keep the binary
+        void prepare(GLuint program) const noexcept;
+        void save(uint64_t key, GLuint program);
+
+        void addColdTime(std::chrono::nanoseconds time) noexcept { cold_time += time.count(); ++misses; }
+
+        // removes all entries
+        void clear();
+
+        [[nodiscard]] Stats getStats() const noexcept;
+        [[nodiscard]] const auto& getDirectory() const noexcept { return directory; }
+        [[nodiscard]] auto isSupported() const noexcept { return supported; }
+    };
+}
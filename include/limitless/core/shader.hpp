@@ -1,22 +1,14 @@
 #pragma once
 
 #include <limitless/core/context_debug.hpp>
+#include <limitless/core/shader_preprocessor.hpp>
 
 #include <limitless/util/filesystem.hpp>
 #include <fstream>
 #include <utility>
+#include <set>
 
 namespace Limitless {
-    class shader_file_not_found : public std::runtime_error {
-    public:
-        explicit shader_file_not_found(const std::string& error) : std::runtime_error(error) {}
-    };
-
-    class shader_include_not_found : public std::runtime_error {
-    public:
-        explicit shader_include_not_found(const std::string& error) : std::runtime_error(error) {}
-    };
-
     class shader_compilation_error : public std::runtime_error {
     public:
         explicit shader_compilation_error(const std::string& error) : std::runtime_error(error) {}
@@ -37,19 +29,19 @@ namespace Limitless {
         fs::path path;
         Type type {Type::Vertex};
         GLuint id {};
+        // files that were included into source
+        std::set<fs::path> dependencies;
+        // values of keys given while source is not expanded yet
+        ShaderPreprocessor::Keys keys;
+        bool expanded {};
 
-        void replaceExtensions() noexcept;
-        void replaceVersion() noexcept;
-        void replaceIncludes(const fs::path& base_dir);
-
-        void checkStatus() const;
+        static std::string getExtensions();
 
         Shader() = default;
-        static std::string getSource(const fs::path& filepath);
-        static void resolveIncludes(const fs::path& base_dir, std::string& src);
         friend void swap(Shader& lhs, Shader&rhs) noexcept;
     public:
         using ShaderAction = std::function<void(Shader&)>;
+        // only reads and preprocesses source, so shaders can be prepared outside of context thread
         Shader(fs::path path, Type type, const ShaderAction& action = {});
         ~Shader();
 
@@ -60,10 +52,22 @@ namespace Limitless {
         Shader& operator=(Shader&&) noexcept;
 
         [[nodiscard]] const auto& getId() const noexcept { return id; }
+        [[nodiscard]] const auto& getType() const noexcept { return type; }
+        [[nodiscard]] const auto& getPath() const noexcept { return path; }
+        [[nodiscard]] const auto& getDependencies() const noexcept { return dependencies; }
+        // preprocessed source that is passed to driver
+        [[nodiscard]] const auto& getSource() const noexcept { return source; }
+
+        // issues compilation; status is checked separately so that driver can compile several shaders at once
+        void compile();
+        // throws shader_compilation_error; blocks until compilation is finished
+        void checkStatus() const;
 
-        void compile() const;
+        // inside ShaderAction value is substituted while source is expanded; key keeps the first value it was given
+        void replaceKey(const std::string& key, const std::string& value);
 
-        void replaceKey(const std::string& key, const std::string& value) noexcept;
+        // whether source refers to word; inside ShaderAction included files and values of keys are checked
+        [[nodiscard]] bool refersTo(std::string_view word) const;
     };
 
     void swap(Shader& lhs, Shader&rhs) noexcept;
@@ -3,12 +3,16 @@
 #include <limitless/util/filesystem.hpp>
 #include <functional>
 #include <optional>
+#include <chrono>
+#include <array>
+#include <set>
 
 #include <limitless/core/shader.hpp>
 #include <limitless/pipeline/render_settings.hpp>
 
 namespace Limitless {
     class ShaderProgram;
+    class ProgramBinaryCache;
     class RenderSettings;
     class Context;
 
@@ -17,12 +21,49 @@ namespace Limitless {
         using std::runtime_error::runtime_error;
     };
 
+    /*
+     * program whose compilation and linking were issued without querying their status
+     *
+     * with GL_KHR_parallel_shader_compile driver compiles it on its own threads and isReady() does not block
+     */
+    class PendingProgram final {
+    private:
+        std::vector<Shader> shaders;
+        std::set<fs::path> dependencies;
+        std::set<std::string> settings_macros;
+        std::string settings_defines;
+        GLuint id {};
+        uint64_t key {};
+        std::chrono::steady_clock::time_point start;
+
+        friend class ShaderCompiler;
+    public:
+        PendingProgram() = default;
+        ~PendingProgram();
+
+        PendingProgram(const PendingProgram&) = delete;
+        PendingProgram& operator=(const PendingProgram&) = delete;
+
+        PendingProgram(PendingProgram&& rhs) noexcept;
+        PendingProgram& operator=(PendingProgram&& rhs) noexcept;
+
+        // always true without GL_KHR_parallel_shader_compile; finishing then blocks until driver is done
+        [[nodiscard]] bool isReady() const noexcept;
+
+        [[nodiscard]] const auto& getDependencies() const noexcept { return dependencies; }
+        [[nodiscard]] const auto& getSettingsMacros() const noexcept { return settings_macros; }
+        [[nodiscard]] const auto& getSettingsDefines() const noexcept { return settings_defines; }
+    };
+
     class ShaderCompiler {
     protected:
         std::vector<Shader> shaders;
         static void checkStatus(GLuint program_id);
         Context& context;
 
+        // shared by all compilers; programs are compiled from sources when not set
+        inline static std::shared_ptr<ProgramBinaryCache> binary_cache;
+
         // optional RenderSettings to replace Limitless::Settings
         std::optional<RenderSettings> render_settings;
 
@@ -40,6 +81,31 @@ namespace Limitless {
         using ShaderAction = std::function<void(Shader&)>;
         std::shared_ptr<ShaderProgram> compile(const fs::path& path, const ShaderAction& actions = ShaderAction{});
 
+        // reads and preprocesses all stages found for path; does not use context, so it can run on worker threads
+        std::vector<Shader> preprocess(const fs::path& path, const ShaderAction& actions = ShaderAction{}) const;
+
+        // issues compilation and linking of added shaders
+        PendingProgram submit();
+        // checks compilation and linking; throws on errors
+        std::shared_ptr<ShaderProgram> finish(PendingProgram& pending);
+
         ShaderCompiler& operator<<(Shader&& shader) noexcept;
+
+        // render settings macros that can be defined in place of Limitless::Settings
+        static constexpr std::array<std::string_view, 6> SETTINGS_MACROS = {
+            "NORMAL_MAPPING",
+            "DIRECTIONAL_CSM",
+            "DIRECTIONAL_SPLIT_COUNT",
+            "DIRECTIONAL_PFC",
+            "SCREEN_SPACE_AMBIENT_OCCLUSION",
+            "MICRO_SHADOWING"
+        };
+
+        static std::set<std::string> getSettingsMacros(std::string_view source);
+        // defines of settings values restricted to macros
+        static std::string getSettingsDefines(const RenderSettings& settings, const std::set<std::string>& macros);
+
+        static void setBinaryCache(std::shared_ptr<ProgramBinaryCache> cache) noexcept { binary_cache = std::move(cache); }
+        [[nodiscard]] static const auto& getBinaryCache() noexcept { return binary_cache; }
     };
 }
\ No newline at end of file
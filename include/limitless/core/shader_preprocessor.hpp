@@ -0,0 +1,80 @@
+#pragma once
+
+#include <limitless/util/filesystem.hpp>
+#include <unordered_map>
+#include <shared_mutex>
+#include <mutex>
+#include <stdexcept>
+#include <memory>
+#include <vector>
+#include <string>
+#include <set>
+
+namespace Limitless {
+    class shader_file_not_found : public std::runtime_error {
+    public:
+        explicit shader_file_not_found(const std::string& error) : std::runtime_error(error) {}
+    };
+
+    class shader_include_not_found : public std::runtime_error {
+    public:
+        explicit shader_include_not_found(const std::string& error) : std::runtime_error(error) {}
+    };
+
+    /*
+     * expands #include directives and substitution keys of GLSL sources
+     *
+     * every file is read and split into text, include and key tokens once and kept in memory
+     * keys are 'Limitless::Name' and '_MATERIAL_NAME' identifiers; keys without value are left in text
+     * expansion is a single pass over tokens of the file and its includes
+     *
+     * thread-safe
+     */
+    class ShaderPreprocessor final {
+    public:
+        using Keys = std::unordered_map<std::string, std::string>;
+
+        struct Token {
+            enum class Type { Text, Include, Key };
+
+            Type type;
+            // range in file text
+            size_t begin;
+            size_t end;
+            // index in file includes for include tokens
+            size_t include {};
+        };
+
+        struct File {
+            fs::path path;
+            std::string text;
+            std::vector<Token> tokens;
+            // normalized paths of included files in order of appearance
+            std::vector<fs::path> includes;
+        };
+    private:
+        inline static std::unordered_map<std::string, std::shared_ptr<const File>> files;
+        inline static std::shared_mutex mutex;
+
+        static void expand(const File& file, const Keys& keys, std::string& out, std::set<fs::path>& dependencies,
+                           std::vector<const File*>& include_stack, std::vector<const std::string*>& key_stack);
+    public:
+        // splits text into tokens; includes are resolved relative to path
+        static File tokenize(fs::path path, std::string text);
+
+        // throws shader_file_not_found
+        static std::shared_ptr<const File> load(const fs::path& path);
+
+        // throws shader_file_not_found for path and shader_include_not_found for its includes
+        static std::string expand(const fs::path& path, const Keys& keys, std::set<fs::path>& dependencies);
+
+        // checks whether file, its includes or values of keys contain word
+        static bool refersTo(const fs::path& path, const Keys& keys, std::string_view word);
+
+        // file is read again next time it is requested
+        static void invalidate(const fs::path& path);
+        // files that were not found are looked up again, e.g. includes created while shaders are reloaded
+        static void invalidateMissing();
+        static void clear();
+    };
+}
@@ -2,6 +2,7 @@
 
 #include <limitless/core/indexed_buffer.hpp>
 #include <vector>
+#include <set>
 #include <limitless/shader_storage.hpp>
 #include "context_state.hpp"
 
@@ -32,12 +33,21 @@ namespace Limitless {
         // stores uniform values
         std::map<std::string, std::unique_ptr<Uniform>> uniforms;
 
+        // files program was preprocessed from
+        std::set<fs::path> dependencies;
+        // render settings macros referred by sources and defines they were compiled with
+        std::set<std::string> settings_macros;
+        std::string settings_defines;
+        // version of context shared samplers applied to program
+        uint64_t shared_version {};
+
         GLint getUniformLocation(const Uniform& uniform) const noexcept;
 
         void getUniformLocations() noexcept;
         void getIndexedBufferBounds(ContextState& ctx) noexcept;
 
         void bindIndexedBuffers(ContextState& ctx);
+        void applySharedSamplers(ContextState& ctx);
         void bindTextures() const noexcept;
 
         ShaderProgram() noexcept = default;
@@ -59,6 +69,9 @@ namespace Limitless {
         ShaderProgram& operator=(ShaderProgram&& rhs) noexcept;
 
         [[nodiscard]] auto getId() const noexcept { return id; }
+        [[nodiscard]] const auto& getDependencies() const noexcept { return dependencies; }
+        [[nodiscard]] const auto& getSettingsMacros() const noexcept { return settings_macros; }
+        [[nodiscard]] const auto& getSettingsDefines() const noexcept { return settings_defines; }
 
         void use();
 
@@ -0,0 +1,28 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace Limitless {
+    class Texture;
+
+    /*
+     * samplers set once per pass and seen by every program, e.g. shadow maps or refraction texture
+     *
+     * every change bumps version; program applies samplers in use() only when it has not seen current version yet,
+     * so draws between two changes cost a single comparison
+     */
+    class SharedSamplers final {
+    private:
+        std::vector<std::pair<std::string, std::shared_ptr<Texture>>> samplers;
+        uint64_t version {1};
+    public:
+        void set(const std::string& name, std::shared_ptr<Texture> texture);
+        void remove(const std::string& name);
+
+        [[nodiscard]] const auto& getSamplers() const noexcept { return samplers; }
+        [[nodiscard]] auto getVersion() const noexcept { return version; }
+    };
+}
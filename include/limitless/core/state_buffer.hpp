@@ -1,6 +1,7 @@
 #pragma once
 
 #include <limitless/core/buffer.hpp>
+#include <limitless/core/gpu_memory.hpp>
 #include <optional>
 
 namespace Limitless {
@@ -16,6 +17,10 @@ namespace Limitless {
         std::optional<void*> persistent_ptr;
         std::optional<GLsync> sync;
 
+        GpuAllocation memory;
+        // records current size in GPU memory statistics
+        void track();
+
         virtual void bufferStorage(const void* data);
         virtual void bufferData(const void* data) const noexcept;
 
@@ -47,6 +52,7 @@ namespace Limitless {
         StateBuffer* clone() override;
 
         void resize(size_t size) noexcept override;
+        void setName(std::string name) override;
 
         void fence() noexcept override;
         void waitFence() noexcept override;
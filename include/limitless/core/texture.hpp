@@ -1,6 +1,7 @@
 #pragma once
 
 #include <limitless/core/context_debug.hpp>
+#include <limitless/core/gpu_memory.hpp>
 #include <limitless/util/filesystem.hpp>
 #include <glm/glm.hpp>
 #include <functional>
@@ -40,6 +41,7 @@ namespace Limitless {
             RGB16F = GL_RGB16F,
             RGBA16F = GL_RGBA16F,
             RGB32F = GL_RGB32F,
+            RG32F = GL_RG32F,
 
             RG8_SNORM = GL_RG8_SNORM,
 
@@ -136,6 +138,14 @@ namespace Limitless {
         bool border {false};
         bool compressed {false};
         bool immutable {false};
+
+        GpuAllocation memory;
+        GpuMemory::Category memory_category {GpuMemory::Category::Texture};
+
+        // estimated bytes of allocated levels
+        [[nodiscard]] size_t getByteSize() const noexcept;
+        // records current size in GPU memory statistics
+        void track();
     protected:
         Texture() = default;
         friend class TextureBuilder;
@@ -153,6 +163,9 @@ namespace Limitless {
         [[nodiscard]] auto getDataType() const noexcept { return data_type; }
         [[nodiscard]] auto getFormat() const noexcept { return format; }
         [[nodiscard]] auto getInternalFormat() const noexcept { return internal_format; }
+
+        // bytes of texel, or of 4x4 block for compressed formats
+        [[nodiscard]] static size_t getTexelSize(InternalFormat format) noexcept;
         [[nodiscard]] auto getType() const noexcept { return target; }
         [[nodiscard]] auto getSize() const noexcept { return size; }
         [[nodiscard]] auto getMin() const noexcept { return min; }
@@ -183,6 +196,9 @@ namespace Limitless {
         Texture& setWrapR(Wrap wrap);
         void setParameters();
 
+        // render targets are reported separately in GPU memory statistics
+        void setMemoryCategory(GpuMemory::Category category);
+
         /* ALLOCATION FUNCTIONS */
 
         // allocates mutable storage
@@ -218,6 +234,10 @@ namespace Limitless {
         // resizes texture; content becomes empty
         void resize(glm::uvec3 size);
 
+        // replaces storage with new one of different size and level count, parameters are kept; content becomes empty
+        // levels of mutable storage are allocated by following image calls
+        void reallocate(glm::uvec3 size, uint32_t levels);
+
         void accept(TextureVisitor& visitor);
     };
 }
@@ -1,23 +1,68 @@
 #pragma once
 
-#include <limitless/core/extension_texture.hpp>
-#include <limitless/core/texture.hpp>
+#include <limitless/core/context_debug.hpp>
+#include <unordered_map>
+#include <cstdint>
 #include <vector>
 
 namespace Limitless {
-    class TextureBinder {
+    class Texture;
+
+    /*
+     * assigns texture units to samplers of a program on contexts without bindless textures
+     *
+     * textures already sitting in a unit are found through id to unit hash;
+     * others replace texture of least recently used unit, so every texture costs constant time
+     *
+     * owned by ContextState, units bound outside of binder are detected by comparing with its texture map
+     */
+    class TextureBinder final {
+    public:
+        struct Stats {
+            // textures requested by programs
+            uint64_t requests {};
+            // requests served by texture already bound to its unit
+            uint64_t hits {};
+            // textures bound to units
+            uint64_t binds {};
+            // binds that replaced another texture
+            uint64_t evictions {};
+        };
     private:
-        //TODO: move to context state
-        static inline GLint current_bind {0};
+        static constexpr GLuint NONE = ~0u;
+
+        // texture id of every unit in ContextState::texture_bound
+        const GLuint* bound {};
+        GLuint count {};
+        // texture id to unit it was bound to by binder
+        std::unordered_map<GLuint, GLuint> units;
+
+        // units in use order, head is the most recently used one
+        std::vector<GLuint> previous;
+        std::vector<GLuint> next;
+        GLuint head {NONE};
+        GLuint tail {NONE};
+
+        std::vector<GLint> indices;
+
+        Stats frame_stats;
+        Stats last_frame_stats;
+
+        void unlink(GLuint unit) noexcept;
+        void touch(GLuint unit) noexcept;
     public:
-        // TODO: fix
-//        // binds texture to any unit and returns its index
-//        static GLint bind(Texture& texture) noexcept;
-//
-//        //TODO: returns slot to bind, not binding it itself
-//        static GLint bind(GLenum target, const ExtensionTexture& texture) noexcept;
-
-        // binds textures and returns indices to units
-        [[nodiscard]] static std::vector<GLint> bind(const std::vector<Texture*>& textures);
+        TextureBinder() = default;
+
+        // texture units are owned by context state, their storage moves with it
+        void init(const std::vector<GLuint>& texture_bound);
+
+        // binds textures and returns indices to units; valid until next call
+        [[nodiscard]] const std::vector<GLint>& bind(const std::vector<Texture*>& textures);
+
+        // closes statistics of current frame
+        void onFrame() noexcept;
+
+        [[nodiscard]] const auto& getFrameStats() const noexcept { return frame_stats; }
+        [[nodiscard]] const auto& getLastFrameStats() const noexcept { return last_frame_stats; }
     };
-}
\ No newline at end of file
+}
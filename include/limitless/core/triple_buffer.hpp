@@ -24,6 +24,8 @@ namespace Limitless {
         void bindAs(Type target) const noexcept override;
         void bind() const noexcept override;
 
+        void setName(std::string name) override;
+
         void fence() noexcept override;
         void waitFence() noexcept override;
 
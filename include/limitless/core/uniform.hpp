@@ -9,6 +9,7 @@
 namespace Limitless {
     class Texture;
     class ShaderProgram;
+    struct FrameTime;
 
     enum class UniformType {
         Value,
@@ -88,24 +89,24 @@ namespace Limitless {
         [[nodiscard]] const auto& getSampler() const noexcept { return sampler; }
         void setSampler(const std::shared_ptr<Texture>& texture) noexcept;
 
+        // also changed when texture replaced its object, e.g. streamed levels were reallocated
+        [[nodiscard]] bool& getChanged() noexcept override;
+
         [[nodiscard]] UniformSampler* clone() noexcept override;
         void set(const ShaderProgram& shader) override;
     };
 
+    /*
+     * simulation time of scene clock, so it pauses and scales with the rest of scene
+     */
     class UniformTime : public UniformValue<float> {
-    private:
-        std::chrono::time_point<std::chrono::steady_clock> start;
-        friend class UniformSerializer;
     public:
         explicit UniformTime(const std::string& name) noexcept;
         ~UniformTime() override = default;
 
-        void update() noexcept;
-
-        [[nodiscard]] bool& getChanged() noexcept override { changed = true; return changed; }
+        void update(const FrameTime& time) noexcept;
 
         [[nodiscard]] UniformTime* clone() noexcept override;
-        void set(const ShaderProgram& shader) override;
     };
 
     std::string getUniformDeclaration(const Uniform& uniform) noexcept;
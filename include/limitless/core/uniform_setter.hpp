@@ -6,6 +6,7 @@
 namespace Limitless {
     class ShaderProgram;
 
+    // per-draw uniforms; values constant for whole pass belong to uniform blocks or SharedSamplers
     class UniformSetter {
     private:
         std::vector<std::function<void(ShaderProgram&)>> setters;
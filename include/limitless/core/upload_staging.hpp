@@ -0,0 +1,58 @@
+#pragma once
+
+#include <limitless/core/buffer.hpp>
+#include <glm/glm.hpp>
+#include <optional>
+#include <memory>
+#include <array>
+
+namespace Limitless {
+    class Texture;
+
+    /*
+     * persistently mapped pixel unpack buffer used as ring of per-frame segments
+     *
+     * data is copied into current segment and uploaded from it asynchronously
+     * flush() fences current segment; next segment is reused only when its fence is signaled
+     * data bigger than segment is uploaded directly from client memory
+     */
+    class UploadStaging final {
+    public:
+        static constexpr uint32_t SEGMENT_COUNT = 3;
+
+        struct Stats {
+            size_t staged {};
+            size_t direct {};
+            // times segment was not yet released by GPU
+            uint32_t stalls {};
+        };
+    private:
+        std::unique_ptr<Buffer> buffer;
+        std::array<GLsync, SEGMENT_COUNT> fences {};
+        std::byte* memory {};
+        size_t segment_size;
+        uint32_t segment {};
+        size_t offset {};
+        Stats stats;
+
+        // returns offset in buffer
+        std::optional<size_t> stage(const void* data, size_t size);
+        void bind() const noexcept;
+        void unbind() const noexcept;
+    public:
+        explicit UploadStaging(size_t size = 48 * 1024 * 1024);
+        ~UploadStaging();
+
+        UploadStaging(const UploadStaging&) = delete;
+        UploadStaging& operator=(const UploadStaging&) = delete;
+
+        void subImage(Texture& texture, uint32_t level, glm::uvec2 offset, glm::uvec2 size, const void* data, size_t byte_count);
+        void compressedSubImage(Texture& texture, uint32_t level, glm::uvec2 offset, glm::uvec2 size, const void* data, size_t byte_count);
+
+        // should be called once per frame after uploads
+        void flush();
+
+        [[nodiscard]] const auto& getStats() const noexcept { return stats; }
+        [[nodiscard]] auto getSegmentSize() const noexcept { return segment_size; }
+    };
+}
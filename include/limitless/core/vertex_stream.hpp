@@ -1,6 +1,7 @@
 #pragma once
 
 #include <limitless/core/vertex_array.hpp>
+#include <limitless/core/context_state.hpp>
 #include <limitless/core/buffer_builder.hpp>
 #include <limitless/core/abstract_vertex_stream.hpp>
 
@@ -102,6 +103,8 @@ namespace Limitless {
 
             glDrawArrays(static_cast<GLenum>(draw_mode), 0, stream.size());
 
+            ContextState::onDrawCall();
+
             vertex_buffer->fence();
         }
 
@@ -114,6 +117,8 @@ namespace Limitless {
 
             glDrawArraysInstanced(static_cast<GLenum>(draw_mode), 0, stream.size(), count);
 
+            ContextState::onDrawCall();
+
             vertex_buffer->fence();
         }
 
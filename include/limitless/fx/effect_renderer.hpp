@@ -11,6 +11,7 @@ namespace Limitless {
     class UniformSetter;
     class Context;
     class Assets;
+    struct FrameTime;
 
     using Instances = std::vector<std::reference_wrapper<AbstractInstance>>;
 
@@ -32,7 +33,7 @@ namespace Limitless::fx {
         explicit EffectRenderer(Context& context) noexcept;
         ~EffectRenderer() = default;
 
-        void update(const Instances& instances);
+        void update(const Instances& instances, const FrameTime& time);
         void draw(Context& ctx, const Assets& assets, ShaderPass shader, ms::Blending blending, const UniformSetter& setter);
     };
 }
\ No newline at end of file
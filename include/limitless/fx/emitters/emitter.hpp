@@ -47,15 +47,15 @@ namespace Limitless::fx {
         // emitter duration in seconds; 0 for infinity
         std::chrono::duration<float> duration {0.0f};
 
-        std::chrono::time_point<std::chrono::steady_clock> start_time {};
-        std::chrono::time_point<std::chrono::steady_clock> last_time {};
+        // simulated time since first update
+        std::chrono::duration<float> elapsed {};
 
         bool done {false};
 
         UniqueEmitterShader unique_shader;
 
         void emit(uint32_t count) noexcept;
-        void spawnParticles() noexcept;
+        void spawnParticles(std::chrono::duration<float> delta) noexcept;
         void killParticles() noexcept;
 
         explicit Emitter(Type type);
@@ -79,7 +79,7 @@ namespace Limitless::fx {
         [[nodiscard]] UniqueEmitterRenderer getUniqueRendererType() const noexcept override { return { type, std::nullopt, nullptr }; }
 
         [[nodiscard]] Emitter* clone() const override;
-        void update(Context& ctx, const Camera& camera) override;
+        void update(Context& ctx, const Camera& camera, const FrameTime& time) override;
         void accept(EmitterVisitor& visitor) noexcept override;
 
         bool& getLocalSpace() noexcept override;
@@ -21,8 +21,8 @@ namespace Limitless::fx {
         // time in seconds between bursts for burst mode
         float spawn_rate {1.0f};
 
-        // last time emitted
-        std::chrono::time_point<std::chrono::steady_clock> last_spawn {};
+        // simulated time since last emission; empty until first update, which emits right away
+        std::optional<std::chrono::duration<float>> since_spawn;
 
         struct Burst {
             // particles count for 1 burst
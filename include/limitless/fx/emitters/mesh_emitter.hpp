@@ -39,7 +39,7 @@ namespace Limitless::fx {
 
         [[nodiscard]] MeshEmitter* clone() const override;
 
-        void update(Context& context, const Camera& camera) override;
+        void update(Context& context, const Camera& camera, const FrameTime& time) override;
         void accept(EmitterVisitor& visitor) noexcept override;
     };
 }
\ No newline at end of file
@@ -143,14 +143,14 @@ namespace Limitless::fx {
             return beam_particles;
         }
 
-        void update([[maybe_unused]] AbstractEmitter& emitter, std::vector<Particle>& particles, [[maybe_unused]] float dt, Context& ctx, const Camera& camera) noexcept override {
+        void update([[maybe_unused]] AbstractEmitter& emitter, std::vector<Particle>& particles, float dt, Context& ctx, const Camera& camera) noexcept override {
             beam_particles.clear();
 
             for (auto& particle : particles) {
-                const auto current = std::chrono::steady_clock::now();
-                const auto delta_time = std::chrono::duration_cast<std::chrono::duration<float>>(current - particle.last_rebuild);
+                particle.since_rebuild += std::chrono::duration<float>(dt);
 
-                if (delta_time > particle.rebuild_delta) {
+                // new particle is built at once
+                if (particle.derivative_line.empty() || particle.since_rebuild > particle.rebuild_delta) {
                     auto& line = particle.derivative_line;
                     line.clear();
                     generate(particle.derivative_line, particle, particle.position, particle.target, particle.displacement);
@@ -166,7 +166,7 @@ namespace Limitless::fx {
                         line.insert(line.begin(), line[line.size() - 2]);
                     }
 
-                    particle.last_rebuild = current;
+                    particle.since_rebuild = {};
                 }
 
                 generate(particle, ctx, camera);
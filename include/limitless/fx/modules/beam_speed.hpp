@@ -23,20 +23,18 @@ namespace Limitless::fx {
         void initialize([[maybe_unused]] AbstractEmitter& emitter, Particle& particle, [[maybe_unused]] size_t index) noexcept override {
             particle.speed = distribution->get();
             particle.length = 0.0f;
-            particle.speed_start = std::chrono::steady_clock::now();
+            particle.speed_time = 0.0f;
         }
 
         [[nodiscard]] BeamSpeed* clone() const override {
             return new BeamSpeed(*this);
         }
 
-        void update([[maybe_unused]] AbstractEmitter& emitter, std::vector<Particle>& particles, [[maybe_unused]] float dt, [[maybe_unused]] Context& ctx, [[maybe_unused]] const Camera& camera) noexcept override {
-            using namespace std::chrono;
+        void update([[maybe_unused]] AbstractEmitter& emitter, std::vector<Particle>& particles, float dt, [[maybe_unused]] Context& ctx, [[maybe_unused]] const Camera& camera) noexcept override {
             for (auto& particle : particles) {
-                const auto current_time = steady_clock::now();
-                std::chrono::duration<double> mil = current_time - particle.speed_start;
+                particle.speed_time += dt;
 
-                particle.length = mil.count() / particle.speed;
+                particle.length = particle.speed_time / particle.speed;
                 particle.length = glm::clamp(particle.length, 0.0f, 1.0f);
             }
         }
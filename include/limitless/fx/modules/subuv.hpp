@@ -12,9 +12,8 @@ namespace Limitless::fx {
         float fps;
         // scaling factor to frame-sprite space
         glm::vec2 subUV_factor;
-        // last time updated
-        std::chrono::time_point<std::chrono::steady_clock> last_time;
-        bool first_update {false};
+        // simulated time since frames were switched
+        float since_switch {};
         // texture size
         glm::vec2 texture_size;
         // frame count
@@ -59,15 +58,10 @@ namespace Limitless::fx {
             particle.subUV.w = frames[0].y;
         }
 
-        void update([[maybe_unused]] AbstractEmitter& emitter, std::vector<Particle>& particles, [[maybe_unused]] float dt, [[maybe_unused]] Context& ctx, [[maybe_unused]] const Camera& camera) noexcept override {
-            if (first_update) {
-                last_time = std::chrono::steady_clock::now();
-                first_update = false;
-            }
-
-            auto current_time = std::chrono::steady_clock::now();
+        void update([[maybe_unused]] AbstractEmitter& emitter, std::vector<Particle>& particles, float dt, [[maybe_unused]] Context& ctx, [[maybe_unused]] const Camera& camera) noexcept override {
+            since_switch += dt;
 
-            if (std::chrono::duration_cast<std::chrono::duration<float>>(current_time - last_time).count() >= (1.0f / fps)) {
+            if (since_switch >= (1.0f / fps)) {
                 for (auto& p : particles) {
 
                     auto current_frame = glm::vec2{p.subUV.z, p.subUV.w};
@@ -79,7 +73,7 @@ namespace Limitless::fx {
                     p.subUV.w = next_frame.y;
                 }
 
-                last_time = current_time;
+                since_switch = 0.0f;
             }
         }
 
@@ -85,11 +85,13 @@ namespace Limitless::fx {
 
         bool build {};
 
-        std::chrono::time_point<std::chrono::steady_clock> speed_start {};
+        // simulated time since beam started to grow
+        float speed_time {};
 
         std::chrono::duration<float> rebuild_delta {1.0f};
         std::vector<glm::vec3> derivative_line;
-        std::chrono::time_point<std::chrono::steady_clock> last_rebuild {};
+        // simulated time since line was rebuilt
+        std::chrono::duration<float> since_rebuild {};
     };
 
     // beam particle representation on GPU for mapping
@@ -3,6 +3,7 @@
 #include <limitless/util/bounding_box.hpp>
 #include <limitless/instances/instance_attachment.hpp>
 #include <limitless/util/matrix_stack.hpp>
+#include <limitless/pipeline/draw_list.hpp>
 
 namespace Limitless {
     enum class ShaderPass;
@@ -12,6 +13,7 @@ namespace Limitless {
     class Assets;
     class Context;
     class Camera;
+    struct FrameTime;
 
 	namespace ms {
 		enum class Blending;
@@ -40,6 +42,11 @@ namespace Limitless {
 		bool hidden {};
         bool done {};
 
+        // changes whenever recorded draws of instance change
+        uint64_t version {};
+        // changes whenever instance is moved
+        uint64_t transform_version {};
+
 		virtual void updateBoundingBox() noexcept = 0;
 		void updateModelMatrix() noexcept;
 		void updateFinalMatrix() noexcept;
@@ -64,6 +71,12 @@ namespace Limitless {
         [[nodiscard]] const auto& getFinalMatrix() const noexcept { return final_matrix; }
         [[nodiscard]] const auto& getBoundingBox() noexcept { updateBoundingBox(); return bounding_box; }
 
+        [[nodiscard]] virtual uint64_t getVersion() const noexcept { return version; }
+        [[nodiscard]] auto getTransformVersion() const noexcept { return transform_version; }
+
+        // materials changed through references are not tracked, so instance has to be recorded again explicitly
+        void invalidate() noexcept { ++version; }
+
 		void removeOutline() noexcept;
 		void removeShadow() noexcept;
 		void makeOutlined() noexcept;
@@ -84,12 +97,16 @@ namespace Limitless {
         virtual AbstractInstance& setTransformation(const glm::mat4& transformation);
         virtual AbstractInstance& setParent(const glm::mat4& parent);
 
-		virtual void updateAttachments(Context& context, const Camera& camera);
-		virtual void update(Context& context, const Camera& camera);
+		virtual void updateAttachments(Context& context, const Camera& camera, const FrameTime& time);
+		virtual void update(Context& context, const Camera& camera, const FrameTime& time);
 
         // draws instance with no extra uniform setting
         void draw(Context& ctx, const Assets& assets, ShaderPass shader_type, ms::Blending blending);
 
         virtual void draw(Context& ctx, const Assets& assets, ShaderPass shader_type, ms::Blending blending, const UniformSetter& uniform_set) = 0;
+
+        // records draws of instance without GL calls; may be called from worker thread
+        // instance is drawn as usual during replay by default
+        virtual void record(DrawList::Segment& segment);
     };
 }
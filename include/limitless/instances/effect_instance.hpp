@@ -24,7 +24,7 @@ namespace Limitless {
         bool isDone() const noexcept;
 
         void updateBoundingBox() noexcept override;
-        void updateEmitters(Context& context, const Camera& camera) const noexcept;
+        void updateEmitters(Context& context, const Camera& camera, const FrameTime& time) const noexcept;
 
         friend class fx::EffectBuilder;
         friend class EffectSerializer;
@@ -61,7 +61,7 @@ namespace Limitless {
         const auto& getEmitters() const noexcept { return emitters; }
         auto& getEmitters() noexcept { return emitters; }
 
-        void update(Context& context, const Camera& camera) override;
+        void update(Context& context, const Camera& camera, const FrameTime& time) override;
 
         void draw(Context& ctx, const Assets& assets, ShaderPass shader_type, ms::Blending blending, const UniformSetter& uniform_set) override;
     };
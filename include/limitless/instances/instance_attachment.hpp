@@ -9,10 +9,15 @@ namespace Limitless {
 	class AbstractInstance;
 	class Context;
 	class Camera;
+	struct FrameTime;
 
 	class InstanceAttachment {
 	private:
 		std::unordered_map<uint64_t, std::unique_ptr<AbstractInstance>> attachments;
+		// counter of scene instance belongs to, advanced whenever attachment is attached or detached; null outside of scene
+		uint64_t* structure_version {};
+
+		void onStructureChange() noexcept;
 	protected:
 		InstanceAttachment& setParent(const glm::mat4& parent) noexcept;
 	public:
@@ -22,7 +27,7 @@ namespace Limitless {
 		InstanceAttachment(const InstanceAttachment&);
 		InstanceAttachment(InstanceAttachment&&) = default;
 
-		void updateAttachments(Context& context, const Camera& camera);
+		void updateAttachments(Context& context, const Camera& camera, const FrameTime& time);
 
 		void attach(std::unique_ptr<AbstractInstance> attachment);
 		void detach(uint64_t id);
@@ -33,10 +38,15 @@ namespace Limitless {
 		auto& getAttachments() noexcept { return attachments; }
 		const auto& getAttachments() const noexcept { return attachments; }
 
+		// set by scene for its instances and passed to their attachments
+		void setStructureVersion(uint64_t* version) noexcept;
+
 		template<typename Instance, typename... Args>
 		auto& attach(Args&&... args) {
 			auto instance = std::make_unique<Instance>(std::forward<Args>(args)...);
+			instance->setStructureVersion(structure_version);
 			const auto [it, success] = attachments.emplace(instance->getId(), std::move(instance));
+			onStructureChange();
 			return it->second;
 		}
 	};
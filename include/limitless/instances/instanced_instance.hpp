@@ -1,7 +1,6 @@
 #pragma once
 
 #include <limitless/instances/model_instance.hpp>
-#include <limitless/core/buffer_builder.hpp>
 #include <limitless/core/context.hpp>
 
 namespace Limitless {
@@ -16,64 +15,51 @@ namespace Limitless {
         // contains instanced models
         std::vector<std::unique_ptr<ModelInstance>> instances;
 
-        // contains model matrices for each ModelInstance
-        std::shared_ptr<Buffer> buffer;
-
-        void initializeBuffer(uint32_t count) {
-            BufferBuilder builder;
-            buffer = builder.setTarget(Buffer::Type::ShaderStorage)
-                    .setUsage(Buffer::Usage::DynamicDraw)
-                    .setAccess(Buffer::MutableAccess::WriteOrphaning)
-                    .setData(nullptr)
-                    .setDataSize(sizeof(glm::mat4) * count)
-                    .build("model_buffer", *ContextState::getState(glfwGetCurrentContext()));
-        }
-
-        virtual void checkSize() {
-            if (buffer->getSize() < sizeof(glm::mat4) * instances.size()) {
-                buffer->resize(sizeof(glm::mat4) * instances.size());
-            }
-        }
+        // contains model matrices for each ModelInstance of current frame
+        FrameRing::Allocation models;
 
         void updateBoundingBox() noexcept override {
             assert("RIP");
         }
 
-        void updateBuffer(Context& context, const Camera& camera) {
-            checkSize();
+        // matrices are written straight into frame memory
+        void uploadBuffer(Context& context) {
+            models = context.getFrameRing().allocate(Buffer::Type::ShaderStorage, sizeof(glm::mat4) * instances.size());
 
-            std::vector<glm::mat4> data;
-            data.reserve(instances.size());
+            auto* data = models.as<glm::mat4>();
+            for (const auto& instance : instances) {
+                *data++ = instance->getModelMatrix();
+            }
+        }
 
+        void updateBuffer(Context& context, const Camera& camera, const FrameTime& time) {
             for (const auto& instance : instances) {
                 //TODO
 //                if (instance->isHidden()) {
 //                    continue;
 //                }
 
-                instance->update(context, camera);
-
-                data.emplace_back(instance->getModelMatrix());
+                instance->update(context, camera, time);
             }
 
-            buffer->mapData(data.data(), data.size() * sizeof(glm::mat4));
+            uploadBuffer(context);
         }
 
         explicit InstancedInstance(ModelShader shader, const glm::vec3& position, uint32_t count)
             : AbstractInstance(shader, position) {
-            initializeBuffer(count);
+            instances.reserve(count);
         }
     public:
         explicit InstancedInstance(const glm::vec3& position, uint32_t count = 4)
             : AbstractInstance(ModelShader::Instanced, position) {
-            initializeBuffer(count);
+            instances.reserve(count);
         }
 
         ~InstancedInstance() override = default;
 
         InstancedInstance(const InstancedInstance& rhs)
             : AbstractInstance(rhs.shader_type, rhs.position) {
-            initializeBuffer(rhs.instances.size());
+            instances.reserve(rhs.instances.size());
             for (const auto& instance : rhs.instances) {
                 instances.emplace_back(instance->clone());
             }
@@ -101,14 +87,14 @@ namespace Limitless {
         ModelInstance& at(size_t index) { return *instances.at(index); }
         [[nodiscard]] const ModelInstance& at(size_t index) const { return *instances.at(index); }
 
-        void update(Context& context, const Camera& camera) override {
+        void update(Context& context, const Camera& camera, const FrameTime& time) override {
             if (instances.empty()) {
                 return;
             }
 
-            AbstractInstance::update(context, camera);
+            AbstractInstance::update(context, camera, time);
 
-            updateBuffer(context, camera);
+            updateBuffer(context, camera, time);
         }
 
         void draw(Context& ctx, const Assets& assets, ShaderPass pass, ms::Blending blending, const UniformSetter& uniform_set) override {
@@ -116,7 +102,13 @@ namespace Limitless {
                 return;
             }
 
-            buffer->bindBase(ctx.getIndexedBuffers().getBindingPoint(IndexedBuffer::Type::ShaderStorage, "model_buffer"));
+            // instance can be drawn in a frame it was not updated in
+            auto& ring = ctx.getFrameRing();
+            if (!ring.isCurrent(models)) {
+                uploadBuffer(ctx);
+            }
+
+            ring.bind(models, Buffer::Type::ShaderStorage, ctx.getIndexedBuffers().getBindingPoint(IndexedBuffer::Type::ShaderStorage, "model_buffer"));
 
             // iterates over all meshes
             for (auto& [name, mesh] : instances[0]->getMeshes()) {
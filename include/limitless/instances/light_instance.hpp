@@ -80,8 +80,8 @@ namespace Limitless {
 			        [[maybe_unused]] const UniformSetter& uniform_set) override {
 		}
 
-	    void update(Context& context, const Camera& camera) override {
-		    AbstractInstance::update(context, camera);
+	    void update(Context& context, const Camera& camera, const FrameTime& time) override {
+		    AbstractInstance::update(context, camera, time);
 		    synchronize();
 	    }
 
@@ -18,6 +18,8 @@ namespace Limitless {
         std::shared_ptr<ms::Material> base;
         std::map<uint64_t, std::shared_ptr<ms::Material>> materials;
         bool layered {true};
+        // changes whenever layers are changed
+        uint64_t version {};
     public:
         explicit MaterialInstance(const std::shared_ptr<ms::Material>& material);
         ~MaterialInstance() = default;
@@ -50,6 +52,8 @@ namespace Limitless {
         void makeNonLayered() noexcept;
         bool isLayered() const noexcept;
 
+        [[nodiscard]] auto getVersion() const noexcept { return version; }
+
         // gets material layer
         ms::Material& operator[](uint64_t id) { return *materials.at(id); }
         const ms::Material& operator[](uint64_t id) const { return *materials.at(id); }
@@ -4,17 +4,20 @@
 #include <limitless/models/abstract_mesh.hpp>
 #include <limitless/ms/blending.hpp>
 #include <limitless/core/uniform_setter.hpp>
+#include <limitless/pipeline/draw_list.hpp>
 
 namespace Limitless {
     class Assets;
     enum class ShaderPass;
     enum class ModelShader;
+    struct FrameTime;
 
     class MeshInstance final {
     private:
         std::shared_ptr<AbstractMesh> mesh;
         MaterialInstance material;
         bool hidden {};
+        uint64_t version {};
     public:
         MeshInstance(std::shared_ptr<AbstractMesh> mesh, const std::shared_ptr<ms::Material>& material) noexcept;
         ~MeshInstance() = default;
@@ -22,12 +25,15 @@ namespace Limitless {
         MeshInstance(const MeshInstance&) = default;
         MeshInstance(MeshInstance&&) = default;
 
-        void update();
+        void update(const FrameTime& time);
 
         [[nodiscard]] const auto& getMaterial() const noexcept { return material; }
         [[nodiscard]] auto& getMaterial() noexcept { return material; }
         [[nodiscard]] bool isHidden() const noexcept { return hidden; }
 
+        // changes whenever recorded draws of mesh change
+        [[nodiscard]] auto getVersion() const noexcept { return version + material.getVersion(); }
+
         void hide() noexcept;
         void reveal() noexcept;
 
@@ -39,6 +45,12 @@ namespace Limitless {
                   ms::Blending blending,
                   const UniformSetter& uniform_setter);
 
+        // records draws of material layers of list blending
+        void record(DrawList::Segment& segment,
+                    AbstractInstance& instance,
+                    ModelShader model,
+                    const glm::mat4& model_matrix);
+
         void draw_instanced(Context& ctx,
                             const Assets& assets,
                             ShaderPass pass,
@@ -25,7 +25,7 @@ namespace Limitless {
         ModelInstance(const ModelInstance&) = default;
         ModelInstance(ModelInstance&&) noexcept = default;
 
-        void update(Context &context, const Camera &camera) override;
+        void update(Context &context, const Camera &camera, const FrameTime& time) override;
 
         ModelInstance* clone() noexcept override;
 
@@ -38,5 +38,8 @@ namespace Limitless {
 
         using AbstractInstance::draw;
         void draw(Context& ctx, const Assets& assets, ShaderPass shader_type, ms::Blending blending, const UniformSetter& uniform_setter) override;
+        void record(DrawList::Segment& segment) override;
+
+        [[nodiscard]] uint64_t getVersion() const noexcept override;
     };
 }
\ No newline at end of file
@@ -3,26 +3,26 @@
 #include <limitless/instances/model_instance.hpp>
 #include <limitless/instances/socket_attachment.hpp>
 #include <limitless/models/skeletal_model.hpp>
+#include <limitless/core/frame_ring.hpp>
 #include <chrono>
 
 namespace Limitless {
-	class Buffer;
-
     class SkeletalInstance final : public ModelInstance, public SocketAttachment<> {
     private:
         std::vector<glm::mat4> bone_transform;
-        std::shared_ptr<Buffer> bone_buffer;
+        // bone transforms of current frame
+        FrameRing::Allocation bone_data;
 
         const Animation* animation {};
         bool paused {};
 
-        std::chrono::time_point<std::chrono::steady_clock> last_time;
-        std::chrono::duration<double> animation_duration;
+        // simulated time animation is played for
+        std::chrono::duration<double> animation_duration {};
 
         void updateBoundingBox() noexcept override;
-        void initializeBuffer();
+        void uploadBones(Context& context);
 
-        void updateAnimationFrame();
+        void updateAnimationFrame(const FrameTime& time);
         const AnimationNode* findAnimationNode(const Bone& bone) const noexcept;
     public:
         SkeletalInstance(std::shared_ptr<AbstractModel> m, const glm::vec3& position);
@@ -38,8 +38,8 @@ namespace Limitless {
 
         SkeletalInstance* clone() noexcept override;
 
-	    void updateAttachments(Context& context, const Camera& camera) override;
-	    void update(Context& context, const Camera& camera) override;
+	    void updateAttachments(Context& context, const Camera& camera, const FrameTime& time) override;
+	    void update(Context& context, const Camera& camera, const FrameTime& time) override;
 
         SkeletalInstance& play(const std::string& name);
         SkeletalInstance& pause() noexcept;
@@ -53,5 +53,8 @@ namespace Limitless {
 
         using AbstractInstance::draw;
         void draw(Context& ctx, const Assets& assets, ShaderPass shader_type, ms::Blending blending, const UniformSetter& uniform_setter) override;
+
+        // bones are uploaded during draw, so instance is drawn as usual during replay
+        void record(DrawList::Segment& segment) override { AbstractInstance::record(segment); }
     };
 }
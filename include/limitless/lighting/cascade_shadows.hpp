@@ -39,7 +39,6 @@ namespace Limitless {
 
         std::vector<ShadowFrustum> frustums;
         std::vector<float> far_bounds {};
-        std::shared_ptr<Buffer> light_buffer;
         std::vector<glm::mat4> light_space;
 
         void initBuffers(Context& context);
@@ -47,7 +46,7 @@ namespace Limitless {
         void updateLightMatrices(const DirectionalLight& light);
     public:
         explicit CascadeShadows(Context& context, const RenderSettings& settings);
-        ~CascadeShadows();
+        ~CascadeShadows() = default;
 
         void update(Context& ctx, const RenderSettings& settings);
 
@@ -57,7 +56,10 @@ namespace Limitless {
                   Assets& assets,
                   const Camera& camera,
                   fx::EffectRenderer* renderer);
-        void setUniform(ShaderProgram& sh) const;
-        void mapData() const;
+
+        [[nodiscard]] const std::shared_ptr<Texture>& getShadowMap() const;
+
+        // uploads far bounds and light matrices of frame as directional_shadows block
+        void upload(Context& ctx) const;
     };
 }
@@ -2,6 +2,7 @@
 
 #include <unordered_map>
 #include <vector>
+#include <algorithm>
 #include <memory>
 
 namespace Limitless {
@@ -58,8 +59,9 @@ namespace Limitless {
 
         template<typename... Args>
         auto emplace_back(Args&&... args) {
+            // grows geometrically, every reserve reallocates storage buffer
             if (capacity() == size()) {
-                reserve(size() + 1);
+                reserve(std::max<size_t>(size() * 2, 1));
             }
             lights.emplace_back(std::forward<Args>(args)...);
             lights_map.emplace(next_id, lights.size() - 1);
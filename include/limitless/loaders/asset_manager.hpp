@@ -5,42 +5,59 @@
 #include <limitless/util/filesystem.hpp>
 #include <limitless/loaders/model_loader.hpp>
 #include <limitless/loaders/texture_loader.hpp>
+#include <limitless/loaders/asset_pipeline.hpp>
+#include <limitless/loaders/texture_streamer.hpp>
 
 namespace Limitless {
     class Assets;
+    class AssetPack;
+    class ByteSource;
+    class UploadStaging;
 
     fs::path getAssetsDir();
     fs::path getShadersDir();
 
+    /*
+     * loads assets through staged pipeline
+     *
+     * reading and decoding run on CPU workers, GL objects are created in doDelayedJob on main context
+     * within per-frame upload budget, which counts uploaded bytes; returned ids can be passed as dependencies of other assets
+     */
     class AssetManager final {
     private:
-        using future_model = std::future<std::function<std::shared_ptr<AbstractModel>()>>;
         using future_asset = std::future<void>;
+        using Dependencies = std::vector<AssetPipeline::Id>;
 
-        struct model_postproc {
-            future_model future;
-            std::function<void(future_model&)> addition;
-        };
-
-        std::vector<model_postproc> model_futures;
         std::vector<future_asset> asset_futures;
+        // workers with shared GL context; run assimp import and deserialization of materials and effects, which create GL objects
         ContextThreadPool pool;
 
         Assets& assets;
+
+        // created on first upload on main context
+        std::unique_ptr<UploadStaging> staging;
+        AssetPipeline pipeline;
+        TextureStreamer streamer;
+
+        UploadStaging& getStaging();
     public:
         AssetManager(Context& context, Assets& assets, uint32_t pool_size = std::thread::hardware_concurrency());
         ~AssetManager();
 
-        void loadModel(std::string asset_name, fs::path path, const ModelLoaderFlags& flags = {});
-        void loadTexture(fs::path path, const TextureLoaderFlags& flags = TextureLoaderFlags{});
+        // mounts pack to assets, so files referenced by loaded assets are read from it too
+        void mount(std::shared_ptr<AssetPack> pack);
 
-        void loadMaterial(std::string asset_name, fs::path path);
-        void loadEffect(std::string asset_name, fs::path path);
+        AssetPipeline::Id loadModel(std::string asset_name, fs::path path, const ModelLoaderFlags& flags = {}, const Dependencies& dependencies = {});
+        AssetPipeline::Id loadTexture(fs::path path, const TextureLoaderFlags& flags = TextureLoaderFlags{});
+
+        AssetPipeline::Id loadMaterial(std::string asset_name, fs::path path, const Dependencies& dependencies = {});
+        AssetPipeline::Id loadEffect(std::string asset_name, fs::path path, const Dependencies& dependencies = {});
 
         void build(std::function<void()> f);
 
         // does a delayed job
-        // constructs loaded models because VertexArray is not shared between contexts
+        // uploads loaded assets within budget because VertexArray is not shared between contexts
+        // schedules texture levels requested from streamer during the frame
         void doDelayedJob();
 
         // compiles all required shaders
@@ -50,5 +67,9 @@ namespace Limitless {
 
         bool isDone();
         operator bool() { return isDone(); }
+
+        [[nodiscard]] auto getProgress() const { return pipeline.getProgress(); }
+        [[nodiscard]] auto& getPipeline() noexcept { return pipeline; }
+        [[nodiscard]] auto& getTextureStreamer() noexcept { return streamer; }
     };
 }
@@ -0,0 +1,86 @@
+#pragma once
+
+#include <limitless/util/byte_source.hpp>
+#include <unordered_map>
+#include <stdexcept>
+#include <string>
+
+namespace Limitless {
+    struct asset_pack_error : public std::runtime_error {
+        using runtime_error::runtime_error;
+    };
+
+    enum class PackCompression : uint32_t {
+        None,
+        LZ4
+    };
+
+    /*
+     * single archive of assets
+     *
+     * layout: header, index of named entries, entry data aligned to pack alignment
+     * file is mapped once; uncompressed entries are returned without copying
+     */
+    class AssetPack final {
+    public:
+        static constexpr uint32_t MAGIC = 0x4B41504C; // "LPAK"
+        static constexpr uint32_t VERSION = 0x1;
+        static constexpr auto EXTENSION = ".lpack";
+
+        struct Entry {
+            uint64_t offset;
+            uint64_t size;
+            uint64_t original_size;
+            PackCompression compression;
+            // entry is written to index as is, so tail padding is explicit and zeroed
+            uint32_t padding;
+        };
+    private:
+        std::shared_ptr<MappedFile> file;
+        std::unordered_map<std::string, Entry> entries;
+        fs::path path;
+        // size and modification time of pack file
+        uint64_t stamp {};
+    public:
+        explicit AssetPack(const fs::path& path);
+        ~AssetPack() = default;
+
+        AssetPack(const AssetPack&) = delete;
+        AssetPack& operator=(const AssetPack&) = delete;
+
+        // entries are named by generic path relative to packed directory
+        static std::string getEntryName(const fs::path& path);
+
+        [[nodiscard]] bool contains(const fs::path& name) const;
+        [[nodiscard]] const Entry& at(const fs::path& name) const;
+
+        // identifies contents of entry for caches of derived data, changes when pack is rebuilt
+        [[nodiscard]] uint64_t getStamp(const fs::path& name) const;
+
+        // source stays valid after pack is destroyed
+        // path is logical path of the source, entry name by default
+        [[nodiscard]] std::unique_ptr<ByteSource> open(const fs::path& name, const fs::path& path = {}) const;
+
+        [[nodiscard]] const auto& getEntries() const noexcept { return entries; }
+        [[nodiscard]] const auto& getPath() const noexcept { return path; }
+    };
+
+    class AssetPackBuilder {
+    private:
+        struct Pending {
+            std::string name;
+            fs::path path;
+            PackCompression compression;
+        };
+
+        std::vector<Pending> pending;
+        uint32_t alignment {16};
+    public:
+        AssetPackBuilder& setAlignment(uint32_t alignment);
+        AssetPackBuilder& add(const fs::path& name, fs::path path, PackCompression compression = PackCompression::None);
+        // adds all regular files, names are relative to root
+        AssetPackBuilder& addDirectory(const fs::path& root, PackCompression compression = PackCompression::None);
+
+        void build(const fs::path& path);
+    };
+}
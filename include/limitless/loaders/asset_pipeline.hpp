@@ -0,0 +1,128 @@
+#pragma once
+
+#include <limitless/util/thread_pool.hpp>
+#include <condition_variable>
+#include <stdexcept>
+#include <chrono>
+#include <string>
+#include <deque>
+#include <array>
+
+namespace Limitless {
+    struct asset_pipeline_error : public std::runtime_error {
+        using runtime_error::runtime_error;
+    };
+
+    enum class AssetStage : uint8_t {
+        IO,
+        Decode,
+        Bake,
+        Upload
+    };
+
+    /*
+     * dependency graph of asset loading jobs
+     *
+     * IO, Decode and Bake jobs run on plain CPU workers without GL context unless they are given a pool of their own,
+     * e.g. workers with shared GL context for jobs that create GL objects
+     * Upload jobs run on the thread calling update() within per-frame budget
+     * job starts when all its dependencies are done; failure is propagated to dependents
+     */
+    class AssetPipeline final {
+    public:
+        using Id = uint32_t;
+
+        // cpu job
+        using Task = std::function<void()>;
+        // upload job returns amount of uploaded bytes
+        using UploadTask = std::function<size_t()>;
+
+        struct StageStats {
+            uint32_t total {};
+            uint32_t done {};
+            uint32_t failed {};
+            // time spent executing jobs of the stage
+            std::chrono::nanoseconds time {};
+            // only for upload stage
+            size_t bytes {};
+        };
+
+        struct Progress {
+            uint32_t total {};
+            uint32_t done {};
+            uint32_t failed {};
+
+            [[nodiscard]] float getRatio() const noexcept { return total == 0 ? 1.0f : static_cast<float>(done + failed) / static_cast<float>(total); }
+        };
+
+        struct UploadBudget {
+            size_t bytes {32 * 1024 * 1024};
+            std::chrono::microseconds time {std::chrono::milliseconds{4}};
+        };
+    private:
+        enum class State { Waiting, Queued, Done, Failed };
+
+        struct Job {
+            std::string name;
+            AssetStage stage;
+            Task task;
+            UploadTask upload;
+            // pipeline workers when null
+            ThreadPool* pool {};
+            std::vector<Id> dependents;
+            uint32_t pending {};
+            State state {State::Waiting};
+        };
+
+        // ids are indices, jobs are never removed before reset
+        std::vector<Job> jobs;
+        std::deque<Id> uploads;
+        std::array<StageStats, 4> stats {};
+        std::exception_ptr error;
+        UploadBudget budget;
+
+        mutable std::mutex mutex;
+        std::condition_variable settled;
+
+        // declared last to be joined before everything else is destroyed
+        ThreadPool workers;
+
+        Id emplace(std::string name, AssetStage stage, Task task, UploadTask upload, const std::vector<Id>& dependencies, ThreadPool* pool);
+        void schedule(Id id);
+        void finish(Id id, std::chrono::nanoseconds time, size_t bytes, std::exception_ptr exception);
+        void fail(Id id);
+        void run(Id id);
+        size_t runUpload(Id id);
+        bool isSettled() const noexcept;
+        void rethrow();
+    public:
+        explicit AssetPipeline(uint32_t pool_size = std::thread::hardware_concurrency());
+        ~AssetPipeline() = default;
+
+        AssetPipeline(const AssetPipeline&) = delete;
+        AssetPipeline& operator=(const AssetPipeline&) = delete;
+
+        // job is queued to pool when it is ready, so no pipeline worker is blocked waiting for it; pool has to outlive the job
+        Id add(std::string name, AssetStage stage, Task task, const std::vector<Id>& dependencies = {}, ThreadPool* pool = nullptr);
+        Id upload(std::string name, UploadTask task, const std::vector<Id>& dependencies = {});
+
+        void setUploadBudget(const UploadBudget& budget) noexcept;
+
+        // runs ready upload jobs until budget is exhausted; at least one job is run per call
+        // rethrows first failure
+        size_t update();
+
+        // runs everything including uploads on calling thread; rethrows first failure
+        void wait();
+
+        // forgets finished jobs, pipeline has to be done
+        void reset();
+
+        [[nodiscard]] bool isDone() const;
+        [[nodiscard]] bool isDone(Id id) const;
+        [[nodiscard]] Progress getProgress() const;
+        [[nodiscard]] StageStats getStats(AssetStage stage) const;
+        [[nodiscard]] size_t getUploadQueueSize() const;
+        [[nodiscard]] const auto& getUploadBudget() const noexcept { return budget; }
+    };
+}
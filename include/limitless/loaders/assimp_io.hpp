@@ -0,0 +1,27 @@
+#pragma once
+
+#include <assimp/IOSystem.hpp>
+
+namespace Limitless {
+    class Assets;
+
+    /*
+     * assimp file system over byte sources of assets
+     *
+     * model and files it references (e.g. obj materials, gltf buffers) are read from mounted pack when it contains them
+     */
+    class AssimpIOSystem final : public Assimp::IOSystem {
+    private:
+        const Assets& assets;
+    public:
+        explicit AssimpIOSystem(const Assets& _assets) noexcept : assets {_assets} {}
+        ~AssimpIOSystem() override = default;
+
+        bool Exists(const char* file) const override;
+        char getOsSeparator() const override;
+
+        // streams are read-only
+        Assimp::IOStream* Open(const char* file, const char* mode = "rb") override;
+        void Close(Assimp::IOStream* stream) override;
+    };
+}
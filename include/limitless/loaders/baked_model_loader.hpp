@@ -0,0 +1,36 @@
+#pragma once
+
+#include <limitless/util/filesystem.hpp>
+#include <memory>
+#include <optional>
+
+namespace Limitless {
+    class AbstractModel;
+    class ModelLoaderFlags;
+    class Assets;
+    class ByteSource;
+
+    /*
+     * engine-native model cache
+     *
+     * contains already converted vertices, indices, bone weights, bones, skeleton tree, animations
+     * and serialized materials; arrays are stored 16-byte aligned so loading is a memory map and a copy into GL buffers
+     *
+     * cache is stale when source file size, write time, loader flags or format version differ
+     */
+    class BakedModelLoader {
+    public:
+        static constexpr uint32_t MAGIC = 0x4C444D4C; // "LMDL"
+        static constexpr uint32_t VERSION = 0x1;
+        static constexpr auto EXTENSION = ".lmodel";
+
+        static fs::path getBakedPath(const fs::path& source);
+        static bool isStale(const fs::path& baked, const fs::path& source, const ModelLoaderFlags& flags);
+        // for cache that is not next to its source, e.g. packed one; source time is not known, so only its size is compared
+        static bool isStale(const ByteSource& baked, const ModelLoaderFlags& flags, std::optional<uint64_t> source_size = std::nullopt);
+
+        static std::shared_ptr<AbstractModel> load(Assets& assets, const fs::path& baked);
+        static std::shared_ptr<AbstractModel> load(Assets& assets, const ByteSource& source);
+        static void save(const fs::path& baked, const fs::path& source, const AbstractModel& model, const ModelLoaderFlags& flags);
+    };
+}
@@ -4,17 +4,40 @@
 #include <limitless/loaders/texture_loader.hpp>
 
 namespace Limitless {
+    class ByteSource;
+    class ByteBuffer;
+
     class dds_loader_exception : public std::runtime_error {
     public:
         explicit dds_loader_exception(const char* msg) : std::runtime_error(msg) {}
         explicit dds_loader_exception(const std::string& str) : std::runtime_error(str) {}
     };
 
+    struct DDSLevel {
+        glm::uvec2 size;
+        // points into source memory
+        const std::byte* data;
+        std::size_t byte_count;
+    };
+
+    // parsed file; levels are ordered from full resolution down
+    struct DDSImage {
+        Texture::InternalFormat internal_format;
+        std::vector<DDSLevel> levels;
+
+        [[nodiscard]] std::size_t getByteCount(uint32_t first_level) const noexcept;
+    };
+
     class DDSLoader {
         static std::size_t getDXTByteCount(glm::uvec2 size, std::size_t block_size) noexcept;
-
-        static void loadLevel(std::shared_ptr<Texture>& texture, std::ifstream& fs, uint32_t level, int channels);
     public:
+        // source has to outlive returned image
+        static DDSImage parse(const ByteSource& source, const TextureLoaderFlags& flags);
+
+        // file contents of block compressed image; BC4, BC5 and BC7 use extended header
+        static std::vector<std::byte> write(const DDSImage& image);
+
         static std::shared_ptr<Texture> load(Assets& assets, const fs::path& path, const TextureLoaderFlags& flags);
+        static std::shared_ptr<Texture> load(Assets& assets, const ByteSource& source, const TextureLoaderFlags& flags);
     };
 }
@@ -6,12 +6,14 @@
 namespace Limitless {
     class EffectInstance;
     class Assets;
+    class ByteSource;
     class Context;
     class RenderSettings;
 
     class EffectLoader {
     public:
         static std::shared_ptr<EffectInstance> load(Assets& assets, const fs::path& path);
+        static std::shared_ptr<EffectInstance> load(Assets& assets, const ByteSource& source);
         static void save(const fs::path& path, const std::shared_ptr<EffectInstance>& asset);
     };
 }
\ No newline at end of file
@@ -10,10 +10,12 @@ namespace Limitless::ms {
 namespace Limitless {
     class Context;
     class Assets;
+    class ByteSource;
 
     class MaterialLoader {
     public:
         static std::shared_ptr<ms::Material> load(Assets& ctx, const fs::path& path);
+        static std::shared_ptr<ms::Material> load(Assets& assets, const ByteSource& source);
         static void save(const fs::path& path, const std::shared_ptr<ms::Material>& asset_name);
     };
 }
\ No newline at end of file
@@ -22,6 +22,7 @@ namespace Limitless {
     class Assets;
     class Context;
     class RenderSettings;
+    class ByteSource;
 
     struct VertexBoneWeight;
     struct Animation;
@@ -36,7 +37,9 @@ namespace Limitless {
         GenerateUniqueMeshNames,
         FlipWindingOrder,
         NoMaterials,
-		GlobalScale
+		GlobalScale,
+        // loads from engine-native cache next to the source, bakes it on first load or when stale
+        Baked
     };
 
     class ModelLoaderFlags {
@@ -52,6 +55,7 @@ namespace Limitless {
         static std::vector<std::shared_ptr<AbstractMesh>> loadMeshes(Assets& assets, const aiScene *scene, const fs::path& path, std::vector<Bone>& bones, std::unordered_map<std::string, uint32_t>& bone_map, const ModelLoaderFlags& flags);
         template<typename T, typename T1>
         static std::shared_ptr<AbstractMesh> loadMesh(Assets& assets, aiMesh *mesh, const fs::path& path, std::vector<Bone>& bones, std::unordered_map<std::string, uint32_t>& bone_map, const ModelLoaderFlags& flags);
+        static std::shared_ptr<AbstractModel> importModel(Assets& assets, const fs::path& path, const ModelLoaderFlags& flags, const ByteSource* source = nullptr);
     protected:
         static std::vector<VertexBoneWeight> loadBoneWeights(aiMesh* mesh, std::vector<Bone>& bones, std::unordered_map<std::string, uint32_t>& bone_map);
         static std::vector<Animation> loadAnimations(const aiScene* scene, std::vector<Bone>& bones, std::unordered_map<std::string, uint32_t>& bone_map);
@@ -65,6 +69,10 @@ namespace Limitless {
         virtual ~ModelLoader() = default;
     public:
         static std::shared_ptr<AbstractModel> loadModel(Assets& assets, const fs::path& path, const ModelLoaderFlags& flags = {});
+        // imports from memory, baked model when source has baked extension
+        static std::shared_ptr<AbstractModel> loadModel(Assets& assets, const ByteSource& source, const ModelLoaderFlags& flags = {});
+        // offline bake, writes cache file regardless of its state
+        static void bakeModel(Assets& assets, const fs::path& path, const ModelLoaderFlags& flags = {});
         static void addAnimations(const fs::path& path, const std::shared_ptr<AbstractModel>& skeletal, const ModelLoaderFlags& flags = {});
         static void addAnimations(const std::vector<fs::path>& paths, const std::shared_ptr<AbstractModel>& skeletal, const ModelLoaderFlags& flags = {});
     };
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <limitless/loaders/texture_loader.hpp>
+#include <limitless/util/block_compression.hpp>
+#include <limitless/util/thread_pool.hpp>
+#include <optional>
+#include <chrono>
+#include <mutex>
+
+namespace Limitless {
+    class ByteSource;
+
+    /*
+     * compresses textures to BCn on CPU and keeps results as DDS files
+     *
+     * entries are keyed by source path, stamp of its contents and by flags that change pixels or format
+     * stamp of file is its size and modification time, packed sources pass stamp of their pack entry
+     * mip levels are generated on CPU, so next runs only map the file and upload its levels
+     *
+     * thread-safe
+     */
+    class TextureCompressor final {
+    public:
+        struct Stats {
+            uint32_t hits {};
+            uint32_t misses {};
+            // time spent generating mips and encoding blocks
+            std::chrono::nanoseconds encode_time {};
+            // pixels of all encoded levels
+            uint64_t encoded_pixels {};
+        };
+    private:
+        fs::path directory;
+        ThreadPool pool;
+        Stats stats;
+        mutable std::mutex mutex;
+
+        [[nodiscard]] static fs::path getEntryName(const fs::path& path, const TextureLoaderFlags& flags, uint64_t stamp);
+    public:
+        explicit TextureCompressor(fs::path directory, uint32_t threads = std::max(std::thread::hardware_concurrency(), 1u));
+
+        // format requested by flags for image with channels; nullopt if flags ask for none or it is not supported
+        static std::optional<BlockFormat> getBlockFormat(const TextureLoaderFlags& flags, int channels);
+        // cached files already have origin and downscale applied
+        static TextureLoaderFlags getLoadFlags(const TextureLoaderFlags& flags) noexcept;
+
+        // size and modification time of file on disk
+        static uint64_t getFileStamp(const fs::path& path);
+
+        // cached dds with logical path of texture, nullptr if there is no entry
+        std::unique_ptr<ByteSource> find(const fs::path& path, const TextureLoaderFlags& flags, uint64_t stamp);
+        std::unique_ptr<ByteSource> find(const fs::path& path, const TextureLoaderFlags& flags);
+        // encodes image and its mips and stores it; nullptr if image cannot be compressed with flags
+        std::unique_ptr<ByteSource> compress(const DecodedTexture& image, const TextureLoaderFlags& flags, uint64_t stamp);
+        std::unique_ptr<ByteSource> compress(const DecodedTexture& image, const TextureLoaderFlags& flags);
+
+        // removes all entries
+        void clear();
+
+        [[nodiscard]] Stats getStats() const;
+        [[nodiscard]] const auto& getDirectory() const noexcept { return directory; }
+    };
+}
@@ -3,11 +3,15 @@
 #include <limitless/core/texture.hpp>
 #include <limitless/core/context_debug.hpp>
 #include <limitless/util/filesystem.hpp>
+#include <limitless/util/mipmap.hpp>
 #include <set>
 
 namespace Limitless {
     class Assets;
     class TextureBuilder;
+    class ByteSource;
+    class UploadStaging;
+    class TextureCompressor;
 
     class TextureLoaderFlags {
     public:
@@ -32,6 +36,12 @@ namespace Limitless {
         // for dds it loads mipmaps in a file
         bool mipmap {true};
 
+        // filter of mipmaps generated on CPU; cubemaps use driver mipmaps
+        MipFilter mip_filter {MipFilter::Box};
+
+        // dds only; low mips are loaded at once, higher ones are streamed on demand, downscale is ignored
+        bool streaming {false};
+
         bool anisotropic_filter {false};
         float anisotropic_value {0.0f}; // 0.0f for max supported
 
@@ -53,11 +63,36 @@ namespace Limitless {
         explicit texture_loader_exception(const char* msg) : std::runtime_error(msg) {}
     };
 
+    // image decoded to client memory, waiting for upload
+    struct DecodedTexture {
+        fs::path path;
+        int width {};
+        int height {};
+        int channels {};
+        std::shared_ptr<unsigned char> data;
+        // levels below data when mipmaps are requested
+        std::vector<MipLevel> mips;
+
+        [[nodiscard]] size_t getByteCount() const noexcept { return static_cast<size_t>(width) * height * channels; }
+
+        // with generated mipmaps
+        [[nodiscard]] size_t getTotalByteCount() const noexcept {
+            auto count = getByteCount();
+            for (const auto& mip : mips) {
+                count += mip.pixels.size();
+            }
+            return count;
+        }
+    };
+
     class TextureLoader final {
     private:
+        inline static std::shared_ptr<TextureCompressor> compressor;
+
         static void setFormat(TextureBuilder& builder, const TextureLoaderFlags& flags, int channels);
         static void setAnisotropicFilter(const std::shared_ptr<Texture>& texture, const TextureLoaderFlags& flags);
-        static void setDownScale(int& width, int& height, int channels, unsigned char*& data, const TextureLoaderFlags& flags);
+        static void setDownScale(DecodedTexture& image, const TextureLoaderFlags& flags);
+        static void setMipLevels(Texture& texture, const DecodedTexture& image, UploadStaging* staging);
         static bool isPowerOfTwo(int width, int height);
     public:
         TextureLoader() = delete;
@@ -67,6 +102,16 @@ namespace Limitless {
         static GLFWimage loadGLFWImage(Assets& assets, const fs::path& path, const TextureLoaderFlags& flags = {});
 
         static std::shared_ptr<Texture> load(Assets& assets, const fs::path& path, const TextureLoaderFlags& flags = {});
+        static std::shared_ptr<Texture> load(Assets& assets, const ByteSource& source, const TextureLoaderFlags& flags = {});
+
+        // decoding does not touch GL and can be done on any thread
+        static DecodedTexture decode(const ByteSource& source, const TextureLoaderFlags& flags = {});
+        static std::shared_ptr<Texture> upload(Assets& assets, const DecodedTexture& image, const TextureLoaderFlags& flags, UploadStaging& staging);
+
+        // compressed textures are encoded on CPU once and loaded from compressor cache afterwards
+        static void setCompressor(std::shared_ptr<TextureCompressor> _compressor) noexcept { compressor = std::move(_compressor); }
+        [[nodiscard]] static const auto& getCompressor() noexcept { return compressor; }
+
         static std::shared_ptr<Texture> loadCubemap(Assets& assets, const fs::path& path, const TextureLoaderFlags& flags = {});
     };
 }
\ No newline at end of file
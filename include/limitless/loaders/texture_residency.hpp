@@ -0,0 +1,102 @@
+#pragma once
+
+#include <glm/glm.hpp>
+#include <unordered_map>
+#include <cstdint>
+#include <vector>
+
+namespace Limitless {
+    /*
+     * residency bookkeeping of streamed textures, GL objects are changed by TextureStreamer
+     *
+     * texture is described by bytes of its levels; levels from 'base' to the smallest one are always resident
+     * requests of a frame keep finest level wanted by any caller, update() turns them into promotions within budget
+     * when budget is exceeded, textures that were not requested for a while lose their high mips, least recently requested first
+     */
+    class TextureResidency final {
+    public:
+        using Key = const void*;
+
+        struct Change {
+            Key key;
+            uint32_t level;
+        };
+
+        struct Plan {
+            // levels that became resident right away
+            std::vector<Change> evictions;
+            // levels that have to be loaded and passed to finish()
+            std::vector<Change> promotions;
+        };
+
+        struct Stats {
+            size_t resident_bytes {};
+            size_t budget {};
+            // promotions waiting to be read or uploaded
+            size_t queue_length {};
+            uint32_t textures {};
+            uint32_t promotions {};
+            uint32_t evictions {};
+        };
+    private:
+        struct Entry {
+            // bytes of every level, finest first
+            std::vector<size_t> levels;
+            uint32_t base {};
+            // finest resident level
+            uint32_t resident {};
+            // finest level requested during last frame
+            uint32_t wanted {};
+            uint64_t last_requested {};
+            // level being loaded
+            uint32_t promoted {};
+            bool loading {};
+
+            [[nodiscard]] size_t getByteCount(uint32_t first) const noexcept;
+        };
+
+        std::unordered_map<Key, Entry> entries;
+        size_t budget;
+        size_t resident_bytes {};
+        size_t pending_bytes {};
+        uint64_t frame {1};
+        uint32_t promotions {};
+        uint32_t evictions {};
+
+        // frames without request before texture can lose its high mips
+        uint64_t eviction_delay {60};
+
+        // drops high mips until resident and pending bytes fit into limit
+        void evict(size_t limit, std::vector<Change>& changes);
+        void setResident(Entry& entry, uint32_t level) noexcept;
+    public:
+        explicit TextureResidency(size_t budget);
+
+        // level of texture with 'size' and 'level_count' levels that gives about one texel per covered pixel
+        static uint32_t getLevel(glm::uvec2 size, uint32_t level_count, float screen_size) noexcept;
+
+        // texture starts with 'base' level resident
+        void add(Key key, std::vector<size_t> levels, uint32_t base);
+        void remove(Key key);
+
+        void request(Key key, uint32_t level);
+
+        // plans requested levels and evicts when over budget; should be called once per frame
+        Plan update();
+
+        // promoted level was loaded; returns whether it should be applied to texture
+        bool finish(Key key, uint32_t level);
+
+        // tries to free bytes, e.g. when GpuMemory budget is exceeded; returns levels that became resident
+        std::vector<Change> trim(size_t bytes);
+
+        void setBudget(size_t bytes) noexcept { budget = bytes; }
+        void setEvictionDelay(uint64_t frames) noexcept { eviction_delay = frames; }
+
+        [[nodiscard]] bool contains(Key key) const noexcept { return entries.find(key) != entries.end(); }
+        [[nodiscard]] bool isLoading(Key key) const noexcept;
+        [[nodiscard]] uint32_t getResident(Key key) const;
+
+        [[nodiscard]] Stats getStats() const noexcept;
+    };
+}
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <limitless/loaders/dds_loader.hpp>
+#include <limitless/loaders/asset_pipeline.hpp>
+#include <limitless/loaders/texture_residency.hpp>
+#include <limitless/core/gpu_memory.hpp>
+#include <unordered_map>
+
+namespace Limitless {
+    class AbstractInstance;
+    using Instances = std::vector<std::reference_wrapper<AbstractInstance>>;
+    class MeshInstance;
+    class ByteSource;
+    class Camera;
+
+    /*
+     * keeps only low mips of streamed dds textures resident and loads higher ones on demand
+     *
+     * demand is screen-space size of visible meshes whose materials use the texture
+     * higher mips are read on pipeline workers and uploaded within pipeline upload budget
+     * when resident size exceeds budget, textures that were not requested for a while lose their high mips
+     * they are trimmed the same way when GpuMemory budget is exceeded
+     * levels are reallocated in new texture object, so samplers referencing texture see its id change
+     *
+     * used from main thread only
+     */
+    class TextureStreamer final {
+    public:
+        using Stats = TextureResidency::Stats;
+    private:
+        struct Entry {
+            std::shared_ptr<Texture> texture;
+            std::shared_ptr<ByteSource> source;
+            DDSImage image;
+        };
+
+        AssetPipeline& pipeline;
+        std::unordered_map<const Texture*, Entry> entries;
+        TextureResidency residency;
+
+        // largest level size that is always resident
+        uint32_t base_size {64};
+
+        GpuMemory::ListenerId budget_listener {};
+
+        uint32_t getBaseLevel(const DDSImage& image) const noexcept;
+        // replaces texture levels by image levels starting from 'level'; data points to that level
+        static void apply(Entry& entry, uint32_t level, const std::byte* data);
+        void apply(const std::vector<TextureResidency::Change>& changes);
+        void promote(Entry& entry, uint32_t level);
+    public:
+        explicit TextureStreamer(AssetPipeline& pipeline, size_t budget = 512 * 1024 * 1024);
+        ~TextureStreamer();
+
+        TextureStreamer(const TextureStreamer&) = delete;
+        TextureStreamer& operator=(const TextureStreamer&) = delete;
+
+        // creates texture with base levels resident; source is kept for later reads
+        std::shared_ptr<Texture> load(Assets& assets, std::shared_ptr<ByteSource> source, const TextureLoaderFlags& flags);
+
+        // texture is drawn covering about 'screen_size' pixels
+        void request(const Texture& texture, float screen_size);
+        void request(const MeshInstance& mesh, float screen_size);
+        // estimates screen size of model instances by their bounding boxes
+        void request(const Instances& instances, const Camera& camera, glm::uvec2 viewport);
+
+        // schedules requested levels and evicts when over budget; should be called once per frame
+        void update();
+
+        // tries to free bytes of streamed levels; called when GpuMemory budget is exceeded
+        void trim(size_t bytes);
+
+        void setBudget(size_t bytes) noexcept { residency.setBudget(bytes); }
+        void setBaseSize(uint32_t size) noexcept { base_size = size; }
+        void setEvictionDelay(uint64_t frames) noexcept { residency.setEvictionDelay(frames); }
+
+        [[nodiscard]] Stats getStats() const noexcept { return residency.getStats(); }
+    };
+}
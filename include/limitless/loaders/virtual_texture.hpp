@@ -0,0 +1,197 @@
+#pragma once
+
+#include <limitless/loaders/texture_loader.hpp>
+#include <limitless/loaders/asset_pipeline.hpp>
+#include <limitless/core/uniform.hpp>
+#include <glm/gtc/type_precision.hpp>
+#include <unordered_map>
+#include <unordered_set>
+#include <optional>
+#include <atomic>
+#include <array>
+
+namespace Limitless {
+    class Buffer;
+    class Context;
+
+    /*
+     * pages material textures into one shared physical atlas
+     *
+     * every texture gets a region of virtual page space; indirection texture maps each virtual page of each mip
+     * to the pool tile holding it or to the closest coarser resident page
+     * shaders mark pages they sample in feedback buffer during regular passes, marks are read back a few frames later
+     * textures are decoded again from their files; tiles are cut and converted to RGBA8 on pipeline workers
+     * sRGB pages go to SRGB8_ALPHA8 pool, so they are filtered in linear space; both pools share tile layout
+     * and uploaded within pipeline upload budget; least recently used tiles are replaced when pool is full
+     * decoded image is freed once every page of texture was cut and decoded again when evicted page is requested
+     *
+     * materials sample through regions instead of own samplers, so draws do not change texture bindings
+     * update() has to run every frame before paged materials are drawn; only Deferred pipeline adds VirtualTexturePass for it
+     *
+     * used from main thread only
+     */
+    class VirtualTexture final {
+    public:
+        struct Settings {
+            // texels of page side without border
+            uint32_t page_size {128};
+            // texels repeated around page for filtering
+            uint32_t border {1};
+            // tiles of pool side
+            uint32_t pool_size {16};
+            // pages of virtual space side, power of two
+            uint32_t virtual_size {256};
+            // pages scheduled for loading per frame
+            uint32_t max_requests {32};
+        };
+
+        struct Stats {
+            uint32_t textures {};
+            uint32_t tiles {};
+            uint32_t resident_pages {};
+            uint32_t loading_pages {};
+            // pages marked in last read feedback
+            uint32_t requested_pages {};
+            uint32_t uploads {};
+            uint32_t evictions {};
+        };
+
+        static constexpr uint32_t FEEDBACK_FRAMES = 3;
+    private:
+        static constexpr uint32_t NONE = ~0u;
+
+        // filled by decode job
+        struct Decoded {
+            DecodedTexture image;
+            // 0 pending, 1 ready, 2 failed
+            std::atomic<uint32_t> state {};
+        };
+
+        struct Source {
+            fs::path path;
+            TextureLoaderFlags flags;
+            // first page and page count of region
+            glm::uvec2 origin;
+            glm::uvec2 pages;
+            // coarsest mip at which texture still has pages of its own
+            uint32_t max_mip;
+            bool srgb;
+            // pages of all mips of region
+            uint32_t page_count;
+            // null when image was freed
+            std::shared_ptr<Decoded> decoded;
+            // pages cut from current image
+            std::unordered_set<uint32_t> tiled;
+            // coarsest page is loaded once image is decoded
+            bool based {};
+        };
+
+        struct Tile {
+            // page key, NONE when free
+            uint32_t page {NONE};
+            uint64_t last_used {};
+            // coarsest pages of textures are never replaced
+            bool locked {};
+            bool loading {};
+            // bumped on every load, so upload of released tile is dropped
+            uint32_t generation {};
+        };
+
+        // mirror of one indirection level with rows changed since last flush
+        struct IndirectionLevel {
+            uint32_t size;
+            std::vector<glm::u8vec4> entries;
+            uint32_t dirty_begin {NONE};
+            uint32_t dirty_end {};
+        };
+
+        // std140 layout of virtual_texture block
+        struct Parameters {
+            glm::vec2 physical_size;
+            float page_size;
+            float border;
+            uint32_t virtual_size;
+            uint32_t frame;
+            uint32_t padding[2];
+        };
+
+        AssetPipeline& pipeline;
+        Settings settings;
+
+        std::vector<Source> sources;
+        std::unordered_map<const Texture*, uint32_t> source_indices;
+        // source index + 1 of every virtual page at mip 0, 0 when unused
+        std::vector<uint32_t> owners;
+        // free square blocks of virtual space by log2 of their side
+        std::vector<std::vector<glm::uvec2>> free_blocks;
+
+        std::vector<Tile> tiles;
+        // resident and loading pages to their tiles
+        std::unordered_map<uint32_t, uint32_t> pages;
+        std::vector<IndirectionLevel> indirection_levels;
+
+        std::shared_ptr<Texture> physical;
+        std::shared_ptr<Texture> physical_srgb;
+        std::shared_ptr<Texture> indirection;
+        UniformSampler physical_sampler;
+        UniformSampler physical_srgb_sampler;
+        UniformSampler indirection_sampler;
+
+        std::shared_ptr<Buffer> parameters;
+        std::array<std::unique_ptr<Buffer>, FEEDBACK_FRAMES> feedback;
+        std::array<GLsync, FEEDBACK_FRAMES> fences {};
+        std::vector<uint32_t> marks;
+
+        uint64_t frame {};
+        Stats stats;
+
+        static uint32_t getPageKey(uint32_t mip, uint32_t x, uint32_t y) noexcept { return (mip << 28u) | (y << 14u) | x; }
+        [[nodiscard]] uint32_t getFeedbackSize() const noexcept;
+
+        std::optional<glm::uvec2> allocate(uint32_t side);
+        // returns block and merges it with its free neighbours
+        void deallocate(glm::uvec2 block, uint32_t side);
+        // first free tile or least recently used unlocked one
+        std::optional<uint32_t> acquireTile();
+        void release(uint32_t tile);
+
+        // recomputes indirection entries under page after it became resident or was released
+        void refresh(uint32_t mip, uint32_t x, uint32_t y);
+        void flushIndirection();
+
+        // starts decoding file of source on pipeline workers
+        void decode(Source& source);
+        void readFeedback(uint32_t index);
+        void load(uint32_t source_index, uint32_t mip, uint32_t x, uint32_t y, bool locked);
+    public:
+        VirtualTexture(Context& ctx, AssetPipeline& pipeline, const Settings& settings);
+        VirtualTexture(Context& ctx, AssetPipeline& pipeline);
+        ~VirtualTexture();
+
+        VirtualTexture(const VirtualTexture&) = delete;
+        VirtualTexture& operator=(const VirtualTexture&) = delete;
+
+        // reserves region for texture and starts decoding its file; false if texture cannot be paged
+        bool add(const std::shared_ptr<Texture>& texture, const TextureLoaderFlags& flags = {});
+        // releases region of texture and its pages
+        void remove(const Texture& texture);
+        [[nodiscard]] bool contains(const Texture& texture) const noexcept { return source_indices.count(&texture) != 0; }
+
+        // xy first page, zw page count; z is negative for sRGB textures
+        [[nodiscard]] glm::vec4 getRegion(const Texture& texture) const;
+
+        // reads feedback, schedules page loads and binds buffers for the frame; should be called once per frame before drawing
+        void update(Context& ctx);
+
+        // RGBA8 page of image with border, repeating image at its edges
+        // region is size of whole texture at mip in texels
+        static std::vector<uint8_t> makeTile(const DecodedTexture& image, glm::uvec2 region, glm::uvec2 page, uint32_t page_size, uint32_t border);
+
+        [[nodiscard]] const auto& getPhysicalSampler() const noexcept { return physical_sampler; }
+        [[nodiscard]] const auto& getPhysicalSRGBSampler() const noexcept { return physical_srgb_sampler; }
+        [[nodiscard]] const auto& getIndirectionSampler() const noexcept { return indirection_sampler; }
+        [[nodiscard]] const auto& getSettings() const noexcept { return settings; }
+        [[nodiscard]] bool isUpdated() const noexcept { return frame != 0; }
+        [[nodiscard]] Stats getStats() const noexcept;
+    };
+}
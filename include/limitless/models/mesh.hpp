@@ -11,8 +11,15 @@ namespace Limitless {
         std::string name;
         BoundingBox bounding_box {};
 
+        // indexed and skinned streams derive from vertex stream of same vertex type
         void calculateBoundingBox() {
-//            bounding_box = Limitless::calculateBoundingBox(stream.getVertices());
+            if (const auto* vertices = dynamic_cast<const VertexStream<VertexNormalTangent>*>(stream.get()); vertices) {
+                bounding_box = Limitless::calculateBoundingBox(vertices->getVertices());
+            } else if (const auto* vertices = dynamic_cast<const VertexStream<VertexNormal>*>(stream.get()); vertices) {
+                bounding_box = Limitless::calculateBoundingBox(vertices->getVertices());
+            } else if (const auto* vertices = dynamic_cast<const VertexStream<Vertex>*>(stream.get()); vertices) {
+                bounding_box = Limitless::calculateBoundingBox(vertices->getVertices());
+            }
         }
     public:
 //        Mesh(std::vector<Vertex>&& vertices, VertexStreamUsage usage, VertexStreamDraw draw, std::string _name)
@@ -14,6 +14,8 @@
 
 namespace Limitless {
     class Buffer;
+    class VirtualTexture;
+    struct FrameTime;
 }
 
 namespace Limitless::ms {
@@ -70,9 +72,16 @@ namespace Limitless::ms {
         // tessellation snippet
         std::string tessellation_snippet;
 
+        // property textures are sampled from this atlas when set
+        std::shared_ptr<VirtualTexture> virtual_texture;
+
+        // last regions mapped for property samplers, kept when new texture cannot be paged
+        std::unordered_map<std::string, glm::vec4> regions;
+
         template<typename V>
         void map(std::vector<std::byte>& block, const Uniform& uniform) const;
         void map(std::vector<std::byte>& block, Uniform& uniform);
+        void mapRegion(std::vector<std::byte>& block, const UniformSampler& sampler);
         void map();
 
         friend void swap(Material&, Material&) noexcept;
@@ -92,7 +101,8 @@ namespace Limitless::ms {
         Material(Material&&) noexcept = default;
         Material& operator=(Material&&) noexcept = default;
 
-        void update();
+        // sets time uniforms from frame and maps buffer if anything changed
+        void update(const FrameTime& time);
 
         [[nodiscard]] const UniformValue<glm::vec4>& getColor() const;
         [[nodiscard]] const UniformValue<glm::vec4>& getEmissiveColor() const;
@@ -136,6 +146,7 @@ namespace Limitless::ms {
         [[nodiscard]] const auto& getMaterialBuffer() const noexcept { return material_buffer; }
         [[nodiscard]] const auto& getProperties() const noexcept { return properties; }
         [[nodiscard]] const auto& getUniforms() const noexcept { return uniforms; }
+        [[nodiscard]] const auto& getVirtualTexture() const noexcept { return virtual_texture; }
 
         auto& getBlending() noexcept { return blending; }
         auto& getTwoSided() noexcept { return two_sided; }
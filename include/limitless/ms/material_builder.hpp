@@ -2,9 +2,11 @@
 
 #include <limitless/ms/material.hpp>
 #include <limitless/pipeline/shader_pass_types.hpp>
-#include <limitless/ms/unique_material.hpp>
 #include <functional>
 #include <mutex>
+#include <unordered_map>
+#include <vector>
+#include <string>
 #include <limitless/pipeline/render_settings.hpp>
 
 namespace Limitless {
@@ -23,19 +25,28 @@ namespace Limitless::ms {
     };
 
     class MaterialBuilder {
+    public:
+        struct ShaderSharing {
+            // built materials
+            uint64_t materials {};
+            // distinct shader indices assigned to them
+            uint64_t shaders {};
+        };
     private:
-        static inline std::map<UniqueMaterial, uint64_t> unique_materials;
+        // shader indices for content hash of material shaders, with keys they were assigned to since hashes may collide
+        static inline std::unordered_map<uint64_t, std::vector<std::pair<std::string, uint64_t>>> shader_indices;
         static inline uint64_t next_shader_index {};
+        static inline uint64_t material_count {};
         static inline std::mutex mutex;
 
         std::shared_ptr<Material> material;
 
         Assets& assets;
 
-        [[nodiscard]] UniqueMaterial getMaterialType() const noexcept;
         void initializeMaterialBuffer();
         void checkRequirements();
         void setMaterialIndex();
+        void pageTextures();
         void setModelShaders();
         void createMaterial();
     public:
@@ -75,6 +86,10 @@ namespace Limitless::ms {
         MaterialBuilder& set(decltype(material->properties)&& properties);
         MaterialBuilder& set(decltype(material->uniforms)&& uniforms);
 
+        static ShaderSharing getShaderSharing() noexcept;
+
+        // materials built afterwards sample their property textures through virtual texture if all of them fit
+
         void clear();
         void setTo(const std::shared_ptr<Material>& material);
         std::shared_ptr<Material> build();
@@ -33,5 +33,13 @@ namespace Limitless::ms {
 
         using ShaderCompiler::compile;
         void compile(const Material& material, ShaderPass pass_shader, ModelShader model_shader);
+
+        // everything material puts into its shaders; materials with equal keys share programs
+        static std::string getShaderKey(const Material& material);
+        static uint64_t getShaderHash(const Material& material);
+
+        using ShaderCompiler::preprocess;
+        // sources of material variant; can be prepared on worker threads and then submitted
+        std::vector<Shader> preprocess(const Material& material, ShaderPass pass_shader, ModelShader model_shader) const;
     };
 }
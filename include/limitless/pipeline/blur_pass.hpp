@@ -7,11 +7,15 @@ namespace Limitless {
     class BloomPass final : public RenderPass {
     private:
         Bloom bloom;
+        std::shared_ptr<Texture> source;
     public:
         BloomPass(Pipeline& pipeline, glm::uvec2 frame_size);
 
         auto& getBloom() noexcept { return bloom; }
 
+        void declare(RenderGraph::Builder& builder) override;
+        void realize(RenderGraph& graph) override;
+
         void draw(Instances& instances, Context& ctx, const Assets& assets, const Camera& camera, UniformSetter& setter) override;
 
         std::shared_ptr<Texture> getResult() override;
@@ -4,15 +4,22 @@
 #include <limitless/core/framebuffer.hpp>
 
 namespace Limitless {
+    class BloomPass;
+
     class CompositePass final : public RenderPass {
     private:
         Framebuffer framebuffer;
+
+        std::shared_ptr<Texture> lightened;
+        std::shared_ptr<Texture> bloom;
+        BloomPass* bloom_pass {};
     public:
-        explicit CompositePass(Pipeline& pipeline, glm::uvec2 size);
+        explicit CompositePass(Pipeline& pipeline);
 
         std::shared_ptr<Texture> getResult() override;
 
-        void onFramebufferChange(glm::uvec2 size) override;
+        void declare(RenderGraph::Builder& builder) override;
+        void realize(RenderGraph& graph) override;
 
         void draw(Instances& instances, Context& ctx, const Assets& assets, const Camera& camera, UniformSetter& setter) override;
     };
@@ -8,7 +8,7 @@ namespace Limitless {
     private:
         Framebuffer framebuffer;
     public:
-        DeferredFramebufferPass(Pipeline& pipeline, glm::uvec2 frame_size);
+        explicit DeferredFramebufferPass(Pipeline& pipeline);
 
         auto& getFramebuffer() noexcept { return framebuffer; }
         auto& getAlbedo() noexcept { return framebuffer.get(FramebufferAttachment::Color0).texture; }
@@ -17,8 +17,9 @@ namespace Limitless {
         auto& getEmissive() noexcept { return framebuffer.get(FramebufferAttachment::Color3).texture; }
         auto& getDepth() noexcept { return framebuffer.get(FramebufferAttachment::Depth).texture; }
 
-        void draw(Instances& instances, Context& ctx, const Assets& assets, const Camera& camera, UniformSetter& setter) override;
+        void declare(RenderGraph::Builder& builder) override;
+        void realize(RenderGraph& graph) override;
 
-        void onFramebufferChange(glm::uvec2 size) override;
+        void draw(Instances& instances, Context& ctx, const Assets& assets, const Camera& camera, UniformSetter& setter) override;
     };
-}
\ No newline at end of file
+}
@@ -7,14 +7,23 @@ namespace Limitless {
     class DeferredLightingPass final : public RenderPass {
     private:
         Framebuffer framebuffer;
+
+        std::shared_ptr<Texture> albedo;
+        std::shared_ptr<Texture> normal;
+        std::shared_ptr<Texture> properties;
+        std::shared_ptr<Texture> depth;
+        std::shared_ptr<Texture> emissive;
+        // null when pipeline has no ambient occlusion
+        std::shared_ptr<Texture> ssao;
     public:
-        explicit DeferredLightingPass(Pipeline& pipeline, glm::uvec2 frame_size);
+        explicit DeferredLightingPass(Pipeline& pipeline);
 
         auto& getFramebuffer() noexcept { return framebuffer; }
 
-        void draw(Instances& instances, Context& ctx, const Assets& assets, const Camera& camera, UniformSetter& setter) override;
+        void declare(RenderGraph::Builder& builder) override;
+        void realize(RenderGraph& graph) override;
 
-        void onFramebufferChange(glm::uvec2 size) override;
+        void draw(Instances& instances, Context& ctx, const Assets& assets, const Camera& camera, UniformSetter& setter) override;
 
         std::shared_ptr<Texture> getResult() override;
     };
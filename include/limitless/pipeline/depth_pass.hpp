@@ -1,19 +1,41 @@
 #pragma once
 
 #include <limitless/pipeline/render_pass.hpp>
+#include <limitless/pipeline/draw_list.hpp>
+
+#include <unordered_set>
 
 namespace Limitless::fx {
     class EffectRenderer;
 }
 
 namespace Limitless {
+    class Framebuffer;
+    class HiZPass;
+
     class DepthPass final : public RenderPass {
     private:
         fx::EffectRenderer& renderer;
+        Framebuffer* framebuffer {};
+        // tests instances for occlusion when pipeline builds Hi-Z pyramid
+        HiZPass* hiz {};
+        // instances skipped this frame; later passes skip the same ones, so depth and their attachments agree
+        std::unordered_set<const AbstractInstance*> occluded;
+        DrawList commands;
+        // scene version and camera position commands were sorted for
+        uint64_t scene_version {};
+        glm::vec3 sorted_from {};
     public:
         DepthPass(Pipeline& pipeline, fx::EffectRenderer& renderer);
         ~DepthPass() override = default;
 
+        void declare(RenderGraph::Builder& builder) override;
+        void realize(RenderGraph& graph) override;
+
+        void update(Scene& scene, Instances& instances, Context& ctx, const Camera& camera) override;
         void draw(Instances& instances, Context& ctx, const Assets& assets, const Camera& camera, UniformSetter& setter) override;
+
+        [[nodiscard]] const auto& getDrawList() const noexcept { return commands; }
+        [[nodiscard]] bool isOccluded(const AbstractInstance& instance) const noexcept { return occluded.count(&instance) != 0; }
     };
 }
\ No newline at end of file
@@ -0,0 +1,151 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include <functional>
+#include <optional>
+#include <vector>
+
+namespace Limitless::ms {
+    class Material;
+    enum class Blending;
+}
+
+namespace Limitless {
+    class AbstractInstance;
+    class AbstractMesh;
+    class MaterialInstance;
+    class ShaderProgram;
+    class UniformSetter;
+    class Assets;
+    class Context;
+    enum class ShaderPass;
+
+    /*
+     * list of draws of one pass recorded ahead of submission
+     *
+     * record() resolves materials and shaders of instances without touching GL, so it is split
+     * across workers of assets by instance ranges; every range is recorded into its own segment
+     * replay() submits segments in instance order on the thread owning context
+     *
+     * instances that cannot be recorded without GL calls are kept as fallback commands and drawn as usual during replay
+     * recorded commands point into instances, so list is valid until instances are changed or destroyed
+     *
+     * update() keeps list between frames: it is recorded again only when set of instances, pass or shaders changed,
+     * otherwise just instances whose version changed are recorded again into patch segment
+     */
+    class DrawList final {
+    public:
+        struct Command {
+            AbstractInstance* instance {};
+            // null for fallback command
+            ShaderProgram* shader {};
+            MaterialInstance* material {};
+            const ms::Material* layer {};
+            uint64_t layer_id {};
+            AbstractMesh* mesh {};
+            const glm::mat4* model_matrix {};
+            bool patches {};
+        };
+
+        // commands recorded by one thread
+        class Segment final {
+        private:
+            const DrawList* list;
+            std::vector<Command> commands;
+        public:
+            explicit Segment(const DrawList& list) noexcept;
+
+            void add(const Command& command);
+            // adds command drawing instance itself during replay
+            void addFallback(AbstractInstance& instance);
+
+            [[nodiscard]] const auto& getList() const noexcept { return *list; }
+            [[nodiscard]] const auto& getCommands() const noexcept { return commands; }
+
+            void clear() noexcept { commands.clear(); }
+        };
+
+        struct Stats {
+            uint64_t updates {};
+            // updates that reused commands of all instances
+            uint64_t hits {};
+            // updates that recorded all instances
+            uint64_t misses {};
+            // instances passed to updates
+            uint64_t instances {};
+            // instances recorded by updates
+            uint64_t recorded {};
+        };
+
+        // called for every instance before its first command is replayed
+        using InstanceCallback = std::function<void(AbstractInstance&)>;
+        // commands of instance are skipped during replay when it returns false
+        using InstanceFilter = std::function<bool(AbstractInstance&)>;
+        using Sorter = std::function<bool(const std::reference_wrapper<AbstractInstance>&, const std::reference_wrapper<AbstractInstance>&)>;
+
+        // minimal count of instances recorded by one thread
+        static constexpr size_t RANGE_SIZE = 128;
+    private:
+        // commands of instance in replay order
+        struct Entry {
+            AbstractInstance* instance;
+            const Segment* segment;
+            uint32_t begin;
+            uint32_t end;
+            uint64_t version;
+            uint64_t transform_version;
+        };
+
+        std::vector<Segment> segments;
+        // instances recorded again since last full record
+        Segment patch {*this};
+        std::vector<Entry> entries;
+        size_t command_count {};
+
+        const Assets* assets {};
+        ShaderPass pass {};
+        ms::Blending blending {};
+        // versions list was recorded for by update
+        std::optional<uint64_t> content_version;
+        uint64_t shaders_version {};
+
+        Stats stats;
+
+        void patchEntry(Entry& entry);
+    public:
+        DrawList() = default;
+        ~DrawList() = default;
+
+        DrawList(const DrawList&) = delete;
+        DrawList& operator=(const DrawList&) = delete;
+
+        // records draws of instances; previous commands are cleared
+        void record(std::vector<std::reference_wrapper<AbstractInstance>>& instances, const Assets& assets, ShaderPass pass, ms::Blending blending);
+
+        // brings list up to date with instances identified by version; they are sorted when list is recorded
+        // cached commands are reordered when reorder is set or any of instances moved
+        void update(std::vector<std::reference_wrapper<AbstractInstance>>& instances,
+                    uint64_t version,
+                    const Assets& assets,
+                    ShaderPass pass,
+                    ms::Blending blending,
+                    const Sorter& sorter,
+                    bool reorder);
+
+        [[nodiscard]] const Assets& getAssets() const noexcept { return *assets; }
+        [[nodiscard]] auto getPass() const noexcept { return pass; }
+        [[nodiscard]] auto getBlending() const noexcept { return blending; }
+
+        [[nodiscard]] auto getCommandCount() const noexcept { return command_count; }
+        [[nodiscard]] const auto& getStats() const noexcept { return stats; }
+
+        // share of instances served from cache by updates
+        [[nodiscard]] float getHitRate() const noexcept;
+
+        // submits recorded commands; has to be called on thread owning context
+        void replay(Context& ctx, const UniformSetter& setter, const InstanceCallback& callback = {}, const InstanceFilter& filter = {}) const;
+
+        void clear() noexcept;
+    };
+}
@@ -8,13 +8,15 @@ namespace Limitless {
     class FXAAPass final : public RenderPass {
     private:
     	Framebuffer framebuffer;
+    	std::shared_ptr<Texture> scene;
     public:
-        explicit FXAAPass(Pipeline& pipeline, glm::uvec2 frame_size);
+        explicit FXAAPass(Pipeline& pipeline);
+
+        void declare(RenderGraph::Builder& builder) override;
+        void realize(RenderGraph& graph) override;
 
         std::shared_ptr<Texture> getResult() override { return framebuffer.get(FramebufferAttachment::Color0).texture; }
 
 	    void draw(Instances& instances, Context& ctx, const Assets& assets, const Camera& camera, UniformSetter& setter) override;
-
-        void onFramebufferChange(glm::uvec2 size) override;
     };
 }
\ No newline at end of file
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <limitless/pipeline/render_pass.hpp>
+#include <limitless/pipeline/draw_list.hpp>
 #include <limitless/core/framebuffer.hpp>
 
 namespace Limitless::fx {
@@ -8,13 +9,28 @@ namespace Limitless::fx {
 }
 
 namespace Limitless {
+    class DepthPass;
+
     class GBufferPass final : public RenderPass {
     private:
         fx::EffectRenderer& renderer;
+        Framebuffer* framebuffer {};
+        // instances occluded in depth are skipped, so nothing is drawn without depth of its own
+        DepthPass* depth {};
+        DrawList commands;
+        // scene version and camera position commands were sorted for
+        uint64_t scene_version {};
+        glm::vec3 sorted_from {};
     public:
         GBufferPass(Pipeline& pipeline, fx::EffectRenderer& renderer);
         ~GBufferPass() override = default;
 
+        void declare(RenderGraph::Builder& builder) override;
+        void realize(RenderGraph& graph) override;
+
+        void update(Scene& scene, Instances& instances, Context& ctx, const Camera& camera) override;
         void draw(Instances& instances, Context& ctx, const Assets& assets, const Camera& camera, UniformSetter& setter) override;
+
+        [[nodiscard]] const auto& getDrawList() const noexcept { return commands; }
     };
 }
\ No newline at end of file
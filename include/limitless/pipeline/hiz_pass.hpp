@@ -0,0 +1,74 @@
+#pragma once
+
+#include <limitless/pipeline/render_pass.hpp>
+#include <limitless/pipeline/occlusion_tester.hpp>
+#include <limitless/core/framebuffer.hpp>
+#include <limitless/core/buffer.hpp>
+
+#include <array>
+
+namespace Limitless {
+    /*
+     * hierarchical depth pyramid built from depth of DepthPass
+     *
+     * every texel keeps nearest (R) and farthest (G) depth of texels it covers; level 0 is half of frame size
+     * pyramid is imported into graph as "hiz" for screen-space passes
+     *
+     * farthest depth of coarse level is read back without waiting and fed to occlusion tester,
+     * so boxes are tested against depth of frame finished by GPU, usually previous one
+     */
+    class HiZPass final : public RenderPass {
+    public:
+        // frames that may be in flight before readback slot is reused
+        static constexpr uint32_t READBACK_COUNT = 3;
+        // largest side of level that is read back
+        static constexpr uint32_t READBACK_SIZE = 128;
+    private:
+        struct Readback {
+            std::unique_ptr<Buffer> buffer;
+            GLsync fence {};
+            glm::uvec2 size {};
+            glm::mat4 view_projection {1.0f};
+        };
+
+        std::shared_ptr<Texture> pyramid;
+        // levels from 1 are rendered here while previous level of pyramid is sampled
+        std::shared_ptr<Texture> scratch;
+        std::shared_ptr<Texture> depth;
+        // framebuffer per level of pyramid
+        std::vector<Framebuffer> levels;
+        // framebuffer per level of scratch, starting from 1
+        std::vector<Framebuffer> scratch_levels;
+
+        std::array<Readback, READBACK_COUNT> readbacks;
+        uint32_t readback_level {};
+        // slot captured next, it is also the oldest one
+        uint32_t next {};
+
+        OcclusionTester tester;
+
+        void build(glm::uvec2 frame_size);
+        void downsample(Context& ctx, const Assets& assets);
+        void capture(const Camera& camera);
+        void poll();
+        void releaseReadbacks() noexcept;
+        static void unbindPackBuffer() noexcept;
+    public:
+        HiZPass(Pipeline& pipeline, glm::uvec2 frame_size);
+        ~HiZPass() override;
+
+        void declare(RenderGraph::Builder& builder) override;
+        void realize(RenderGraph& graph) override;
+
+        void update(Scene& scene, Instances& instances, Context& ctx, const Camera& camera) override;
+        void draw(Instances& instances, Context& ctx, const Assets& assets, const Camera& camera, UniformSetter& setter) override;
+
+        std::shared_ptr<Texture> getResult() override { return pyramid; }
+
+        void onFramebufferChange(glm::uvec2 size) override;
+
+        [[nodiscard]] auto& getOcclusionTester() noexcept { return tester; }
+        [[nodiscard]] const auto& getOcclusionTester() const noexcept { return tester; }
+        [[nodiscard]] auto getReadbackLevel() const noexcept { return readback_level; }
+    };
+}
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <limitless/util/bounding_box.hpp>
+#include <glm/glm.hpp>
+
+#include <cstdint>
+#include <vector>
+
+namespace Limitless {
+    /*
+     * tests bounding boxes against farthest depth of previous frame on CPU
+     *
+     * depth is read back from coarse level of Hi-Z pyramid and reduced further into own mip chain
+     * box is occluded when its nearest depth lies behind farthest depth of every texel it covers
+     * boxes are projected with view projection depth was rendered with, so result lags camera by latency of readback
+     * boxes crossing near plane, lying outside of screen or with unknown bounds are never occluded
+     */
+    class OcclusionTester final {
+    public:
+        struct Stats {
+            uint64_t tested {};
+            uint64_t occluded {};
+        };
+
+        // box is tested at level where it covers at most this many texels in each direction
+        static constexpr uint32_t MAX_TEXELS = 4;
+    private:
+        // farthest depth of texels, finest level first
+        std::vector<std::vector<float>> levels;
+        std::vector<glm::uvec2> sizes;
+        glm::mat4 view_projection {1.0f};
+
+        Stats frame_stats;
+        Stats last_frame_stats;
+
+        [[nodiscard]] float getFarthest(uint32_t level, glm::uvec2 first, glm::uvec2 last) const noexcept;
+    public:
+        OcclusionTester() = default;
+
+        // takes farthest depth of every texel in rows from bottom, as rendered with view projection
+        void update(glm::uvec2 size, std::vector<float> depth, const glm::mat4& view_projection);
+        // forgets depth; nothing is occluded until next update
+        void reset() noexcept;
+
+        [[nodiscard]] bool isOccluded(const BoundingBox& box) noexcept;
+
+        // should be called once per frame before boxes are tested
+        void onFrame() noexcept;
+
+        [[nodiscard]] bool isAvailable() const noexcept { return !levels.empty(); }
+        [[nodiscard]] glm::uvec2 getSize() const noexcept { return sizes.empty() ? glm::uvec2{} : sizes.front(); }
+        [[nodiscard]] const auto& getViewProjection() const noexcept { return view_projection; }
+
+        [[nodiscard]] const auto& getFrameStats() const noexcept { return frame_stats; }
+        [[nodiscard]] const auto& getLastFrameStats() const noexcept { return last_frame_stats; }
+    };
+}
@@ -19,8 +19,15 @@ namespace Limitless {
     class Pipeline {
     protected:
         std::vector<std::unique_ptr<RenderPass>> passes;
+        RenderGraph graph;
         RenderTarget* target {};
         glm::uvec2 size;
+
+        // kept between frames, so that scene update pass refills it only when scene changes
+        Instances instances;
+
+        // builds graph from declarations of passes; should be called after passes are added
+        void compile();
     public:
         explicit Pipeline(glm::uvec2 size, RenderTarget& target) noexcept;
         virtual ~Pipeline() = default;
@@ -43,16 +50,27 @@ namespace Limitless {
         }
 
         template<typename Pass>
-        auto& get() {
+        Pass* find() const noexcept {
             for (const auto& pass : passes) {
                 if (auto *p = dynamic_cast<Pass*>(pass.get()); p) {
-                    return *p;
+                    return p;
                 }
             }
 
+            return nullptr;
+        }
+
+        template<typename Pass>
+        auto& get() {
+            if (auto* pass = find<Pass>(); pass) {
+                return *pass;
+            }
+
             throw pipeline_pass_not_found(typeid(Pass).name());
         }
 
+        [[nodiscard]] const auto& getGraph() const noexcept { return graph; }
+
         auto& getPrevious(RenderPass* curr) {
 	        for (uint32_t i = 1; i < passes.size(); ++i) {
 		        if (passes[i].get() == curr) {
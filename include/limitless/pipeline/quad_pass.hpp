@@ -14,6 +14,8 @@ namespace Limitless {
 
         void setTarget(RenderTarget& target);
 
+        void declare(RenderGraph::Builder& builder) override;
+
         void draw(Instances& instances, Context& ctx, const Assets& assets, const Camera& camera, UniformSetter& setter) override;
     };
 }
\ No newline at end of file
@@ -0,0 +1,180 @@
+#pragma once
+
+#include <limitless/core/texture.hpp>
+#include <glm/glm.hpp>
+
+#include <unordered_map>
+#include <stdexcept>
+#include <optional>
+#include <ostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace Limitless {
+    class Context;
+
+    class render_graph_error : public std::logic_error {
+    public:
+        using std::logic_error::logic_error;
+    };
+
+    /*
+     * graph of render passes and named textures they read and write
+     *
+     * passes are added in execution order and declare their accesses through Builder
+     * compile() culls passes whose outputs are never read, computes lifetimes of transient textures
+     * and lets textures with same descriptor and non-overlapping lifetimes share one physical texture
+     * begin() performs clears and memory barriers scheduled for pass; it has to be called right before pass is executed
+     */
+    class RenderGraph final {
+    public:
+        using PassId = uint32_t;
+        using ResourceId = uint32_t;
+
+        enum class Access {
+            // sampled in shader or read by blit
+            Sampled,
+            // used as framebuffer attachment
+            Attachment,
+            // image load/store
+            Storage
+        };
+
+        struct TextureDescriptor {
+            Texture::InternalFormat format {Texture::InternalFormat::RGBA8};
+            Texture::Filter filter {Texture::Filter::Nearest};
+            // size relative to frame
+            glm::vec2 scale {1.0f};
+            // cleared right before first pass writing it
+            bool clear {};
+            // depth formats are cleared to x, stencil to y
+            glm::vec4 clear_value {0.0f};
+        };
+
+        struct Stats {
+            // bytes of transient textures if each of them had its own memory
+            size_t requested {};
+            // bytes of physical textures after aliasing
+            size_t allocated {};
+            uint32_t resources {};
+            uint32_t textures {};
+            uint32_t passes {};
+            uint32_t culled {};
+        };
+
+        class Builder {
+        private:
+            RenderGraph& graph;
+            PassId pass;
+        public:
+            Builder(RenderGraph& graph, PassId pass) noexcept;
+
+            // declares transient texture owned by graph; pass writes it
+            ResourceId create(const std::string& name, const TextureDescriptor& descriptor);
+            // declares texture owned by pass; it is never aliased
+            ResourceId import(const std::string& name, std::shared_ptr<Texture> texture);
+
+            ResourceId read(const std::string& name, Access access = Access::Sampled);
+            ResourceId write(const std::string& name, Access access = Access::Attachment);
+
+            // reads resource last written by any of preceding passes if there is one
+            std::optional<ResourceId> readPrevious(Access access = Access::Sampled);
+
+            [[nodiscard]] bool contains(const std::string& name) const noexcept;
+
+            // pass is kept even when nothing reads its outputs
+            void setSideEffect() noexcept;
+        };
+    private:
+        struct Use {
+            ResourceId resource;
+            Access access;
+        };
+
+        struct PassNode {
+            std::string name;
+            std::vector<Use> reads;
+            std::vector<Use> writes;
+            bool side_effect {};
+            bool culled {};
+
+            // scheduled by compile
+            std::vector<ResourceId> clears;
+            GLbitfield barriers {};
+        };
+
+        struct ResourceNode {
+            std::string name;
+            TextureDescriptor descriptor;
+            std::shared_ptr<Texture> imported;
+            std::optional<PassId> last_writer;
+
+            // lifetime in kept passes
+            std::optional<PassId> first;
+            PassId last {};
+            std::optional<uint32_t> physical;
+        };
+
+        struct Physical {
+            TextureDescriptor descriptor;
+            glm::uvec2 size;
+            std::shared_ptr<Texture> texture;
+            PassId last {};
+        };
+
+        std::vector<PassNode> passes;
+        std::vector<ResourceNode> resources;
+        std::unordered_map<std::string, ResourceId> names;
+        std::vector<Physical> physicals;
+
+        glm::uvec2 frame_size {};
+        Stats stats;
+
+        ResourceId add(const std::string& name);
+        [[nodiscard]] ResourceId getId(const std::string& name) const;
+
+        void cull();
+        void computeLifetimes();
+        void alias();
+        void schedule();
+        void realize();
+
+        void clear(const ResourceNode& resource, Context& ctx);
+
+        [[nodiscard]] glm::uvec2 getSize(const TextureDescriptor& descriptor) const noexcept;
+        [[nodiscard]] static bool isDepth(Texture::InternalFormat format) noexcept;
+        [[nodiscard]] static std::shared_ptr<Texture> build(const TextureDescriptor& descriptor, glm::uvec2 size);
+    public:
+        RenderGraph();
+        ~RenderGraph();
+
+        RenderGraph(const RenderGraph&) = delete;
+        RenderGraph& operator=(const RenderGraph&) = delete;
+
+        // pass ids follow order of adding
+        Builder addPass(std::string name);
+
+        // forgets passes and resources; physical textures are kept to be reused by next compile
+        void reset() noexcept;
+
+        // culls, aliases and allocates textures for frame of specified size
+        void compile(glm::uvec2 size);
+
+        // performs clears and barriers scheduled before pass
+        void begin(PassId pass, Context& ctx);
+
+        [[nodiscard]] auto getPassCount() const noexcept { return passes.size(); }
+        [[nodiscard]] bool isCulled(PassId pass) const { return passes.at(pass).culled; }
+        [[nodiscard]] const std::string& getName(PassId pass) const { return passes.at(pass).name; }
+        [[nodiscard]] bool contains(const std::string& name) const noexcept { return names.find(name) != names.end(); }
+
+        // texture of resource; it is null when nothing uses resource
+        [[nodiscard]] const std::shared_ptr<Texture>& getTexture(const std::string& name) const;
+
+        [[nodiscard]] const auto& getStats() const noexcept { return stats; }
+
+        // prints passes and resources with physical texture they are assigned to
+        void report(std::ostream& stream) const;
+    };
+}
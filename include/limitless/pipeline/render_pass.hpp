@@ -1,5 +1,7 @@
 #pragma once
 
+#include <limitless/pipeline/render_graph.hpp>
+
 #include <functional>
 #include <memory>
 #include <stdexcept>
@@ -28,6 +30,11 @@ namespace Limitless {
         std::shared_ptr<Texture> getPreviousResult();
         virtual std::shared_ptr<Texture> getResult() { throw std::logic_error{"This RenderPass does not provide result method!"}; }
 
+        // declares textures pass reads and writes; passes without declarations are never culled
+        virtual void declare(RenderGraph::Builder& builder);
+        // called after graph is compiled, textures of graph can be taken from here
+        virtual void realize(RenderGraph& graph);
+
         virtual void addSetter(UniformSetter& setter);
         virtual void draw(Instances& instances, Context& ctx, const Assets& assets, const Camera& camera, UniformSetter& setter);
 
@@ -20,6 +20,9 @@ namespace Limitless {
         bool fast_approximate_antialiasing = true;
         bool depth_of_field = false;
 
+        // builds Hi-Z pyramid and skips depth and G-buffer draws of models hidden behind depth of previous frames
+        bool occlusion_culling = false;
+
         bool directional_cascade_shadow_mapping = true;
         glm::uvec2 directional_shadow_resolution = { 1024 * 4, 1024 * 4 };
         uint8_t directional_split_count = 3; // [2; 4]
@@ -31,5 +34,7 @@ namespace Limitless {
         bool light_radius = true;
         bool coordinate_system_axes = false;
         bool bounding_box = false;
+        // timings of last profiled frame
+        bool profiler = false;
     };
 }
@@ -10,6 +10,7 @@ namespace Limitless::ms {
 
 namespace Limitless {
     class ContextEventObserver;
+    class TextureStreamer;
     class Scene;
     class Context;
     class Assets;
@@ -19,6 +20,10 @@ namespace Limitless {
     private:
         RenderSettings settings;
         std::unique_ptr<Pipeline> pipeline;
+        // optional, requests mip levels of streamed textures drawn in frame
+        TextureStreamer* streamer {};
+        // instances that passed culling in last frame, kept to reuse allocation
+        Instances visible;
     public:
         Renderer(std::unique_ptr<Pipeline> pipeline, const RenderSettings& settings);
         Renderer(ContextEventObserver& ctx, const RenderSettings& settings);
@@ -31,8 +36,12 @@ namespace Limitless {
         auto& getSettings() noexcept { return settings; }
         [[nodiscard]] const auto& getSettings() const noexcept { return settings; }
 
+        // streamer has to outlive renderer, e.g. AssetManager::getTextureStreamer()
+        void setTextureStreamer(TextureStreamer* _streamer) noexcept { streamer = _streamer; }
+
         void update(ContextEventObserver& ctx, Assets& assets);
         void updatePipeline(ContextEventObserver& ctx);
-        void draw(Context& context, const Assets& assets, Scene& scene, Camera& camera);
+        // variants of materials that are still compiling are drawn with fallback programs
+        void draw(Context& context, Assets& assets, Scene& scene, Camera& camera);
     };
 }
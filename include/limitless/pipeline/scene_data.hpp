@@ -6,7 +6,6 @@
 namespace Limitless {
     class Context;
     class Camera;
-    class Buffer;
 
     struct SceneData {
         glm::mat4 projection {1.0f};
@@ -24,10 +23,9 @@ namespace Limitless {
     class SceneDataStorage final {
     private:
         SceneData scene_data;
-        std::shared_ptr<Buffer> buffer;
     public:
-        explicit SceneDataStorage(Context& context);
-        ~SceneDataStorage();
+        SceneDataStorage() = default;
+        ~SceneDataStorage() = default;
 
         SceneDataStorage(const SceneDataStorage&) = delete;
         SceneDataStorage(SceneDataStorage&&) = delete;
@@ -2,11 +2,14 @@
 
 #include <limitless/pipeline/render_pass.hpp>
 #include <limitless/pipeline/scene_data.hpp>
+#include <optional>
 
 namespace Limitless {
     class SceneUpdatePass final : public RenderPass {
     private:
         SceneDataStorage scene_data;
+        // scene version instances were copied at; passes only reorder them in between
+        std::optional<uint64_t> instances_version;
     public:
         SceneUpdatePass(Pipeline& pipeline, Context& ctx);
 
@@ -18,7 +18,6 @@ namespace Limitless {
         DirectionalShadowPass(Pipeline& pipeline, Context& ctx, const RenderSettings& settings);
         DirectionalShadowPass(Pipeline& pipeline, Context& ctx, const RenderSettings& settings, fx::EffectRenderer& renderer);
 
-        void addSetter(UniformSetter& setter) override;
         void update(Scene& scene, Instances& instances, Context& ctx, const Camera& camera) override;
         void draw(Instances& instances, Context& ctx, const Assets& assets, const Camera& camera, UniformSetter& setter) override;
     };
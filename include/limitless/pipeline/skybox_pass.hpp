@@ -1,6 +1,7 @@
 #pragma once
 
 #include <limitless/pipeline/render_pass.hpp>
+#include <limitless/core/frame_clock.hpp>
 
 namespace Limitless {
     class Skybox;
@@ -8,6 +9,7 @@ namespace Limitless {
     class SkyboxPass final : public RenderPass {
     private:
         Skybox* skybox {};
+        FrameTime time;
     public:
         explicit SkyboxPass(Pipeline& pipeline);
 
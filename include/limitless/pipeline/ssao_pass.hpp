@@ -20,6 +20,8 @@ namespace Limitless {
         } data;
 
         Framebuffer framebuffer;
+        std::shared_ptr<Texture> normal;
+        std::shared_ptr<Texture> depth;
         std::shared_ptr<Texture> noise;
         std::shared_ptr<Buffer> buffer;
 
@@ -27,12 +29,12 @@ namespace Limitless {
         void generateKernel(Context& ctx);
     public:
         SSAOPass(Pipeline& pipeline, ContextEventObserver& ctx);
-        SSAOPass(Pipeline& pipeline, ContextEventObserver& ctx, glm::uvec2 frame_size);
+
+        void declare(RenderGraph::Builder& builder) override;
+        void realize(RenderGraph& graph) override;
 
         std::shared_ptr<Texture> getResult() override { return framebuffer.get(FramebufferAttachment::Color1).texture; }
 
         void draw(Instances& instances, Context& ctx, const Assets& assets, const Camera& camera, UniformSetter& setter) override;
-
-        void onFramebufferChange(glm::uvec2 size) override;
     };
 }
@@ -13,13 +13,19 @@ namespace Limitless {
     private:
         Framebuffer framebuffer;
         fx::EffectRenderer& renderer;
+
+        Framebuffer* lighting {};
+        std::shared_ptr<Texture> refraction;
+
         void sort(Instances& instances, const Camera& camera, ms::Blending blending);
     public:
-        explicit TranslucentPass(Pipeline& pipeline, fx::EffectRenderer& renderer, glm::uvec2 frame_size, std::shared_ptr<Texture> depth);
+        explicit TranslucentPass(Pipeline& pipeline, fx::EffectRenderer& renderer);
+
+        void declare(RenderGraph::Builder& builder) override;
+        void realize(RenderGraph& graph) override;
 
         void draw(Instances& instances, Context& ctx, const Assets& assets, const Camera& camera, UniformSetter& setter) override;
 
         std::shared_ptr<Texture> getResult() override;
-        void onFramebufferChange(glm::uvec2 size) override;
     };
 }
\ No newline at end of file
@@ -0,0 +1,14 @@
+#pragma once
+
+#include <limitless/pipeline/render_pass.hpp>
+
+namespace Limitless {
+    // updates virtual texture of drawn assets before anything samples it
+    // every pipeline drawing paged materials has to add it before its draw passes
+    class VirtualTexturePass final : public RenderPass {
+    public:
+        explicit VirtualTexturePass(Pipeline& pipeline);
+
+        void draw(Instances& instances, Context& ctx, const Assets& assets, const Camera& camera, UniformSetter& setter) override;
+    };
+}
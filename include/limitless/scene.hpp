@@ -1,8 +1,10 @@
 #pragma once
 
 #include <limitless/lighting/lighting.hpp>
+#include <limitless/core/frame_clock.hpp>
 #include <stdexcept>
 #include <unordered_map>
+#include <optional>
 #include <memory>
 
 namespace Limitless {
@@ -19,6 +21,20 @@ namespace Limitless {
         std::unordered_map<uint64_t, std::unique_ptr<AbstractInstance>> instances;
         std::shared_ptr<Skybox> skybox;
 
+        // advanced once per update, its time is passed to every instance
+        FrameClock clock;
+
+        // changes whenever instances are added or removed; unique among all scenes
+        static inline uint64_t next_version {};
+        uint64_t version {++next_version};
+        // advanced by attachments of instances of this scene; last value seen by getVersion
+        uint64_t structure_version {};
+        uint64_t attachments_version {};
+
+        // instances with their attachments; rebuilt when version changes
+        Instances wrappers;
+        std::optional<uint64_t> wrappers_version;
+
         void removeDeadInstances() noexcept;
     public:
         explicit Scene(Context& context);
@@ -31,7 +47,9 @@ namespace Limitless {
         T& add(T* instance) noexcept {
             static_assert(std::is_base_of_v<AbstractInstance, T>, "Typename type must be base of AbstractInstance");
 
+            instance->setStructureVersion(&structure_version);
             instances.emplace(instance->getId(), instance);
+            version = ++next_version;
             return *instance;
         }
 
@@ -40,7 +58,9 @@ namespace Limitless {
             static_assert(std::is_base_of_v<AbstractInstance, T>, "Typename type must be base of AbstractInstance");
 
             T* instance = new T(std::forward<Args>(args)...);
+            instance->setStructureVersion(&structure_version);
             instances.emplace(instance->getId(), instance);
+            version = ++next_version;
             return *instance;
         }
 
@@ -55,8 +75,13 @@ namespace Limitless {
         const auto& getSkybox() const noexcept { return skybox; }
         void setSkybox(std::shared_ptr<Skybox> skybox);
 
+        // advances clock and updates instances with its time
         virtual void update(Context& context, const Camera& camera);
 
+        auto& getClock() noexcept { return clock; }
+        [[nodiscard]] const auto& getClock() const noexcept { return clock; }
+        [[nodiscard]] const auto& getTime() const noexcept { return clock.getTime(); }
+
         auto begin() noexcept { return instances.begin(); }
         auto begin() const noexcept { return instances.begin(); }
 
@@ -64,7 +89,10 @@ namespace Limitless {
         auto end() const noexcept { return instances.end(); }
 
         auto& getInstances() noexcept { return instances; }
-        Instances getWrappers() noexcept;
+        const Instances& getWrappers();
+
+        // identifies set of instances and their attachments
+        [[nodiscard]] uint64_t getVersion() noexcept;
 
         auto size() const noexcept { return instances.size(); }
 
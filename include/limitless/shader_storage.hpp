@@ -2,11 +2,15 @@
 
 #include <limitless/fx/emitters/unique_emitter.hpp>
 #include <limitless/pipeline/shader_pass_types.hpp>
+#include <limitless/core/shader_compiler.hpp>
 #include <limitless/util/filesystem.hpp>
 #include <unordered_map>
 #include <memory>
+#include <shared_mutex>
 #include <mutex>
+#include <atomic>
 #include <map>
+#include <set>
 
 namespace Limitless {
     class RenderSettings;
@@ -44,7 +48,27 @@ namespace Limitless {
         std::map<ShaderKey, std::shared_ptr<ShaderProgram>> materials;
         std::map<fx::UniqueEmitterShaderKey, std::shared_ptr<ShaderProgram>> emitters;
 
-        std::mutex mutex;
+        // material variants that are being compiled by driver
+        std::map<ShaderKey, PendingProgram> pending;
+        // drawn instead of material variants that are not compiled yet
+        std::map<std::pair<ShaderPass, ModelShader>, std::shared_ptr<ShaderProgram>> fallbacks;
+
+        // programs removed for recompilation; drawn until replacements are compiled and put back when they fail
+        std::unordered_map<std::string, std::shared_ptr<ShaderProgram>> replaced_shaders;
+        std::map<ShaderKey, std::shared_ptr<ShaderProgram>> replaced_materials;
+        std::map<fx::UniqueEmitterShaderKey, std::shared_ptr<ShaderProgram>> replaced_emitters;
+
+        // programs are resolved by draw list workers while GL thread adds and finishes them
+        mutable std::shared_mutex mutex;
+
+        // changes whenever material programs are added, finished or removed
+        std::atomic<uint64_t> version {};
+
+        template<typename Predicate>
+        uint32_t erasePending(Predicate&& predicate);
+        // moves finished program to its reserved key; failed one is logged and replaced program is put back,
+        // otherwise key stays unresolved
+        void finish(ShaderCompiler& compiler, const ShaderKey& key, PendingProgram& program);
     public:
         ShaderStorage() = default;
         ~ShaderStorage() = default;
@@ -59,8 +83,35 @@ namespace Limitless {
         void add(ShaderPass material_type, ModelShader model_type, uint64_t material_index, std::shared_ptr<ShaderProgram> program);
         void add(const fx::UniqueEmitterShaderKey& emitter_type, std::shared_ptr<ShaderProgram> program);
 
+        // variant is drawn with fallback program until it is compiled, or for good when it fails to compile
+        void add(ShaderPass material_type, ModelShader model_type, uint64_t material_index, PendingProgram program);
+        // compiled variant of material is used for its pass and model type while other variants are compiled
+        void setFallback(ShaderPass material_type, ModelShader model_type, uint64_t material_index);
+
         void remove(ShaderPass material_type, ModelShader model_type, uint64_t material_index);
 
+        // removes programs whose sources refer to settings that changed their values; returns number of removed programs
+        // removed programs are still drawn until they are compiled again
+        uint32_t removeOutdated(const RenderSettings& settings);
+        // removes programs that were preprocessed from file, same way
+        uint32_t removeDependent(const fs::path& file);
+
+        // puts back removed program after its replacement failed to compile; returns false when there is none
+        bool restore(const std::string& name);
+        bool restore(ShaderPass material_type, ModelShader model_type, uint64_t material_index);
+        bool restore(const fx::UniqueEmitterShaderKey& emitter_type);
+        // all files programs were preprocessed from
+        std::set<fs::path> getDependencies() const;
+
+        // moves programs finished by driver to storage; should be called once per frame
+        void update(Context& ctx);
+        // finishes all pending programs
+        void wait(Context& ctx);
+        [[nodiscard]] size_t getPendingCount() const noexcept { return pending.size(); }
+
+        // programs resolved with older version may be replaced or destroyed
+        [[nodiscard]] uint64_t getVersion() const noexcept { return version; }
+
         bool contains(const std::string& name) noexcept;
         bool contains(ShaderPass material_type, ModelShader model_type, uint64_t material_index) noexcept;
         bool contains(const fx::UniqueEmitterShaderKey& emitter_type) noexcept;
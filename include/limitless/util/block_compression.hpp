@@ -0,0 +1,32 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+namespace Limitless {
+    class ThreadPool;
+
+    // BCn formats encoded on CPU
+    enum class BlockFormat {
+        BC1, // rgb, 8 bytes per block
+        BC3, // rgba, 16 bytes per block
+        BC4, // r, 8 bytes per block
+        BC5, // rg, 16 bytes per block
+        BC7  // rgba, 16 bytes per block; mode 6 only
+    };
+
+    size_t getBlockSize(BlockFormat format) noexcept;
+    size_t getCompressedSize(BlockFormat format, uint32_t width, uint32_t height) noexcept;
+
+    // encodes single 4x4 block of rgba8 pixels in row order
+    void compressBlock(BlockFormat format, const uint8_t* rgba, std::byte* out) noexcept;
+
+    /*
+     * encodes tightly packed 8-bit image with 1-4 channels; missing color channels are 0, missing alpha is 255
+     *
+     * edge blocks of sizes not divisible by 4 repeat last row and column
+     * rows of blocks are split between pool threads when pool is specified
+     */
+    std::vector<std::byte> compressImage(BlockFormat format, const uint8_t* pixels, uint32_t width, uint32_t height, uint32_t channels, ThreadPool* pool = nullptr);
+}
@@ -3,6 +3,7 @@
 #include <glm/glm.hpp>
 #include <glm/gtx/functions.hpp>
 #include <vector>
+#include <limits>
 
 namespace Limitless {
     struct BoundingBox {
@@ -12,8 +13,12 @@ namespace Limitless {
 
     template<typename V>
     inline BoundingBox calculateBoundingBox(const std::vector<V>& vertices) {
+        if (vertices.empty()) {
+            return {};
+        }
+
         auto min = glm::vec3{ std::numeric_limits<float>::max() };
-        auto max = glm::vec3{ std::numeric_limits<float>::min() };
+        auto max = glm::vec3{ std::numeric_limits<float>::lowest() };
 
         for (const auto& v : vertices) {
             const glm::vec3 position = v.getPosition();
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <limitless/util/mapped_file.hpp>
+#include <memory>
+#include <vector>
+
+namespace Limitless {
+    class ByteBuffer;
+
+    /*
+     * contiguous read-only bytes of an asset
+     *
+     * path is logical asset path, loaders use it for naming and format detection
+     */
+    class ByteSource {
+    protected:
+        fs::path path;
+    public:
+        explicit ByteSource(fs::path _path) noexcept : path {std::move(_path)} {}
+        virtual ~ByteSource() = default;
+
+        [[nodiscard]] virtual const std::byte* getData() const noexcept = 0;
+        [[nodiscard]] virtual size_t getSize() const noexcept = 0;
+
+        [[nodiscard]] const auto& getPath() const noexcept { return path; }
+
+        // non-owning buffer, source must outlive it
+        [[nodiscard]] ByteBuffer view() const;
+    };
+
+    class FileByteSource final : public ByteSource {
+    private:
+        MappedFile file;
+    public:
+        explicit FileByteSource(const fs::path& path);
+
+        [[nodiscard]] const std::byte* getData() const noexcept override { return file.getData(); }
+        [[nodiscard]] size_t getSize() const noexcept override { return file.getSize(); }
+    };
+
+    class MemoryByteSource final : public ByteSource {
+    private:
+        std::vector<std::byte> bytes;
+    public:
+        MemoryByteSource(fs::path path, std::vector<std::byte>&& bytes) noexcept;
+
+        [[nodiscard]] const std::byte* getData() const noexcept override { return bytes.data(); }
+        [[nodiscard]] size_t getSize() const noexcept override { return bytes.size(); }
+    };
+
+    // range of memory kept alive by its owner, e.g. uncompressed entry of mapped pack
+    class ViewByteSource final : public ByteSource {
+    private:
+        std::shared_ptr<const void> owner;
+        const std::byte* data;
+        size_t size;
+    public:
+        ViewByteSource(fs::path path, std::shared_ptr<const void> owner, const std::byte* data, size_t size) noexcept;
+
+        [[nodiscard]] const std::byte* getData() const noexcept override { return data; }
+        [[nodiscard]] size_t getSize() const noexcept override { return size; }
+    };
+}
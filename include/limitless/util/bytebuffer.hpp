@@ -1,8 +1,12 @@
 #pragma once
 
 #include <algorithm>
+#include <stdexcept>
+#include <cstring>
 #include <string>
 #include <memory>
+#include <vector>
+#include <array>
 #include <set>
 #include <unordered_map>
 #include <map>
@@ -10,17 +14,49 @@
 namespace Limitless {
     class Assets;
 
+    struct bytebuffer_error : public std::runtime_error {
+        using runtime_error::runtime_error;
+    };
+
+    /*
+     * writes append to the end, reads advance the cursor
+     *
+     * size/data/begin/end refer to the unread part of the buffer
+     * buffer can view external memory (e.g. memory mapped file) without copying,
+     * such memory must outlive the buffer; first modification copies it
+     */
     class ByteBuffer final {
     private:
         std::vector<std::byte> buffer;
 
+        // non-owning memory
+        const std::byte* external {};
+        size_t external_size {};
+
+        // read cursor
+        size_t position {};
+
+        [[nodiscard]] const std::byte* storage() const noexcept { return external ? external : buffer.data(); }
+        [[nodiscard]] size_t total() const noexcept { return external ? external_size : buffer.size(); }
+
+        void detach() {
+            if (external) {
+                buffer.assign(external + position, external + external_size);
+                external = nullptr;
+                external_size = 0;
+                position = 0;
+            }
+        }
+
         void write(const std::byte& bytes, size_t size) {
-            buffer.insert(buffer.end(), &bytes, &bytes + size);
+            detach();
+            const auto offset = buffer.size();
+            buffer.resize(offset + size);
+            std::memcpy(buffer.data() + offset, &bytes, size);
         }
 
         void read(std::byte& bytes, size_t size) {
-            std::copy(buffer.begin(), buffer.begin() + size, &bytes);
-            buffer.erase(buffer.begin(), buffer.begin() + size);
+            std::memcpy(&bytes, skip(size), size);
         }
     public:
         ByteBuffer() = default;
@@ -37,15 +73,35 @@ namespace Limitless {
         ByteBuffer(ByteBuffer&&) = default;
         ByteBuffer& operator=(ByteBuffer&&) = default;
 
-        [[nodiscard]] auto size() const noexcept { return buffer.size(); }
-        [[nodiscard]] auto capacity() const noexcept { return buffer.capacity(); }
-        [[nodiscard]] auto data() const noexcept { return buffer.data(); }
-        [[nodiscard]] auto cdata() noexcept { return reinterpret_cast<char*>(buffer.data()); }
-        void reserve(size_t size) noexcept { buffer.reserve(size); }
+        static ByteBuffer view(const std::byte* data, size_t size) noexcept {
+            ByteBuffer buffer;
+            buffer.external = data;
+            buffer.external_size = size;
+            return buffer;
+        }
+
+        [[nodiscard]] auto size() const noexcept { return total() - position; }
+        [[nodiscard]] auto capacity() const noexcept { return external ? external_size : buffer.capacity(); }
+        [[nodiscard]] auto data() const noexcept { return storage() + position; }
+        [[nodiscard]] auto cdata() { detach(); return reinterpret_cast<char*>(buffer.data() + position); }
+        [[nodiscard]] auto isView() const noexcept { return external != nullptr; }
+        void reserve(size_t size) { detach(); buffer.reserve(position + size); }
+
+        // advances the cursor and returns pointer to skipped bytes without copying
+        const std::byte* skip(size_t size) {
+            if (size > this->size()) {
+                throw bytebuffer_error("ByteBuffer read out of range");
+            }
+
+            const auto* bytes = data();
+            position += size;
+            return bytes;
+        }
 
         template<typename Iter>
         auto insert(Iter first, Iter last) {
-            return buffer.insert(buffer.begin(), first, last);
+            detach();
+            return buffer.insert(buffer.begin() + position, first, last);
         }
 
         void write(const std::string& str) {
@@ -56,8 +112,7 @@ namespace Limitless {
         void read(std::string& str) {
             size_t size{};
             read(size);
-            str.resize(size);
-            read(reinterpret_cast<std::byte&>(*str.data()), size);
+            str.assign(reinterpret_cast<const char*>(skip(size)), size);
         }
 
         template<typename T, std::enable_if_t<std::is_trivially_copyable_v<std::remove_reference_t<T>>, bool> = true>
@@ -71,16 +126,15 @@ namespace Limitless {
         }
 
         void flip() {
-            std::reverse(buffer.begin(), buffer.end());
+            detach();
+            std::reverse(buffer.begin() + position, buffer.end());
         }
 
-        template<typename T, std::enable_if_t<std::is_copy_constructible_v<T>, bool> = true>
+        template<typename T, std::enable_if_t<std::is_trivially_copyable_v<T>, bool> = true>
         T erase() {
-            std::array<std::byte, sizeof(T)> value{};
-            std::copy(buffer.begin(), buffer.begin() + sizeof(T), value.begin());
-            buffer.erase(buffer.begin(), buffer.begin() + sizeof(T));
-
-            return reinterpret_cast<T&>(value);
+            T value;
+            read(value);
+            return value;
         }
 
         template<typename T>
@@ -102,7 +156,13 @@ namespace Limitless {
         template<typename T>
         ByteBuffer& operator<<(const std::vector<T>& v) {
             *this << v.size();
-            std::for_each(v.begin(), v.end(), [this] (const auto& el) { *this << el; });
+            if constexpr (std::is_arithmetic_v<T>) {
+                if (!v.empty()) {
+                    write(reinterpret_cast<const std::byte&>(*v.data()), v.size() * sizeof(T));
+                }
+            } else {
+                std::for_each(v.begin(), v.end(), [this] (const auto& el) { *this << el; });
+            }
             return *this;
         }
 
@@ -126,6 +186,13 @@ namespace Limitless {
         ByteBuffer& operator>>(std::vector<T>& v) {
             size_t size{};
             *this >> size;
+            if constexpr (std::is_arithmetic_v<T>) {
+                const auto* bytes = skip(size * sizeof(T));
+                const auto offset = v.size();
+                v.resize(offset + size);
+                std::memcpy(v.data() + offset, bytes, size * sizeof(T));
+                return *this;
+            }
             v.reserve(size);
             for (size_t i = 0; i < size; ++i) {
                 T value{};
@@ -225,14 +292,25 @@ namespace Limitless {
             return *this;
         }
 
-        [[nodiscard]] auto begin() const { return buffer.cbegin(); }
-        [[nodiscard]] auto end() const { return buffer.cend(); }
+        [[nodiscard]] auto begin() const noexcept { return data(); }
+        [[nodiscard]] auto end() const noexcept { return storage() + total(); }
 
         ByteBuffer& operator<<(const ByteBuffer& b) {
-            buffer.insert(buffer.end(), b.begin(), b.end());
+            if (b.size() != 0) {
+                write(*b.data(), b.size());
+            }
             return *this;
         }
 
+        ByteBuffer& operator<<(ByteBuffer&& b) {
+            // takes storage of temporary buffer when nothing to append to
+            if (size() == 0 && !b.isView()) {
+                *this = std::move(b);
+                return *this;
+            }
+            return *this << static_cast<const ByteBuffer&>(b);
+        }
+
         template<typename T, std::enable_if_t<std::is_trivially_copyable_v<std::remove_reference_t<T>>, bool> = true>
         ByteBuffer& operator<<(T&& value) {
             write(std::forward<T>(value));
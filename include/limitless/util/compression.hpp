@@ -0,0 +1,15 @@
+#pragma once
+
+#include <stdexcept>
+#include <cstddef>
+#include <vector>
+
+namespace Limitless {
+    struct compression_error : public std::runtime_error {
+        using runtime_error::runtime_error;
+    };
+
+    // LZ4 block format; fast to decode, used for asset pack entries
+    std::vector<std::byte> compressLZ4(const std::byte* data, size_t size);
+    void decompressLZ4(const std::byte* data, size_t size, std::byte* out, size_t out_size);
+}
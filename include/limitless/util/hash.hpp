@@ -0,0 +1,30 @@
+#pragma once
+
+#include <string_view>
+#include <cstdint>
+#include <cstddef>
+
+namespace Limitless {
+    constexpr uint64_t FNV_OFFSET = 14695981039346656037ull;
+    constexpr uint64_t FNV_PRIME = 1099511628211ull;
+
+    // FNV-1a; stable between runs and platforms, so it can key on-disk caches
+    inline uint64_t hashBytes(const void* data, size_t size, uint64_t seed = FNV_OFFSET) noexcept {
+        auto hash = seed;
+        const auto* bytes = static_cast<const unsigned char*>(data);
+        for (size_t i = 0; i < size; ++i) {
+            hash ^= bytes[i];
+            hash *= FNV_PRIME;
+        }
+        return hash;
+    }
+
+    constexpr uint64_t hashString(std::string_view str, uint64_t seed = FNV_OFFSET) noexcept {
+        auto hash = seed;
+        for (const auto c : str) {
+            hash ^= static_cast<unsigned char>(c);
+            hash *= FNV_PRIME;
+        }
+        return hash;
+    }
+}
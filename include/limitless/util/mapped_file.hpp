@@ -0,0 +1,43 @@
+#pragma once
+
+#include <limitless/util/filesystem.hpp>
+#include <stdexcept>
+#include <cstddef>
+
+namespace Limitless {
+    struct mapped_file_error : public std::runtime_error {
+        using runtime_error::runtime_error;
+    };
+
+    // read-only memory mapping of the whole file
+    class MappedFile final {
+    private:
+        const std::byte* data {};
+        size_t size {};
+
+    #ifdef WIN32
+        void* file {};
+        void* mapping {};
+    #else
+        int descriptor {-1};
+    #endif
+
+        void close() noexcept;
+    public:
+        explicit MappedFile(const fs::path& path);
+        ~MappedFile();
+
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+
+        MappedFile(MappedFile&&) noexcept;
+        MappedFile& operator=(MappedFile&&) noexcept;
+
+        [[nodiscard]] auto getData() const noexcept { return data; }
+        [[nodiscard]] auto getSize() const noexcept { return size; }
+        [[nodiscard]] auto empty() const noexcept { return size == 0; }
+
+        [[nodiscard]] auto begin() const noexcept { return data; }
+        [[nodiscard]] auto end() const noexcept { return data + size; }
+    };
+}
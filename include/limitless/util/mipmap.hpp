@@ -0,0 +1,33 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+namespace Limitless {
+    class ThreadPool;
+
+    enum class MipFilter {
+        // 2x2 average
+        Box,
+        // kaiser windowed sinc over 6x6 pixels, keeps more detail
+        Kaiser
+    };
+
+    struct MipLevel {
+        uint32_t width {};
+        uint32_t height {};
+        std::vector<uint8_t> pixels;
+    };
+
+    /*
+     * halves tightly packed 8-bit image with 1-4 channels
+     *
+     * with srgb, first three channels of 3 and 4 channel images are filtered in linear space
+     * last pixel of odd sized row or column covers three source pixels, so none is dropped
+     * rows are split between pool threads when pool is specified
+     */
+    MipLevel downsample(const uint8_t* pixels, uint32_t width, uint32_t height, uint32_t channels, bool srgb, MipFilter filter, ThreadPool* pool = nullptr);
+
+    // all levels below image down to 1x1
+    std::vector<MipLevel> generateMipChain(const uint8_t* pixels, uint32_t width, uint32_t height, uint32_t channels, bool srgb, MipFilter filter, ThreadPool* pool = nullptr);
+}
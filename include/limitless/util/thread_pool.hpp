@@ -47,5 +47,7 @@ namespace Limitless {
         }
 
         void joinAll();
+
+        [[nodiscard]] size_t getThreadCount() const noexcept { return threads.size(); }
     };
 }
@@ -0,0 +1,45 @@
+Limitless::GLSL_VERSION
+Limitless::Extensions
+
+// depth buffer or previous level of pyramid
+uniform sampler2D source;
+uniform int level;
+uniform int from_depth;
+
+// nearest and farthest depth
+out vec2 color;
+
+vec2 fetch(ivec2 position, ivec2 size) {
+    vec4 value = texelFetch(source, min(position, size - 1), level);
+    return from_depth != 0 ? value.rr : value.rg;
+}
+
+vec2 reduce(vec2 lhs, vec2 rhs) {
+    return vec2(min(lhs.x, rhs.x), max(lhs.y, rhs.y));
+}
+
+void main() {
+    ivec2 size = textureSize(source, level);
+    ivec2 position = ivec2(gl_FragCoord.xy) * 2;
+
+    vec2 result = reduce(reduce(fetch(position, size), fetch(position + ivec2(1, 0), size)),
+                         reduce(fetch(position + ivec2(0, 1), size), fetch(position + ivec2(1, 1), size)));
+
+    // last texel of odd row or column also covers third one, so nothing is skipped
+    bool extra_x = (size.x & 1) != 0 && position.x == size.x - 3;
+    bool extra_y = (size.y & 1) != 0 && position.y == size.y - 3;
+
+    if (extra_x) {
+        result = reduce(result, reduce(fetch(position + ivec2(2, 0), size), fetch(position + ivec2(2, 1), size)));
+    }
+
+    if (extra_y) {
+        result = reduce(result, reduce(fetch(position + ivec2(0, 2), size), fetch(position + ivec2(1, 2), size)));
+    }
+
+    if (extra_x && extra_y) {
+        result = reduce(result, fetch(position + ivec2(2, 2), size));
+    }
+
+    color = result;
+}
\ No newline at end of file
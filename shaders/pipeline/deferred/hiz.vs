@@ -0,0 +1,9 @@
+Limitless::GLSL_VERSION
+Limitless::Extensions
+
+layout (location = 0) in vec3 vertex_position;
+layout (location = 1) in vec2 vertex_uv;
+
+void main() {
+    gl_Position = vec4(vertex_position, 1.0);
+}
\ No newline at end of file
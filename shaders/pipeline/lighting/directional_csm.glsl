@@ -1,10 +1,10 @@
 #if defined (DIRECTIONAL_CSM)
     layout (std140) buffer directional_shadows {
+        vec4 _far_bounds;
         mat4 _dir_light_space[];
     };
 
     uniform sampler2DArray _dir_shadows;
-    uniform vec4 _far_bounds;
 
     int getShadowFrustumIndex(vec3 position) {
         vec4 p = getViewProjection() * vec4(position, 1.0);
@@ -35,7 +35,35 @@ layout (std140) uniform material_buffer {
         vec4 _material_emissive;
     #endif
 
-    #if defined (BINDLESS_TEXTURE)
+    #if defined (MATERIAL_VIRTUAL_TEXTURE)
+        #if defined (MATERIAL_DIFFUSE)
+            vec4 material_diffuse;
+        #endif
+
+        #if defined (MATERIAL_NORMAL)
+            vec4 material_normal;
+        #endif
+
+        #if defined (MATERIAL_EMISSIVEMASK)
+            vec4 material_emissive_mask;
+        #endif
+
+        #if defined (MATERIAL_BLENDMASK)
+            vec4 material_blend_mask;
+        #endif
+
+        #if defined (MATERIAL_METALLIC_TEXTURE)
+            vec4 material_metallic_texture;
+        #endif
+
+        #if defined (MATERIAL_ROUGHNESS_TEXTURE)
+            vec4 material_roughness_texture;
+        #endif
+
+        #if defined (MATERIAL_AMBIENT_OCCLUSION_TEXTURE)
+            vec4 material_ambient_occlusion_texture;
+        #endif
+    #elif defined (BINDLESS_TEXTURE)
         #if defined (MATERIAL_DIFFUSE)
             sampler2D material_diffuse;
         #endif
@@ -101,41 +129,52 @@ layout (std140) uniform material_buffer {
 };
 
 #if !defined (BINDLESS_TEXTURE)
-    #if defined (MATERIAL_DIFFUSE)
-        uniform sampler2D material_diffuse;
-    #endif
-
-    #if defined (MATERIAL_NORMAL)
-        uniform sampler2D material_normal;
-    #endif
-
     #if defined (MATERIAL_DISPLACEMENT)
         uniform sampler2D material_displacement;
     #endif
 
-    #if defined (MATERIAL_EMISSIVEMASK)
-        uniform sampler2D material_emissive_mask;
-    #endif
+    #if !defined (MATERIAL_VIRTUAL_TEXTURE)
+        #if defined (MATERIAL_DIFFUSE)
+            uniform sampler2D material_diffuse;
+        #endif
 
-    #if defined (MATERIAL_BLENDMASK)
-        uniform sampler2D material_blend_mask;
-    #endif
+        #if defined (MATERIAL_NORMAL)
+            uniform sampler2D material_normal;
+        #endif
 
-    #if defined (MATERIAL_METALLIC_TEXTURE)
-        uniform sampler2D material_metallic_texture;
-    #endif
+        #if defined (MATERIAL_EMISSIVEMASK)
+            uniform sampler2D material_emissive_mask;
+        #endif
 
-    #if defined (MATERIAL_ROUGHNESS_TEXTURE)
-        uniform sampler2D material_roughness_texture;
-    #endif
+        #if defined (MATERIAL_BLENDMASK)
+            uniform sampler2D material_blend_mask;
+        #endif
+
+        #if defined (MATERIAL_METALLIC_TEXTURE)
+            uniform sampler2D material_metallic_texture;
+        #endif
+
+        #if defined (MATERIAL_ROUGHNESS_TEXTURE)
+            uniform sampler2D material_roughness_texture;
+        #endif
 
-    #if defined (MATERIAL_AMBIENT_OCCLUSION_TEXTURE)
-        uniform sampler2D material_ambient_occlusion_texture;
+        #if defined (MATERIAL_AMBIENT_OCCLUSION_TEXTURE)
+            uniform sampler2D material_ambient_occlusion_texture;
+        #endif
     #endif
 
     _MATERIAL_SAMPLER_UNIFORMS
 #endif
 
+// property textures are sampled through virtual texture regions stored in place of samplers
+#if defined (MATERIAL_VIRTUAL_TEXTURE)
+    #include "./virtual_texture.glsl"
+
+    #define _materialTexture(property, uv) sampleVirtualTexture(property, uv)
+#else
+    #define _materialTexture(property, uv) texture(property, uv)
+#endif
+
 _MATERIAL_GLOBAL_DEFINITIONS
 
 uint getMaterialShadingModel() {
@@ -180,7 +219,7 @@ float getMaterialRoughness() {
 
 #if defined (MATERIAL_AMBIENT_OCCLUSION_TEXTURE)
     float getMaterialAmbientOcclusion(vec2 uv) {
-        return texture(material_ambient_occlusion_texture, uv).r;
+        return _materialTexture(material_ambient_occlusion_texture, uv).r;
     }
 #endif
 
@@ -200,13 +239,13 @@ float getMaterialRoughness() {
 
 #if defined (MATERIAL_DIFFUSE)
     vec4 getMaterialDiffuse(vec2 uv) {
-        return texture(material_diffuse, uv);
+        return _materialTexture(material_diffuse, uv);
     }
 #endif
 
 #if defined (MATERIAL_NORMAL)
     vec3 getMaterialNormal(vec2 uv) {
-        return texture(material_normal, uv).xyz;
+        return _materialTexture(material_normal, uv).xyz;
     }
 #endif
 
@@ -218,24 +257,24 @@ float getMaterialRoughness() {
 
 #if defined (MATERIAL_EMISSIVEMASK)
     vec3 getMaterialEmissiveMask(vec2 uv) {
-        return texture(material_emissive_mask, uv).rgb;
+        return _materialTexture(material_emissive_mask, uv).rgb;
     }
 #endif
 
 #if defined (MATERIAL_BLENDMASK)
     float getMaterialBlendMask(vec2 uv) {
-        return texture(material_blend_mask, uv).r;
+        return _materialTexture(material_blend_mask, uv).r;
     }
 #endif
 
 #if defined (MATERIAL_METALLIC_TEXTURE)
     float getMaterialMetallic(vec2 uv) {
-        return texture(material_metallic_texture, uv).r;
+        return _materialTexture(material_metallic_texture, uv).r;
     }
 #endif
 
 #if defined (MATERIAL_ROUGHNESS_TEXTURE)
     float getMaterialRoughness(vec2 uv) {
-        return texture(material_roughness_texture, uv).r;
+        return _materialTexture(material_roughness_texture, uv).r;
     }
 #endif
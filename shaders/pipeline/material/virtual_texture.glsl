@@ -0,0 +1,84 @@
+/*
+    sampling of material textures paged into Limitless::VirtualTexture
+
+    vec4 sampleVirtualTexture(vec4 region, vec2 uv);
+
+    region xy is first page of texture, zw its page count; z is negative for sRGB textures
+    fragment shaders mark sampled pages in feedback buffer
+*/
+
+layout (std140) uniform virtual_texture {
+    vec2 _vt_physical_size;
+    float _vt_page_size;
+    float _vt_border;
+    uint _vt_virtual_size;
+    uint _vt_frame;
+};
+
+uniform sampler2D _vt_physical;
+// sRGB pages, decoded to linear by sampler
+uniform sampler2D _vt_physical_srgb;
+uniform sampler2D _vt_indirection;
+
+#if defined (FRAGMENT_SHADER)
+    // one bit per virtual page of every mip, mip 0 first
+    layout (std430) buffer virtual_texture_feedback {
+        uint _vt_requests[];
+    };
+
+    void _requestVirtualPage(vec4 region, vec2 uv, float mip) {
+        // one pixel of every 4x4 block reports per frame
+        ivec2 pixel = ivec2(gl_FragCoord.xy) & 3;
+        if (uint(pixel.y * 4 + pixel.x) != (_vt_frame & 15u)) {
+            return;
+        }
+
+        uint level = uint(mip);
+        uint side = _vt_virtual_size >> level;
+        uvec2 page = uvec2((region.xy + fract(uv) * vec2(abs(region.z), region.w)) / exp2(mip));
+
+        uint bit = (_vt_virtual_size * _vt_virtual_size - side * side) / 3u * 4u + page.y * side + page.x;
+        uint mask = 1u << (bit & 31u);
+        if ((_vt_requests[bit >> 5u] & mask) == 0u) {
+            atomicOr(_vt_requests[bit >> 5u], mask);
+        }
+    }
+#endif
+
+vec4 _sampleVirtualPage(vec4 region, vec2 uv, float mip) {
+    // virtual page coordinate at mip 0
+    vec2 coord = region.xy + fract(uv) * vec2(abs(region.z), region.w);
+
+    int level = int(mip);
+    vec4 entry = round(texelFetch(_vt_indirection, ivec2(coord / exp2(mip)), level) * 255.0);
+    if (entry.w == 0.0) {
+        return vec4(0.0);
+    }
+
+    // resident page can be coarser than requested one
+    vec2 inside = fract(coord / exp2(entry.z));
+    vec2 texel = entry.xy * (_vt_page_size + 2.0 * _vt_border) + _vt_border + inside * _vt_page_size;
+    vec2 physical = texel / _vt_physical_size;
+    return region.z < 0.0 ? textureLod(_vt_physical_srgb, physical, 0.0) : textureLod(_vt_physical, physical, 0.0);
+}
+
+vec4 sampleVirtualTexture(vec4 region, vec2 uv) {
+    #if defined (FRAGMENT_SHADER)
+        vec2 pages = vec2(abs(region.z), region.w);
+        float max_mip = log2(min(pages.x, pages.y));
+
+        vec2 texels = uv * pages * _vt_page_size;
+        vec2 dx = dFdx(texels);
+        vec2 dy = dFdy(texels);
+        float mip = clamp(0.5 * log2(max(dot(dx, dx), dot(dy, dy))), 0.0, max_mip);
+
+        float lower = floor(mip);
+        float upper = min(lower + 1.0, max_mip);
+        _requestVirtualPage(region, uv, lower);
+
+        // trilinear between pages of neighbouring mips
+        return mix(_sampleVirtualPage(region, uv, lower), _sampleVirtualPage(region, uv, upper), mip - lower);
+    #else
+        return _sampleVirtualPage(region, uv, 0.0);
+    #endif
+}
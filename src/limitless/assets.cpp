@@ -12,6 +12,12 @@
 #include <limitless/models/line.hpp>
 #include <limitless/models/cylinder.hpp>
 
+#include <limitless/core/shader_preprocessor.hpp>
+#include <limitless/loaders/asset_manager.hpp>
+#include <limitless/loaders/asset_pack.hpp>
+#include <limitless/util/thread_pool.hpp>
+#include <plog/Log.h>
+#include <algorithm>
 #include <utility>
 
 using namespace Limitless;
@@ -26,6 +32,16 @@ Assets::Assets(fs::path _base_dir, fs::path _shader_dir) noexcept
     , shader_dir {std::move(_shader_dir)} {
 }
 
+Assets::~Assets() = default;
+
+ThreadPool& Assets::getWorkers() const {
+    // one thread is left to the caller, which waits for results
+    std::call_once(workers_created, [this] {
+        workers = std::make_unique<ThreadPool>(std::max(std::thread::hardware_concurrency(), 2u) - 1);
+    });
+    return *workers;
+}
+
 void Assets::load([[maybe_unused]] Context& context) {
     // builds default materials for every model type
     ms::MaterialBuilder builder {*this};
@@ -88,9 +104,8 @@ void Assets::add(const Assets& other) {
 void Assets::compileShaders(Context& ctx, const RenderSettings& settings) {
 	initialize(ctx, settings);
 
-    for (const auto& [_, material] : materials) {
-        compileMaterial(ctx, settings, material);
-    }
+    compileFallbacks(ctx, settings);
+    submitMaterials(ctx, settings);
 
     for (const auto& [_, effect] : effects) {
         compileEffect(ctx, settings, effect);
@@ -99,13 +114,59 @@ void Assets::compileShaders(Context& ctx, const RenderSettings& settings) {
     for (const auto& [_, skybox] : skyboxes) {
         compileSkybox(ctx, settings, skybox);
     }
+
+    updateShaderTimestamps();
 }
 
 void Assets::recompileShaders(Context& ctx, const RenderSettings& settings) {
-    shaders.clear();
+    shaders.removeOutdated(settings);
     compileShaders(ctx, settings);
 }
 
+void Assets::reloadShaders(Context& ctx, const RenderSettings& settings, const fs::path& file) {
+    ShaderPreprocessor::invalidate(file);
+    ShaderPreprocessor::invalidateMissing();
+
+    if (shaders.removeDependent(file) != 0) {
+        compileShaders(ctx, settings);
+    }
+}
+
+void Assets::reloadChangedShaders(Context& ctx, const RenderSettings& settings) {
+    bool changed {};
+    for (auto& [file, timestamp] : shader_timestamps) {
+        std::error_code error;
+        const auto time = fs::last_write_time(file, error);
+
+        if (!error && time != timestamp) {
+            timestamp = time;
+            ShaderPreprocessor::invalidate(file);
+            changed |= shaders.removeDependent(file) != 0;
+        }
+    }
+
+    if (changed) {
+        // changed file may include one that did not exist before
+        ShaderPreprocessor::invalidateMissing();
+
+        // replaced programs keep drawing on failure, so broken edit does not stop the frame loop
+        try {
+            compileShaders(ctx, settings);
+        } catch (const std::exception& e) {
+            PLOG_ERROR << "Shader reload failed: " << e.what();
+        }
+    }
+}
+
+void Assets::updateShaderTimestamps() {
+    for (const auto& file : shaders.getDependencies()) {
+        std::error_code error;
+        if (const auto time = fs::last_write_time(file, error); !error) {
+            shader_timestamps.emplace(file, time);
+        }
+    }
+}
+
 void Assets::compileMaterial(Context& ctx, const RenderSettings& settings, const std::shared_ptr<ms::Material>& material) {
     ms::MaterialCompiler compiler {ctx, *this, settings};
 
@@ -123,6 +184,87 @@ void Assets::compileMaterial(Context& ctx, const RenderSettings& settings, const
     }
 }
 
+void Assets::compileFallbacks(Context& ctx, const RenderSettings& settings) {
+    if (!materials.contains("default")) {
+        return;
+    }
+
+    const auto& material = materials.at("default");
+    compileMaterial(ctx, settings, material);
+
+    for (const auto& model_shader_type : material->getModelShaders()) {
+        if (model_shader_type == ModelShader::Effect) {
+            continue;
+        }
+
+        for (const auto& pass_shader : getRequiredPassShaders(settings)) {
+            shaders.setFallback(pass_shader, model_shader_type, material->getShaderIndex());
+        }
+    }
+}
+
+void Assets::submitMaterials(Context& ctx, const RenderSettings& settings) {
+    struct Variant {
+        const ms::Material& material;
+        ShaderPass pass_shader;
+        ModelShader model_shader;
+        std::future<std::vector<Shader>> sources;
+    };
+
+    ms::MaterialCompiler compiler {ctx, *this, settings};
+    std::vector<Variant> variants;
+
+    // sources are read and preprocessed on workers
+    auto& pool = getWorkers();
+
+    for (const auto& [_, material] : materials) {
+        for (const auto& model_shader_type : material->getModelShaders()) {
+            // effect shaders compiled separately
+            if (model_shader_type == ModelShader::Effect) {
+                continue;
+            }
+
+            for (const auto& pass_shader : getRequiredPassShaders(settings)) {
+                if (!shaders.reserveIfNotContains(pass_shader, model_shader_type, material->getShaderIndex())) {
+                    auto sources = pool.add([&compiler, &material = *material, pass_shader, model_shader_type] {
+                        return compiler.preprocess(material, pass_shader, model_shader_type);
+                    });
+                    variants.push_back({*material, pass_shader, model_shader_type, std::move(sources)});
+                }
+            }
+        }
+    }
+
+    // every variant is issued before any status is queried, shaders.update() picks up finished ones
+    // workers reference compiler, so all of them are waited for before failure is thrown
+    std::exception_ptr error;
+    for (auto& variant : variants) {
+        try {
+            auto sources = variant.sources.get();
+            if (error) {
+                continue;
+            }
+
+            for (auto& shader : sources) {
+                compiler << std::move(shader);
+            }
+
+            shaders.add(variant.pass_shader, variant.model_shader, variant.material.getShaderIndex(), compiler.submit());
+        } catch (const std::exception& e) {
+            // variant that is compiled again after reload keeps its previous program
+            if (shaders.restore(variant.pass_shader, variant.model_shader, variant.material.getShaderIndex())) {
+                PLOG_ERROR << variant.material.getName() << " failed to compile, previous program is kept: " << e.what();
+            } else if (!error) {
+                error = std::make_exception_ptr(ms::material_compilation_error{variant.material.getName() + e.what()});
+            }
+        }
+    }
+
+    if (error) {
+        std::rethrow_exception(error);
+    }
+}
+
 PassShaders Assets::getRequiredPassShaders(const RenderSettings& settings) {
     PassShaders pass_shaders;
 
@@ -176,6 +318,22 @@ void Assets::reloadTextures(const TextureLoaderFlags& settings) {
 	}
 }
 
+void Assets::mount(std::shared_ptr<AssetPack> _pack) {
+    pack = std::move(_pack);
+}
+
+bool Assets::isPacked(const fs::path& path) const {
+    return pack && pack->contains(path.lexically_relative(getAssetsDir()));
+}
+
+std::unique_ptr<ByteSource> Assets::open(const fs::path& path) const {
+    if (isPacked(path)) {
+        return pack->open(path.lexically_relative(getAssetsDir()), path);
+    }
+
+    return std::make_unique<FileByteSource>(path);
+}
+
 void Assets::recompileMaterial(Context& ctx, const RenderSettings& settings, const std::shared_ptr<ms::Material>& material) {
     ms::MaterialCompiler compiler {ctx, *this, settings};
 
@@ -80,6 +80,7 @@ std::unique_ptr<Buffer> BufferBuilder::build() {
 // builds indexed buffer for specified context
 std::shared_ptr<Buffer> BufferBuilder::build(std::string_view name, ContextState& ctx) {
     std::shared_ptr<Buffer> buffer = build();
+    buffer->setName(std::string{name});
     ctx.getIndexedBuffers().add(name, buffer);
     return buffer;
 }
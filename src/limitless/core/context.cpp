@@ -81,6 +81,9 @@ Context::~Context() {
 
 void Context::makeCurrent() const noexcept {
     glfwMakeContextCurrent(window);
+
+    // state lookups of this thread hit cache from now on
+    getState(window);
 }
 
 void Context::swapBuffers() const noexcept {
@@ -18,6 +18,11 @@ void ContextInitializer::initializeGLEW() {
     getExtensions();
     getLimits();
 
+    // lets driver compile shaders on as many threads as it wants
+    if (isExtensionSupported("GL_KHR_parallel_shader_compile")) {
+        glMaxShaderCompilerThreadsKHR(0xFFFFFFFF);
+    }
+
 #ifdef GL_DEBUG
     printExtensions();
 #endif
@@ -84,6 +89,8 @@ void ContextInitializer::getLimits() noexcept {
     glGetIntegerv(GL_MAX_UNIFORM_BUFFER_BINDINGS, &limits.uniform_buffer_max_count);
     glGetIntegerv(GL_MAX_SHADER_STORAGE_BUFFER_BINDINGS, &limits.shader_storage_max_count);
     glGetIntegerv(GL_MAX_COMBINED_TEXTURE_IMAGE_UNITS, &limits.max_texture_units);
+    glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &limits.uniform_buffer_offset_alignment);
+    glGetIntegerv(GL_SHADER_STORAGE_BUFFER_OFFSET_ALIGNMENT, &limits.shader_storage_buffer_offset_alignment);
 
     if (isExtensionSupported("GL_EXT_texture_filter_anisotropic")) {
         glGetFloatv(GL_MAX_TEXTURE_MAX_ANISOTROPY, &limits.anisotropic_max);
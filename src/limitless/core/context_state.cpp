@@ -10,25 +10,32 @@ bool Limitless::operator<(const BindingPoint& a, const BindingPoint& b) noexcept
 }
 
 void ContextState::init() noexcept {
-    for (GLint i = 0; i < ContextInitializer::limits.max_texture_units; ++i) {
-        texture_bound.emplace(i, 0);
-    }
+    texture_bound.assign(ContextInitializer::limits.max_texture_units, 0);
+
+    buffer_point.reserve(Buffer::Type::Uniform, ContextInitializer::limits.uniform_buffer_max_count);
+    buffer_point.reserve(Buffer::Type::ShaderStorage, ContextInitializer::limits.shader_storage_max_count);
+
+    texture_binder.init(texture_bound);
+    frame_ring = std::make_unique<FrameRing>();
 }
 
 void ContextState::registerState(GLFWwindow* window) noexcept {
     std::unique_lock lock{mutex};
 
     state_map.emplace(window, this);
+    ++generation;
 }
 
 void ContextState::unregisterState(GLFWwindow* window) noexcept {
     std::unique_lock lock{mutex};
 
     state_map.erase(window);
+    ++generation;
 }
 
 void ContextState::swapStateMap(Context& lhs, Context& rhs) noexcept {
     std::unique_lock lock{mutex};
+    ++generation;
 
     // we do not register nullptr window at context default construct, so have to check
     // try to understand that is going on here
@@ -49,10 +56,22 @@ void ContextState::swapStateMap(Context& lhs, Context& rhs) noexcept {
     }
 }
 
+void ContextState::onDrawCall() noexcept {
+    if (auto* state = getState(glfwGetCurrentContext()); state) {
+        ++state->frame_stats.draw_calls;
+    }
+}
+
+void ContextState::onFrame() noexcept {
+    last_frame_stats = frame_stats;
+    frame_stats = {};
+}
+
 void ContextState::clearColor(const glm::vec4& color) noexcept {
     if (clear_color != color) {
         clear_color = color;
         glClearColor(color.x, color.y, color.z, color.w);
+        ++frame_stats.state_changes;
     }
 }
 
@@ -61,6 +80,7 @@ void ContextState::setBlendFunc(BlendFactor src, BlendFactor dst) noexcept {
         src_factor = src;
         dst_factor = dst;
         glBlendFunc(static_cast<GLenum>(src_factor), static_cast<GLenum>(dst_factor));
+        ++frame_stats.state_changes;
     }
 }
 
@@ -68,6 +88,7 @@ void ContextState::setBlendColor(const glm::vec4& color) noexcept {
     if (blending_color != color) {
         blending_color = color;
         glBlendColor(color.r, color.g, color.b, color.a);
+        ++frame_stats.state_changes;
     }
 }
 
@@ -78,6 +99,7 @@ void ContextState::clear(Clear bits) noexcept {
 void ContextState::setLineWidth(float width) noexcept {
     if (line_width != width) {
         glLineWidth(width);
+        ++frame_stats.state_changes;
         line_width = width;
     }
 }
@@ -85,6 +107,7 @@ void ContextState::setLineWidth(float width) noexcept {
 void ContextState::enable(Capabilities func) noexcept {
     if (!capability_map[func]) {
         glEnable(static_cast<GLenum>(func));
+        ++frame_stats.state_changes;
         capability_map[func] = true;
     }
 }
@@ -95,6 +118,7 @@ void ContextState::setStencilFunc(StencilFunc func, int32_t ref, int32_t mask) n
         stencil_func_ref = ref;
         stencil_func_mask = mask;
         glStencilFunc(static_cast<GLenum>(stencil_func), stencil_func_ref, stencil_func_mask);
+        ++frame_stats.state_changes;
     }
 }
 
@@ -104,6 +128,7 @@ void ContextState::setStencilOp(StencilOp sfail, StencilOp dpfail, StencilOp dpp
         stencil_op[1] = dpfail;
         stencil_op[2] = dppass;
         glStencilOp(static_cast<GLenum>(sfail), static_cast<GLenum>(dpfail), static_cast<GLenum>(dppass));
+        ++frame_stats.state_changes;
     }
 }
 
@@ -111,12 +136,14 @@ void ContextState::setStencilMask(int32_t mask) noexcept {
     if (stencil_mask != mask) {
         stencil_mask = mask;
         glStencilMask(mask);
+        ++frame_stats.state_changes;
     }
 }
 
 void ContextState::setPixelStore(PixelStore name, GLint param) noexcept {
     if (pixel_pack != name || pixel_param != param) {
         glPixelStorei(static_cast<GLenum>(name), param);
+        ++frame_stats.state_changes;
         pixel_pack = name;
         pixel_param = param;
     }
@@ -125,6 +152,7 @@ void ContextState::setPixelStore(PixelStore name, GLint param) noexcept {
 void ContextState::disable(Capabilities func) noexcept {
     if (capability_map[func]) {
         glDisable(static_cast<GLenum>(func));
+        ++frame_stats.state_changes;
         capability_map[func] = false;
     }
 }
@@ -133,6 +161,7 @@ void ContextState::setViewPort(glm::uvec2 viewport_size) noexcept {
     if (viewport != viewport_size) {
         viewport = viewport_size;
         glViewport(0, 0, viewport.x, viewport.y);
+        ++frame_stats.state_changes;
     }
 }
 
@@ -140,12 +169,14 @@ void ContextState::setViewPort(glm::uvec2 position, glm::uvec2 size) noexcept {
 //    if (viewport != size) {
 //        viewport = size;
         glViewport(position.x, position.y, size.x, size.y);
+        ++frame_stats.state_changes;
 //    }
 }
 
 void ContextState::setDepthFunc(DepthFunc func) noexcept {
     if (depth_func != func) {
         glDepthFunc(static_cast<GLenum>(func));
+        ++frame_stats.state_changes;
         depth_func = func;
     }
 }
@@ -153,6 +184,7 @@ void ContextState::setDepthFunc(DepthFunc func) noexcept {
 void ContextState::setDepthMask(DepthMask mask) noexcept {
     if (depth_mask != mask) {
         glDepthMask(static_cast<GLenum>(mask));
+        ++frame_stats.state_changes;
         depth_mask = mask;
     }
 }
@@ -160,6 +192,7 @@ void ContextState::setDepthMask(DepthMask mask) noexcept {
 void ContextState::setCullFace(CullFace mode) noexcept {
     if (cull_face != mode) {
         glCullFace(static_cast<GLenum>(mode));
+        ++frame_stats.state_changes;
         cull_face = mode;
     }
 }
@@ -167,33 +200,44 @@ void ContextState::setCullFace(CullFace mode) noexcept {
 void ContextState::setFrontFace(FrontFace mode) noexcept {
     if (front_face != mode) {
         glFrontFace(static_cast<GLenum>(mode));
+        ++frame_stats.state_changes;
         front_face = mode;
     }
 }
 
 ContextState* ContextState::getState(GLFWwindow* window) noexcept {
-    try {
-        return state_map.at(window);
-    } catch (...) {
-        return nullptr;
+    // the same window is asked for over and over from one thread
+    if (window == current_window && current_generation == generation.load(std::memory_order_acquire)) {
+        return current_state;
     }
+
+    std::unique_lock lock{mutex};
+
+    const auto found = state_map.find(window);
+    current_window = window;
+    current_state = found != state_map.end() ? found->second : nullptr;
+    current_generation = generation.load(std::memory_order_relaxed);
+
+    return current_state;
 }
 
 void ContextState::setPolygonMode(CullFace face, PolygonMode mode) noexcept {
     if (face != polygon_face || polygon_mode != mode) {
         glPolygonMode(static_cast<GLenum>(face), static_cast<GLenum>(mode));
+        ++frame_stats.state_changes;
         polygon_face = face;
         polygon_mode = mode;
     }
 }
 
 bool ContextState::hasState(GLFWwindow* window) noexcept {
-    return window ? state_map.find(window) != state_map.end() : false;
+    return window ? getState(window) != nullptr : false;
 }
 
 void ContextState::setScissorTest(glm::uvec2 origin, glm::uvec2 size) noexcept {
     if (scissor_origin != origin || scissor_size != size) {
         glScissor(origin.x, origin.y, size.x, size.y);
+        ++frame_stats.state_changes;
         scissor_origin = origin;
         scissor_size = size;
     }
@@ -0,0 +1,66 @@
+#include <limitless/core/frame_clock.hpp>
+
+#include <algorithm>
+
+using namespace Limitless;
+
+const FrameTime& FrameClock::tick() noexcept {
+    const auto now = Clock::now();
+    const auto measured = last_tick ? std::chrono::duration_cast<Duration>(now - *last_tick) : Duration {};
+    last_tick = now;
+
+    return advance(frame_delta.value_or(measured));
+}
+
+const FrameTime& FrameClock::advance(Duration delta) noexcept {
+    if (started) {
+        ++current.frame;
+    }
+    started = true;
+
+    delta = paused ? Duration {} : std::clamp(delta, Duration {}, max_delta) * scale;
+
+    if (step) {
+        accumulator += delta;
+        current.steps = static_cast<uint32_t>(accumulator / *step);
+        current.delta = *step * static_cast<float>(current.steps);
+        accumulator -= current.delta;
+        current.alpha = accumulator / *step;
+    } else {
+        current.steps = 0;
+        current.delta = delta;
+        current.alpha = 0.0f;
+    }
+
+    current.time += current.delta;
+
+    return current;
+}
+
+void FrameClock::reset() noexcept {
+    current = {};
+    last_tick = std::nullopt;
+    accumulator = {};
+    started = false;
+}
+
+void FrameClock::setStep(std::optional<Duration> _step) noexcept {
+    step = _step && _step->count() > 0.0f ? _step : std::nullopt;
+    accumulator = {};
+}
+
+void FrameClock::setFrameDelta(std::optional<Duration> delta) noexcept {
+    frame_delta = delta;
+}
+
+void FrameClock::setMaxDelta(Duration delta) noexcept {
+    max_delta = delta;
+}
+
+void FrameClock::setScale(float _scale) noexcept {
+    scale = _scale;
+}
+
+void FrameClock::setPaused(bool _paused) noexcept {
+    paused = _paused;
+}
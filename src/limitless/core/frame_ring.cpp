@@ -0,0 +1,178 @@
+#include <limitless/core/frame_ring.hpp>
+
+#include <limitless/core/buffer_builder.hpp>
+#include <limitless/core/context_initializer.hpp>
+#include <limitless/core/context_state.hpp>
+#include <algorithm>
+
+using namespace Limitless;
+
+namespace {
+    // segments start at offset valid for any binding
+    constexpr size_t RING_ALIGNMENT = 256;
+}
+
+FrameRing::FrameRing(size_t _segment_size)
+    : segment_size {_segment_size} {
+}
+
+FrameRing::~FrameRing() {
+    // fences died with context when it was destroyed first
+    if (!ContextState::getState(glfwGetCurrentContext())) {
+        return;
+    }
+
+    for (auto& fence : fences) {
+        if (fence) {
+            glDeleteSync(fence);
+        }
+    }
+
+    for (auto& old : retired) {
+        glDeleteSync(old.fence);
+    }
+}
+
+void FrameRing::create(size_t size) {
+    const auto alignment = std::max<size_t>({
+        RING_ALIGNMENT,
+        static_cast<size_t>(ContextInitializer::limits.uniform_buffer_offset_alignment),
+        static_cast<size_t>(ContextInitializer::limits.shader_storage_buffer_offset_alignment)
+    });
+
+    segment_size = (size + alignment - 1) / alignment * alignment;
+    segment = 0;
+    offset = 0;
+
+    persistent = ContextInitializer::isExtensionSupported("GL_ARB_buffer_storage");
+
+    if (persistent) {
+        buffer = BufferBuilder()
+                .setTarget(Buffer::Type::Uniform)
+                .setUsage(Buffer::Storage::DynamicCoherentWrite)
+                .setAccess(Buffer::ImmutableAccess::WriteCoherent)
+                .setDataSize(segment_size * FRAME_COUNT)
+                .build();
+
+        memory = static_cast<std::byte*>(buffer->mapBufferRange(0, static_cast<GLsizeiptr>(buffer->getSize())));
+    } else {
+        buffer = BufferBuilder()
+                .setTarget(Buffer::Type::Uniform)
+                .setUsage(Buffer::Usage::StreamDraw)
+                .setAccess(Buffer::MutableAccess::Write)
+                .setDataSize(segment_size * FRAME_COUNT)
+                .build();
+
+        staging.resize(segment_size * FRAME_COUNT);
+        memory = staging.data();
+    }
+
+    buffer->setName("frame_ring");
+}
+
+void FrameRing::grow(size_t required) {
+    // allocations of this frame and frames in flight still point to old buffer
+    retired.push_back({std::move(buffer), std::move(staging), glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0)});
+    staging = {};
+
+    // new buffer has nothing to wait for
+    for (auto& fence : fences) {
+        if (fence) {
+            glDeleteSync(fence);
+            fence = {};
+        }
+    }
+
+    create(std::max(segment_size * 2, required));
+    ++frame_stats.growths;
+}
+
+void FrameRing::wait(GLsync fence) {
+    if (glClientWaitSync(fence, 0, 0) == GL_TIMEOUT_EXPIRED) {
+        ++frame_stats.stalls;
+
+        const auto start = std::chrono::steady_clock::now();
+        while (glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000) == GL_TIMEOUT_EXPIRED);
+        frame_stats.stall_time += std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+    }
+    glDeleteSync(fence);
+}
+
+FrameRing::Allocation FrameRing::allocate(Buffer::Type target, size_t size) {
+    switch (target) {
+        case Buffer::Type::Uniform:
+            return allocate(size, ContextInitializer::limits.uniform_buffer_offset_alignment);
+        case Buffer::Type::ShaderStorage:
+            return allocate(size, ContextInitializer::limits.shader_storage_buffer_offset_alignment);
+        default:
+            return allocate(size, 16);
+    }
+}
+
+FrameRing::Allocation FrameRing::allocate(size_t size, size_t alignment) {
+    if (!buffer) {
+        create(segment_size);
+    }
+
+    alignment = std::max<size_t>(alignment, 1);
+
+    auto aligned = (offset + alignment - 1) / alignment * alignment;
+    if (aligned + size > segment_size) {
+        grow(size);
+        aligned = 0;
+    }
+
+    const auto position = segment * segment_size + aligned;
+    offset = aligned + size;
+
+    ++frame_stats.allocations;
+    frame_stats.uploaded += size;
+
+    return {memory + position, static_cast<GLintptr>(position), size, buffer->getId(), frame};
+}
+
+void FrameRing::bind(const Allocation& allocation, Buffer::Type target, GLuint index) {
+    if (!persistent) {
+        glBindBuffer(GL_COPY_WRITE_BUFFER, allocation.buffer);
+        glBufferSubData(GL_COPY_WRITE_BUFFER, allocation.offset, static_cast<GLsizeiptr>(allocation.size), allocation.data);
+    }
+
+    // ranges of the same buffer differ, so binding is never skipped
+    glBindBufferRange(static_cast<GLenum>(target), index, allocation.buffer, allocation.offset, static_cast<GLsizeiptr>(allocation.size));
+
+    if (auto* state = ContextState::getState(glfwGetCurrentContext()); state) {
+        state->buffer_point[{target, index}] = allocation.buffer;
+        state->buffer_target[target] = allocation.buffer;
+    }
+}
+
+void FrameRing::onFrame() {
+    last_frame_stats = frame_stats;
+    frame_stats = {};
+    ++frame;
+
+    if (!buffer) {
+        return;
+    }
+
+    if (offset != 0) {
+        fences[segment] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    }
+
+    segment = (segment + 1) % FRAME_COUNT;
+    offset = 0;
+
+    if (auto& fence = fences[segment]; fence) {
+        wait(fence);
+        fence = {};
+    }
+
+    // old buffers are released once GPU is done with them
+    retired.erase(std::remove_if(retired.begin(), retired.end(), [] (auto& old) {
+        if (glClientWaitSync(old.fence, 0, 0) == GL_TIMEOUT_EXPIRED) {
+            return false;
+        }
+        glDeleteSync(old.fence);
+        return true;
+    }), retired.end());
+}
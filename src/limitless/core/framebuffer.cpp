@@ -12,6 +12,7 @@ void Framebuffer::bind() noexcept {
     if (auto* state = ContextState::getState(glfwGetCurrentContext()); state) {
         if (state->framebuffer_id != id) {
             glBindFramebuffer(GL_FRAMEBUFFER, id);
+            ++state->frame_stats.binds;
             state->framebuffer_id = id;
         }
     }
@@ -160,6 +161,8 @@ Framebuffer& Framebuffer::operator<<(const TextureAttachment& attachment) noexce
             break;
     }
 
+    attachment.texture->setMemoryCategory(GpuMemory::Category::RenderTarget);
+
     attachments[attachment.attachment] = attachment;
     return *this;
 }
@@ -176,6 +179,7 @@ void Framebuffer::unbind() noexcept {
     if (auto* state = ContextState::getState(glfwGetCurrentContext()); state) {
         if (state->framebuffer_id != 0) {
             glBindFramebuffer(GL_FRAMEBUFFER, 0);
+            ++state->frame_stats.binds;
             state->framebuffer_id = 0;
         }
     }
@@ -334,7 +338,9 @@ Framebuffer& Framebuffer::operator=(Framebuffer&& rhs) noexcept {
 
 void Framebuffer::blit(Framebuffer& source, Texture::Filter filter, FramebufferBlit blit) {
     //TODO: constraints
-    auto size = attachments.at(FramebufferAttachment::Color0).texture->getSize();
+    // attachment can be a level of mip chain
+    const auto& target = attachments.at(FramebufferAttachment::Color0);
+    const auto size = glm::max(glm::uvec2{target.texture->getSize()} >> target.level, glm::uvec2{1});
 
     drawBuffer(FramebufferAttachment::Color0);
     source.readBuffer(FramebufferAttachment::Color0);
@@ -346,6 +352,9 @@ void Framebuffer::blit(Framebuffer& source, Texture::Filter filter, FramebufferB
                       0, 0, size.x, size.y,
                       static_cast<GLenum>(blit), static_cast<GLenum>(filter));
 
+    // context state expects source to be bound after readBuffer
+    glBindFramebuffer(GL_FRAMEBUFFER, source.id);
+
     source.drawBuffer(FramebufferAttachment::Color0);
     glReadBuffer(GL_NONE);
 }
@@ -354,6 +363,7 @@ void DefaultFramebuffer::unbind() noexcept {
     if (auto* state = ContextState::getState(glfwGetCurrentContext()); state) {
         if (state->framebuffer_id != 0) {
             glBindFramebuffer(GL_FRAMEBUFFER, 0);
+            ++state->frame_stats.binds;
             state->framebuffer_id = 0;
         }
     }
@@ -363,6 +373,7 @@ void DefaultFramebuffer::bind() noexcept {
     if (auto* state = ContextState::getState(glfwGetCurrentContext()); state) {
         if (state->framebuffer_id != 0) {
             glBindFramebuffer(GL_FRAMEBUFFER, 0);
+            ++state->frame_stats.binds;
             state->framebuffer_id = 0;
         }
     }
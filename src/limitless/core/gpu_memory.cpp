@@ -0,0 +1,300 @@
+#include <limitless/core/gpu_memory.hpp>
+
+#include <unordered_map>
+#include <algorithm>
+#include <iostream>
+#include <array>
+#include <mutex>
+
+using namespace Limitless;
+
+namespace {
+    struct State {
+        std::mutex mutex;
+        std::unordered_map<uint64_t, GpuMemory::Allocation> allocations;
+        uint64_t next_id {1};
+
+        std::array<GpuMemory::Usage, GpuMemory::CATEGORY_COUNT> usage {};
+        size_t total {};
+        size_t peak {};
+
+        GpuMemory::Churn frame_churn;
+        GpuMemory::Churn last_frame_churn;
+
+        // 0 disables budget
+        size_t budget {};
+        std::vector<std::pair<GpuMemory::ListenerId, GpuMemory::BudgetListener>> listeners;
+        GpuMemory::ListenerId next_listener {1};
+        bool warned {};
+
+        void add(GpuMemory::Category category, size_t bytes) noexcept {
+            auto& entry = usage[static_cast<size_t>(category)];
+            entry.bytes += bytes;
+            entry.peak = std::max(entry.peak, entry.bytes);
+
+            total += bytes;
+            peak = std::max(peak, total);
+        }
+
+        void subtract(GpuMemory::Category category, size_t bytes) noexcept {
+            auto& entry = usage[static_cast<size_t>(category)];
+            entry.bytes -= std::min(entry.bytes, bytes);
+            total -= std::min(total, bytes);
+        }
+    };
+
+    // never destroyed, buffers and textures held by static objects are released after exit
+    State& getState() {
+        static auto* state = new State;
+        return *state;
+    }
+}
+
+uint64_t GpuMemory::allocate(Category category, size_t bytes) {
+    auto& state = getState();
+    std::unique_lock lock(state.mutex);
+
+    const auto id = state.next_id++;
+    state.allocations.emplace(id, Allocation{category, {}, bytes});
+
+    state.add(category, bytes);
+    ++state.usage[static_cast<size_t>(category)].count;
+
+    ++state.frame_churn.allocations;
+    state.frame_churn.allocated_bytes += bytes;
+
+    return id;
+}
+
+void GpuMemory::update(uint64_t id, Category category, size_t bytes) {
+    auto& state = getState();
+    std::unique_lock lock(state.mutex);
+
+    const auto found = state.allocations.find(id);
+    if (found == state.allocations.end()) {
+        return;
+    }
+
+    auto& allocation = found->second;
+    state.subtract(allocation.category, allocation.bytes);
+    --state.usage[static_cast<size_t>(allocation.category)].count;
+
+    state.add(category, bytes);
+    ++state.usage[static_cast<size_t>(category)].count;
+
+    // retagging alone is not a reallocation
+    if (allocation.bytes != bytes) {
+        ++state.frame_churn.frees;
+        state.frame_churn.freed_bytes += allocation.bytes;
+        ++state.frame_churn.allocations;
+        state.frame_churn.allocated_bytes += bytes;
+    }
+
+    allocation.category = category;
+    allocation.bytes = bytes;
+}
+
+void GpuMemory::setName(uint64_t id, std::string name) {
+    auto& state = getState();
+    std::unique_lock lock(state.mutex);
+
+    if (const auto found = state.allocations.find(id); found != state.allocations.end()) {
+        found->second.name = std::move(name);
+    }
+}
+
+std::string GpuMemory::getName(uint64_t id) {
+    auto& state = getState();
+    std::unique_lock lock(state.mutex);
+
+    const auto found = state.allocations.find(id);
+    return found != state.allocations.end() ? found->second.name : std::string{};
+}
+
+void GpuMemory::release(uint64_t id) noexcept {
+    auto& state = getState();
+    std::unique_lock lock(state.mutex);
+
+    const auto found = state.allocations.find(id);
+    if (found == state.allocations.end()) {
+        return;
+    }
+
+    const auto& allocation = found->second;
+    state.subtract(allocation.category, allocation.bytes);
+    --state.usage[static_cast<size_t>(allocation.category)].count;
+
+    ++state.frame_churn.frees;
+    state.frame_churn.freed_bytes += allocation.bytes;
+
+    state.allocations.erase(found);
+}
+
+void GpuMemory::orphan(size_t bytes) noexcept {
+    auto& state = getState();
+    std::unique_lock lock(state.mutex);
+
+    ++state.frame_churn.orphanings;
+    state.frame_churn.orphaned_bytes += bytes;
+}
+
+GpuMemory::Usage GpuMemory::getUsage(Category category) noexcept {
+    auto& state = getState();
+    std::unique_lock lock(state.mutex);
+    return state.usage[static_cast<size_t>(category)];
+}
+
+size_t GpuMemory::getTotal() noexcept {
+    auto& state = getState();
+    std::unique_lock lock(state.mutex);
+    return state.total;
+}
+
+size_t GpuMemory::getPeak() noexcept {
+    auto& state = getState();
+    std::unique_lock lock(state.mutex);
+    return state.peak;
+}
+
+GpuMemory::Churn GpuMemory::getFrameChurn() noexcept {
+    auto& state = getState();
+    std::unique_lock lock(state.mutex);
+    return state.frame_churn;
+}
+
+GpuMemory::Churn GpuMemory::getLastFrameChurn() noexcept {
+    auto& state = getState();
+    std::unique_lock lock(state.mutex);
+    return state.last_frame_churn;
+}
+
+std::vector<GpuMemory::Allocation> GpuMemory::getAllocations() {
+    auto& state = getState();
+    std::vector<Allocation> result;
+    {
+        std::unique_lock lock(state.mutex);
+        result.reserve(state.allocations.size());
+        for (const auto& [id, allocation] : state.allocations) {
+            result.push_back(allocation);
+        }
+    }
+
+    std::sort(result.begin(), result.end(), [] (const auto& lhs, const auto& rhs) {
+        return lhs.bytes > rhs.bytes;
+    });
+    return result;
+}
+
+void GpuMemory::setBudget(size_t bytes) noexcept {
+    auto& state = getState();
+    std::unique_lock lock(state.mutex);
+    state.budget = bytes;
+    state.warned = false;
+}
+
+size_t GpuMemory::getBudget() noexcept {
+    auto& state = getState();
+    std::unique_lock lock(state.mutex);
+    return state.budget;
+}
+
+GpuMemory::ListenerId GpuMemory::addBudgetListener(BudgetListener listener) {
+    auto& state = getState();
+    std::unique_lock lock(state.mutex);
+    const auto id = state.next_listener++;
+    state.listeners.emplace_back(id, std::move(listener));
+    return id;
+}
+
+void GpuMemory::removeBudgetListener(ListenerId id) noexcept {
+    auto& state = getState();
+    std::unique_lock lock(state.mutex);
+    state.listeners.erase(std::remove_if(state.listeners.begin(), state.listeners.end(), [&] (const auto& listener) { return listener.first == id; }), state.listeners.end());
+}
+
+void GpuMemory::onFrame() {
+    auto& state = getState();
+    size_t excess {};
+    size_t limit {};
+    std::vector<std::pair<ListenerId, BudgetListener>> to_notify;
+    {
+        std::unique_lock lock(state.mutex);
+
+        state.last_frame_churn = state.frame_churn;
+        state.frame_churn = {};
+
+        if (state.budget == 0 || state.total <= state.budget) {
+            state.warned = false;
+            return;
+        }
+
+        excess = state.total - state.budget;
+        limit = state.budget;
+
+        // warns once each time budget is crossed
+        if (!state.warned) {
+            state.warned = true;
+            std::cerr << "GPU memory budget exceeded: " << state.total << " of " << state.budget << " bytes" << std::endl;
+        }
+
+        to_notify = state.listeners;
+    }
+
+    // listeners free memory, which takes the lock again
+    for (const auto& [_, listener] : to_notify) {
+        listener(excess, limit);
+    }
+}
+
+const char* GpuMemory::getCategoryName(Category category) noexcept {
+    switch (category) {
+        case Category::VertexBuffer: return "vertex buffer";
+        case Category::IndexBuffer: return "index buffer";
+        case Category::UniformBuffer: return "uniform buffer";
+        case Category::StorageBuffer: return "storage buffer";
+        case Category::Buffer: return "buffer";
+        case Category::Texture: return "texture";
+        case Category::RenderTarget: return "render target";
+    }
+    return "";
+}
+
+GpuAllocation::~GpuAllocation() {
+    reset();
+}
+
+GpuAllocation::GpuAllocation(GpuAllocation&& rhs) noexcept {
+    swap(*this, rhs);
+}
+
+GpuAllocation& GpuAllocation::operator=(GpuAllocation&& rhs) noexcept {
+    swap(*this, rhs);
+    return *this;
+}
+
+void GpuAllocation::set(GpuMemory::Category category, size_t bytes) {
+    if (id == 0) {
+        id = GpuMemory::allocate(category, bytes);
+    } else {
+        GpuMemory::update(id, category, bytes);
+    }
+}
+
+void GpuAllocation::setName(std::string name) {
+    GpuMemory::setName(id, std::move(name));
+}
+
+std::string GpuAllocation::getName() const {
+    return GpuMemory::getName(id);
+}
+
+void GpuAllocation::reset() noexcept {
+    if (id != 0) {
+        GpuMemory::release(id);
+        id = 0;
+    }
+}
+
+void Limitless::swap(GpuAllocation& lhs, GpuAllocation& rhs) noexcept {
+    std::swap(lhs.id, rhs.id);
+}
@@ -11,6 +11,14 @@ std::shared_ptr<Buffer> IndexedBuffer::get(std::string_view name) {
     }
 }
 
+Buffer* IndexedBuffer::find(std::string_view name) const noexcept {
+    const auto [first, last] = buffers.equal_range(std::string{name});
+    if (first == last || std::next(first) != last) {
+        return nullptr;
+    }
+    return first->second.get();
+}
+
 void IndexedBuffer::add(std::string_view name, std::shared_ptr<Buffer> buffer) noexcept {
     buffers.emplace(name, std::move(buffer));
 }
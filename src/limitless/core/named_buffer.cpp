@@ -21,6 +21,7 @@ NamedBuffer::NamedBuffer(Type _target, size_t _size, const void* data, Usage usa
     glCreateBuffers(1, &id);
 
     NamedBuffer::bufferData(data);
+    track();
 }
 
 NamedBuffer::NamedBuffer(Type _target, size_t _size, const void* data, Storage usage, ImmutableAccess _access) {
@@ -32,6 +33,7 @@ NamedBuffer::NamedBuffer(Type _target, size_t _size, const void* data, Storage u
     glCreateBuffers(1, &id);
 
     NamedBuffer::bufferStorage(data);
+    track();
 }
 
 void NamedBuffer::bufferStorage(const void* data) {
@@ -80,10 +82,13 @@ void NamedBuffer::resize(size_t new_size) noexcept {
     size = new_size;
 
     if (std::holds_alternative<Storage>(usage_flags)) {
+        auto name = memory.getName();
         NamedBuffer new_buffer{target, size, nullptr, std::get<Storage>(usage_flags), std::get<ImmutableAccess>(access)};
         swap(*this, new_buffer);
+        memory.setName(std::move(name));
     } else {
         NamedBuffer::bufferData(nullptr);
+        track();
     }
 }
 
@@ -13,11 +13,7 @@ NamedTexture::~NamedTexture() {
     if (id != 0) {
         if (auto* state = ContextState::getState(glfwGetCurrentContext()); state) {
             auto& target_map = state->texture_bound;
-
-            std::for_each(target_map.begin(), target_map.end(), [&] (auto& state) {
-                auto& [s_unit, s_id] = state;
-                if (s_id == id) s_id = 0;
-            });
+            std::replace(target_map.begin(), target_map.end(), id, 0u);
 
             glDeleteTextures(1, &id);
         }
@@ -1,15 +1,376 @@
 #include <limitless/core/profiler.hpp>
 
+#include <limitless/text/text_instance.hpp>
+#include <limitless/core/context_state.hpp>
 #include <limitless/assets.hpp>
 
+#include <algorithm>
+#include <iomanip>
+#include <map>
+
 using namespace Limitless;
 
+namespace {
+    void writeJsonString(std::ostream& stream, std::string_view string) {
+        stream << '"';
+        for (const auto c : string) {
+            switch (c) {
+                case '"': stream << "\\\""; break;
+                case '\\': stream << "\\\\"; break;
+                case '\n': stream << "\\n"; break;
+                case '\t': stream << "\\t"; break;
+                default:
+                    if (static_cast<unsigned char>(c) < 0x20) {
+                        stream << "\\u" << std::hex << std::setw(4) << std::setfill('0') << static_cast<int>(c) << std::dec;
+                    } else {
+                        stream << c;
+                    }
+            }
+        }
+        stream << '"';
+    }
+
+    double toMicroseconds(std::chrono::nanoseconds time) noexcept {
+        return std::chrono::duration<double, std::micro>(time).count();
+    }
+
+    double toMilliseconds(std::chrono::nanoseconds time) noexcept {
+        return std::chrono::duration<double, std::milli>(time).count();
+    }
+}
+
+Profiler::Profiler(bool _gpu) noexcept
+    : gpu {_gpu} {
+}
+
+Profiler::~Profiler() {
+    if (ContextState::getState(glfwGetCurrentContext())) {
+        release();
+    }
+}
+
+void Profiler::release() {
+    clear();
+
+    std::unique_lock lock {mutex};
+    for (auto& slot : slots) {
+        if (!slot.queries.empty()) {
+            glDeleteQueries(static_cast<GLsizei>(slot.queries.size()), slot.queries.data());
+            slot.queries.clear();
+        }
+    }
+}
+
+std::vector<Profiler::Open>& Profiler::getOpenScopes() {
+    thread_local std::vector<Open> open;
+    return open;
+}
+
+uint32_t Profiler::getThread(std::thread::id id) {
+    return threads.emplace(id, static_cast<uint32_t>(threads.size())).first->second;
+}
+
+uint32_t Profiler::allocateQueries(Slot& slot) {
+    if (slot.used_queries + 2 > slot.queries.size()) {
+        const auto old_size = slot.queries.size();
+        slot.queries.resize(std::max<size_t>(old_size * 2, 64));
+        glGenQueries(static_cast<GLsizei>(slot.queries.size() - old_size), slot.queries.data() + old_size);
+    }
+
+    const auto query = slot.used_queries;
+    slot.used_queries += 2;
+    return query;
+}
+
+void Profiler::push(Scope scope, uint32_t query) {
+    auto& slot = slots[current];
+    scope.thread = getThread(std::this_thread::get_id());
+    slot.frame.scopes.emplace_back(std::move(scope));
+    slot.scope_queries.emplace_back(query);
+}
+
+void Profiler::begin(std::string_view name) {
+    auto& open = getOpenScopes();
+
+    // disabled scope is kept to be matched by end
+    if (!enabled) {
+        open.push_back({nullptr, {}, {}, {}, NO_QUERY});
+        return;
+    }
+
+    Open scope {this, std::string {name}, {}, Clock::now(), NO_QUERY};
+
+    const auto parent = std::find_if(open.rbegin(), open.rend(), [&] (const auto& o) { return o.profiler == this; });
+    scope.path = parent == open.rend() ? scope.name : parent->path + '/' + scope.name;
+
+    if (gpu && gl_thread == std::this_thread::get_id()) {
+        std::unique_lock lock {mutex};
+        auto& slot = slots[current];
+        scope.query = allocateQueries(slot);
+        glQueryCounter(slot.queries[scope.query], GL_TIMESTAMP);
+    }
+
+    open.emplace_back(std::move(scope));
+}
+
+void Profiler::end() {
+    auto& open = getOpenScopes();
+    if (open.empty()) {
+        return;
+    }
+
+    auto scope = std::move(open.back());
+    open.pop_back();
+
+    if (scope.profiler != this) {
+        return;
+    }
+
+    const auto now = Clock::now();
+    const auto depth = std::count_if(open.begin(), open.end(), [&] (const auto& o) { return o.profiler == this; });
+
+    std::unique_lock lock {mutex};
+    if (scope.query != NO_QUERY) {
+        glQueryCounter(slots[current].queries[scope.query + 1], GL_TIMESTAMP);
+    }
+
+    Scope result;
+    result.name = std::move(scope.name);
+    result.path = std::move(scope.path);
+    result.depth = static_cast<uint32_t>(depth);
+    result.cpu_begin = scope.begin - origin;
+    result.cpu_end = now - origin;
+    push(std::move(result), scope.query);
+}
+
+void Profiler::add(std::string_view name, Clock::time_point begin, Clock::time_point end) {
+    if (!enabled) {
+        return;
+    }
+
+    const auto& open = getOpenScopes();
+    const auto parent = std::find_if(open.rbegin(), open.rend(), [&] (const auto& o) { return o.profiler == this; });
+
+    Scope scope;
+    scope.name = std::string {name};
+    scope.path = parent == open.rend() ? scope.name : parent->path + '/' + scope.name;
+    scope.depth = static_cast<uint32_t>(std::count_if(open.begin(), open.end(), [&] (const auto& o) { return o.profiler == this; }));
+    scope.cpu_begin = begin - origin;
+    scope.cpu_end = end - origin;
+
+    std::unique_lock lock {mutex};
+    push(std::move(scope), NO_QUERY);
+}
+
+bool Profiler::resolve(Slot& slot) {
+    if (slot.used_queries != 0) {
+        // timestamps are written in order, so last one being ready means all of them are
+        GLint available {};
+        glGetQueryObjectiv(slot.queries[slot.used_queries - 1], GL_QUERY_RESULT_AVAILABLE, &available);
+        if (available != GL_TRUE) {
+            return false;
+        }
+
+        std::vector<GLuint64> timestamps(slot.used_queries);
+        for (uint32_t i = 0; i < slot.used_queries; ++i) {
+            glGetQueryObjectui64v(slot.queries[i], GL_QUERY_RESULT, &timestamps[i]);
+        }
+
+        const auto first = *std::min_element(timestamps.begin(), timestamps.end());
+        for (size_t i = 0; i < slot.frame.scopes.size(); ++i) {
+            const auto query = slot.scope_queries[i];
+            if (query == NO_QUERY) {
+                continue;
+            }
+
+            auto& scope = slot.frame.scopes[i];
+            scope.gpu_begin = slot.frame.begin + std::chrono::nanoseconds {timestamps[query] - first};
+            scope.gpu_end = slot.frame.begin + std::chrono::nanoseconds {timestamps[query + 1] - first};
+        }
+    }
+
+    finish(slot);
+    return true;
+}
+
+void Profiler::finish(Slot& slot) {
+    history.emplace_back(std::move(slot.frame));
+    while (history.size() > HISTORY_SIZE) {
+        history.pop_front();
+    }
+
+    slot.frame = {};
+    slot.scope_queries.clear();
+    slot.used_queries = 0;
+    slot.pending = false;
+}
+
+void Profiler::onFrame() {
+    std::unique_lock lock {mutex};
+    gl_thread = std::this_thread::get_id();
+
+    const auto now = Clock::now() - origin;
+    const auto index = slots[current].frame.index;
+    slots[current].frame.end = now;
+    slots[current].pending = true;
+
+    // collects finished frames in order they were issued
+    for (uint32_t i = 1; i <= FRAME_LATENCY; ++i) {
+        auto& slot = slots[(current + i) % FRAME_LATENCY];
+        if (!slot.pending) {
+            continue;
+        }
+        if (!resolve(slot)) {
+            break;
+        }
+    }
+
+    current = (current + 1) % FRAME_LATENCY;
+
+    // slot is reused, so its frame is kept without GPU timings
+    auto& slot = slots[current];
+    if (slot.pending) {
+        finish(slot);
+    }
+
+    slot.frame.index = index + 1;
+    slot.frame.begin = now;
+}
+
+void Profiler::clear() {
+    std::unique_lock lock {mutex};
+    history.clear();
+    for (auto& slot : slots) {
+        slot.frame.scopes.clear();
+        slot.scope_queries.clear();
+        slot.used_queries = 0;
+        slot.pending = false;
+    }
+}
+
+void Profiler::setEnabled(bool _enabled) noexcept {
+    enabled = _enabled;
+}
+
+std::deque<Profiler::Frame> Profiler::getFrames() const {
+    std::unique_lock lock {mutex};
+    return history;
+}
+
+void Profiler::exportChromeTrace(std::ostream& stream) const {
+    std::unique_lock lock {mutex};
+
+    stream << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+    stream << R"({"name":"process_name","ph":"M","pid":0,"args":{"name":"CPU"}},)" << '\n';
+    stream << R"({"name":"process_name","ph":"M","pid":1,"args":{"name":"GPU"}})";
+
+    const auto event = [&] (std::string_view name, const char* category, uint32_t pid, uint32_t tid, std::chrono::nanoseconds begin, std::chrono::nanoseconds end) {
+        stream << ",\n{\"name\":";
+        writeJsonString(stream, name);
+        stream << ",\"cat\":\"" << category << "\",\"ph\":\"X\",\"pid\":" << pid << ",\"tid\":" << tid
+               << ",\"ts\":" << toMicroseconds(begin) << ",\"dur\":" << toMicroseconds(end - begin) << '}';
+    };
+
+    stream << std::fixed << std::setprecision(3);
+    for (const auto& frame : history) {
+        event("Frame " + std::to_string(frame.index), "frame", 0, 0, frame.begin, frame.end);
+
+        for (const auto& scope : frame.scopes) {
+            event(scope.name, "cpu", 0, scope.thread, scope.cpu_begin, scope.cpu_end);
+
+            if (scope.gpu_begin && scope.gpu_end) {
+                event(scope.name, "gpu", 1, 0, *scope.gpu_begin, *scope.gpu_end);
+            }
+        }
+    }
+    stream.unsetf(std::ios_base::floatfield);
+
+    stream << "\n]}\n";
+}
+
+void Profiler::exportCsv(std::ostream& stream) const {
+    struct Summary {
+        uint32_t count {};
+        std::chrono::nanoseconds cpu_total {};
+        std::chrono::nanoseconds cpu_max {};
+        uint32_t gpu_count {};
+        std::chrono::nanoseconds gpu_total {};
+        std::chrono::nanoseconds gpu_max {};
+    };
+
+    std::unique_lock lock {mutex};
+
+    // keeps order in which scopes first appeared
+    std::vector<std::string> paths;
+    std::map<std::string, Summary> summaries;
+    for (const auto& frame : history) {
+        for (const auto& scope : frame.scopes) {
+            auto [it, inserted] = summaries.try_emplace(scope.path);
+            if (inserted) {
+                paths.emplace_back(scope.path);
+            }
+
+            auto& summary = it->second;
+            const auto cpu = scope.cpu_end - scope.cpu_begin;
+            ++summary.count;
+            summary.cpu_total += cpu;
+            summary.cpu_max = std::max(summary.cpu_max, cpu);
+
+            if (scope.gpu_begin && scope.gpu_end) {
+                const auto gpu_time = *scope.gpu_end - *scope.gpu_begin;
+                ++summary.gpu_count;
+                summary.gpu_total += gpu_time;
+                summary.gpu_max = std::max(summary.gpu_max, gpu_time);
+            }
+        }
+    }
+
+    stream << "scope,count,cpu_avg_ms,cpu_max_ms,gpu_avg_ms,gpu_max_ms\n";
+    stream << std::fixed << std::setprecision(4);
+    for (const auto& path : paths) {
+        const auto& summary = summaries.at(path);
+
+        std::string quoted;
+        for (const auto c : path) {
+            quoted += c == '"' ? std::string {"\"\""} : std::string {c};
+        }
+
+        stream << '"' << quoted << "\"," << summary.count << ','
+               << toMilliseconds(summary.cpu_total) / summary.count << ','
+               << toMilliseconds(summary.cpu_max) << ',';
+
+        if (summary.gpu_count != 0) {
+            stream << toMilliseconds(summary.gpu_total) / summary.gpu_count << ','
+                   << toMilliseconds(summary.gpu_max);
+        } else {
+            stream << ',';
+        }
+        stream << '\n';
+    }
+    stream.unsetf(std::ios_base::floatfield);
+}
+
 void Profiler::draw(Context& ctx, const Assets& assets) {
+    std::unique_lock lock {mutex};
+    if (history.empty()) {
+        return;
+    }
+
+    auto scopes = history.back().scopes;
+    lock.unlock();
+
+    std::sort(scopes.begin(), scopes.end(), [] (const auto& a, const auto& b) { return a.cpu_begin < b.cpu_begin; });
+
     TextInstance text {"text", glm::vec2{0.0f}, assets.fonts.at("nunito")};
     text.setSize(glm::vec2{0.5f});
     glm::vec2 position = {400, 400};
-    for (const auto& [name, query] : queries) {
-        text.setText(name + " " + std::to_string(query.getDuration()));
+    for (const auto& scope : scopes) {
+        auto line = std::string(scope.depth * 2, ' ') + scope.name + " " + std::to_string(toMilliseconds(scope.cpu_end - scope.cpu_begin));
+        if (scope.gpu_begin && scope.gpu_end) {
+            line += " / " + std::to_string(toMilliseconds(*scope.gpu_end - *scope.gpu_begin));
+        }
+
+        text.setText(line);
         text.setPosition(position);
         text.draw(ctx, assets);
 
@@ -17,16 +378,15 @@ void Profiler::draw(Context& ctx, const Assets& assets) {
     }
 }
 
-TimeQuery& Profiler::operator[] (const std::string& name) {
-    return queries[name];
+ProfilerScope::ProfilerScope(std::string_view name)
+    : ProfilerScope(Limitless::profiler, name) {
 }
 
-ProfilerScope::ProfilerScope(const std::string& name)
-    : query {profiler[name]} {
-    query.start();
+ProfilerScope::ProfilerScope(Profiler& _profiler, std::string_view name)
+    : profiler {_profiler} {
+    profiler.begin(name);
 }
 
 ProfilerScope::~ProfilerScope() {
-    query.stop();
-    query.calculate();
+    profiler.end();
 }
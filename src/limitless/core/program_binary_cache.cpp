@@ -0,0 +1,175 @@
+#include <limitless/core/program_binary_cache.hpp>
+
+#include <limitless/core/context_initializer.hpp>
+#include <limitless/util/hash.hpp>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <vector>
+#include <thread>
+
+using namespace Limitless;
+
+namespace {
+    constexpr uint32_t BINARY_CACHE_MAGIC = 0x4342504Cu; // LPBC
+    constexpr uint32_t BINARY_CACHE_VERSION = 1;
+
+    struct EntryHeader {
+        uint32_t magic;
+        uint32_t version;
+        uint64_t key;
+        uint64_t driver;
+        uint32_t format;
+        uint32_t length;
+    };
+
+    std::string getGLString(GLenum name) {
+        const auto* str = reinterpret_cast<const char*>(glGetString(name));
+        return str ? str : "";
+    }
+}
+
+ProgramBinaryCache::ProgramBinaryCache(fs::path _directory)
+    : directory {std::move(_directory)} {
+    if (ContextInitializer::isExtensionSupported("GL_ARB_get_program_binary")) {
+        GLint formats {};
+        glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formats);
+        supported = formats > 0;
+    }
+
+    // binaries are valid only for the exact driver that produced them
+    driver = hashString(getGLString(GL_VENDOR));
+    driver = hashString(getGLString(GL_RENDERER), driver);
+    driver = hashString(getGLString(GL_VERSION), driver);
+
+    if (supported) {
+        std::error_code error;
+        fs::create_directories(directory, error);
+        supported = !error;
+    }
+}
+
+fs::path ProgramBinaryCache::getEntryPath(uint64_t key) const {
+    std::stringstream name;
+    name << std::hex << std::setw(16) << std::setfill('0') << key << ".bin";
+    return directory / name.str();
+}
+
+GLuint ProgramBinaryCache::load(uint64_t key) {
+    if (!supported) {
+        return 0;
+    }
+
+    const auto path = getEntryPath(key);
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        return 0;
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+
+    const auto reject = [&] {
+        file.close();
+        std::error_code error;
+        fs::remove(path, error);
+        ++rejected;
+        return 0u;
+    };
+
+    EntryHeader header {};
+    if (!file.read(reinterpret_cast<char*>(&header), sizeof(header))) {
+        return reject();
+    }
+
+    if (header.magic != BINARY_CACHE_MAGIC || header.version != BINARY_CACHE_VERSION ||
+        header.key != key || header.driver != driver || header.length == 0) {
+        return reject();
+    }
+
+    std::vector<char> binary(header.length);
+    if (!file.read(binary.data(), header.length)) {
+        return reject();
+    }
+
+    const GLuint program_id = glCreateProgram();
+    glProgramBinary(program_id, header.format, binary.data(), static_cast<GLsizei>(header.length));
+
+    // driver can refuse binaries after update even if it reports the same version
+    GLint link_status {};
+    glGetProgramiv(program_id, GL_LINK_STATUS, &link_status);
+    if (!link_status) {
+        glDeleteProgram(program_id);
+        return reject();
+    }
+
+    warm_time += (std::chrono::steady_clock::now() - start).count();
+    ++hits;
+
+    return program_id;
+}
+
+void ProgramBinaryCache::prepare(GLuint program) const noexcept {
+    if (supported) {
+        glProgramParameteri(program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+    }
+}
+
+void ProgramBinaryCache::save(uint64_t key, GLuint program) {
+    if (!supported) {
+        return;
+    }
+
+    GLint length {};
+    glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length);
+    if (length <= 0) {
+        return;
+    }
+
+    std::vector<char> binary(length);
+    GLenum format {};
+    glGetProgramBinary(program, length, &length, &format, binary.data());
+
+    EntryHeader header {BINARY_CACHE_MAGIC, BINARY_CACHE_VERSION, key, driver, format, static_cast<uint32_t>(length)};
+
+    // written aside and renamed so that interrupted writes never leave broken entries;
+    // temporary name is unique per thread, so workers saving the same program do not write into one file
+    const auto path = getEntryPath(key);
+    auto temporary = path;
+    temporary += "." + std::to_string(std::hash<std::thread::id>{}(std::this_thread::get_id())) + ".tmp";
+
+    std::error_code error;
+    {
+        std::ofstream file(temporary, std::ios::binary | std::ios::trunc);
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        file.write(binary.data(), length);
+        file.close();
+        if (!file) {
+            fs::remove(temporary, error);
+            return;
+        }
+    }
+
+    fs::rename(temporary, path, error);
+    if (error) {
+        fs::remove(temporary, error);
+    }
+}
+
+ProgramBinaryCache::Stats ProgramBinaryCache::getStats() const noexcept {
+    Stats stats;
+    stats.hits = hits;
+    stats.misses = misses;
+    stats.rejected = rejected;
+    stats.warm_time = std::chrono::nanoseconds {warm_time};
+    stats.cold_time = std::chrono::nanoseconds {cold_time};
+    return stats;
+}
+
+void ProgramBinaryCache::clear() {
+    std::error_code error;
+    for (const auto& entry : fs::directory_iterator(directory, error)) {
+        if (entry.path().extension() == ".bin") {
+            fs::remove(entry.path(), error);
+        }
+    }
+}
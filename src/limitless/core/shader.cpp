@@ -1,7 +1,6 @@
 #include <limitless/core/shader.hpp>
 #include <limitless/core/context_initializer.hpp>
 #include <string>
-#include <sstream>
 
 using namespace Limitless;
 
@@ -20,6 +19,9 @@ namespace {
     inline constexpr auto shading_language_420pack = "GL_ARB_shading_language_420pack";
     inline constexpr auto extension_shading_language_420pack = "#extension GL_ARB_shading_language_420pack : require\n";
 
+    // lets shared includes use derivatives and fragment-only storage
+    inline constexpr auto fragment_shader_define = "#define FRAGMENT_SHADER\n";
+
     inline constexpr auto explicit_uniform_location = "GL_ARB_explicit_uniform_location";
     inline constexpr auto extension_explicit_uniform_location = "#extension GL_ARB_explicit_uniform_location : require\n";
 }
@@ -27,21 +29,21 @@ namespace {
 Shader::Shader(fs::path _path, Type _type, const ShaderAction& action)
     : path{std::move(_path)}
     , type{_type} {
-    source = getSource(path);
+    static const auto version = "#version " + std::to_string(ContextInitializer::major_version) + std::to_string(ContextInitializer::minor_version) + "0 core";
+
+    // throws shader_file_not_found before anything else is done
+    ShaderPreprocessor::load(path);
 
-    replaceVersion();
-    replaceExtensions();
-    replaceIncludes(path.parent_path());
+    keys.emplace(version_key, version);
+    keys.emplace(extensions_key, getExtensions() + (type == Type::Fragment ? fragment_shader_define : ""));
 
     if (action) {
         action(*this);
     }
 
-    // includes can appear in other includes that were added by ShaderActions
-    // so replace one more time
-    replaceIncludes(path.parent_path());
-
-    id = glCreateShader(static_cast<GLenum>(type));
+    source = ShaderPreprocessor::expand(path, keys, dependencies);
+    keys.clear();
+    expanded = true;
 }
 
 Shader::~Shader() {
@@ -78,13 +80,12 @@ void Shader::checkStatus() const {
 //    }
 }
 
-void Shader::replaceVersion() noexcept {
-    static const auto version = "#version " + std::to_string(ContextInitializer::major_version) + std::to_string(ContextInitializer::minor_version) + "0 core";
-
-    replaceKey(version_key, version);
-}
+void Shader::replaceKey(const std::string& key, const std::string& value) {
+    if (!expanded) {
+        keys.emplace(key, value);
+        return;
+    }
 
-void Shader::replaceKey(const std::string& key, const std::string& value) noexcept {
     size_t found = 0;
     for (;;) {
         found = source.find(key, found);
@@ -97,7 +98,15 @@ void Shader::replaceKey(const std::string& key, const std::string& value) noexce
     }
 }
 
-void Shader::replaceExtensions() noexcept {
+bool Shader::refersTo(std::string_view word) const {
+    if (expanded) {
+        return source.find(word) != std::string::npos;
+    }
+
+    return ShaderPreprocessor::refersTo(path, keys, word);
+}
+
+std::string Shader::getExtensions() {
     std::string extensions;
 
     if (ContextInitializer::isExtensionSupported(shader_storage_buffer_object)) {
@@ -118,91 +127,18 @@ void Shader::replaceExtensions() noexcept {
         extensions.append(bindless_samplers);
     }
 
-    replaceKey(extensions_key, extensions);
-}
-
-std::string Shader::getSource(const fs::path& filepath) {
-    try {
-        std::ifstream file(filepath);
-        std::string file_source;
-
-        file.exceptions(std::ifstream::failbit | std::ifstream::badbit);
-
-        if (file.good()) {
-            std::stringstream stream;
-            stream << file.rdbuf();
-
-            file_source = stream.str();
-        }
-
-        return file_source;
-    } catch (...) {
-        throw shader_file_not_found(filepath.string());
-    }
-}
-
-void Shader::resolveIncludes(const fs::path& base_dir, std::string& src) {
-    static constexpr std::string_view include = "#include";
-
-    std::size_t found {};
-    for (;;) {
-        found = src.find(include, found);
-
-        if (found == std::string::npos) {
-            return;
-        }
-
-        size_t beg = found + include.length() + 2;
-        size_t end = src.find('"', beg);
-        size_t name_length = end - beg;
-
-        fs::path file_name = src.substr(beg, name_length);
-
-        auto include_src = getSource(base_dir / file_name);
-
-        resolveIncludes(base_dir / file_name.parent_path(), include_src);
-
-        src.replace(found, include.length() + 3 + name_length, include_src);
-    }
+    return extensions;
 }
 
-void Shader::replaceIncludes(const fs::path& base_dir) {
-    try {
-        resolveIncludes(base_dir, source);
-    } catch (const shader_file_not_found& not_found) {
-        throw shader_include_not_found("Failed to resolve include for " + path.string() + ": " + not_found.what());
+void Shader::compile() {
+    if (id == 0) {
+        id = glCreateShader(static_cast<GLenum>(type));
     }
 
-//    size_t found = 0;
-//    for (;;) {
-//        found = source.find(include, found);
-//
-//        if (found == std::string::npos) {
-//            break;
-//        }
-//
-//        size_t beg = found + include.length() + 2;
-//        size_t end = source.find('"', beg);
-//        size_t name_length = end - beg;
-//
-//        std::string file_name = source.substr(beg, name_length);
-//
-//        try {
-//            const auto& include_src = getSource(base_dir / file_name);
-//            source.replace(found, include.length() + 3 + name_length, include_src);
-//        } catch (const shader_file_not_found& not_found) {
-//            throw shader_include_not_found("Failed to resolve include for " + path.string() + ": " + not_found.what());
-//        }
-//    }
-}
-
-void Shader::compile() const {
     const auto* src = source.data();
 
     glShaderSource(id, 1, &src, nullptr);
     glCompileShader(id);
-
-    checkStatus();
 }
 
 void Limitless::swap(Shader &lhs, Shader &rhs) noexcept {
@@ -212,6 +148,9 @@ void Limitless::swap(Shader &lhs, Shader &rhs) noexcept {
     swap(lhs.path, rhs.path);
     swap(lhs.type, rhs.type);
     swap(lhs.id, rhs.id);
+    swap(lhs.dependencies, rhs.dependencies);
+    swap(lhs.keys, rhs.keys);
+    swap(lhs.expanded, rhs.expanded);
 }
 
 Shader::Shader(Shader&& rhs) noexcept : Shader() {
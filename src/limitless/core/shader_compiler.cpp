@@ -3,6 +3,10 @@
 #include <fstream>
 #include <limitless/core/context.hpp>
 #include <limitless/core/shader_program.hpp>
+#include <limitless/core/program_binary_cache.hpp>
+#include <limitless/core/context_initializer.hpp>
+#include <limitless/util/hash.hpp>
+#include <utility>
 #include <limitless/pipeline/render_settings.hpp>
 
 using namespace Limitless;
@@ -39,8 +43,6 @@ void ShaderCompiler::checkStatus(const GLuint program_id) {
         log.resize(log_size);
         glGetProgramInfoLog(program_id, log_size, &log_size, log.data());
 
-        glDeleteProgram(program_id);
-
         {
             std::ofstream file("shader_linking_error");
             file << log << std::endl;
@@ -56,79 +58,223 @@ ShaderCompiler& ShaderCompiler::operator<<(Shader&& shader) noexcept {
     return *this;
 }
 
-std::shared_ptr<ShaderProgram> ShaderCompiler::compile() {
+PendingProgram::~PendingProgram() {
+    if (id != 0) {
+        glDeleteProgram(id);
+    }
+}
+
+PendingProgram::PendingProgram(PendingProgram&& rhs) noexcept
+    : shaders {std::move(rhs.shaders)}
+    , dependencies {std::move(rhs.dependencies)}
+    , settings_macros {std::move(rhs.settings_macros)}
+    , settings_defines {std::move(rhs.settings_defines)}
+    , id {std::exchange(rhs.id, 0)}
+    , key {rhs.key}
+    , start {rhs.start} {
+}
+
+PendingProgram& PendingProgram::operator=(PendingProgram&& rhs) noexcept {
+    std::swap(shaders, rhs.shaders);
+    std::swap(dependencies, rhs.dependencies);
+    std::swap(settings_macros, rhs.settings_macros);
+    std::swap(settings_defines, rhs.settings_defines);
+    std::swap(id, rhs.id);
+    std::swap(key, rhs.key);
+    std::swap(start, rhs.start);
+    return *this;
+}
+
+bool PendingProgram::isReady() const noexcept {
+    static const bool parallel = ContextInitializer::isExtensionSupported("GL_KHR_parallel_shader_compile");
+
+    // programs from binary cache are linked already
+    if (!parallel || shaders.empty()) {
+        return true;
+    }
+
+    GLint completed {};
+    glGetProgramiv(id, GL_COMPLETION_STATUS_KHR, &completed);
+    return completed != 0;
+}
+
+PendingProgram ShaderCompiler::submit() {
     if (shaders.empty()) {
         throw shader_linking_error("No shaders to link. ShaderCompiler is empty.");
     }
 
-    const GLuint program_id = glCreateProgram();
+    PendingProgram pending;
+    pending.shaders = std::move(shaders);
+    shaders.clear();
 
-    for (const auto& shader : shaders) {
-        shader.compile();
-        glAttachShader(program_id, shader.getId());
+    for (const auto& shader : pending.shaders) {
+        pending.dependencies.emplace(shader.getPath().lexically_normal());
+        pending.dependencies.insert(shader.getDependencies().begin(), shader.getDependencies().end());
+
+        // programs compiled without settings do not depend on them
+        if (render_settings) {
+            pending.settings_macros.merge(getSettingsMacros(shader.getSource()));
+        }
     }
 
-    glLinkProgram(program_id);
+    if (render_settings) {
+        pending.settings_defines = getSettingsDefines(*render_settings, pending.settings_macros);
+    }
 
-    checkStatus(program_id);
+    // settings defines and shader actions are already in sources, so they are part of the key
+    if (binary_cache) {
+        pending.key = FNV_OFFSET;
+        for (const auto& shader : pending.shaders) {
+            const auto type = static_cast<uint32_t>(shader.getType());
+            pending.key = hashBytes(&type, sizeof(type), pending.key);
+            pending.key = hashString(shader.getSource(), pending.key);
+        }
 
-    shaders.clear();
+        if (const auto cached = binary_cache->load(pending.key); cached != 0) {
+            pending.shaders.clear();
+            pending.id = cached;
+            return pending;
+        }
+    }
+
+    pending.start = std::chrono::steady_clock::now();
+    pending.id = glCreateProgram();
+
+    if (binary_cache) {
+        binary_cache->prepare(pending.id);
+    }
 
-    return std::shared_ptr<ShaderProgram>(new ShaderProgram(context, program_id));
+    // nothing is queried here, so that the driver does not have to finish before the next program is issued
+    for (auto& shader : pending.shaders) {
+        shader.compile();
+        glAttachShader(pending.id, shader.getId());
+    }
+
+    glLinkProgram(pending.id);
+
+    return pending;
 }
 
-void ShaderCompiler::replaceRenderSettings(Shader& shader) const {
-    if (render_settings) {
-        std::string settings;
+std::shared_ptr<ShaderProgram> ShaderCompiler::finish(PendingProgram& pending) {
+    if (!pending.shaders.empty()) {
+        for (const auto& shader : pending.shaders) {
+            shader.checkStatus();
+        }
 
-        //TODO: remove
-        if (render_settings->normal_mapping) {
-            settings.append("#define NORMAL_MAPPING\n");
+        // pending program still owns id and deletes it on failure
+        checkStatus(pending.id);
+
+        if (binary_cache) {
+            binary_cache->addColdTime(std::chrono::steady_clock::now() - pending.start);
+            binary_cache->save(pending.key, pending.id);
         }
 
-        if (render_settings->directional_cascade_shadow_mapping) {
-            settings.append("#define DIRECTIONAL_CSM\n");
+        pending.shaders.clear();
+    }
+
+    auto program = std::shared_ptr<ShaderProgram>(new ShaderProgram(context, std::exchange(pending.id, 0)));
+    program->dependencies = std::move(pending.dependencies);
+    program->settings_macros = std::move(pending.settings_macros);
+    program->settings_defines = std::move(pending.settings_defines);
+    return program;
+}
 
-            settings.append("#define DIRECTIONAL_SPLIT_COUNT " + std::to_string(render_settings->directional_split_count) + '\n');
+std::shared_ptr<ShaderProgram> ShaderCompiler::compile() {
+    auto pending = submit();
+    return finish(pending);
+}
 
-            if (render_settings->directional_pcf) {
-                settings.append("#define DIRECTIONAL_PFC\n");
-            }
+std::set<std::string> ShaderCompiler::getSettingsMacros(std::string_view source) {
+    std::set<std::string> macros;
+    for (const auto& macro : SETTINGS_MACROS) {
+        if (source.find(macro) != std::string_view::npos) {
+            macros.emplace(macro);
         }
+    }
+    return macros;
+}
 
-        if (render_settings->screen_space_ambient_occlusion) {
-	        settings.append("#define SCREEN_SPACE_AMBIENT_OCCLUSION\n");
+std::string ShaderCompiler::getSettingsDefines(const RenderSettings& settings, const std::set<std::string>& macros) {
+    std::string defines;
+    const auto define = [&] (const std::string& macro, const std::string& value = {}) {
+        if (macros.count(macro) != 0) {
+            defines.append("#define " + macro + (value.empty() ? "" : " " + value) + '\n');
         }
+    };
+
+    //TODO: remove
+    if (settings.normal_mapping) {
+        define("NORMAL_MAPPING");
+    }
 
-        if (render_settings->micro_shadowing) {
-            settings.append("#define MICRO_SHADOWING\n");
+    if (settings.directional_cascade_shadow_mapping) {
+        define("DIRECTIONAL_CSM");
+        define("DIRECTIONAL_SPLIT_COUNT", std::to_string(settings.directional_split_count));
+
+        if (settings.directional_pcf) {
+            define("DIRECTIONAL_PFC");
         }
+    }
 
-        shader.replaceKey("Limitless::Settings", settings);
-    } else {
-        shader.replaceKey("Limitless::Settings", "");
+    if (settings.screen_space_ambient_occlusion) {
+        define("SCREEN_SPACE_AMBIENT_OCCLUSION");
+    }
+
+    if (settings.micro_shadowing) {
+        define("MICRO_SHADOWING");
     }
+
+    return defines;
 }
 
-std::shared_ptr<ShaderProgram> ShaderCompiler::compile(const fs::path& path, const ShaderAction& action) {
-    uint8_t shader_count {};
-    for (const auto& [extension, type] : shader_file_extensions) {
-        try {
-            Shader shader { path.string() + extension.data(), type, action };
+void ShaderCompiler::replaceRenderSettings(Shader& shader) const {
+    static const std::string key = "Limitless::Settings";
+
+    // only defines that source refers to are added, so other settings do not change it
+    if (render_settings) {
+        std::set<std::string> macros;
+        for (const auto& macro : SETTINGS_MACROS) {
+            if (shader.refersTo(macro)) {
+                macros.emplace(macro);
+            }
+        }
+
+        shader.replaceKey(key, getSettingsDefines(*render_settings, macros));
+    } else {
+        shader.replaceKey(key, "");
+    }
+}
 
-            replaceRenderSettings(shader);
+std::vector<Shader> ShaderCompiler::preprocess(const fs::path& path, const ShaderAction& action) const {
+    // settings are substituted in the same pass as the rest of keys
+    const auto props = [&] (Shader& shader) {
+        if (action) {
+            action(shader);
+        }
 
-            *this << std::move(shader);
+        replaceRenderSettings(shader);
+    };
 
-            ++shader_count;
+    std::vector<Shader> sources;
+    for (const auto& [extension, type] : shader_file_extensions) {
+        try {
+            sources.emplace_back(path.string() + extension.data(), type, props);
         } catch (const shader_file_not_found& e) {
             continue;
         }
     }
 
-    if (shader_count == 0) {
+    if (sources.empty()) {
         throw shader_compilation_error("Shaders not found : " + path.string());
     }
 
+    return sources;
+}
+
+std::shared_ptr<ShaderProgram> ShaderCompiler::compile(const fs::path& path, const ShaderAction& action) {
+    for (auto& shader : preprocess(path, action)) {
+        *this << std::move(shader);
+    }
+
     return compile();
 }
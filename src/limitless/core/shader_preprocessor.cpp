@@ -0,0 +1,234 @@
+#include <limitless/core/shader_preprocessor.hpp>
+
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+
+using namespace Limitless;
+
+namespace {
+    constexpr std::string_view INCLUDE = "#include";
+    constexpr std::string_view ENGINE_KEY = "Limitless::";
+    constexpr std::string_view MATERIAL_KEY = "_MATERIAL_";
+
+    bool isIdentifier(char c) noexcept {
+        return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '_';
+    }
+
+    bool startsWith(std::string_view text, size_t pos, std::string_view prefix) noexcept {
+        return text.compare(pos, prefix.size(), prefix) == 0;
+    }
+
+    std::string readFile(const fs::path& path) {
+        std::ifstream file(path, std::ios::binary);
+        if (!file) {
+            throw shader_file_not_found(path.string());
+        }
+
+        std::stringstream stream;
+        stream << file.rdbuf();
+        return stream.str();
+    }
+}
+
+ShaderPreprocessor::File ShaderPreprocessor::tokenize(fs::path path, std::string text) {
+    File file {std::move(path), std::move(text), {}, {}};
+    const std::string_view view = file.text;
+
+    size_t text_begin {};
+    const auto flush = [&] (size_t end) {
+        if (end > text_begin) {
+            file.tokens.push_back({Token::Type::Text, text_begin, end});
+        }
+    };
+
+    for (size_t i = 0; i < view.size();) {
+        const auto c = view[i];
+
+        if (c == '#' && startsWith(view, i, INCLUDE)) {
+            auto name_begin = i + INCLUDE.size();
+            while (name_begin < view.size() && (view[name_begin] == ' ' || view[name_begin] == '\t')) {
+                ++name_begin;
+            }
+
+            const auto name_end = name_begin < view.size() && view[name_begin] == '"' ? view.find_first_of("\"\n", name_begin + 1) : std::string_view::npos;
+            if (name_end != std::string_view::npos && view[name_end] == '"') {
+                flush(i);
+
+                const auto name = view.substr(name_begin + 1, name_end - name_begin - 1);
+                file.includes.emplace_back((file.path.parent_path() / fs::path(name)).lexically_normal());
+                file.tokens.push_back({Token::Type::Include, i, name_end + 1, file.includes.size() - 1});
+
+                i = text_begin = name_end + 1;
+                continue;
+            }
+        }
+
+        const bool key_start = (c == 'L' && startsWith(view, i, ENGINE_KEY)) || (c == '_' && startsWith(view, i, MATERIAL_KEY));
+        if (key_start && (i == 0 || !isIdentifier(view[i - 1]))) {
+            auto end = i + (c == 'L' ? ENGINE_KEY.size() : MATERIAL_KEY.size());
+            while (end < view.size() && isIdentifier(view[end])) {
+                ++end;
+            }
+
+            flush(i);
+            file.tokens.push_back({Token::Type::Key, i, end});
+
+            i = text_begin = end;
+            continue;
+        }
+
+        ++i;
+    }
+
+    flush(view.size());
+
+    return file;
+}
+
+std::shared_ptr<const ShaderPreprocessor::File> ShaderPreprocessor::load(const fs::path& path) {
+    const auto key = path.lexically_normal().string();
+
+    {
+        std::shared_lock lock {mutex};
+        if (const auto it = files.find(key); it != files.end()) {
+            // missing files are remembered too, compilers probe every stage extension
+            if (!it->second) {
+                throw shader_file_not_found(path.string());
+            }
+            return it->second;
+        }
+    }
+
+    // read outside of lock; if another thread was faster its file is kept
+    std::shared_ptr<const File> file;
+    try {
+        file = std::make_shared<const File>(tokenize(path.lexically_normal(), readFile(path)));
+    } catch (const shader_file_not_found&) {
+        std::unique_lock lock {mutex};
+        files.emplace(key, nullptr);
+        throw;
+    }
+
+    std::unique_lock lock {mutex};
+    return files.emplace(key, std::move(file)).first->second;
+}
+
+void ShaderPreprocessor::expand(const File& file, const Keys& keys, std::string& out, std::set<fs::path>& dependencies,
+                                std::vector<const File*>& include_stack, std::vector<const std::string*>& key_stack) {
+    include_stack.push_back(&file);
+
+    for (const auto& token : file.tokens) {
+        const auto text = std::string_view {file.text}.substr(token.begin, token.end - token.begin);
+
+        switch (token.type) {
+            case Token::Type::Text:
+                out.append(text);
+                break;
+            case Token::Type::Include: {
+                const auto& include_path = file.includes[token.include];
+
+                std::shared_ptr<const File> include;
+                try {
+                    include = load(include_path);
+                } catch (const shader_file_not_found& not_found) {
+                    throw shader_include_not_found("Failed to resolve include for " + include_stack.front()->path.string() + ": " + not_found.what());
+                }
+
+                const auto recursive = std::any_of(include_stack.begin(), include_stack.end(), [&] (const auto* parent) { return parent->path == include->path; });
+                if (recursive) {
+                    throw shader_include_not_found("Recursive include of " + include_path.string() + " in " + file.path.string());
+                }
+
+                dependencies.emplace(include_path);
+                expand(*include, keys, out, dependencies, include_stack, key_stack);
+                break;
+            }
+            case Token::Type::Key: {
+                const auto value = keys.find(std::string {text});
+                const auto active = value != keys.end() && std::find(key_stack.begin(), key_stack.end(), &value->first) != key_stack.end();
+
+                if (value == keys.end() || active) {
+                    out.append(text);
+                    break;
+                }
+
+                // values can contain includes and other keys; includes are relative to the shader
+                key_stack.push_back(&value->first);
+                const auto snippet = tokenize(include_stack.front()->path, value->second);
+                expand(snippet, keys, out, dependencies, include_stack, key_stack);
+                key_stack.pop_back();
+                break;
+            }
+        }
+    }
+
+    include_stack.pop_back();
+}
+
+std::string ShaderPreprocessor::expand(const fs::path& path, const Keys& keys, std::set<fs::path>& dependencies) {
+    const auto file = load(path);
+
+    std::string out;
+    out.reserve(file->text.size() * 4);
+
+    std::vector<const File*> include_stack;
+    std::vector<const std::string*> key_stack;
+    expand(*file, keys, out, dependencies, include_stack, key_stack);
+
+    return out;
+}
+
+bool ShaderPreprocessor::refersTo(const fs::path& path, const Keys& keys, std::string_view word) {
+    for (const auto& [_, value] : keys) {
+        if (value.find(word) != std::string::npos) {
+            return true;
+        }
+    }
+
+    // every file of include graph is checked once
+    std::vector<std::shared_ptr<const File>> queue {load(path)};
+    std::set<fs::path> visited {queue.front()->path};
+
+    while (!queue.empty()) {
+        const auto file = std::move(queue.back());
+        queue.pop_back();
+
+        if (file->text.find(word) != std::string::npos) {
+            return true;
+        }
+
+        for (const auto& include : file->includes) {
+            if (visited.emplace(include).second) {
+                try {
+                    queue.push_back(load(include));
+                } catch (const shader_file_not_found&) {
+                    // reported when source is expanded
+                }
+            }
+        }
+    }
+
+    return false;
+}
+
+void ShaderPreprocessor::invalidate(const fs::path& path) {
+    std::unique_lock lock {mutex};
+    files.erase(path.lexically_normal().string());
+}
+
+void ShaderPreprocessor::invalidateMissing() {
+    std::unique_lock lock {mutex};
+    for (auto it = files.begin(); it != files.end();) {
+        if (!it->second) {
+            it = files.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+void ShaderPreprocessor::clear() {
+    std::unique_lock lock {mutex};
+    files.clear();
+}
@@ -5,6 +5,8 @@
 #include <limitless/core/bindless_texture.hpp>
 #include <limitless/core/texture_binder.hpp>
 #include <limitless/core/context.hpp>
+#include <limitless/loaders/virtual_texture.hpp>
+#include <cassert>
 
 using namespace Limitless;
 
@@ -27,9 +29,11 @@ void ShaderProgram::use() {
         if (state->shader_id != id) {
             state->shader_id = id;
             glUseProgram(id);
+            ++state->frame_stats.binds;
         }
 
         bindIndexedBuffers(*state);
+        applySharedSamplers(*state);
         bindTextures();
 
         for (auto& [name, uniform] : uniforms) {
@@ -57,6 +61,10 @@ void Limitless::swap(ShaderProgram& lhs, ShaderProgram& rhs) noexcept {
     swap(lhs.locations, rhs.locations);
     swap(lhs.indexed_binds, rhs.indexed_binds);
     swap(lhs.uniforms, rhs.uniforms);
+    swap(lhs.dependencies, rhs.dependencies);
+    swap(lhs.settings_macros, rhs.settings_macros);
+    swap(lhs.settings_defines, rhs.settings_defines);
+    swap(lhs.shared_version, rhs.shared_version);
 }
 
 void ShaderProgram::getUniformLocations() noexcept {
@@ -131,24 +139,40 @@ void ShaderProgram::bindIndexedBuffers(ContextState& ctx) {
         }
 
         // binds buffer to state binding point
-        try {
-            auto buffer = ctx.getIndexedBuffers().get(name);
+        // blocks without single named buffer are bound by their owners, e.g. FrameRing allocations
+        auto* buffer = ctx.getIndexedBuffers().find(name);
+        if (!buffer) {
+            continue;
+        }
 
-            Buffer::Type program_target {};
-            switch (target) {
-                case IndexedBuffer::Type::UniformBuffer:
-                    program_target = Buffer::Type::Uniform;
-                    break;
-                case IndexedBuffer::Type::ShaderStorage:
-                    program_target = Buffer::Type::ShaderStorage;
-                    break;
-            }
+        Buffer::Type program_target {};
+        switch (target) {
+            case IndexedBuffer::Type::UniformBuffer:
+                program_target = Buffer::Type::Uniform;
+                break;
+            case IndexedBuffer::Type::ShaderStorage:
+                program_target = Buffer::Type::ShaderStorage;
+                break;
+        }
 
-            buffer->bindBaseAs(program_target, bound_point);
-        } catch (const buffer_not_found& e) {
-            continue;
+        buffer->bindBaseAs(program_target, bound_point);
+    }
+}
+
+void ShaderProgram::applySharedSamplers(ContextState& ctx) {
+    const auto& shared = ctx.getSharedSamplers();
+    if (shared_version == shared.getVersion()) {
+        return;
+    }
+
+    // only samplers program declares, others would take texture units for nothing
+    for (const auto& [name, texture] : shared.getSamplers()) {
+        if (texture && locations.find(name) != locations.end()) {
+            *this << UniformSampler{name, texture};
         }
     }
+
+    shared_version = shared.getVersion();
 }
 
 ShaderProgram& ShaderProgram::operator<<(const UniformSampler& uniform) noexcept {
@@ -170,9 +194,16 @@ ShaderProgram& ShaderProgram::operator<<(const ms::Material& material) {
 
     material.getMaterialBuffer()->bindBase(found->bound_point);
 
-    for (const auto& [type, uniform] : material.getProperties()) {
-        if (uniform->getType() == UniformType::Sampler) {
-            *this << static_cast<UniformSampler&>(*uniform);
+    // property textures live in atlas, so its samplers stay the same between materials
+    if (const auto& virtual_texture = material.getVirtualTexture(); virtual_texture) {
+        // pages are requested and loaded by VirtualTexturePass, pipelines without it sample empty regions
+        assert(virtual_texture->isUpdated());
+        *this << virtual_texture->getPhysicalSampler() << virtual_texture->getPhysicalSRGBSampler() << virtual_texture->getIndirectionSampler();
+    } else {
+        for (const auto& [type, uniform] : material.getProperties()) {
+            if (uniform->getType() == UniformType::Sampler) {
+                *this << static_cast<UniformSampler&>(*uniform);
+            }
         }
     }
 
@@ -218,7 +249,7 @@ void ShaderProgram::bindTextures() const noexcept {
             }
         }
 
-        const auto units = TextureBinder::bind(to_bind);
+        const auto& units = ContextState::getState(glfwGetCurrentContext())->getTextureBinder().bind(to_bind);
 
         uint32_t i = 0;
         for (const auto& [name, uniform] : uniforms) {
@@ -0,0 +1,29 @@
+#include <limitless/core/shared_samplers.hpp>
+
+#include <algorithm>
+
+using namespace Limitless;
+
+void SharedSamplers::set(const std::string& name, std::shared_ptr<Texture> texture) {
+    auto found = std::find_if(samplers.begin(), samplers.end(), [&] (const auto& sampler) { return sampler.first == name; });
+
+    if (found == samplers.end()) {
+        samplers.emplace_back(name, std::move(texture));
+        ++version;
+        return;
+    }
+
+    if (found->second != texture) {
+        found->second = std::move(texture);
+        ++version;
+    }
+}
+
+void SharedSamplers::remove(const std::string& name) {
+    auto found = std::find_if(samplers.begin(), samplers.end(), [&] (const auto& sampler) { return sampler.first == name; });
+
+    if (found != samplers.end()) {
+        samplers.erase(found);
+        ++version;
+    }
+}
@@ -14,6 +14,7 @@ StateBuffer::StateBuffer(Type target, size_t size, const void* data, Usage usage
     glGenBuffers(1, &id);
 
     StateBuffer::bufferData(data);
+    track();
 }
 
 StateBuffer::StateBuffer(Type target, size_t size, const void* data, Storage usage, ImmutableAccess access)
@@ -21,33 +22,19 @@ StateBuffer::StateBuffer(Type target, size_t size, const void* data, Storage usa
     glGenBuffers(1, &id);
 
     StateBuffer::bufferStorage(data);
+    track();
 }
 
 StateBuffer::~StateBuffer() {
     if (id != 0) {
         if (auto* state = ContextState::getState(glfwGetCurrentContext()); state) {
-            auto& target_map = state->buffer_target;
-            auto& point_map = state->buffer_point;
-
-            std::for_each(target_map.begin(), target_map.end(), [&] (auto& state_target) {
-                auto& [s_target, s_id] = state_target;
-                if (s_id == id) s_id = 0;
-            });
-
-            bool bound {};
-            std::for_each(point_map.begin(), point_map.end(), [&] (auto& state_point) {
-                auto& [s_point, s_id] = state_point;
-                if (s_id == id) {
-                    s_id = 0;
-                    bound = true;
-                }
-            });
+            state->buffer_target.reset(id);
 
             // some strange behavior on old cpu
             // if buffer's bound to any binding point
             // we have to reset its target binding
-            if (bound) {
-                target_map[target] = 0;
+            if (state->buffer_point.reset(id)) {
+                state->buffer_target[target] = 0;
             }
 
             glDeleteBuffers(1, &id);
@@ -65,6 +52,7 @@ void Limitless::swap(StateBuffer& lhs, StateBuffer& rhs) noexcept {
     swap(lhs.access, rhs.access);
     swap(lhs.persistent_ptr, rhs.persistent_ptr);
     swap(lhs.sync, rhs.sync);
+    swap(lhs.memory, rhs.memory);
 }
 
 StateBuffer::StateBuffer(StateBuffer&& rhs) noexcept : StateBuffer() {
@@ -169,9 +157,10 @@ void StateBuffer::mapData(const void* data, size_t data_size) {
         switch (std::get<MutableAccess>(access)) {
             case MutableAccess::None:
                 throw buffer_error{"Static created buffer should not be mapped"};
-            case MutableAccess::Write:
-                [[fallthrough]];
             case MutableAccess::WriteOrphaning:
+                GpuMemory::orphan(size);
+                [[fallthrough]];
+            case MutableAccess::Write:
                 std::memcpy(mapBufferRange(0, data_size), data, data_size);
                 unmapBuffer();
                 break;
@@ -287,14 +276,35 @@ void StateBuffer::resize(size_t new_size) noexcept{
     size = new_size;
 
     if (std::holds_alternative<Storage>(usage_flags)) {
+        auto name = memory.getName();
         StateBuffer new_buffer{target, size, nullptr, std::get<Storage>(usage_flags), std::get<ImmutableAccess>(access)};
         swap(*this, new_buffer);
+        memory.setName(std::move(name));
     } else {
         bind();
         StateBuffer::bufferData(nullptr);
+        track();
     }
 }
 
+void StateBuffer::track() {
+    const auto category = [&] {
+        switch (target) {
+            case Type::Array: return GpuMemory::Category::VertexBuffer;
+            case Type::Element: return GpuMemory::Category::IndexBuffer;
+            case Type::Uniform: return GpuMemory::Category::UniformBuffer;
+            case Type::ShaderStorage: return GpuMemory::Category::StorageBuffer;
+            default: return GpuMemory::Category::Buffer;
+        }
+    }();
+
+    memory.set(category, size);
+}
+
+void StateBuffer::setName(std::string name) {
+    memory.setName(std::move(name));
+}
+
 StateBuffer* StateBuffer::clone() {
     //TODO: a che po normalnomy private copy ctor ?
     if (std::holds_alternative<Storage>(usage_flags)) {
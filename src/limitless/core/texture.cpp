@@ -2,6 +2,8 @@
 
 #include <limitless/core/extension_texture.hpp>
 #include <limitless/core/context_initializer.hpp>
+#include <algorithm>
+#include <cmath>
 
 using namespace Limitless;
 
@@ -32,6 +34,8 @@ void Texture::storage(const void* data) {
     if (mipmap) {
         generateMipMap();
     }
+
+    track();
 }
 
 void Texture::storage([[maybe_unused]] const std::array<void*, 6>& data) {
@@ -58,6 +62,8 @@ void Texture::image(const void* data) {
     if (mipmap) {
         generateMipMap();
     }
+
+    track();
 }
 
 void Texture::image(const std::array<void*, 6>& data) {
@@ -70,16 +76,20 @@ void Texture::image(const std::array<void*, 6>& data) {
     if (mipmap) {
         generateMipMap();
     }
+
+    track();
 }
 
 void Texture::image(uint32_t level, glm::uvec2 _size, const void* data) {
     setParameters();
     texture->texImage2D(static_cast<GLenum>(target), level, static_cast<GLenum>(internal_format), static_cast<GLenum>(format), static_cast<GLenum>(data_type), _size, border, data);
+    track();
 }
 
 void Texture::image(uint32_t level, glm::uvec3 _size, const void* data) {
     setParameters();
     texture->texImage3D(static_cast<GLenum>(target), level, static_cast<GLenum>(internal_format), static_cast<GLenum>(format), static_cast<GLenum>(data_type), _size, border, data);
+    track();
 }
 
 void Texture::compressedImage(const void* data, std::size_t byte_count) {
@@ -92,11 +102,13 @@ void Texture::compressedImage(const void* data, std::size_t byte_count) {
 void Texture::compressedImage(uint32_t level, glm::uvec2 _size, const void* data, std::size_t byte_count) {
     setParameters();
     texture->compressedTexImage2D(static_cast<GLenum>(target), level, static_cast<GLenum>(internal_format), _size, border, data, byte_count);
+    track();
 }
 
 void Texture::compressedImage(uint32_t level, glm::uvec3 _size, const void* data, std::size_t byte_count) {
     setParameters();
     texture->compressedTexImage3D(static_cast<GLenum>(target), level, static_cast<GLenum>(internal_format), _size, border, data, byte_count);
+    track();
 }
 
 void Texture::subImage(uint32_t level, glm::uvec2 offset, glm::uvec2 _size, const void* data) {
@@ -121,6 +133,7 @@ void Texture::compressedSubImage(uint32_t level, glm::uvec3 offset, glm::uvec3 _
 
 void Texture::generateMipMap() {
     texture->generateMipMap(static_cast<GLenum>(target));
+    track();
 }
 
 void Texture::bind(GLuint index) const {
@@ -140,6 +153,129 @@ void Texture::resize(glm::uvec3 _size) {
     }
 }
 
+void Texture::reallocate(glm::uvec3 _size, uint32_t _levels) {
+    size = _size;
+    levels = _levels;
+
+    // new object releases memory of dropped levels
+    texture = std::unique_ptr<ExtensionTexture>(texture->clone());
+    setParameters();
+
+    if (anisotropic != 0.0f) {
+        setAnisotropicFilter(anisotropic);
+    }
+
+    if (isImmutable()) {
+        if (is2D()) {
+            texture->texStorage2D(static_cast<GLenum>(target), levels, static_cast<GLenum>(internal_format), static_cast<glm::uvec2>(size));
+        }
+
+        if (is3D()) {
+            texture->texStorage3D(static_cast<GLenum>(target), levels, static_cast<GLenum>(internal_format), size);
+        }
+    }
+
+    track();
+}
+
+size_t Texture::getTexelSize(InternalFormat format) noexcept {
+    switch (format) {
+        case InternalFormat::R:
+        case InternalFormat::R8:
+            return 1;
+        case InternalFormat::Depth16:
+        case InternalFormat::RG8:
+        case InternalFormat::RG8_SNORM:
+            return 2;
+        case InternalFormat::RGB8:
+        case InternalFormat::RGB8_SNORM:
+        case InternalFormat::sRGB8:
+            return 3;
+        case InternalFormat::RGB16:
+        case InternalFormat::RGB16F:
+        case InternalFormat::RGB16_SNORM:
+            return 6;
+        case InternalFormat::RGBA16:
+        case InternalFormat::RGBA16F:
+        case InternalFormat::RGBA16_SNORM:
+        case InternalFormat::RG32F:
+        case InternalFormat::RGB_DXT1:
+        case InternalFormat::RGBA_DXT1:
+        case InternalFormat::sRGB_DXT1:
+        case InternalFormat::sRGBA_DXT1:
+        case InternalFormat::R_RGTC:
+            return 8;
+        case InternalFormat::RGB32F:
+            return 12;
+        case InternalFormat::RGBA_DXT3:
+        case InternalFormat::RGBA_DXT5:
+        case InternalFormat::sRGBA_DXT3:
+        case InternalFormat::sRGBA_DXT5:
+        case InternalFormat::RGBA_BC7:
+        case InternalFormat::sRGBA_BC7:
+        case InternalFormat::RG_RGTC:
+            return 16;
+        default:
+            return 4;
+    }
+}
+
+size_t Texture::getByteSize() const noexcept {
+    // block size of compressed formats, texel size of others
+    const size_t bytes = getTexelSize(internal_format);
+
+    const bool block = compressed
+        || internal_format == InternalFormat::RGB_DXT1 || internal_format == InternalFormat::RGBA_DXT1
+        || internal_format == InternalFormat::sRGB_DXT1 || internal_format == InternalFormat::sRGBA_DXT1
+        || internal_format == InternalFormat::RGBA_DXT3 || internal_format == InternalFormat::sRGBA_DXT3
+        || internal_format == InternalFormat::RGBA_DXT5 || internal_format == InternalFormat::sRGBA_DXT5
+        || internal_format == InternalFormat::RGBA_BC7 || internal_format == InternalFormat::sRGBA_BC7
+        || internal_format == InternalFormat::R_RGTC || internal_format == InternalFormat::RG_RGTC;
+
+    size_t layers = 1;
+    switch (target) {
+        case Type::Tex2D: break;
+        case Type::Tex3D:
+        case Type::Tex2DArray: layers = size.z; break;
+        case Type::CubeMap: layers = 6; break;
+        case Type::TexCubeMapArray: layers = static_cast<size_t>(size.z) * 6; break;
+    }
+
+    const auto level_count = mipmap
+        ? static_cast<uint32_t>(std::log2(std::max({size.x, size.y, 1u}))) + 1
+        : std::max(levels, 1u);
+
+    size_t total {};
+    for (uint32_t level = 0; level < level_count; ++level) {
+        const auto width = static_cast<size_t>(std::max(size.x >> level, 1u));
+        const auto height = static_cast<size_t>(std::max(size.y >> level, 1u));
+        // only 3D textures shrink in depth
+        const auto depth = target == Type::Tex3D ? std::max<size_t>(layers >> level, 1) : layers;
+
+        total += block
+            ? ((width + 3) / 4) * ((height + 3) / 4) * bytes * depth
+            : width * height * bytes * depth;
+    }
+
+    return total;
+}
+
+void Texture::track() {
+    memory.set(memory_category, getByteSize());
+
+    if (path) {
+        memory.setName(path->string());
+    }
+}
+
+void Texture::setMemoryCategory(GpuMemory::Category category) {
+    memory_category = category;
+
+    if (memory) {
+        track();
+    }
+}
+
 void Texture::accept(TextureVisitor& visitor) {
     texture->accept(visitor);
 }
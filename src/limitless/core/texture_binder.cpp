@@ -1,117 +1,97 @@
 #include <limitless/core/texture_binder.hpp>
-#include <limitless/core/context_state.hpp>
-#include <limitless/core/context_initializer.hpp>
-#include <algorithm>
+#include <limitless/core/texture.hpp>
 #include <stdexcept>
-#include <iterator>
 
 using namespace Limitless;
-//
-//GLint TextureBinder::bind(Texture& texture) noexcept {
-//    // contains [unit_index, texture_id]
-//    const auto& texture_bound = ContextState::getState(glfwGetCurrentContext())->texture_bound;
-//
-//    // checks if there is already bound texture
-//    const auto already_bound = std::find_if(texture_bound.begin(), texture_bound.end(), [&] (const auto& bind) { return bind.second == texture.getId(); });
-//    if (already_bound != texture_bound.end()) {
-//        return already_bound->first;
-//    }
-//
-//    // checks for free slots
-//    const auto empty_slot = std::find_if(texture_bound.begin(), texture_bound.end(), [] (const auto& bind) { return bind.second == 0; });
-//    if (empty_slot != texture_bound.end()) {
-//        texture.bind(empty_slot->first);
-//        return empty_slot->first;
-//    }
-//
-//    const auto unit = current_bind;
-//    texture.bind(unit);
-//
-//    current_bind = ++current_bind >= ContextInitializer::limits.max_texture_units ? 0 : current_bind;
-//
-//    return unit;
-//}
-
-std::vector<GLint> TextureBinder::bind(const std::vector<Texture*>& textures) {
-    if (textures.size() > static_cast<size_t>(ContextInitializer::limits.max_texture_units)) {
-        throw std::runtime_error("Failed to bind textures which more than texture units.");
+
+void TextureBinder::init(const std::vector<GLuint>& texture_bound) {
+    bound = texture_bound.data();
+    count = static_cast<GLuint>(texture_bound.size());
+
+    units.clear();
+    units.reserve(count);
+
+    // units start in order, the first one is used first
+    previous.resize(count);
+    next.resize(count);
+    for (GLuint unit = 0; unit < count; ++unit) {
+        previous[unit] = unit + 1 < count ? unit + 1 : NONE;
+        next[unit] = unit > 0 ? unit - 1 : NONE;
     }
+    head = count > 0 ? count - 1 : NONE;
+    tail = count > 0 ? 0 : NONE;
+}
 
-    using IndexMap = std::map<uint32_t, const Texture*>;
-    auto& texture_bound = ContextState::getState(glfwGetCurrentContext())->texture_bound;
-    std::vector<GLint> indices(textures.size(), -1);
+void TextureBinder::unlink(GLuint unit) noexcept {
+    if (previous[unit] != NONE) {
+        next[previous[unit]] = next[unit];
+    } else {
+        head = next[unit];
+    }
 
-    IndexMap bind_map;
-    uint32_t i = 0;
-    for (const auto* texture : textures) {
-        bind_map.emplace(i++, texture);
+    if (next[unit] != NONE) {
+        previous[next[unit]] = previous[unit];
+    } else {
+        tail = previous[unit];
     }
+}
 
-    // checks if there is already bound to context textures and creates map with it
-    IndexMap already_bound;
-    for (const auto& [index, texture] : bind_map) {
-        const auto& tex_ptr = texture;
-        const auto found = std::find_if(texture_bound.begin(), texture_bound.end(), [&] (const auto& bind) { return bind.second == tex_ptr->getId(); });
-        if (found != texture_bound.end()) {
-            indices[index] = found->first;
-            already_bound.emplace(index, texture);
-        }
+void TextureBinder::touch(GLuint unit) noexcept {
+    if (unit == head) {
+        return;
     }
 
-    // creates map with unbound textures
-    IndexMap unbound_map;
-    std::set_difference(bind_map.begin(), bind_map.end(), already_bound.begin(), already_bound.end(), std::inserter(unbound_map, unbound_map.begin()));
-
-    // checks for free texture unit slots in context
-    IndexMap empty_bound;
-    for (const auto& [index, texture] : unbound_map) {
-        auto found = std::find_if(texture_bound.begin(), texture_bound.end(), [] (const auto& bind) { return bind.second == 0; });
-        if (found != texture_bound.end()) {
-            indices[index] = found->first;
-            empty_bound.emplace(index, texture);
-            texture->bind(found->first);
-        }
+    unlink(unit);
+
+    previous[unit] = NONE;
+    next[unit] = head;
+    previous[head] = unit;
+    head = unit;
+}
+
+const std::vector<GLint>& TextureBinder::bind(const std::vector<Texture*>& textures) {
+    if (textures.size() > count) {
+        throw std::runtime_error("Failed to bind textures which more than texture units.");
     }
 
-    IndexMap replace_map;
-    std::set_difference(unbound_map.begin(), unbound_map.end(), empty_bound.begin(), empty_bound.end(), std::inserter(replace_map, replace_map.begin()));
-
-    for (const auto& [index, texture] : replace_map) {
-        std::vector<int>::iterator found;
-        while (found != indices.end()) {
-            found = std::find_if(indices.begin(), indices.end(), [] (const auto& index) { return index == current_bind; });
-            if (found == indices.end()) {
-                indices[index] = current_bind;
-                texture->bind(current_bind);
-                current_bind = ++current_bind >= ContextInitializer::limits.max_texture_units ? 0 : current_bind;
+    indices.resize(textures.size());
+    frame_stats.requests += textures.size();
+
+    for (size_t i = 0; i < textures.size(); ++i) {
+        const auto id = textures[i]->getId();
+
+        // texture can be rebound or deleted by someone else, so hash is checked against context state
+        if (const auto found = units.find(id); found != units.end()) {
+            if (bound[found->second] == id) {
+                touch(found->second);
+                indices[i] = static_cast<GLint>(found->second);
+                ++frame_stats.hits;
+                continue;
             }
+            units.erase(found);
         }
+
+        // units used by this call were moved to head, so tail is never one of them
+        const auto unit = tail;
+        if (const auto replaced = bound[unit]; replaced != 0) {
+            if (const auto it = units.find(replaced); it != units.end() && it->second == unit) {
+                units.erase(it);
+            }
+            ++frame_stats.evictions;
+        }
+
+        textures[i]->bind(unit);
+        units[id] = unit;
+        touch(unit);
+
+        indices[i] = static_cast<GLint>(unit);
+        ++frame_stats.binds;
     }
 
     return indices;
 }
-//
-//GLint TextureBinder::bind(GLenum target, const ExtensionTexture& texture) noexcept {
-//    // contains [unit_index, texture_id]
-//    const auto& texture_bound = ContextState::getState(glfwGetCurrentContext())->texture_bound;
-//
-//    // checks if there is already bound texture
-//    const auto already_bound = std::find_if(texture_bound.begin(), texture_bound.end(), [&] (const auto& bind) { return bind.second == texture.getId(); });
-//    if (already_bound != texture_bound.end()) {
-//        return already_bound->first;
-//    }
-//
-//    // checks for free slots
-//    const auto empty_slot = std::find_if(texture_bound.begin(), texture_bound.end(), [] (const auto& bind) { return bind.second == 0; });
-//    if (empty_slot != texture_bound.end()) {
-//        texture.bind(target, empty_slot->first);
-//        return empty_slot->first;
-//    }
-//
-//    const auto unit = current_bind;
-//    texture.bind(target, unit);
-//
-//    current_bind = ++current_bind >= ContextInitializer::limits.max_texture_units ? 0 : current_bind;
-//
-//    return unit;
-//}
+
+void TextureBinder::onFrame() noexcept {
+    last_frame_stats = frame_stats;
+    frame_stats = {};
+}
@@ -96,6 +96,12 @@ void TripleBuffer::waitFence() noexcept {
     buffers[curr_index]->waitFence();
 }
 
+void TripleBuffer::setName(std::string name) {
+    for (auto& buffer : buffers) {
+        buffer->setName(name);
+    }
+}
+
 void TripleBuffer::fence() noexcept {
     buffers[curr_index]->fence();
 
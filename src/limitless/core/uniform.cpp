@@ -4,6 +4,7 @@
 #include <limitless/core/bindless_texture.hpp>
 #include <limitless/core/texture.hpp>
 #include <limitless/core/context_initializer.hpp>
+#include <limitless/core/frame_clock.hpp>
 
 using namespace Limitless;
 
@@ -178,7 +179,19 @@ constexpr UniformValueType UniformValue<T>::getUniformValueType() {
 }
 
 UniformSampler::UniformSampler(const std::string& name, std::shared_ptr<Texture> sampler) noexcept
-    : UniformValue{name, UniformType::Sampler, -1}, sampler{std::move(sampler)} { }
+    : UniformValue{name, UniformType::Sampler, -1}, sampler{std::move(sampler)} {
+    if (this->sampler) {
+        sampler_id = this->sampler->getId();
+    }
+}
+
+bool& UniformSampler::getChanged() noexcept {
+    if (sampler && sampler_id != sampler->getId()) {
+        sampler_id = sampler->getId();
+        changed = true;
+    }
+    return changed;
+}
 
 void UniformSampler::setSampler(const std::shared_ptr<Texture>& texture) noexcept {
     if (sampler != texture || sampler_id != texture->getId()) {
@@ -277,17 +290,8 @@ UniformTime::UniformTime(const std::string& name) noexcept
 
 }
 
-void UniformTime::update() noexcept {
-    if (start == std::chrono::time_point<std::chrono::steady_clock>{}) {
-        start = std::chrono::steady_clock::now();
-    }
-
-    setValue(std::chrono::duration_cast<std::chrono::duration<float>>(std::chrono::steady_clock::now() - start).count());
-}
-
-void UniformTime::set(const ShaderProgram& shader) {
-    update();
-    UniformValue::set(shader);
+void UniformTime::update(const FrameTime& time) noexcept {
+    setValue(static_cast<float>(time.time.count()));
 }
 
 UniformTime* UniformTime::clone() noexcept {
@@ -0,0 +1,117 @@
+#include <limitless/core/upload_staging.hpp>
+
+#include <limitless/core/buffer_builder.hpp>
+#include <limitless/core/context_initializer.hpp>
+#include <limitless/core/context_state.hpp>
+#include <limitless/core/texture.hpp>
+#include <cstring>
+
+using namespace Limitless;
+
+namespace {
+    // pixel offsets have to be aligned to the size of pixel component
+    constexpr size_t STAGING_ALIGNMENT = 16;
+}
+
+UploadStaging::UploadStaging(size_t size)
+    : segment_size {size / SEGMENT_COUNT / STAGING_ALIGNMENT * STAGING_ALIGNMENT} {
+    // without persistent mapping everything is uploaded directly
+    if (!ContextInitializer::isExtensionSupported("GL_ARB_buffer_storage")) {
+        segment_size = 0;
+        return;
+    }
+
+    buffer = BufferBuilder()
+            .setTarget(Buffer::Type::PixelUnpack)
+            .setUsage(Buffer::Storage::DynamicCoherentWrite)
+            .setAccess(Buffer::ImmutableAccess::WriteCoherent)
+            .setDataSize(segment_size * SEGMENT_COUNT)
+            .build();
+
+    memory = static_cast<std::byte*>(buffer->mapBufferRange(0, static_cast<GLsizeiptr>(buffer->getSize())));
+
+    // buffer is bound while being created
+    unbind();
+}
+
+UploadStaging::~UploadStaging() {
+    for (auto& fence : fences) {
+        if (fence) {
+            glDeleteSync(fence);
+        }
+    }
+}
+
+void UploadStaging::bind() const noexcept {
+    buffer->bind();
+}
+
+void UploadStaging::unbind() const noexcept {
+    // other uploads use client memory, so unpack buffer cannot stay bound
+    if (auto* state = ContextState::getState(glfwGetCurrentContext()); state) {
+        auto& target = state->buffer_target[Buffer::Type::PixelUnpack];
+        if (target != 0) {
+            glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+            target = 0;
+        }
+    }
+}
+
+std::optional<size_t> UploadStaging::stage(const void* data, size_t size) {
+    if (!buffer || size > segment_size) {
+        stats.direct += size;
+        return std::nullopt;
+    }
+
+    if (offset + size > segment_size) {
+        flush();
+    }
+
+    const auto position = segment * segment_size + offset;
+    std::memcpy(memory + position, data, size);
+
+    offset = (offset + size + STAGING_ALIGNMENT - 1) / STAGING_ALIGNMENT * STAGING_ALIGNMENT;
+    stats.staged += size;
+
+    return position;
+}
+
+void UploadStaging::flush() {
+    if (offset == 0) {
+        return;
+    }
+
+    fences[segment] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+
+    segment = (segment + 1) % SEGMENT_COUNT;
+    offset = 0;
+
+    if (auto& fence = fences[segment]; fence) {
+        if (glClientWaitSync(fence, 0, 0) == GL_TIMEOUT_EXPIRED) {
+            ++stats.stalls;
+            while (glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000) == GL_TIMEOUT_EXPIRED);
+        }
+        glDeleteSync(fence);
+        fence = {};
+    }
+}
+
+void UploadStaging::subImage(Texture& texture, uint32_t level, glm::uvec2 _offset, glm::uvec2 size, const void* data, size_t byte_count) {
+    if (const auto position = stage(data, byte_count); position) {
+        bind();
+        texture.subImage(level, _offset, size, reinterpret_cast<const void*>(*position));
+        unbind();
+    } else {
+        texture.subImage(level, _offset, size, data);
+    }
+}
+
+void UploadStaging::compressedSubImage(Texture& texture, uint32_t level, glm::uvec2 _offset, glm::uvec2 size, const void* data, size_t byte_count) {
+    if (const auto position = stage(data, byte_count); position) {
+        bind();
+        texture.compressedSubImage(level, _offset, size, reinterpret_cast<const void*>(*position), byte_count);
+        unbind();
+    } else {
+        texture.compressedSubImage(level, _offset, size, data, byte_count);
+    }
+}
@@ -32,6 +32,7 @@ void VertexArray::bind() const noexcept {
     if (auto* state = ContextState::getState(glfwGetCurrentContext()); state) {
         if (state->vertex_array_id != id) {
             glBindVertexArray(id);
+            ++state->frame_stats.binds;
             state->vertex_array_id = id;
         }
     }
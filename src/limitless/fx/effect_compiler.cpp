@@ -6,6 +6,7 @@
 #include <limitless/fx/emitters/beam_emitter.hpp>
 #include <limitless/instances/effect_instance.hpp>
 #include <limitless/assets.hpp>
+#include <plog/Log.h>
 
 using namespace Limitless::fx;
 using namespace Limitless;
@@ -115,7 +116,16 @@ void EffectCompiler::compile(ShaderPass shader_type, const T& emitter) {
             replaceRenderSettings(shader);
         };
 
-        assets.shaders.add({emitter.getUniqueShaderType(), shader_type}, compile(assets.getShaderDir() / SHADER_PASS_PATH.at(shader_type), props));
+        const auto key = fx::UniqueEmitterShaderKey{emitter.getUniqueShaderType(), shader_type};
+        try {
+            assets.shaders.add(key, compile(assets.getShaderDir() / SHADER_PASS_PATH.at(shader_type), props));
+        } catch (const std::exception& e) {
+            // emitter that is compiled again after reload keeps its previous program
+            if (!assets.shaders.restore(key)) {
+                throw;
+            }
+            PLOG_ERROR << "Emitter shader failed to compile, previous program is kept: " << e.what();
+        }
     }
 }
 
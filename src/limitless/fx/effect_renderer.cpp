@@ -37,11 +37,11 @@ void EffectRenderer::updateRenderers(const Instances& instances) noexcept {
     visitEmitters(instances, creator);
 }
 
-void EffectRenderer::update(const Instances& instances) {
+void EffectRenderer::update(const Instances& instances, const FrameTime& time) {
     updateRenderers(instances);
 
     for (const auto& [type, renderer] : renderers) {
-        type.material->update();
+        type.material->update(time);
         switch (type.emitter_type) {
             case AbstractEmitter::Type::Sprite: {
                 ParticleCollector<SpriteParticle> collector {type};
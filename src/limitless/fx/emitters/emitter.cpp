@@ -1,5 +1,7 @@
 #include <limitless/fx/emitters/emitter.hpp>
 
+#include <limitless/core/frame_clock.hpp>
+
 using namespace Limitless::fx;
 
 template<typename Particle>
@@ -135,37 +137,29 @@ void Emitter<P>::setRotation(const glm::quat& new_rotation) noexcept {
 }
 
 template<typename P>
-void Emitter<P>::spawnParticles() noexcept {
-    using namespace std::chrono;
-
+void Emitter<P>::spawnParticles(std::chrono::duration<float> delta_time) noexcept {
     if (spawn.spawn_rate <= 0.0f) {
         return;
     }
 
-    const auto isFirst = [&] () {
-        return spawn.last_spawn == time_point<steady_clock>();
-    };
-
-    const auto current_time = steady_clock::now();
-    if (isFirst()) {
-        spawn.last_spawn = current_time;
-    }
-    const auto delta = duration_cast<std::chrono::duration<float>>(current_time - spawn.last_spawn).count();
+    const auto first = !spawn.since_spawn;
+    spawn.since_spawn = spawn.since_spawn.value_or(std::chrono::duration<float>{}) + delta_time;
+    const auto delta = spawn.since_spawn->count();
 
     switch (spawn.mode) {
         case EmitterSpawn::Mode::Spray: {
-            if (delta >= (1.0f / spawn.spawn_rate) || isFirst()) {
+            if (delta >= (1.0f / spawn.spawn_rate) || first) {
                 const auto remaining = spawn.max_count - particles.size();
                 if (remaining > 0) {
                     emit(glm::clamp(static_cast<size_t>(delta * spawn.spawn_rate), static_cast<size_t>(1), remaining));
                 }
-                spawn.last_spawn = current_time;
+                spawn.since_spawn = std::chrono::duration<float>{};
             }
             break;
         }
         case EmitterSpawn::Mode::Burst:
             if (spawn.burst->loops != spawn.burst->loops_done) {
-                if (delta >= (1.0f / spawn.spawn_rate) || isFirst()) {
+                if (delta >= (1.0f / spawn.spawn_rate) || first) {
                     auto emit_count = spawn.burst->burst_count->get();
                     emit_count = (particles.size() + emit_count > spawn.max_count) ? spawn.max_count - particles.size() : emit_count;
                     emit(emit_count);
@@ -174,7 +168,7 @@ void Emitter<P>::spawnParticles() noexcept {
                         ++spawn.burst->loops_done;
                     }
 
-                    spawn.last_spawn = current_time;
+                    spawn.since_spawn = std::chrono::duration<float>{};
                 }
             }
             break;
@@ -204,36 +198,28 @@ void Emitter<P>::killParticles() noexcept {
 }
 
 template<typename P>
-void Emitter<P>::update([[maybe_unused]] Context& ctx, [[maybe_unused]] const Camera& camera) {
-    using namespace std::chrono;
-
-    const auto current_time = steady_clock::now();
-    const auto delta_time = duration_cast<std::chrono::duration<float>>(current_time - last_time);
-    last_time = current_time;
-
-	if (start_time == time_point<steady_clock>()) {
-		start_time = current_time;
-	}
+void Emitter<P>::update([[maybe_unused]] Context& ctx, [[maybe_unused]] const Camera& camera, const FrameTime& time) {
+    elapsed += time.delta;
 
     killParticles();
 
     {
         for (auto& module : modules) {
-            module->update(*this, particles, delta_time.count(), ctx, camera);
+            module->update(*this, particles, time.getDelta(), ctx, camera);
         }
 
         for (auto& particle : particles) {
-            particle.position += particle.velocity * delta_time.count();
-            particle.velocity += particle.acceleration * delta_time.count();
+            particle.position += particle.velocity * time.getDelta();
+            particle.velocity += particle.acceleration * time.getDelta();
         }
     }
 
     if (!done) {
-        spawnParticles();
+        spawnParticles(time.delta);
     }
 
     if (duration.count() != 0.0f) {
-        if (current_time - start_time >= duration) {
+        if (elapsed >= duration) {
             done = true;
         }
     }
@@ -23,10 +23,12 @@ void AbstractInstance::updateFinalMatrix() noexcept {
 
 void AbstractInstance::reveal() noexcept {
     hidden = false;
+    ++version;
 }
 
 void AbstractInstance::hide() noexcept {
     hidden = true;
+    ++version;
 }
 
 bool AbstractInstance::isHidden() const noexcept {
@@ -55,31 +57,40 @@ bool AbstractInstance::doesCastShadow() const noexcept {
 
 AbstractInstance& AbstractInstance::setPosition(const glm::vec3& _position) noexcept {
     position = _position;
+    ++transform_version;
     return *this;
 }
 
 AbstractInstance& AbstractInstance::setRotation(const glm::quat& _rotation) noexcept {
     rotation = _rotation;
+    ++transform_version;
     return *this;
 }
 
 AbstractInstance& AbstractInstance::rotateBy(const glm::quat& _rotation) noexcept {
     rotation = _rotation * rotation;
+    ++transform_version;
     return *this;
 }
 
 AbstractInstance& AbstractInstance::setScale(const glm::vec3& _scale) noexcept {
     scale = _scale;
+    ++transform_version;
     return *this;
 }
 
 AbstractInstance& AbstractInstance::setTransformation(const glm::mat4& transformation) {
 	transformation_matrix = transformation;
+	++transform_version;
 	return *this;
 }
 
 AbstractInstance& AbstractInstance::setParent(const glm::mat4& _parent) {
-	parent = _parent;
+	// parent is propagated every frame
+	if (parent != _parent) {
+		parent = _parent;
+		++transform_version;
+	}
 	return *this;
 }
 
@@ -87,19 +98,23 @@ void AbstractInstance::draw(Context& ctx, const Assets& assets, ShaderPass mater
     draw(ctx, assets, material_shader_type, blending, UniformSetter {});
 }
 
-void AbstractInstance::updateAttachments(Context& context, const Camera& camera) {
+void AbstractInstance::record(DrawList::Segment& segment) {
+    segment.addFallback(*this);
+}
+
+void AbstractInstance::updateAttachments(Context& context, const Camera& camera, const FrameTime& time) {
 	InstanceAttachment::setParent(final_matrix);
-	InstanceAttachment::updateAttachments(context, camera);
+	InstanceAttachment::updateAttachments(context, camera, time);
 }
 
-void AbstractInstance::update(Context& context, const Camera& camera) {
+void AbstractInstance::update(Context& context, const Camera& camera, const FrameTime& time) {
 	// updates current model matrices
 	updateModelMatrix();
 	updateFinalMatrix();
 	updateBoundingBox();
 
 	// propagates current instance values to attachments
-	updateAttachments(context, camera);
+	updateAttachments(context, camera, time);
 }
 
 void AbstractInstance::removeOutline() noexcept {
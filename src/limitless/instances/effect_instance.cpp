@@ -25,7 +25,7 @@ EffectInstance::EffectInstance(const EffectInstance& effect) noexcept
     }
 }
 
-void EffectInstance::updateEmitters(Context& context, const Camera& camera) const noexcept {
+void EffectInstance::updateEmitters(Context& context, const Camera& camera, const FrameTime& time) const noexcept {
 	// because we do not use final_matrix in emitter shaders explicitly
 	// we should decompose it to parameters
 	// and set it to emitters
@@ -44,13 +44,13 @@ void EffectInstance::updateEmitters(Context& context, const Camera& camera) cons
 		emitter->setRotation(rotation);
 		//TODO
 		//emitter->setScale(scale);
-        emitter->update(context, camera);
+        emitter->update(context, camera, time);
 	}
 }
 
-void EffectInstance::update(Context& context, const Camera& camera) {
-    AbstractInstance::update(context, camera);
-	updateEmitters(context, camera);
+void EffectInstance::update(Context& context, const Camera& camera, const FrameTime& time) {
+    AbstractInstance::update(context, camera, time);
+	updateEmitters(context, camera, time);
 	done = isDone();
 }
 
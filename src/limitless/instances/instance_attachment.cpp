@@ -10,9 +10,9 @@ InstanceAttachment::InstanceAttachment(const InstanceAttachment& attachment) {
 	}
 }
 
-void InstanceAttachment::updateAttachments(Context& context, const Camera& camera) {
+void InstanceAttachment::updateAttachments(Context& context, const Camera& camera, const FrameTime& time) {
 	for (const auto& [_, attachment] : attachments) {
-        attachment->update(context, camera);
+        attachment->update(context, camera, time);
 	}
 }
 
@@ -23,11 +23,26 @@ InstanceAttachment& InstanceAttachment::setParent(const glm::mat4& parent) noexc
 	return *this;
 }
 
+void InstanceAttachment::onStructureChange() noexcept {
+	if (structure_version) {
+		++*structure_version;
+	}
+}
+
+void InstanceAttachment::setStructureVersion(uint64_t* version) noexcept {
+	structure_version = version;
+	for (const auto& [_, attachment] : attachments) {
+		attachment->setStructureVersion(version);
+	}
+}
+
 void InstanceAttachment::attach(std::unique_ptr<AbstractInstance> attachment) {
+	attachment->setStructureVersion(structure_version);
 	const auto [it, success] = attachments.emplace(attachment->getId(), std::move(attachment));
 	if (!success) {
-		throw std::logic_error {"Attachment already attached! id: " + std::to_string(attachment->getId())};
+		throw std::logic_error {"Attachment already attached! id: " + std::to_string(it->first)};
 	}
+	onStructureChange();
 }
 
 void InstanceAttachment::detach(uint64_t id) {
@@ -35,6 +50,7 @@ void InstanceAttachment::detach(uint64_t id) {
 	if (erased == 0) {
 		throw std::logic_error {"There is no such attachment! id: " + std::to_string(id)};
 	}
+	onStructureChange();
 }
 
 const std::unique_ptr<AbstractInstance>& InstanceAttachment::getAttachment(uint64_t id) const {
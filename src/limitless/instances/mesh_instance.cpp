@@ -15,10 +15,12 @@ MeshInstance::MeshInstance(std::shared_ptr<AbstractMesh> _mesh, const std::share
 
 void MeshInstance::hide() noexcept {
     hidden = true;
+    ++version;
 }
 
 void MeshInstance::reveal() noexcept {
     hidden = false;
+    ++version;
 }
 
 void MeshInstance::draw(Context& ctx,
@@ -94,6 +96,43 @@ void MeshInstance::draw(Context& ctx,
     }
 }
 
+void MeshInstance::record(DrawList::Segment& segment,
+                          AbstractInstance& instance,
+                          ModelShader model,
+                          const glm::mat4& model_matrix) {
+    if (hidden) {
+        return;
+    }
+
+    const auto& list = segment.getList();
+
+    const auto add = [&] (uint64_t id, const ms::Material& mat) {
+        if (mat.getBlending() != list.getBlending()) {
+            return;
+        }
+
+        DrawList::Command command;
+        command.instance = &instance;
+        command.shader = &list.getAssets().shaders.get(list.getPass(), model, mat.getShaderIndex());
+        command.material = &material;
+        command.layer = &mat;
+        command.layer_id = id;
+        command.mesh = mesh.get();
+        command.model_matrix = &model_matrix;
+        command.patches = mat.contains(ms::Property::TessellationFactor);
+        segment.add(command);
+    };
+
+    if (!material.isLayered()) {
+        add(0, material[0]);
+        return;
+    }
+
+    for (const auto& [index, mat] : material) {
+        add(index, *mat);
+    }
+}
+
 void MeshInstance::draw_instanced(Context& ctx,
                         const Assets& assets,
                         ShaderPass pass,
@@ -136,8 +175,8 @@ void MeshInstance::draw_instanced(Context& ctx,
     }
 }
 
-void MeshInstance::update() {
+void MeshInstance::update(const FrameTime& time) {
 	for (const auto& [_, mat] : material) {
-		mat->update();
+		mat->update(time);
 	}
 }
@@ -3,6 +3,7 @@
 #include <limitless/models/model.hpp>
 #include <limitless/models/elementary_model.hpp>
 #include <stdexcept>
+#include <limits>
 
 using namespace Limitless;
 
@@ -49,6 +50,24 @@ void ModelInstance::draw(Context& ctx, const Assets& assets, ShaderPass pass, ms
     }
 }
 
+void ModelInstance::record(DrawList::Segment& segment) {
+    if (hidden) {
+        return;
+    }
+
+    for (auto& [name, mesh] : meshes) {
+        mesh.record(segment, *this, shader_type, final_matrix);
+    }
+}
+
+uint64_t ModelInstance::getVersion() const noexcept {
+    auto sum = AbstractInstance::getVersion();
+    for (const auto& [_, mesh] : meshes) {
+        sum += mesh.getVersion();
+    }
+    return sum;
+}
+
 MeshInstance& ModelInstance::operator[](const std::string& mesh) {
     return meshes.at(mesh);
 }
@@ -58,14 +77,26 @@ ModelInstance* ModelInstance::clone() noexcept {
 }
 
 void ModelInstance::updateBoundingBox() noexcept {
-    bounding_box.center = glm::vec4{position, 1.0f} + glm::vec4{model->getBoundingBox().center, 1.0f} * final_matrix;
-    bounding_box.size = glm::vec4{model->getBoundingBox().size, 1.0f} * final_matrix;
+    // world axis aligned box enclosing transformed corners of model box
+    const auto& box = model->getBoundingBox();
+
+    auto min = glm::vec3{std::numeric_limits<float>::max()};
+    auto max = glm::vec3{std::numeric_limits<float>::lowest()};
+    for (uint32_t i = 0; i < 8; ++i) {
+        const auto corner = box.center + box.size * (glm::vec3(i & 1, (i >> 1) & 1, (i >> 2) & 1) - 0.5f);
+        const auto world = glm::vec3{final_matrix * glm::vec4{corner, 1.0f}};
+        min = glm::min(min, world);
+        max = glm::max(max, world);
+    }
+
+    bounding_box.center = (min + max) * 0.5f;
+    bounding_box.size = max - min;
 }
 
-void ModelInstance::update(Context& context, const Camera& camera) {
-	AbstractInstance::update(context, camera);
+void ModelInstance::update(Context& context, const Camera& camera, const FrameTime& time) {
+	AbstractInstance::update(context, camera, time);
 	//TODO: propagate to inherited classes
 	for (auto& [_, mesh] : meshes) {
-		mesh.update();
+		mesh.update(time);
 	}
 }
@@ -4,24 +4,22 @@
 #include <limitless/core/context.hpp>
 #include <limitless/assets.hpp>
 #include <limitless/ms/material.hpp>
-#include <limitless/core/buffer_builder.hpp>
 #include <limitless/core/vertex.hpp>
 #include <limitless/models/mesh.hpp>
 #include <limitless/core/skeletal_stream.hpp>
+#include <limitless/core/frame_clock.hpp>
 #include <iostream>
+#include <cstring>
 
 using namespace Limitless;
 
 constexpr auto SKELETAL_BUFFER_NAME = "bone_buffer";
 
-void SkeletalInstance::initializeBuffer() {
-    BufferBuilder builder;
-    bone_buffer = builder.setTarget(Buffer::Type::ShaderStorage)
-            .setUsage(Buffer::Usage::DynamicDraw)
-            .setAccess(Buffer::MutableAccess::WriteOrphaning)
-            .setData(bone_transform.data())
-            .setDataSize(bone_transform.size() * sizeof(glm::mat4))
-            .build();
+void SkeletalInstance::uploadBones(Context& context) {
+    const auto size = sizeof(glm::mat4) * bone_transform.size();
+
+    bone_data = context.getFrameRing().allocate(Buffer::Type::ShaderStorage, size);
+    std::memcpy(bone_data.data, bone_transform.data(), size);
 }
 
 SkeletalInstance::SkeletalInstance(std::shared_ptr<AbstractModel> m, const glm::vec3& position)
@@ -29,7 +27,6 @@ SkeletalInstance::SkeletalInstance(std::shared_ptr<AbstractModel> m, const glm::
     auto& skeletal = dynamic_cast<SkeletalModel&>(*model);
 
     bone_transform.resize(skeletal.getBones().size(), glm::mat4(1.0f));
-    initializeBuffer();
 }
 
 const AnimationNode* SkeletalInstance::findAnimationNode(const Bone& bone) const noexcept {
@@ -69,14 +66,18 @@ void SkeletalInstance::draw(Context& ctx, const Assets& assets, ShaderPass pass,
         return;
     }
 
-	bone_buffer->bindBase(ctx.getIndexedBuffers().getBindingPoint(IndexedBuffer::Type::ShaderStorage, SKELETAL_BUFFER_NAME));
+    // instance can be drawn in a frame it was not updated in
+    auto& ring = ctx.getFrameRing();
+    if (!ring.isCurrent(bone_data)) {
+        uploadBones(ctx);
+    }
+
+    ring.bind(bone_data, Buffer::Type::ShaderStorage, ctx.getIndexedBuffers().getBindingPoint(IndexedBuffer::Type::ShaderStorage, SKELETAL_BUFFER_NAME));
 
     // iterates over all meshes
     for (auto& [name, mesh] : meshes) {
         mesh.draw(ctx, assets, pass, shader_type, final_matrix, blending, uniform_setter);
     }
-
-    bone_buffer->fence();
 }
 
 SkeletalInstance& SkeletalInstance::play(const std::string& name) {
@@ -89,7 +90,6 @@ SkeletalInstance& SkeletalInstance::play(const std::string& name) {
     } else {
         animation = &(*found);
         animation_duration = std::chrono::seconds(0);
-        last_time = std::chrono::time_point<std::chrono::steady_clock>();
     }
 
     return *this;
@@ -110,7 +110,7 @@ SkeletalInstance& SkeletalInstance::stop() noexcept {
     return *this;
 }
 
-void SkeletalInstance::updateAnimationFrame() {
+void SkeletalInstance::updateAnimationFrame(const FrameTime& time) {
 	if (!animation || paused) {
 		return;
 	}
@@ -119,13 +119,7 @@ void SkeletalInstance::updateAnimationFrame() {
 	auto& bones = skeletal.getBones();
 	const Animation& anim = *animation;
 
-	const auto current_time = std::chrono::steady_clock::now();
-	if (last_time == std::chrono::time_point<std::chrono::steady_clock>()) {
-		last_time = current_time;
-	}
-	const auto delta_time = current_time - last_time;
-	animation_duration += delta_time;
-	last_time = current_time;
+	animation_duration += time.delta;
 	const auto animation_time = glm::mod(animation_duration.count() * anim.tps, anim.duration);
 
 	std::function<void(const Tree<uint32_t>&, const glm::mat4&)> node_traversal;
@@ -160,21 +154,20 @@ void SkeletalInstance::updateAnimationFrame() {
 	} catch (const std::exception& e) {
 		throw std::runtime_error("Wrong TPS/duration. " + std::string(e.what()));
 	}
-
-	bone_buffer->mapData(bone_transform.data(), sizeof(glm::mat4) * bone_transform.size());
 }
 
-void SkeletalInstance::updateAttachments(Context& context, const Camera& camera) {
+void SkeletalInstance::updateAttachments(Context& context, const Camera& camera, const FrameTime& time) {
 	SocketAttachment::setTransformation();
-	AbstractInstance::updateAttachments(context, camera);
+	AbstractInstance::updateAttachments(context, camera, time);
 }
 
-void SkeletalInstance::update(Context& context, const Camera& camera) {
-	updateAnimationFrame();
+void SkeletalInstance::update(Context& context, const Camera& camera, const FrameTime& time) {
+	updateAnimationFrame(time);
+	uploadBones(context);
 
 	SocketAttachment::update();
 
-    ModelInstance::update(context, camera);
+    ModelInstance::update(context, camera, time);
 }
 
 SkeletalInstance* SkeletalInstance::clone() noexcept {
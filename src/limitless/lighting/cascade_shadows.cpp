@@ -1,7 +1,6 @@
 #include <limitless/lighting/cascade_shadows.hpp>
 
 #include <limitless/core/texture_builder.hpp>
-#include <limitless/core/buffer_builder.hpp>
 #include <limitless/core/shader_program.hpp>
 #include <limitless/core/uniform_setter.hpp>
 #include <limitless/core/uniform.hpp>
@@ -22,7 +21,7 @@ namespace {
     constexpr auto DIRECTIONAL_CSM_BUFFER_NAME = "directional_shadows";
 }
 
-void CascadeShadows::initBuffers(Context& context) {
+void CascadeShadows::initBuffers([[maybe_unused]] Context& context) {
     TextureBuilder builder;
     auto depth = builder.setTarget(Texture::Type::Tex2DArray)
                         .setInternalFormat(Texture::InternalFormat::Depth16)
@@ -51,14 +50,6 @@ void CascadeShadows::initBuffers(Context& context) {
     framebuffer->readBuffer(FramebufferAttachment::None);
     framebuffer->checkStatus();
     framebuffer->unbind();
-
-
-    BufferBuilder buffer_builder;
-    light_buffer = buffer_builder .setTarget(Buffer::Type::ShaderStorage)
-                                  .setUsage(Buffer::Usage::DynamicDraw)
-                                  .setAccess(Buffer::MutableAccess::WriteOrphaning)
-                                  .setDataSize(sizeof(glm::mat4) * split_count)
-                                  .build(DIRECTIONAL_CSM_BUFFER_NAME, context);
 }
 
 CascadeShadows::CascadeShadows(Context& context, const RenderSettings& settings)
@@ -223,24 +214,28 @@ void CascadeShadows::draw(Instances& instances,
     framebuffer->unbind();
 }
 
-void CascadeShadows::setUniform(ShaderProgram& shader) const {
-	if (auto* ctx = ContextState::getState(glfwGetCurrentContext()); ctx) {
-		light_buffer->bindBase(ctx->getIndexedBuffers().getBindingPoint(IndexedBuffer::Type::ShaderStorage, DIRECTIONAL_CSM_BUFFER_NAME));
-	}
+const std::shared_ptr<Texture>& CascadeShadows::getShadowMap() const {
+    return framebuffer->get(FramebufferAttachment::Depth).texture;
+}
 
-    shader << UniformSampler{"_dir_shadows", framebuffer->get(FramebufferAttachment::Depth).texture};
+void CascadeShadows::upload(Context& ctx) const {
+    // std140: vec4 _far_bounds followed by mat4 _dir_light_space[]
+    auto& ring = ctx.getFrameRing();
+    const auto allocation = ring.allocate(Buffer::Type::ShaderStorage, sizeof(glm::vec4) + sizeof(glm::mat4) * split_count);
 
-    // TODO: ?
-    glm::vec4 bounds {0.0f};
-    for (uint32_t i = 0; i < split_count; ++i) {
-        bounds[i] = far_bounds[i];
+    auto* bounds = allocation.as<glm::vec4>();
+    *bounds = glm::vec4{0.0f};
+    for (uint32_t i = 0; i < split_count && i < 4; ++i) {
+        (*bounds)[i] = far_bounds[i];
     }
 
-    shader << UniformValue{"_far_bounds", bounds};
-}
+    // matrices are missing until first frame with directional light
+    auto* matrices = reinterpret_cast<glm::mat4*>(allocation.data + sizeof(glm::vec4));
+    for (uint32_t i = 0; i < split_count; ++i) {
+        matrices[i] = i < light_space.size() ? light_space[i] : glm::mat4{1.0f};
+    }
 
-void CascadeShadows::mapData() const {
-    light_buffer->mapData(light_space.data(), light_space.size() * sizeof(glm::mat4));
+    ring.bind(allocation, Buffer::Type::ShaderStorage, ctx.getIndexedBuffers().getBindingPoint(IndexedBuffer::Type::ShaderStorage, DIRECTIONAL_CSM_BUFFER_NAME));
 }
 
 void CascadeShadows::update(Context& ctx, const RenderSettings& settings) {
@@ -252,9 +247,3 @@ void CascadeShadows::update(Context& ctx, const RenderSettings& settings) {
     frustums.resize(split_count);
     far_bounds.resize(split_count);
 }
-
-CascadeShadows::~CascadeShadows() {
-    if (auto* ctx = ContextState::getState(glfwGetCurrentContext()); ctx) {
-        ctx->getIndexedBuffers().remove(DIRECTIONAL_CSM_BUFFER_NAME, light_buffer);
-    }
-}
@@ -4,10 +4,30 @@
 #include <limitless/loaders/texture_loader.hpp>
 #include <limitless/loaders/material_loader.hpp>
 #include <limitless/loaders/effect_loader.hpp>
+#include <limitless/loaders/baked_model_loader.hpp>
+#include <limitless/loaders/asset_pack.hpp>
+#include <limitless/loaders/dds_loader.hpp>
+#include <limitless/loaders/texture_compressor.hpp>
+#include <limitless/core/upload_staging.hpp>
+#include <limitless/core/gpu_memory.hpp>
+#include <limitless/instances/effect_instance.hpp>
+#include <limitless/ms/material.hpp>
 #include <limitless/assets.hpp>
+#include <utility>
 
 using namespace Limitless;
 
+namespace {
+    size_t getMeshBytes() noexcept {
+        return GpuMemory::getUsage(GpuMemory::Category::VertexBuffer).bytes + GpuMemory::getUsage(GpuMemory::Category::IndexBuffer).bytes;
+    }
+
+    // budget is spent on bytes that are uploaded, not on file size
+    size_t getUploadBytes(const ByteSource& dds, const TextureLoaderFlags& flags) {
+        return DDSLoader::parse(dds, flags).getByteCount(0);
+    }
+}
+
 fs::path Limitless::getAssetsDir() {
     return ENGINE_ASSETS_DIR;
 }
@@ -18,31 +38,138 @@ fs::path Limitless::getShadersDir() {
 
 AssetManager::AssetManager(Context& _context, Assets& _assets, uint32_t pool_size)
     : pool {_context, pool_size}
-    , assets {_assets} {
+    , assets {_assets}
+    , pipeline {pool_size}
+    , streamer {pipeline} {
 }
 
 AssetManager::~AssetManager() {
     wait();
 }
 
-void AssetManager::loadTexture(fs::path path, const TextureLoaderFlags& flags) {
-    auto load_texture = [&, path = std::move(path), fl = flags] () {
-        TextureLoader::load(assets, path, fl);
-    };
+void AssetManager::mount(std::shared_ptr<AssetPack> pack) {
+    assets.mount(std::move(pack));
+}
 
-    asset_futures.emplace_back(pool.add(std::move(load_texture)));
+UploadStaging& AssetManager::getStaging() {
+    if (!staging) {
+        staging = std::make_unique<UploadStaging>();
+    }
+    return *staging;
 }
 
-void AssetManager::loadModel(std::string asset_name, fs::path path, const ModelLoaderFlags& flags) {
-    auto load_model = [&, name = asset_name, path = std::move(path), fl = flags] () {
-        return ThreadedModelLoader::loadModel(assets, path, fl);
+AssetPipeline::Id AssetManager::loadTexture(fs::path path, const TextureLoaderFlags& flags) {
+    struct Loading {
+        std::unique_ptr<ByteSource> source;
+        DecodedTexture image;
+        // block compressed dds from compressor
+        std::unique_ptr<ByteSource> compressed;
+        // keys compressor entry; file stamp on disk does not tell anything about packed source
+        uint64_t stamp {};
     };
 
-    auto addition = [&, name = std::move(asset_name)] (future_model& future) {
-        assets.models.add(name, future.get()());
+    auto loading = std::make_shared<Loading>();
+    const auto name = path.string();
+    const auto& compressor = TextureLoader::getCompressor();
+
+    const auto io = pipeline.add(name, AssetStage::IO, [this, loading, path, flags, compressor] {
+        if (compressor && path.extension() != ".dds") {
+            loading->stamp = assets.isPacked(path) ? assets.getPack()->getStamp(path.lexically_relative(getAssetsDir())) : TextureCompressor::getFileStamp(path);
+            loading->compressed = compressor->find(convertPathSeparators(path), flags, loading->stamp);
+        }
+
+        if (!loading->compressed) {
+            loading->source = assets.open(path);
+        }
+    });
+
+    if (path.extension() == ".dds" && flags.streaming) {
+        return pipeline.upload(name, [this, loading, flags] {
+            const auto resident = streamer.getStats().resident_bytes;
+            streamer.load(assets, std::move(loading->source), flags);
+            return streamer.getStats().resident_bytes - resident;
+        }, {io});
+    }
+
+    // dds is uploaded as is, level by level
+    if (path.extension() == ".dds") {
+        return pipeline.upload(name, [this, loading, flags] {
+            const auto source = std::exchange(loading->source, nullptr);
+            DDSLoader::load(assets, *source, flags);
+            return getUploadBytes(*source, flags);
+        }, {io});
+    }
+
+    // cache misses are encoded on workers, blocks are uploaded as is
+    const auto decode = pipeline.add(name, AssetStage::Decode, [loading, flags, compressor] {
+        if (loading->compressed) {
+            return;
+        }
+
+        loading->image = TextureLoader::decode(*loading->source, flags);
+        loading->source.reset();
+
+        if (compressor) {
+            loading->compressed = compressor->compress(loading->image, flags, loading->stamp);
+        }
+
+        if (loading->compressed) {
+            loading->image = {};
+        }
+    }, {io});
+
+    return pipeline.upload(name, [this, loading, flags] {
+        if (loading->compressed) {
+            const auto compressed = std::exchange(loading->compressed, nullptr);
+            DDSLoader::load(assets, *compressed, TextureCompressor::getLoadFlags(flags));
+            return getUploadBytes(*compressed, TextureCompressor::getLoadFlags(flags));
+        }
+
+        TextureLoader::upload(assets, loading->image, flags, getStaging());
+        return std::exchange(loading->image, {}).getTotalByteCount();
+    }, {decode});
+}
+
+AssetPipeline::Id AssetManager::loadModel(std::string asset_name, fs::path path, const ModelLoaderFlags& flags, const Dependencies& dependencies) {
+    using model_builder = std::function<std::shared_ptr<AbstractModel>()>;
+
+    auto builder = std::make_shared<model_builder>();
+    // counts vertex and index buffers created on upload
+    auto add_model = [this, builder, name = asset_name] {
+        const auto uploaded = getMeshBytes();
+        assets.models.add(name, (*builder)());
+        *builder = nullptr;
+        return getMeshBytes() - uploaded;
     };
 
-    model_futures.emplace_back(model_postproc{pool.add(std::move(load_model)), std::move(addition)});
+    // packed cache is read on worker, GL objects are created on upload; stale one is imported again
+    const auto io = pipeline.add(asset_name, AssetStage::IO, [this, builder, path, flags] {
+        const auto baked = BakedModelLoader::getBakedPath(path);
+        if (!flags.isPresent(ModelLoaderOption::Baked) || !assets.isPacked(baked)) {
+            return;
+        }
+
+        std::optional<uint64_t> source_size;
+        if (assets.isPacked(path)) {
+            source_size = assets.getPack()->at(path.lexically_relative(getAssetsDir())).original_size;
+        } else if (std::error_code error; fs::is_regular_file(path, error)) {
+            source_size = fs::file_size(path, error);
+        }
+
+        std::shared_ptr<ByteSource> source = assets.open(baked);
+        if (!BakedModelLoader::isStale(*source, flags, source_size)) {
+            *builder = [this, source] { return BakedModelLoader::load(assets, *source); };
+        }
+    }, dependencies);
+
+    // assimp import loads materials and textures, so it runs on worker with GL context
+    const auto decode = pipeline.add(asset_name, AssetStage::Decode, [this, builder, path = std::move(path), flags] {
+        if (!*builder) {
+            *builder = ThreadedModelLoader::loadModel(assets, path, flags);
+        }
+    }, {io}, &pool);
+
+    return pipeline.upload(std::move(asset_name), std::move(add_model), {decode});
 }
 
 bool AssetManager::isDone() {
@@ -57,9 +184,7 @@ bool AssetManager::isDone() {
         }
     }
 
-    return std::all_of(model_futures.begin(), model_futures.end(), [] (auto& post) {
-        return post.future.wait_for(0ns) == std::future_status::ready;
-    });
+    return pipeline.isDone();
 }
 
 void AssetManager::wait() {
@@ -68,26 +193,21 @@ void AssetManager::wait() {
         future.get();
     }
 
-    for (auto& [future, addition] : model_futures) {
-        future.wait();
-        addition(future);
-    }
-
     asset_futures.clear();
-    model_futures.clear();
+
+    pipeline.wait();
+
+    if (staging) {
+        staging->flush();
+    }
 }
 
 void AssetManager::doDelayedJob() {
-    using namespace std::chrono;
-    for (auto it = model_futures.begin(); it != model_futures.end();) {
-        auto& [future, addition] = *it;
+    streamer.update();
+    pipeline.update();
 
-        if (future.wait_for(0ms) == std::future_status::ready) {
-            addition(future);
-            it = model_futures.erase(it);
-        } else {
-            ++it;
-        }
+    if (staging) {
+        staging->flush();
     }
 }
 
@@ -95,20 +215,44 @@ void AssetManager::build(std::function<void()> f) {
     asset_futures.emplace_back(pool.add(std::move(f)));
 }
 
-void AssetManager::loadMaterial(std::string asset_name, fs::path path) {
-    auto load_material = [&, name = std::move(asset_name), path = std::move(path)] () {
-        assets.materials.add(name, MaterialLoader::load(assets, path));
-    };
+AssetPipeline::Id AssetManager::loadMaterial(std::string asset_name, fs::path path, const Dependencies& dependencies) {
+    auto source = std::make_shared<std::unique_ptr<ByteSource>>();
+
+    const auto io = pipeline.add(asset_name, AssetStage::IO, [this, source, path = std::move(path)] {
+        *source = assets.open(path);
+    }, dependencies);
+
+    // deserialization creates textures and material buffers, so it runs on worker with GL context
+    auto material = std::make_shared<std::shared_ptr<ms::Material>>();
+    const auto decode = pipeline.add(asset_name, AssetStage::Decode, [this, source, material] {
+        *material = MaterialLoader::load(assets, **source);
+        source->reset();
+    }, {io}, &pool);
 
-    asset_futures.emplace_back(pool.add(std::move(load_material)));
+    // nothing is left to upload on main context
+    return pipeline.upload(asset_name, [this, material, name = asset_name] {
+        assets.materials.add(name, std::exchange(*material, nullptr));
+        return size_t {};
+    }, {decode});
 }
 
-void AssetManager::loadEffect(std::string asset_name, fs::path path) {
-    auto load_effect = [&, name = std::move(asset_name), path = std::move(path)] () {
-        assets.effects.add(name, EffectLoader::load(assets, path));
-    };
+AssetPipeline::Id AssetManager::loadEffect(std::string asset_name, fs::path path, const Dependencies& dependencies) {
+    auto source = std::make_shared<std::unique_ptr<ByteSource>>();
+
+    const auto io = pipeline.add(asset_name, AssetStage::IO, [this, source, path = std::move(path)] {
+        *source = assets.open(path);
+    }, dependencies);
+
+    auto effect = std::make_shared<std::shared_ptr<EffectInstance>>();
+    const auto decode = pipeline.add(asset_name, AssetStage::Decode, [this, source, effect] {
+        *effect = EffectLoader::load(assets, **source);
+        source->reset();
+    }, {io}, &pool);
 
-    asset_futures.emplace_back(pool.add(std::move(load_effect)));
+    return pipeline.upload(asset_name, [this, effect, name = asset_name] {
+        assets.effects.add(name, std::exchange(*effect, nullptr));
+        return size_t {};
+    }, {decode});
 }
 
 void AssetManager::compileShaders(Context& ctx, const RenderSettings& settings) {
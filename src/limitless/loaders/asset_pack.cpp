@@ -0,0 +1,197 @@
+#include <limitless/loaders/asset_pack.hpp>
+
+#include <limitless/util/compression.hpp>
+#include <limitless/util/bytebuffer.hpp>
+#include <limitless/util/hash.hpp>
+
+#include <fstream>
+#include <cstring>
+
+using namespace Limitless;
+
+namespace {
+    struct PackHeader {
+        uint32_t magic;
+        uint32_t version;
+        uint32_t entry_count;
+        uint32_t alignment;
+        uint64_t index_size;
+    };
+
+    // entries that do not shrink at least by this ratio are stored as is
+    constexpr auto MIN_COMPRESSION_RATIO = 0.9;
+
+    uint64_t align(uint64_t offset, uint64_t alignment) noexcept {
+        return (offset + alignment - 1) / alignment * alignment;
+    }
+}
+
+AssetPack::AssetPack(const fs::path& _path)
+    : file {std::make_shared<MappedFile>(_path)}
+    , path {_path} {
+    if (file->getSize() < sizeof(PackHeader)) {
+        throw asset_pack_error("Asset pack is truncated: " + path.string());
+    }
+
+    PackHeader header {};
+    std::memcpy(&header, file->getData(), sizeof(PackHeader));
+
+    if (header.magic != MAGIC) {
+        throw asset_pack_error("It is not an asset pack: " + path.string());
+    }
+
+    if (header.version != VERSION) {
+        throw asset_pack_error("Wrong asset pack version! " + std::to_string(VERSION) + " vs " + std::to_string(header.version));
+    }
+
+    // sizes are compared against remaining bytes, so corrupted values cannot overflow
+    if (header.index_size > file->getSize() - sizeof(PackHeader)) {
+        throw asset_pack_error("Asset pack index is truncated: " + path.string());
+    }
+
+    auto index = ByteBuffer::view(file->getData() + sizeof(PackHeader), header.index_size);
+
+    entries.reserve(header.entry_count);
+    for (uint32_t i = 0; i < header.entry_count; ++i) {
+        std::string name;
+        Entry entry {};
+        index >> name >> entry;
+
+        if (entry.offset > file->getSize() || entry.size > file->getSize() - entry.offset) {
+            throw asset_pack_error("Asset pack entry is out of range: " + name);
+        }
+
+        entries.emplace(std::move(name), entry);
+    }
+
+    std::error_code error;
+    const uint64_t size = file->getSize();
+    const int64_t time = fs::last_write_time(path, error).time_since_epoch().count();
+    stamp = hashBytes(&time, sizeof(time), hashBytes(&size, sizeof(size)));
+}
+
+std::string AssetPack::getEntryName(const fs::path& name) {
+    auto str = name.generic_string();
+    std::replace(str.begin(), str.end(), WIN_PATH_SEPARATOR_CHAR, UNIX_PATH_SEPARATOR_CHAR);
+    return str;
+}
+
+bool AssetPack::contains(const fs::path& name) const {
+    return entries.find(getEntryName(name)) != entries.end();
+}
+
+const AssetPack::Entry& AssetPack::at(const fs::path& name) const {
+    try {
+        return entries.at(getEntryName(name));
+    } catch (...) {
+        throw asset_pack_error("No such entry in asset pack: " + getEntryName(name));
+    }
+}
+
+uint64_t AssetPack::getStamp(const fs::path& name) const {
+    const auto& entry = at(name);
+    const uint64_t values[] = {entry.offset, entry.size, entry.original_size, static_cast<uint64_t>(entry.compression)};
+    return hashBytes(values, sizeof(values), stamp);
+}
+
+std::unique_ptr<ByteSource> AssetPack::open(const fs::path& name, const fs::path& _path) const {
+    const auto& entry = at(name);
+    const auto* data = file->getData() + entry.offset;
+    const auto& source_path = _path.empty() ? name : _path;
+
+    switch (entry.compression) {
+        case PackCompression::None:
+            return std::make_unique<ViewByteSource>(source_path, file, data, entry.size);
+        case PackCompression::LZ4: {
+            std::vector<std::byte> bytes(entry.original_size);
+            decompressLZ4(data, entry.size, bytes.data(), bytes.size());
+            return std::make_unique<MemoryByteSource>(source_path, std::move(bytes));
+        }
+    }
+
+    throw asset_pack_error("Unknown asset pack compression for " + getEntryName(name));
+}
+
+AssetPackBuilder& AssetPackBuilder::setAlignment(uint32_t _alignment) {
+    if (_alignment == 0) {
+        throw asset_pack_error("Asset pack alignment cannot be zero!");
+    }
+    alignment = _alignment;
+    return *this;
+}
+
+AssetPackBuilder& AssetPackBuilder::add(const fs::path& name, fs::path path, PackCompression compression) {
+    pending.push_back({AssetPack::getEntryName(name), std::move(path), compression});
+    return *this;
+}
+
+AssetPackBuilder& AssetPackBuilder::addDirectory(const fs::path& root, PackCompression compression) {
+    for (const auto& item : fs::recursive_directory_iterator(root)) {
+        if (item.is_regular_file()) {
+            add(fs::relative(item.path(), root), item.path(), compression);
+        }
+    }
+    return *this;
+}
+
+void AssetPackBuilder::build(const fs::path& path) {
+    // entries are fixed-size, so index size is known before any data is written
+    uint64_t index_size {};
+    for (const auto& item : pending) {
+        index_size += sizeof(size_t) + item.name.size() + sizeof(AssetPack::Entry);
+    }
+
+    std::ofstream stream;
+    stream.exceptions(std::ofstream::failbit | std::ofstream::badbit);
+    stream.open(path, std::ios::binary | std::ios::trunc);
+
+    const std::vector<char> padding(alignment, 0);
+    uint64_t written = sizeof(PackHeader) + index_size;
+    stream.seekp(static_cast<std::streamoff>(written));
+
+    std::vector<AssetPack::Entry> entries;
+    entries.reserve(pending.size());
+
+    for (const auto& [name, source, compression] : pending) {
+        const MappedFile file {source};
+
+        AssetPack::Entry entry {};
+        entry.original_size = file.getSize();
+        entry.compression = PackCompression::None;
+
+        std::vector<std::byte> compressed;
+        if (compression == PackCompression::LZ4) {
+            compressed = compressLZ4(file.getData(), file.getSize());
+            if (compressed.size() < file.getSize() * MIN_COMPRESSION_RATIO) {
+                entry.compression = PackCompression::LZ4;
+            }
+        }
+
+        const auto* data = entry.compression == PackCompression::LZ4 ? compressed.data() : file.getData();
+        entry.size = entry.compression == PackCompression::LZ4 ? compressed.size() : file.getSize();
+        entry.offset = align(written, alignment);
+
+        stream.write(padding.data(), static_cast<std::streamsize>(entry.offset - written));
+        stream.write(reinterpret_cast<const char*>(data), static_cast<std::streamsize>(entry.size));
+        written = entry.offset + entry.size;
+
+        entries.push_back(entry);
+    }
+
+    ByteBuffer index;
+    index.reserve(index_size);
+    for (size_t i = 0; i < pending.size(); ++i) {
+        index << pending[i].name << entries[i];
+    }
+
+    PackHeader header {};
+    header.magic = AssetPack::MAGIC;
+    header.version = AssetPack::VERSION;
+    header.entry_count = static_cast<uint32_t>(entries.size());
+    header.alignment = alignment;
+    header.index_size = index.size();
+
+    stream.seekp(0);
+    stream.write(reinterpret_cast<const char*>(&header), sizeof(PackHeader));
+    stream.write(reinterpret_cast<const char*>(index.data()), static_cast<std::streamsize>(index.size()));
+}
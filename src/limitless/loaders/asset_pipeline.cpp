@@ -0,0 +1,289 @@
+#include <limitless/loaders/asset_pipeline.hpp>
+
+#include <limitless/core/profiler.hpp>
+
+#include <utility>
+
+using namespace Limitless;
+
+AssetPipeline::AssetPipeline(uint32_t pool_size)
+    : workers {pool_size} {
+}
+
+AssetPipeline::Id AssetPipeline::add(std::string name, AssetStage stage, Task task, const std::vector<Id>& dependencies, ThreadPool* pool) {
+    if (stage == AssetStage::Upload) {
+        throw asset_pipeline_error("Upload job has to be added with upload(): " + name);
+    }
+
+    return emplace(std::move(name), stage, std::move(task), nullptr, dependencies, pool);
+}
+
+AssetPipeline::Id AssetPipeline::upload(std::string name, UploadTask task, const std::vector<Id>& dependencies) {
+    return emplace(std::move(name), AssetStage::Upload, nullptr, std::move(task), dependencies, nullptr);
+}
+
+AssetPipeline::Id AssetPipeline::emplace(std::string name, AssetStage stage, Task task, UploadTask upload, const std::vector<Id>& dependencies, ThreadPool* pool) {
+    std::unique_lock lock {mutex};
+
+    const auto id = static_cast<Id>(jobs.size());
+
+    for (const auto dependency : dependencies) {
+        if (dependency >= id) {
+            throw asset_pipeline_error("Unknown dependency " + std::to_string(dependency) + " of " + name);
+        }
+    }
+
+    auto& job = jobs.emplace_back();
+    job.name = std::move(name);
+    job.stage = stage;
+    job.task = std::move(task);
+    job.upload = std::move(upload);
+    job.pool = pool;
+
+    ++stats[static_cast<size_t>(stage)].total;
+
+    bool failed {};
+    for (const auto dependency : dependencies) {
+        auto& parent = jobs[dependency];
+        switch (parent.state) {
+            case State::Done:
+                break;
+            case State::Failed:
+                failed = true;
+                break;
+            case State::Waiting:
+            case State::Queued:
+                parent.dependents.push_back(id);
+                ++job.pending;
+                break;
+        }
+    }
+
+    if (failed) {
+        // dependents registered in parents are skipped because job is already failed
+        fail(id);
+    } else if (job.pending == 0) {
+        schedule(id);
+    }
+
+    return id;
+}
+
+void AssetPipeline::schedule(Id id) {
+    auto& job = jobs[id];
+    job.state = State::Queued;
+
+    if (job.stage == AssetStage::Upload) {
+        uploads.push_back(id);
+    } else {
+        (job.pool ? *job.pool : workers).add([this, id] { run(id); });
+    }
+}
+
+void AssetPipeline::run(Id id) {
+    Task task;
+    std::string name;
+    {
+        std::unique_lock lock {mutex};
+        task = std::move(jobs[id].task);
+        name = jobs[id].name;
+    }
+
+    std::exception_ptr exception;
+    const auto start = std::chrono::steady_clock::now();
+    try {
+        task();
+    } catch (...) {
+        exception = std::current_exception();
+    }
+    const auto stop = std::chrono::steady_clock::now();
+    const auto time = stop - start;
+    profiler.add(name, start, stop);
+
+    std::unique_lock lock {mutex};
+    finish(id, time, 0, exception);
+}
+
+size_t AssetPipeline::runUpload(Id id) {
+    UploadTask task;
+    std::string name;
+    {
+        std::unique_lock lock {mutex};
+        task = std::move(jobs[id].upload);
+        name = jobs[id].name;
+    }
+
+    std::exception_ptr exception;
+    size_t bytes {};
+    const auto start = std::chrono::steady_clock::now();
+    try {
+        bytes = task();
+    } catch (...) {
+        exception = std::current_exception();
+    }
+    const auto stop = std::chrono::steady_clock::now();
+    const auto time = stop - start;
+    profiler.add(name, start, stop);
+
+    std::unique_lock lock {mutex};
+    finish(id, time, bytes, exception);
+    return bytes;
+}
+
+void AssetPipeline::finish(Id id, std::chrono::nanoseconds time, size_t bytes, std::exception_ptr exception) {
+    auto& stage = stats[static_cast<size_t>(jobs[id].stage)];
+    stage.time += time;
+    stage.bytes += bytes;
+
+    if (exception) {
+        if (!error) {
+            error = exception;
+        }
+        fail(id);
+    } else {
+        jobs[id].state = State::Done;
+        ++stage.done;
+
+        for (const auto dependent : jobs[id].dependents) {
+            auto& job = jobs[dependent];
+            if (job.state == State::Waiting && --job.pending == 0) {
+                schedule(dependent);
+            }
+        }
+    }
+
+    settled.notify_all();
+}
+
+void AssetPipeline::fail(Id id) {
+    auto& job = jobs[id];
+    job.state = State::Failed;
+    job.task = nullptr;
+    job.upload = nullptr;
+    ++stats[static_cast<size_t>(job.stage)].failed;
+
+    for (const auto dependent : job.dependents) {
+        if (jobs[dependent].state == State::Waiting) {
+            fail(dependent);
+        }
+    }
+}
+
+bool AssetPipeline::isSettled() const noexcept {
+    uint32_t settled_count {};
+    uint32_t total {};
+    for (const auto& stage : stats) {
+        settled_count += stage.done + stage.failed;
+        total += stage.total;
+    }
+    return settled_count == total;
+}
+
+void AssetPipeline::rethrow() {
+    std::unique_lock lock {mutex};
+    if (error) {
+        std::rethrow_exception(std::exchange(error, nullptr));
+    }
+}
+
+void AssetPipeline::setUploadBudget(const UploadBudget& _budget) noexcept {
+    std::unique_lock lock {mutex};
+    budget = _budget;
+}
+
+size_t AssetPipeline::update() {
+    const auto start = std::chrono::steady_clock::now();
+    size_t uploaded {};
+
+    for (;;) {
+        Id id;
+        {
+            std::unique_lock lock {mutex};
+            if (uploads.empty()) {
+                break;
+            }
+
+            // first job is always run so that large uploads cannot stall the queue
+            if (uploaded != 0 && (uploaded >= budget.bytes || std::chrono::steady_clock::now() - start >= budget.time)) {
+                break;
+            }
+
+            id = uploads.front();
+            uploads.pop_front();
+        }
+
+        uploaded += runUpload(id);
+    }
+
+    rethrow();
+    return uploaded;
+}
+
+void AssetPipeline::wait() {
+    for (;;) {
+        Id id;
+        {
+            std::unique_lock lock {mutex};
+            settled.wait(lock, [&] { return !uploads.empty() || isSettled(); });
+
+            if (uploads.empty()) {
+                break;
+            }
+
+            id = uploads.front();
+            uploads.pop_front();
+        }
+
+        runUpload(id);
+    }
+
+    rethrow();
+}
+
+void AssetPipeline::reset() {
+    std::unique_lock lock {mutex};
+
+    if (!isSettled()) {
+        throw asset_pipeline_error("Asset pipeline cannot be reset while loading");
+    }
+
+    jobs.clear();
+    stats = {};
+}
+
+bool AssetPipeline::isDone() const {
+    std::unique_lock lock {mutex};
+    return isSettled();
+}
+
+bool AssetPipeline::isDone(Id id) const {
+    std::unique_lock lock {mutex};
+
+    if (id >= jobs.size()) {
+        throw asset_pipeline_error("Unknown asset job " + std::to_string(id));
+    }
+
+    return jobs[id].state == State::Done;
+}
+
+AssetPipeline::Progress AssetPipeline::getProgress() const {
+    std::unique_lock lock {mutex};
+
+    Progress progress;
+    for (const auto& stage : stats) {
+        progress.total += stage.total;
+        progress.done += stage.done;
+        progress.failed += stage.failed;
+    }
+    return progress;
+}
+
+AssetPipeline::StageStats AssetPipeline::getStats(AssetStage stage) const {
+    std::unique_lock lock {mutex};
+    return stats[static_cast<size_t>(stage)];
+}
+
+size_t AssetPipeline::getUploadQueueSize() const {
+    std::unique_lock lock {mutex};
+    return uploads.size();
+}
@@ -0,0 +1,49 @@
+#include <limitless/loaders/assimp_io.hpp>
+
+#include <limitless/util/byte_source.hpp>
+#include <limitless/assets.hpp>
+
+#include <assimp/MemoryIOWrapper.h>
+#include <cstring>
+
+using namespace Limitless;
+
+namespace {
+    // memory stream that keeps its source alive
+    class SourceIOStream final : public Assimp::MemoryIOStream {
+    private:
+        std::unique_ptr<ByteSource> source;
+    public:
+        explicit SourceIOStream(std::unique_ptr<ByteSource> _source)
+            : MemoryIOStream {reinterpret_cast<const uint8_t*>(_source->getData()), _source->getSize()}
+            , source {std::move(_source)} {
+        }
+    };
+}
+
+bool AssimpIOSystem::Exists(const char* file) const {
+    const auto path = convertPathSeparators(file);
+    std::error_code error;
+    return assets.isPacked(path) || fs::is_regular_file(path, error);
+}
+
+char AssimpIOSystem::getOsSeparator() const {
+    return PATH_SEPARATOR_CHAR;
+}
+
+Assimp::IOStream* AssimpIOSystem::Open(const char* file, const char* mode) {
+    if (std::strchr(mode, 'w') || std::strchr(mode, 'a')) {
+        return nullptr;
+    }
+
+    // importer reports missing file itself
+    try {
+        return new SourceIOStream(assets.open(convertPathSeparators(file)));
+    } catch (const std::exception&) {
+        return nullptr;
+    }
+}
+
+void AssimpIOSystem::Close(Assimp::IOStream* stream) {
+    delete stream;
+}
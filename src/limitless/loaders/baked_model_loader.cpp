@@ -0,0 +1,422 @@
+#include <limitless/loaders/baked_model_loader.hpp>
+
+#include <limitless/loaders/model_loader.hpp>
+#include <limitless/models/skeletal_model.hpp>
+#include <limitless/models/mesh.hpp>
+#include <limitless/core/skeletal_stream.hpp>
+#include <limitless/serialization/material_serializer.hpp>
+#include <limitless/util/byte_source.hpp>
+#include <limitless/util/bytebuffer.hpp>
+#include <limitless/ms/material.hpp>
+#include <limitless/assets.hpp>
+
+#include <fstream>
+#include <cstring>
+
+using namespace Limitless;
+
+namespace {
+    constexpr size_t ALIGNMENT = 16;
+
+    struct BakedModelHeader {
+        uint32_t magic;
+        uint32_t version;
+        // layout of engine structures at the time of bake
+        uint32_t vertex_size;
+        uint32_t keyframe_size;
+        // loader flags that affect the content
+        uint32_t options;
+        float scale_factor;
+        uint64_t source_size;
+        int64_t source_time;
+        uint32_t skeletal;
+        uint32_t padding;
+    };
+
+    static_assert(std::is_trivially_copyable_v<VertexNormalTangent>);
+    static_assert(std::is_trivially_copyable_v<VertexBoneWeight>);
+    static_assert(std::is_trivially_copyable_v<KeyFrame<glm::vec3>>);
+    static_assert(std::is_trivially_copyable_v<KeyFrame<glm::fquat>>);
+
+    uint32_t getOptionMask(const ModelLoaderFlags& flags) noexcept {
+        uint32_t mask {};
+        for (const auto& option : flags.options) {
+            if (option == ModelLoaderOption::Baked) {
+                continue;
+            }
+            mask |= 1u << static_cast<uint32_t>(option);
+        }
+        return mask;
+    }
+
+    BakedModelHeader makeHeader(const ModelLoaderFlags& flags) {
+        BakedModelHeader header {};
+        header.magic = BakedModelLoader::MAGIC;
+        header.version = BakedModelLoader::VERSION;
+        header.vertex_size = sizeof(VertexNormalTangent);
+        header.keyframe_size = sizeof(KeyFrame<glm::fquat>);
+        header.options = getOptionMask(flags);
+        header.scale_factor = flags.scale_factor;
+        return header;
+    }
+
+    BakedModelHeader makeHeader(const fs::path& source, const ModelLoaderFlags& flags) {
+        auto header = makeHeader(flags);
+        header.source_size = fs::file_size(source);
+        header.source_time = fs::last_write_time(source).time_since_epoch().count();
+        return header;
+    }
+
+    bool operator==(const BakedModelHeader& lhs, const BakedModelHeader& rhs) noexcept {
+        return lhs.magic == rhs.magic &&
+               lhs.version == rhs.version &&
+               lhs.vertex_size == rhs.vertex_size &&
+               lhs.keyframe_size == rhs.keyframe_size &&
+               lhs.options == rhs.options &&
+               lhs.scale_factor == rhs.scale_factor &&
+               lhs.source_size == rhs.source_size &&
+               lhs.source_time == rhs.source_time;
+    }
+
+    class BakedWriter {
+    private:
+        std::ofstream& stream;
+        size_t offset {};
+    public:
+        explicit BakedWriter(std::ofstream& _stream) noexcept : stream {_stream} {}
+
+        void write(const void* data, size_t size) {
+            stream.write(static_cast<const char*>(data), size);
+            offset += size;
+        }
+
+        template<typename T>
+        void write(const T& value) {
+            static_assert(std::is_trivially_copyable_v<T>);
+            write(&value, sizeof(T));
+        }
+
+        void write(const std::string& str) {
+            write(static_cast<uint64_t>(str.size()));
+            write(str.data(), str.size());
+        }
+
+        void align() {
+            static constexpr std::array<char, ALIGNMENT> zeros {};
+            if (const auto rest = offset % ALIGNMENT; rest != 0) {
+                write(zeros.data(), ALIGNMENT - rest);
+            }
+        }
+
+        template<typename T>
+        void writeArray(const std::vector<T>& array) {
+            write(static_cast<uint64_t>(array.size()));
+            align();
+            write(array.data(), array.size() * sizeof(T));
+        }
+    };
+
+    class BakedReader {
+    private:
+        const std::byte* data;
+        size_t size;
+        size_t position {};
+
+        [[nodiscard]] size_t remaining() const noexcept {
+            return position < size ? size - position : 0;
+        }
+
+        // count comes from file, so it is compared without overflowing position
+        void check(size_t count) const {
+            if (count > remaining()) {
+                throw model_loader_error("Baked model is truncated!");
+            }
+        }
+    public:
+        explicit BakedReader(const ByteSource& source) noexcept
+            : data {source.getData()}
+            , size {source.getSize()} {
+        }
+
+        template<typename T>
+        T read() {
+            static_assert(std::is_trivially_copyable_v<T>);
+            check(sizeof(T));
+            T value;
+            std::memcpy(&value, data + position, sizeof(T));
+            position += sizeof(T);
+            return value;
+        }
+
+        std::string readString() {
+            const auto length = read<uint64_t>();
+            check(length);
+            std::string str {reinterpret_cast<const char*>(data + position), length};
+            position += length;
+            return str;
+        }
+
+        std::pair<const std::byte*, size_t> readBytes() {
+            const auto length = read<uint64_t>();
+            check(length);
+            const auto* bytes = data + position;
+            position += length;
+            return {bytes, length};
+        }
+
+        void align() noexcept {
+            position = (position + ALIGNMENT - 1) / ALIGNMENT * ALIGNMENT;
+        }
+
+        // arrays are aligned in file, so they are used in place
+        template<typename T>
+        std::vector<T> readArray() {
+            const auto count = read<uint64_t>();
+            align();
+            if (count > remaining() / sizeof(T)) {
+                throw model_loader_error("Baked model is truncated!");
+            }
+            const auto* first = reinterpret_cast<const T*>(data + position);
+            position += count * sizeof(T);
+            return std::vector<T>(first, first + count);
+        }
+    };
+
+    void writeTree(BakedWriter& writer, const Tree<uint32_t>& tree) {
+        writer.write(*tree);
+        writer.write(static_cast<uint32_t>(tree.size()));
+        for (const auto& child : tree) {
+            writeTree(writer, child);
+        }
+    }
+
+    void readTree(BakedReader& reader, Tree<uint32_t>& tree) {
+        const auto count = reader.read<uint32_t>();
+        for (uint32_t i = 0; i < count; ++i) {
+            auto& child = tree.add(reader.read<uint32_t>());
+            readTree(reader, child);
+        }
+    }
+}
+
+fs::path BakedModelLoader::getBakedPath(const fs::path& source) {
+    auto path = source;
+    path += EXTENSION;
+    return path;
+}
+
+bool BakedModelLoader::isStale(const fs::path& baked, const fs::path& source, const ModelLoaderFlags& flags) {
+    std::error_code error;
+    if (!fs::exists(baked, error) || !fs::exists(source, error)) {
+        return true;
+    }
+
+    std::ifstream stream(baked, std::ios::binary);
+    BakedModelHeader header {};
+    if (!stream.read(reinterpret_cast<char*>(&header), sizeof(header))) {
+        return true;
+    }
+
+    return !(header == makeHeader(source, flags));
+}
+
+bool BakedModelLoader::isStale(const ByteSource& baked, const ModelLoaderFlags& flags, std::optional<uint64_t> source_size) {
+    BakedModelHeader header {};
+    if (baked.getSize() < sizeof(header)) {
+        return true;
+    }
+    std::memcpy(&header, baked.getData(), sizeof(header));
+
+    auto expected = makeHeader(flags);
+    expected.source_size = source_size.value_or(header.source_size);
+    expected.source_time = header.source_time;
+
+    return !(header == expected);
+}
+
+std::shared_ptr<AbstractModel> BakedModelLoader::load(Assets& assets, const fs::path& baked) {
+    return load(assets, FileByteSource {baked});
+}
+
+std::shared_ptr<AbstractModel> BakedModelLoader::load(Assets& assets, const ByteSource& source) {
+    BakedReader reader {source};
+
+    const auto header = reader.read<BakedModelHeader>();
+    if (header.magic != MAGIC || header.version != VERSION) {
+        throw model_loader_error("Wrong baked model format!");
+    }
+
+    const bool skeletal = header.skeletal != 0;
+    const auto name = reader.readString();
+
+    std::vector<std::shared_ptr<AbstractMesh>> meshes;
+    const auto mesh_count = reader.read<uint32_t>();
+    meshes.reserve(mesh_count);
+    for (uint32_t i = 0; i < mesh_count; ++i) {
+        auto mesh_name = reader.readString();
+        auto vertices = reader.readArray<VertexNormalTangent>();
+        auto indices = reader.readArray<uint32_t>();
+        auto weights = reader.readArray<VertexBoneWeight>();
+
+        if (assets.meshes.contains(mesh_name)) {
+            meshes.emplace_back(assets.meshes.at(mesh_name));
+            continue;
+        }
+
+        auto stream = skeletal ?
+            std::make_unique<SkinnedVertexStream<VertexNormalTangent>>(std::move(vertices), std::move(indices), std::move(weights), VertexStreamUsage::Static, VertexStreamDraw::Triangles) :
+            std::make_unique<IndexedVertexStream<VertexNormalTangent>>(std::move(vertices), std::move(indices), VertexStreamUsage::Static, VertexStreamDraw::Triangles);
+
+        auto mesh = std::make_shared<Mesh>(std::move(stream), std::move(mesh_name));
+        assets.meshes.add(mesh->getName(), mesh);
+        meshes.emplace_back(std::move(mesh));
+    }
+
+    // materials are referenced by name and deserialized only when not loaded yet
+    std::vector<std::shared_ptr<ms::Material>> materials;
+    const auto material_count = reader.read<uint32_t>();
+    materials.reserve(material_count);
+    for (uint32_t i = 0; i < material_count; ++i) {
+        const auto material_name = reader.readString();
+        const auto [bytes, size] = reader.readBytes();
+
+        if (assets.materials.contains(material_name)) {
+            materials.emplace_back(assets.materials.at(material_name));
+            continue;
+        }
+
+        auto buffer = ByteBuffer::view(bytes, size);
+
+        MaterialSerializer serializer;
+        materials.emplace_back(serializer.deserialize(assets, buffer));
+    }
+
+    if (!skeletal) {
+        return std::make_shared<Model>(std::move(meshes), std::move(materials), name);
+    }
+
+    std::vector<Bone> bones;
+    std::unordered_map<std::string, uint32_t> bone_map;
+    const auto bone_count = reader.read<uint32_t>();
+    bones.reserve(bone_count);
+    for (uint32_t i = 0; i < bone_count; ++i) {
+        auto bone_name = reader.readString();
+        const auto offset_matrix = reader.read<glm::mat4>();
+        auto& bone = bones.emplace_back(std::move(bone_name), offset_matrix);
+        bone.node_transform = reader.read<glm::mat4>();
+        bone_map.emplace(bone.name, i);
+    }
+
+    Tree<uint32_t> skeleton {reader.read<uint32_t>()};
+    readTree(reader, skeleton);
+
+    std::vector<Animation> animations;
+    const auto animation_count = reader.read<uint32_t>();
+    animations.reserve(animation_count);
+    for (uint32_t i = 0; i < animation_count; ++i) {
+        auto animation_name = reader.readString();
+        const auto duration = reader.read<double>();
+        const auto tps = reader.read<double>();
+
+        std::vector<AnimationNode> nodes;
+        const auto node_count = reader.read<uint32_t>();
+        nodes.reserve(node_count);
+        for (uint32_t j = 0; j < node_count; ++j) {
+            const auto bone_index = reader.read<uint32_t>();
+            auto positions = reader.readArray<KeyFrame<glm::vec3>>();
+            auto rotations = reader.readArray<KeyFrame<glm::fquat>>();
+            auto scales = reader.readArray<KeyFrame<glm::vec3>>();
+
+            nodes.emplace_back(std::move(positions), std::move(rotations), std::move(scales), bones.at(bone_index));
+        }
+
+        animations.emplace_back(std::move(animation_name), duration, tps, std::move(nodes));
+    }
+
+    const auto global_inverse = reader.read<glm::mat4>();
+
+    return std::make_shared<SkeletalModel>(std::move(meshes), std::move(materials), std::move(bones), std::move(bone_map), std::move(skeleton), std::move(animations), global_inverse, name);
+}
+
+void BakedModelLoader::save(const fs::path& baked, const fs::path& source, const AbstractModel& model, const ModelLoaderFlags& flags) {
+    const auto* skeletal = dynamic_cast<const SkeletalModel*>(&model);
+    const auto& simple = dynamic_cast<const Model&>(model);
+
+    // writes to temporary file first, so interrupted bake is never picked up
+    auto temporary = baked;
+    temporary += ".tmp";
+
+    {
+        std::ofstream stream;
+        stream.exceptions(std::ofstream::failbit | std::ofstream::badbit);
+        stream.open(temporary, std::ios::binary | std::ios::trunc);
+
+        BakedWriter writer {stream};
+
+        auto header = makeHeader(source, flags);
+        header.skeletal = skeletal != nullptr;
+        writer.write(header);
+        writer.write(model.getName());
+
+        writer.write(static_cast<uint32_t>(model.getMeshes().size()));
+        for (const auto& abstract_mesh : model.getMeshes()) {
+            const auto& mesh = dynamic_cast<const Mesh&>(*abstract_mesh);
+            const auto& vertex_stream = mesh.getVertexStream();
+
+            writer.write(mesh.getName());
+
+            if (const auto* skinned = dynamic_cast<const SkinnedVertexStream<VertexNormalTangent>*>(&vertex_stream); skinned) {
+                writer.writeArray(skinned->getVertices());
+                writer.writeArray(skinned->getIndices());
+                writer.writeArray(skinned->getBoneWeights());
+            } else if (const auto* indexed = dynamic_cast<const IndexedVertexStream<VertexNormalTangent>*>(&vertex_stream); indexed) {
+                writer.writeArray(indexed->getVertices());
+                writer.writeArray(indexed->getIndices());
+                writer.writeArray(std::vector<VertexBoneWeight>{});
+            } else {
+                throw model_loader_error("Mesh vertex stream cannot be baked!");
+            }
+        }
+
+        MaterialSerializer serializer;
+        writer.write(static_cast<uint32_t>(simple.getMaterials().size()));
+        for (const auto& material : simple.getMaterials()) {
+            auto buffer = serializer.serialize(*material);
+            writer.write(material->getName());
+            writer.write(static_cast<uint64_t>(buffer.size()));
+            writer.write(buffer.data(), buffer.size());
+        }
+
+        if (skeletal) {
+            const auto& bones = skeletal->getBones();
+            writer.write(static_cast<uint32_t>(bones.size()));
+            for (const auto& bone : bones) {
+                writer.write(bone.name);
+                writer.write(bone.offset_matrix);
+                writer.write(bone.node_transform);
+            }
+
+            writeTree(writer, skeletal->getSkeletonTree());
+
+            const auto& bone_map = skeletal->getBoneMap();
+            writer.write(static_cast<uint32_t>(skeletal->getAnimations().size()));
+            for (const auto& animation : skeletal->getAnimations()) {
+                writer.write(animation.name);
+                writer.write(animation.duration);
+                writer.write(animation.tps);
+
+                writer.write(static_cast<uint32_t>(animation.nodes.size()));
+                for (const auto& node : animation.nodes) {
+                    writer.write(bone_map.at(node.bone.name));
+                    writer.writeArray(node.positions);
+                    writer.writeArray(node.rotations);
+                    writer.writeArray(node.scales);
+                }
+            }
+
+            writer.write(skeletal->getGlobalInverseMatrix());
+        }
+    }
+
+    fs::rename(temporary, baked);
+}
@@ -2,7 +2,9 @@
 #include <limitless/loaders/texture_loader.hpp>
 #include <limitless/core/texture_builder.hpp>
 #include <limitless/util/filesystem.hpp>
-#include <fstream>
+#include <limitless/util/byte_source.hpp>
+#include <limitless/util/bytebuffer.hpp>
+#include <limitless/assets.hpp>
 #include <iostream>
 
 using namespace Limitless;
@@ -36,13 +38,54 @@ namespace {
         uint32_t dwReserved2[3];
     };
 
+    class DDSHEADERDXT10 {
+    public:
+        uint32_t dxgiFormat;
+        uint32_t resourceDimension;
+        uint32_t miscFlag;
+        uint32_t arraySize;
+        uint32_t miscFlags2;
+    };
+
     constexpr auto DDS_CODE = "DDS ";
     constexpr auto DXT1_CODE = 0x31545844;
     constexpr auto DXT3_CODE = 0x33545844;
     constexpr auto DXT5_CODE = 0x35545844;
-    constexpr auto BC5u_CODE = 808540228;
+    constexpr auto ATI1_CODE = 0x31495441;
+    constexpr auto ATI2_CODE = 0x32495441;
+    constexpr auto BC4U_CODE = 0x55344342;
+    constexpr auto BC5U_CODE = 0x55354342;
+    constexpr auto DX10_CODE = 0x30315844;
     constexpr auto DXT1_BLOCK_SIZE = 8;
     constexpr auto DXT5_BLOCK_SIZE = 16;
+
+    // DXGI_FORMAT values of block compressed formats
+    constexpr uint32_t DXGI_BC1_UNORM = 71;
+    constexpr uint32_t DXGI_BC1_UNORM_SRGB = 72;
+    constexpr uint32_t DXGI_BC3_UNORM = 77;
+    constexpr uint32_t DXGI_BC3_UNORM_SRGB = 78;
+    constexpr uint32_t DXGI_BC4_UNORM = 80;
+    constexpr uint32_t DXGI_BC5_UNORM = 83;
+    constexpr uint32_t DXGI_BC7_UNORM = 98;
+    constexpr uint32_t DXGI_BC7_UNORM_SRGB = 99;
+    constexpr uint32_t D3D10_RESOURCE_DIMENSION_TEXTURE2D = 3;
+
+    constexpr uint32_t DDSD_CAPS = 0x1;
+    constexpr uint32_t DDSD_HEIGHT = 0x2;
+    constexpr uint32_t DDSD_WIDTH = 0x4;
+    constexpr uint32_t DDSD_PIXELFORMAT = 0x1000;
+    constexpr uint32_t DDSD_MIPMAPCOUNT = 0x20000;
+    constexpr uint32_t DDSD_LINEARSIZE = 0x80000;
+    constexpr uint32_t DDPF_FOURCC = 0x4;
+    constexpr uint32_t DDSCAPS_COMPLEX = 0x8;
+    constexpr uint32_t DDSCAPS_TEXTURE = 0x1000;
+    constexpr uint32_t DDSCAPS_MIPMAP = 0x400000;
+
+    template<typename T>
+    void append(std::vector<std::byte>& out, const T& value) {
+        const auto* bytes = reinterpret_cast<const std::byte*>(&value);
+        out.insert(out.end(), bytes, bytes + sizeof(T));
+    }
 }
 
 std::size_t DDSLoader::getDXTByteCount(glm::uvec2 size, std::size_t block_size) noexcept {
@@ -50,14 +93,12 @@ std::size_t DDSLoader::getDXTByteCount(glm::uvec2 size, std::size_t block_size)
     return s.x * s.y * block_size;
 }
 
-void DDSLoader::loadLevel(std::shared_ptr<Texture>& texture, std::ifstream& fs, uint32_t level, int channels) {
-    const auto s = glm::clamp(texture->getSize() >> level, 1u, std::numeric_limits<uint32_t>::max());
-    const auto byte_count = getDXTByteCount(s, channels == 3 ? DXT1_BLOCK_SIZE : DXT5_BLOCK_SIZE);
-
-    auto* data = new uint8_t[byte_count];
-    fs.read(reinterpret_cast<char*>(data), byte_count);
-    texture->compressedImage(level, static_cast<glm::uvec2>(s), data, byte_count);
-    delete[] data;
+std::size_t DDSImage::getByteCount(uint32_t first_level) const noexcept {
+    std::size_t count {};
+    for (auto i = first_level; i < levels.size(); ++i) {
+        count += levels[i].byte_count;
+    }
+    return count;
 }
 
 std::shared_ptr<Texture> DDSLoader::load(Assets& assets, const fs::path& _path, const TextureLoaderFlags& flags) {
@@ -67,79 +108,151 @@ std::shared_ptr<Texture> DDSLoader::load(Assets& assets, const fs::path& _path,
         return assets.textures[path.stem().string()];
     }
 
-    std::ifstream fs;
-	fs.exceptions(std::ifstream::failbit | std::ifstream::badbit);
+    try {
+        return load(assets, *assets.open(path), flags);
+    } catch (const mapped_file_error& e) {
+        throw dds_loader_exception{"Cant open " + path.string()};
+    }
+}
 
-	try {
-		fs.open(path, std::ios::binary);
-	} catch (const std::exception& e) {
-		throw dds_loader_exception{"Cant open " + path.string()};
-	}
+DDSImage DDSLoader::parse(const ByteSource& source, const TextureLoaderFlags& flags) {
+    const auto& path = source.getPath();
+
+    // levels are read straight from the source memory
+    auto buffer = source.view();
 
     std::array<char, 4> code {0};
-    fs.read(code.data(), code.size());
+    DDSHEADER header {};
+
+    try {
+        buffer >> code >> header;
+    } catch (const bytebuffer_error& e) {
+        throw dds_loader_exception{"DDS file is truncated! " + path.string()};
+    }
+
     if (std::string(code.data(), code.size()) != DDS_CODE) {
         throw dds_loader_exception{"It is not a DDS file!"};
     }
 
-    DDSHEADER header {};
-    fs.read(reinterpret_cast<char*>(&header), sizeof(DDSHEADER));
+    DDSImage image {};
 
-    TextureBuilder builder;
-    builder .setTarget(Texture::Type::Tex2D);
+    std::size_t block_size {};
 
-    uint32_t channels {};
     switch (header.ddspf.dwFourCC) {
         case DXT1_CODE:
-	        flags.space == TextureLoaderFlags::Space::Linear ? builder.setInternalFormat(Texture::InternalFormat::RGBA_DXT1) : builder.setInternalFormat(Texture::InternalFormat::sRGBA_DXT1);
-            channels = 3;
+            image.internal_format = flags.space == TextureLoaderFlags::Space::Linear ? Texture::InternalFormat::RGBA_DXT1 : Texture::InternalFormat::sRGBA_DXT1;
+            block_size = DXT1_BLOCK_SIZE;
             break;
 	    case DXT3_CODE:
-		    flags.space == TextureLoaderFlags::Space::Linear ? builder.setInternalFormat(Texture::InternalFormat::RGBA_DXT3) : builder.setInternalFormat(Texture::InternalFormat::sRGBA_DXT3);
-		    channels = 4;
+            image.internal_format = flags.space == TextureLoaderFlags::Space::Linear ? Texture::InternalFormat::RGBA_DXT3 : Texture::InternalFormat::sRGBA_DXT3;
+            block_size = DXT5_BLOCK_SIZE;
 		    break;
         case DXT5_CODE:
-		    flags.space == TextureLoaderFlags::Space::Linear ? builder.setInternalFormat(Texture::InternalFormat::RGBA_DXT5) : builder.setInternalFormat(Texture::InternalFormat::sRGBA_DXT5);
-            channels = 4;
+            image.internal_format = flags.space == TextureLoaderFlags::Space::Linear ? Texture::InternalFormat::RGBA_DXT5 : Texture::InternalFormat::sRGBA_DXT5;
+            block_size = DXT5_BLOCK_SIZE;
+            break;
+        case ATI1_CODE:
+        case BC4U_CODE:
+            image.internal_format = Texture::InternalFormat::R_RGTC;
+            block_size = DXT1_BLOCK_SIZE;
+            break;
+        case ATI2_CODE:
+        case BC5U_CODE:
+            image.internal_format = Texture::InternalFormat::RG_RGTC;
+            block_size = DXT5_BLOCK_SIZE;
+            break;
+        // formats without legacy four character code are described by extended header
+        case DX10_CODE: {
+            DDSHEADERDXT10 extension {};
+
+            try {
+                buffer >> extension;
+            } catch (const bytebuffer_error& e) {
+                throw dds_loader_exception{"DDS file is truncated! " + path.string()};
+            }
+
+            switch (extension.dxgiFormat) {
+                case DXGI_BC1_UNORM:
+                case DXGI_BC1_UNORM_SRGB:
+                    image.internal_format = flags.space == TextureLoaderFlags::Space::Linear ? Texture::InternalFormat::RGBA_DXT1 : Texture::InternalFormat::sRGBA_DXT1;
+                    block_size = DXT1_BLOCK_SIZE;
+                    break;
+                case DXGI_BC3_UNORM:
+                case DXGI_BC3_UNORM_SRGB:
+                    image.internal_format = flags.space == TextureLoaderFlags::Space::Linear ? Texture::InternalFormat::RGBA_DXT5 : Texture::InternalFormat::sRGBA_DXT5;
+                    block_size = DXT5_BLOCK_SIZE;
+                    break;
+                case DXGI_BC4_UNORM:
+                    image.internal_format = Texture::InternalFormat::R_RGTC;
+                    block_size = DXT1_BLOCK_SIZE;
+                    break;
+                case DXGI_BC5_UNORM:
+                    image.internal_format = Texture::InternalFormat::RG_RGTC;
+                    block_size = DXT5_BLOCK_SIZE;
+                    break;
+                case DXGI_BC7_UNORM:
+                case DXGI_BC7_UNORM_SRGB:
+                    image.internal_format = flags.space == TextureLoaderFlags::Space::Linear ? Texture::InternalFormat::RGBA_BC7 : Texture::InternalFormat::sRGBA_BC7;
+                    block_size = DXT5_BLOCK_SIZE;
+                    break;
+                default:
+                    throw dds_loader_exception{"Unsupported DXGI format! " + std::to_string(extension.dxgiFormat)};
+            }
             break;
-    	case BC5u_CODE:
-		    builder.setInternalFormat(Texture::InternalFormat::RG_RGTC);
-		    channels = 4;
-    		break;
+        }
         default:
             throw dds_loader_exception{"Unsupported compression code. Contact the admin! " + std::to_string(header.ddspf.dwFourCC)};
     }
 
-	glm::uvec2 size = { header.dwWidth, header.dwHeight };
-	const auto downscale_level = static_cast<uint32_t>(flags.downscale);
-	const auto level = (downscale_level > header.dwMipMapCount - 1) ? header.dwMipMapCount - 1 : downscale_level;
-
-	if (flags.downscale != TextureLoaderFlags::DownScale::None) {
-		if (header.dwMipMapCount == 0) {
-			throw dds_loader_exception("Cant do dds texture downscaling w/o mipmaps in the file! " + path.string());
-		}
-
-		uint32_t byte_count = 0;
-		for (uint32_t i = 0; i < level; ++i) {
-			byte_count += getDXTByteCount(size, channels == 3 ? DXT1_BLOCK_SIZE : DXT5_BLOCK_SIZE);
-			size = size >> 1u;
-		}
-		fs.seekg(byte_count, std::ios_base::cur);
+    // zero mipmap count means single level
+    const auto level_count = std::max(header.dwMipMapCount, 1u);
+    glm::uvec2 size = { header.dwWidth, header.dwHeight };
+
+    image.levels.reserve(level_count);
+    for (uint32_t i = 0; i < level_count; ++i) {
+        const auto byte_count = getDXTByteCount(size, block_size);
+
+        try {
+            image.levels.push_back({size, buffer.skip(byte_count), byte_count});
+        } catch (const bytebuffer_error& e) {
+            throw dds_loader_exception{"DDS file is truncated! " + path.string()};
+        }
+
+        size = glm::max(size >> 1u, glm::uvec2{1u});
+    }
+
+    return image;
+}
+
+std::shared_ptr<Texture> DDSLoader::load(Assets& assets, const ByteSource& source, const TextureLoaderFlags& flags) {
+    auto path = convertPathSeparators(source.getPath());
+
+    if (assets.textures.contains(path.stem().string())) {
+        return assets.textures[path.stem().string()];
+    }
+
+    const auto image = parse(source, flags);
+
+	if (flags.downscale != TextureLoaderFlags::DownScale::None && image.levels.size() == 1) {
+        throw dds_loader_exception("Cant do dds texture downscaling w/o mipmaps in the file! " + path.string());
 	}
-	builder.setSize(size);
-	const auto byte_count = getDXTByteCount(size, channels == 3 ? DXT1_BLOCK_SIZE : DXT5_BLOCK_SIZE);
-	auto* data = new uint8_t[byte_count];
-	fs.read(reinterpret_cast<char*>(data), byte_count);
-	builder.setCompressedData(data, byte_count);
+
+    const auto first_level = std::min<uint32_t>(static_cast<uint32_t>(flags.downscale), image.levels.size() - 1);
+    const auto& first = image.levels[first_level];
+
+    TextureBuilder builder;
+    builder .setTarget(Texture::Type::Tex2D)
+            .setInternalFormat(image.internal_format)
+            .setSize(first.size)
+            .setCompressedData(first.data, first.byte_count);
 	TextureLoader::setTextureParameters(builder, flags);
 	builder.setPath(path);
 	auto texture = builder.buildMutable();
-	delete[] data;
 
     if (flags.mipmap) {
-        const auto mipmap_count = (level == header.dwMipMapCount - 1) ? 0 : (header.dwMipMapCount - 1) - level;
-        for (uint32_t i = 0; i < mipmap_count; ++i) {
-            loadLevel(texture, fs, i + 1, channels);
+        for (auto i = first_level + 1; i < image.levels.size(); ++i) {
+            const auto& level = image.levels[i];
+            texture->compressedImage(i - first_level, level.size, level.data, level.byte_count);
         }
     }
 
@@ -147,3 +260,71 @@ std::shared_ptr<Texture> DDSLoader::load(Assets& assets, const fs::path& _path,
     return texture;
 }
 
+std::vector<std::byte> DDSLoader::write(const DDSImage& image) {
+    uint32_t four_cc = DX10_CODE;
+    uint32_t dxgi_format {};
+    std::size_t block_size = DXT5_BLOCK_SIZE;
+
+    switch (image.internal_format) {
+        case Texture::InternalFormat::RGB_DXT1:
+        case Texture::InternalFormat::RGBA_DXT1:
+        case Texture::InternalFormat::sRGB_DXT1:
+        case Texture::InternalFormat::sRGBA_DXT1:
+            four_cc = DXT1_CODE;
+            block_size = DXT1_BLOCK_SIZE;
+            break;
+        case Texture::InternalFormat::RGBA_DXT5:
+        case Texture::InternalFormat::sRGBA_DXT5:
+            four_cc = DXT5_CODE;
+            break;
+        case Texture::InternalFormat::R_RGTC:
+            dxgi_format = DXGI_BC4_UNORM;
+            block_size = DXT1_BLOCK_SIZE;
+            break;
+        case Texture::InternalFormat::RG_RGTC:
+            dxgi_format = DXGI_BC5_UNORM;
+            break;
+        case Texture::InternalFormat::RGBA_BC7:
+            dxgi_format = DXGI_BC7_UNORM;
+            break;
+        case Texture::InternalFormat::sRGBA_BC7:
+            dxgi_format = DXGI_BC7_UNORM_SRGB;
+            break;
+        default:
+            throw dds_loader_exception{"Format cannot be written to DDS!"};
+    }
+
+    if (image.levels.empty()) {
+        throw dds_loader_exception{"DDS image has no levels!"};
+    }
+
+    const auto& first = image.levels.front();
+
+    DDSHEADER header {};
+    header.dwSize = sizeof(DDSHEADER);
+    header.dwFlags = DDSD_CAPS | DDSD_HEIGHT | DDSD_WIDTH | DDSD_PIXELFORMAT | DDSD_LINEARSIZE | (image.levels.size() > 1 ? DDSD_MIPMAPCOUNT : 0);
+    header.dwHeight = first.size.y;
+    header.dwWidth = first.size.x;
+    header.dwPitchOrLinearSize = static_cast<uint32_t>(getDXTByteCount(first.size, block_size));
+    header.dwMipMapCount = static_cast<uint32_t>(image.levels.size());
+    header.ddspf.dwSize = sizeof(DDSPIXELFORMAT);
+    header.ddspf.dwFlags = DDPF_FOURCC;
+    header.ddspf.dwFourCC = four_cc;
+    header.dwCaps1 = DDSCAPS_TEXTURE | (image.levels.size() > 1 ? DDSCAPS_COMPLEX | DDSCAPS_MIPMAP : 0);
+
+    std::vector<std::byte> out;
+    out.reserve(4 + sizeof(DDSHEADER) + sizeof(DDSHEADERDXT10) + image.getByteCount(0));
+
+    append(out, std::array<char, 4> {'D', 'D', 'S', ' '});
+    append(out, header);
+
+    if (four_cc == DX10_CODE) {
+        append(out, DDSHEADERDXT10 {dxgi_format, D3D10_RESOURCE_DIMENSION_TEXTURE2D, 0, 1, 0});
+    }
+
+    for (const auto& level : image.levels) {
+        out.insert(out.end(), level.data, level.data + level.byte_count);
+    }
+
+    return out;
+}
@@ -8,21 +8,18 @@
 #include <limitless/assets.hpp>
 #include <limitless/loaders/asset_manager.hpp>
 #include <limitless/util/bytebuffer.hpp>
+#include <limitless/util/byte_source.hpp>
 #include <limitless/instances/effect_instance.hpp>
 
 using namespace Limitless::fx;
 using namespace Limitless;
 
 std::shared_ptr<EffectInstance> EffectLoader::load(Assets& assets, const fs::path& _path) {
-    auto path = convertPathSeparators(_path);
-    std::ifstream stream(path, std::ios::binary | std::ios::ate);
-    stream.exceptions(std::ifstream::failbit | std::ifstream::badbit);
-
-    auto filesize = stream.tellg();
-    ByteBuffer buffer{static_cast<size_t>(filesize)};
+    return load(assets, *assets.open(convertPathSeparators(_path)));
+}
 
-    stream.seekg(0, std::ios::beg);
-    stream.read(buffer.cdata(), buffer.size());
+std::shared_ptr<EffectInstance> EffectLoader::load(Assets& assets, const ByteSource& source) {
+    auto buffer = source.view();
 
     std::shared_ptr<EffectInstance> effect;
     buffer >> AssetDeserializer<std::shared_ptr<EffectInstance>>{assets, effect};
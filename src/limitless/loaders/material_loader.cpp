@@ -4,28 +4,21 @@
 #include <fstream>
 
 #include <limitless/util/bytebuffer.hpp>
+#include <limitless/util/byte_source.hpp>
 #include <limitless/ms/material.hpp>
 #include <limitless/serialization/material_serializer.hpp>
 #include <limitless/loaders/asset_manager.hpp>
+#include <limitless/assets.hpp>
 
 using namespace Limitless;
 using namespace Limitless::ms;
 
 std::shared_ptr<ms::Material> MaterialLoader::load(Assets& assets, const fs::path& _path) {
-    auto path = convertPathSeparators(_path);
-    std::ifstream stream;
-    stream.exceptions(std::ifstream::failbit | std::ifstream::badbit);
-    try {
-	    stream.open(path, std::ios::binary | std::ios::ate);
-    } catch (const std::exception& e) {
-    	throw std::runtime_error("Failed to open " + path.string());
-    }
-
-    auto filesize = stream.tellg();
-    ByteBuffer buffer{static_cast<size_t>(filesize)};
-
-    stream.seekg(0, std::ios::beg);
-    stream.read(buffer.cdata(), buffer.size());
+    return load(assets, *assets.open(convertPathSeparators(_path)));
+}
+
+std::shared_ptr<ms::Material> MaterialLoader::load(Assets& assets, const ByteSource& source) {
+    auto buffer = source.view();
 
     std::shared_ptr<ms::Material> material;
     buffer >> AssetDeserializer<std::shared_ptr<ms::Material>>{assets, material};
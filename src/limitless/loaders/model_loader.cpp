@@ -1,5 +1,8 @@
 #include <limitless/loaders/model_loader.hpp>
 
+#include <limitless/loaders/baked_model_loader.hpp>
+#include <limitless/loaders/assimp_io.hpp>
+#include <limitless/util/byte_source.hpp>
 #include <limitless/ms/material_builder.hpp>
 #include <limitless/loaders/texture_loader.hpp>
 #include <limitless/models/skeletal_model.hpp>
@@ -19,6 +22,47 @@ using namespace Limitless;
 std::shared_ptr<AbstractModel> ModelLoader::loadModel(Assets& assets, const fs::path& _path, const ModelLoaderFlags& flags) {
     const auto path = convertPathSeparators(_path);
 
+    if (!flags.isPresent(ModelLoaderOption::Baked)) {
+        return importModel(assets, path, flags);
+    }
+
+    const auto baked = BakedModelLoader::getBakedPath(path);
+    if (!BakedModelLoader::isStale(baked, path, flags)) {
+        try {
+            return BakedModelLoader::load(assets, baked);
+        } catch (const std::exception& e) {
+            std::cerr << baked.string() << " is corrupted, reimporting: " << e.what() << std::endl;
+        }
+    }
+
+    auto model = importModel(assets, path, flags);
+
+    try {
+        BakedModelLoader::save(baked, path, *model, flags);
+    } catch (const std::exception& e) {
+        std::cerr << "Failed to bake " << path.string() << ": " << e.what() << std::endl;
+    }
+
+    return model;
+}
+
+void ModelLoader::bakeModel(Assets& assets, const fs::path& _path, const ModelLoaderFlags& flags) {
+    const auto path = convertPathSeparators(_path);
+    auto model = importModel(assets, path, flags);
+    BakedModelLoader::save(BakedModelLoader::getBakedPath(path), path, *model, flags);
+}
+
+std::shared_ptr<AbstractModel> ModelLoader::loadModel(Assets& assets, const ByteSource& source, const ModelLoaderFlags& flags) {
+    const auto path = convertPathSeparators(source.getPath());
+
+    if (path.extension() == BakedModelLoader::EXTENSION) {
+        return BakedModelLoader::load(assets, source);
+    }
+
+    return importModel(assets, path, flags, &source);
+}
+
+std::shared_ptr<AbstractModel> ModelLoader::importModel(Assets& assets, const fs::path& path, const ModelLoaderFlags& flags, const ByteSource* source) {
     Assimp::Importer importer;
     const aiScene* scene;
 
@@ -44,7 +88,16 @@ std::shared_ptr<AbstractModel> ModelLoader::loadModel(Assets& assets, const fs::
         scene_flags |= aiProcess_FlipWindingOrder;
     }
 
-    scene = importer.ReadFile(path.string().c_str(), scene_flags);
+    if (source) {
+        // external references (e.g. textures) are still resolved relative to the path
+        const auto hint = path.extension().string();
+        scene = importer.ReadFileFromMemory(source->getData(), source->getSize(), scene_flags, hint.empty() ? "" : hint.c_str() + 1);
+    } else {
+        if (assets.getPack()) {
+            importer.SetIOHandler(new AssimpIOSystem(assets));
+        }
+        scene = importer.ReadFile(path.string().c_str(), scene_flags);
+    }
 
     if (!scene || scene->mFlags & AI_SCENE_FLAGS_INCOMPLETE || !scene->mRootNode) {
         throw model_loader_error(importer.GetErrorString());
@@ -0,0 +1,233 @@
+#include <limitless/loaders/texture_compressor.hpp>
+
+#include <limitless/core/context_initializer.hpp>
+#include <limitless/loaders/dds_loader.hpp>
+#include <limitless/util/byte_source.hpp>
+#include <limitless/util/hash.hpp>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <thread>
+
+using namespace Limitless;
+
+namespace {
+    constexpr uint64_t COMPRESSOR_VERSION = 2;
+
+    constexpr auto S3TC_EXTENSION = "GL_EXT_texture_compression_s3tc";
+    constexpr auto BPTC_EXTENSION = "GL_ARB_texture_compression_bptc";
+    constexpr auto RGTC_EXTENSION = "GL_ARB_texture_compression_rgtc";
+
+    Texture::InternalFormat getInternalFormat(BlockFormat format, const TextureLoaderFlags& flags) noexcept {
+        const auto srgb = flags.space == TextureLoaderFlags::Space::sRGB;
+        switch (format) {
+            case BlockFormat::BC1: return srgb ? Texture::InternalFormat::sRGBA_DXT1 : Texture::InternalFormat::RGBA_DXT1;
+            case BlockFormat::BC3: return srgb ? Texture::InternalFormat::sRGBA_DXT5 : Texture::InternalFormat::RGBA_DXT5;
+            case BlockFormat::BC4: return Texture::InternalFormat::R_RGTC;
+            case BlockFormat::BC5: return Texture::InternalFormat::RG_RGTC;
+            case BlockFormat::BC7: return srgb ? Texture::InternalFormat::sRGBA_BC7 : Texture::InternalFormat::RGBA_BC7;
+        }
+        return Texture::InternalFormat::RGBA_BC7;
+    }
+}
+
+TextureCompressor::TextureCompressor(fs::path _directory, uint32_t threads)
+    : directory {std::move(_directory)}
+    , pool {threads} {
+    std::error_code error;
+    fs::create_directories(directory, error);
+}
+
+std::optional<BlockFormat> TextureCompressor::getBlockFormat(const TextureLoaderFlags& flags, int channels) {
+    const auto s3tc = ContextInitializer::isExtensionSupported(S3TC_EXTENSION);
+    const auto bptc = ContextInitializer::isExtensionSupported(BPTC_EXTENSION);
+    const auto rgtc = ContextInitializer::isExtensionSupported(RGTC_EXTENSION);
+
+    // same choice as TextureLoader makes for driver compression
+    switch (flags.compression) {
+        case TextureLoaderFlags::Compression::None:
+            break;
+        case TextureLoaderFlags::Compression::DXT1:
+            if ((channels == 3 || channels == 4) && s3tc) return BlockFormat::BC1;
+            break;
+        case TextureLoaderFlags::Compression::DXT5:
+            if (channels == 4 && s3tc) return BlockFormat::BC3;
+            break;
+        case TextureLoaderFlags::Compression::BC7:
+            if ((channels == 3 || channels == 4) && bptc) return BlockFormat::BC7;
+            break;
+        case TextureLoaderFlags::Compression::RGTC:
+            if (channels == 1 && rgtc) return BlockFormat::BC4;
+            if (channels == 2 && rgtc) return BlockFormat::BC5;
+            break;
+        case TextureLoaderFlags::Compression::Default:
+            if (channels == 1 && rgtc) return BlockFormat::BC4;
+            if (channels == 2 && rgtc) return BlockFormat::BC5;
+            if ((channels == 3 || channels == 4) && bptc) return BlockFormat::BC7;
+            if (channels == 3 && s3tc) return BlockFormat::BC1;
+            if (channels == 4 && s3tc) return BlockFormat::BC3;
+            break;
+    }
+
+    return std::nullopt;
+}
+
+TextureLoaderFlags TextureCompressor::getLoadFlags(const TextureLoaderFlags& flags) noexcept {
+    auto load_flags = flags;
+    load_flags.downscale = TextureLoaderFlags::DownScale::None;
+    return load_flags;
+}
+
+uint64_t TextureCompressor::getFileStamp(const fs::path& path) {
+    std::error_code error;
+    const uint64_t size = fs::file_size(path, error);
+    const int64_t time = fs::last_write_time(path, error).time_since_epoch().count();
+
+    auto stamp = hashBytes(&size, sizeof(size));
+    return hashBytes(&time, sizeof(time), stamp);
+}
+
+fs::path TextureCompressor::getEntryName(const fs::path& path, const TextureLoaderFlags& flags, uint64_t stamp) {
+    const auto add = [] (uint64_t hash, uint64_t value) {
+        return hashBytes(&value, sizeof(value), hash);
+    };
+
+    // support decides format of default compression
+    const uint64_t extensions = (ContextInitializer::isExtensionSupported(S3TC_EXTENSION) ? 1u : 0u)
+                              | (ContextInitializer::isExtensionSupported(BPTC_EXTENSION) ? 2u : 0u)
+                              | (ContextInitializer::isExtensionSupported(RGTC_EXTENSION) ? 4u : 0u);
+
+    auto key = hashString(path.lexically_normal().generic_string());
+    key = add(key, COMPRESSOR_VERSION);
+    key = add(key, stamp);
+    key = add(key, static_cast<uint64_t>(flags.compression));
+    key = add(key, static_cast<uint64_t>(flags.space));
+    key = add(key, static_cast<uint64_t>(flags.origin));
+    key = add(key, static_cast<uint64_t>(flags.downscale));
+    key = add(key, flags.mipmap);
+    key = add(key, static_cast<uint64_t>(flags.mip_filter));
+    key = add(key, extensions);
+
+    std::stringstream name;
+    name << std::hex << std::setw(16) << std::setfill('0') << key << ".dds";
+    return name.str();
+}
+
+std::unique_ptr<ByteSource> TextureCompressor::find(const fs::path& path, const TextureLoaderFlags& flags) {
+    return find(path, flags, getFileStamp(path));
+}
+
+std::unique_ptr<ByteSource> TextureCompressor::find(const fs::path& path, const TextureLoaderFlags& flags, uint64_t stamp) {
+    if (flags.compression == TextureLoaderFlags::Compression::None) {
+        return nullptr;
+    }
+
+    const auto entry = directory / getEntryName(path, flags, stamp);
+
+    std::error_code error;
+    if (!fs::exists(entry, error)) {
+        return nullptr;
+    }
+
+    try {
+        auto file = std::make_shared<MappedFile>(entry);
+        auto source = std::make_unique<ViewByteSource>(path, file, file->getData(), file->getSize());
+
+        // damaged entries are encoded again
+        DDSLoader::parse(*source, getLoadFlags(flags));
+
+        std::unique_lock lock {mutex};
+        ++stats.hits;
+        return source;
+    } catch (const std::exception&) {
+        fs::remove(entry, error);
+        return nullptr;
+    }
+}
+
+std::unique_ptr<ByteSource> TextureCompressor::compress(const DecodedTexture& image, const TextureLoaderFlags& flags) {
+    return compress(image, flags, getFileStamp(image.path));
+}
+
+std::unique_ptr<ByteSource> TextureCompressor::compress(const DecodedTexture& image, const TextureLoaderFlags& flags, uint64_t stamp) {
+    const auto format = getBlockFormat(flags, image.channels);
+    if (!format) {
+        return nullptr;
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    const auto channels = static_cast<uint32_t>(image.channels);
+
+    // encoded levels stay alive until file contents are assembled
+    std::vector<std::vector<std::byte>> blocks;
+    DDSImage dds {getInternalFormat(*format, flags), {}};
+    uint64_t pixel_count {};
+
+    // decode generates mips already; images made elsewhere may come without them
+    std::vector<MipLevel> generated;
+    const auto* mips = &image.mips;
+    if (flags.mipmap && image.mips.empty()) {
+        const auto srgb = flags.space == TextureLoaderFlags::Space::sRGB;
+        generated = generateMipChain(image.data.get(), image.width, image.height, channels, srgb, flags.mip_filter, &pool);
+        mips = &generated;
+    }
+
+    const auto encode = [&] (const uint8_t* pixels, uint32_t width, uint32_t height) {
+        blocks.push_back(compressImage(*format, pixels, width, height, channels, &pool));
+        dds.levels.push_back({{width, height}, blocks.back().data(), blocks.back().size()});
+        pixel_count += static_cast<uint64_t>(width) * height;
+    };
+
+    blocks.reserve(mips->size() + 1);
+    encode(image.data.get(), image.width, image.height);
+    if (flags.mipmap) {
+        for (const auto& mip : *mips) {
+            encode(mip.pixels.data(), mip.width, mip.height);
+        }
+    }
+
+    auto bytes = DDSLoader::write(dds);
+
+    // written through temporary file, so other processes never map partial entry;
+    // temporary name is unique per thread, so workers compressing the same texture do not write into one file
+    const auto entry = directory / getEntryName(image.path, flags, stamp);
+    auto temporary = entry;
+    temporary += "." + std::to_string(std::hash<std::thread::id>{}(std::this_thread::get_id())) + ".tmp";
+
+    bool written {};
+    {
+        std::ofstream file(temporary, std::ios::binary | std::ios::trunc);
+        file.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+        file.close();
+        written = static_cast<bool>(file);
+    }
+
+    // failed write only loses cache entry, encoded texture is still returned
+    std::error_code error;
+    if (written) {
+        fs::rename(temporary, entry, error);
+    }
+    if (!written || error) {
+        fs::remove(temporary, error);
+    }
+
+    {
+        std::unique_lock lock {mutex};
+        ++stats.misses;
+        stats.encode_time += std::chrono::steady_clock::now() - start;
+        stats.encoded_pixels += pixel_count;
+    }
+
+    return std::make_unique<MemoryByteSource>(image.path, std::move(bytes));
+}
+
+void TextureCompressor::clear() {
+    std::error_code error;
+    fs::remove_all(directory, error);
+    fs::create_directories(directory, error);
+}
+
+TextureCompressor::Stats TextureCompressor::getStats() const {
+    std::unique_lock lock {mutex};
+    return stats;
+}
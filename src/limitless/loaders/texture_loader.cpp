@@ -2,13 +2,15 @@
 
 #include <limitless/core/context_initializer.hpp>
 #include <limitless/core/texture_builder.hpp>
+#include <limitless/core/upload_staging.hpp>
 
 #define STB_IMAGE_IMPLEMENTATION
 #include <stb_image.h>
-#define STB_IMAGE_RESIZE_IMPLEMENTATION
-#include <stb_image_resize.h>
 #include <limitless/assets.hpp>
 #include <limitless/loaders/dds_loader.hpp>
+#include <limitless/loaders/texture_compressor.hpp>
+#include <limitless/util/byte_source.hpp>
+#include <limitless/util/thread_pool.hpp>
 
 #if GL_DEBUG
 	#include <iostream>
@@ -21,6 +23,24 @@ namespace {
     constexpr auto S3TC_EXTENSION = "GL_EXT_texture_compression_s3tc";
     constexpr auto BPTC_EXTENSION = "GL_ARB_texture_compression_bptc";
     constexpr auto RGTC_EXTENSION = "GL_ARB_texture_compression_rgtc";
+
+    // decode callers may run on pools themselves, so rows and faces are split on a pool of their own
+    ThreadPool& getPool() {
+        static ThreadPool pool {std::max(std::thread::hardware_concurrency(), 1u)};
+        return pool;
+    }
+
+    // rows of 1, 2 and 3 channel levels are tightly packed, so they are not aligned to default 4 bytes
+    void setUnpackAlignment(GLint alignment) noexcept {
+        glPixelStorei(GL_UNPACK_ALIGNMENT, alignment);
+    }
+
+    uint32_t getLevelCount(const DecodedTexture& image) {
+        if (!image.mips.empty()) {
+            return static_cast<uint32_t>(image.mips.size()) + 1;
+        }
+        return static_cast<uint32_t>(glm::floor(glm::log2(static_cast<float>(glm::max(image.width, image.height))))) + 1;
+    }
 }
 
 void TextureLoader::setFormat(TextureBuilder& builder, const TextureLoaderFlags& flags, int channels) {
@@ -145,10 +165,74 @@ std::shared_ptr<Texture> TextureLoader::load(Assets& assets, const fs::path& _pa
     	return DDSLoader::load(assets, path, flags);
     }
 
-    stbi_set_flip_vertically_on_load(static_cast<bool>((int)flags.origin));
+    try {
+        return load(assets, *assets.open(path), flags);
+    } catch (const mapped_file_error& e) {
+        throw std::runtime_error("Failed to load texture: " + path.string() + " " + e.what());
+    }
+}
+
+std::shared_ptr<Texture> TextureLoader::load(Assets& assets, const ByteSource& source, const TextureLoaderFlags& flags) {
+    auto path = convertPathSeparators(source.getPath());
+
+    if (assets.textures.contains(path.stem().string())) {
+        return assets.textures[path.stem().string()];
+    }
+
+    if (path.extension().string() == ".dds") {
+        return DDSLoader::load(assets, source, flags);
+    }
+
+    if (compressor) {
+        if (auto cached = compressor->find(path, flags)) {
+            return DDSLoader::load(assets, *cached, TextureCompressor::getLoadFlags(flags));
+        }
+    }
+
+    const auto image = decode(source, flags);
+
+    if (compressor) {
+        if (auto compressed = compressor->compress(image, flags)) {
+            return DDSLoader::load(assets, *compressed, TextureCompressor::getLoadFlags(flags));
+        }
+    }
+
+    TextureBuilder builder;
+
+    builder.setTarget(Texture::Type::Tex2D)
+           .setLevels(getLevelCount(image))
+           .setSize({ image.width, image.height })
+           .setDataType(Texture::DataType::UnsignedByte)
+           .setData(image.data.get())
+           .setPath(path);
+
+    setFormat(builder, flags, image.channels);
+    setTextureParameters(builder, flags);
+
+    // levels are already generated
+    if (!image.mips.empty()) {
+        builder.setMipMap(false);
+    }
+
+    setUnpackAlignment(1);
+    auto texture = builder.build();
+    setUnpackAlignment(4);
+
+    setAnisotropicFilter(texture, flags);
+    setMipLevels(*texture, image, nullptr);
+
+    assets.textures.add(path.stem().string(), texture);
+    return texture;
+}
+
+DecodedTexture TextureLoader::decode(const ByteSource& source, const TextureLoaderFlags& flags) {
+    auto path = convertPathSeparators(source.getPath());
+
+    // decode runs on many workers at once, so flip is not set process-wide
+    stbi_set_flip_vertically_on_load_thread(static_cast<bool>((int)flags.origin));
 
     int width = 0, height = 0, channels = 0;
-    unsigned char* data = stbi_load(path.string().c_str(), &width, &height, &channels, 0);
+    unsigned char* data = stbi_load_from_memory(reinterpret_cast<const stbi_uc*>(source.getData()), static_cast<int>(source.getSize()), &width, &height, &channels, 0);
 
     if (!data) {
 	    throw std::runtime_error("Failed to load texture: " + path.string() + " " + stbi_failure_reason());
@@ -160,50 +244,120 @@ std::shared_ptr<Texture> TextureLoader::load(Assets& assets, const fs::path& _pa
         }
 	#endif
 
-    setDownScale(width, height, channels, data, flags);
+    DecodedTexture image {path, width, height, channels, std::shared_ptr<unsigned char>(data, [] (unsigned char* ptr) { stbi_image_free(ptr); }), {}};
+
+    setDownScale(image, flags);
+
+    // generated here so that upload does not stall on driver mipmap generation
+    if (flags.mipmap) {
+        const auto srgb = flags.space == TextureLoaderFlags::Space::sRGB;
+        image.mips = generateMipChain(image.data.get(), image.width, image.height, image.channels, srgb, flags.mip_filter, &getPool());
+    }
+
+    return image;
+}
+
+std::shared_ptr<Texture> TextureLoader::upload(Assets& assets, const DecodedTexture& image, const TextureLoaderFlags& flags, UploadStaging& staging) {
+    const auto name = image.path.stem().string();
+
+    if (assets.textures.contains(name)) {
+        return assets.textures[name];
+    }
+
+    // driver compresses on upload, so compressed textures cannot be filled by sub image
+    const bool staged = flags.compression == TextureLoaderFlags::Compression::None;
 
     TextureBuilder builder;
 
     builder.setTarget(Texture::Type::Tex2D)
-           .setLevels(glm::floor(glm::log2(static_cast<float>(glm::max(width, height)))) + 1)
-           .setSize({ width, height })
+           .setLevels(getLevelCount(image))
+           .setSize({ image.width, image.height })
            .setDataType(Texture::DataType::UnsignedByte)
-           .setData(data)
-           .setPath(path);
+           .setData(staged ? nullptr : image.data.get())
+           .setPath(image.path);
 
-    setFormat(builder, flags, channels);
+    setFormat(builder, flags, image.channels);
     setTextureParameters(builder, flags);
 
+    if (!image.mips.empty()) {
+        builder.setMipMap(false);
+    }
+
+    setUnpackAlignment(1);
     auto texture = builder.build();
     setAnisotropicFilter(texture, flags);
 
-    if (flags.downscale != TextureLoaderFlags::DownScale::None) {
-        delete data;
-    } else {
-        stbi_image_free(data);
+    if (staged) {
+        staging.subImage(*texture, 0, {0, 0}, glm::uvec2{image.width, image.height}, image.data.get(), image.getByteCount());
+        if (texture->hasMipmap()) {
+            texture->generateMipMap();
+        }
     }
+    setUnpackAlignment(4);
 
-    assets.textures.add(path.stem().string(), texture);
+    setMipLevels(*texture, image, staged ? &staging : nullptr);
+
+    assets.textures.add(name, texture);
     return texture;
 }
 
-std::shared_ptr<Texture> TextureLoader::loadCubemap([[maybe_unused]] Assets& assets, const fs::path& _path, const TextureLoaderFlags& flags) {
+std::shared_ptr<Texture> TextureLoader::loadCubemap(Assets& assets, const fs::path& _path, const TextureLoaderFlags& flags) {
     auto path = convertPathSeparators(_path);
-
-    stbi_set_flip_vertically_on_load(static_cast<bool>((int)flags.origin));
+    const auto flip = static_cast<bool>((int)flags.origin);
 
     constexpr std::array ext = { "_right", "_left", "_top", "_bottom", "_front", "_back" };
 
+    struct Face {
+        unsigned char* data {};
+        int width {};
+        int height {};
+        int channels {};
+        // stb keeps failure reason per thread, so it is taken on worker
+        std::string error;
+    };
+
+    // faces are decoded in parallel
+    std::array<std::future<Face>, 6> faces;
+    for (size_t i = 0; i < faces.size(); ++i) {
+        std::string p = path.parent_path().string() + PATH_SEPARATOR + path.stem().string() + ext[i] + path.extension().string();
+        faces[i] = getPool().add([&assets, flip, p = std::move(p)] {
+            // flip is per thread, so it is set on worker that decodes face
+            stbi_set_flip_vertically_on_load_thread(flip);
+
+            Face face;
+            try {
+                const auto source = assets.open(p);
+                face.data = stbi_load_from_memory(reinterpret_cast<const stbi_uc*>(source->getData()), static_cast<int>(source->getSize()), &face.width, &face.height, &face.channels, 0);
+                if (!face.data) {
+                    const auto* reason = stbi_failure_reason();
+                    face.error = p + " " + (reason ? reason : "unknown error");
+                }
+            } catch (const std::exception& e) {
+                face.error = p + " " + e.what();
+            }
+            return face;
+        });
+    }
+
     std::array<void*, 6> data = { nullptr };
     int width = 0, height = 0, channels = 0;
+    std::string error;
 
-    for (size_t i = 0; i < data.size(); ++i) {
-        std::string p = path.parent_path().string() + PATH_SEPARATOR + path.stem().string() + ext[i] + path.extension().string();
-        data[i] = stbi_load(p.c_str(), &width, &height, &channels, 0);
-
-        if (!data[i]) {
-            throw std::runtime_error("Failed to load texture: " + path.string() + " " + stbi_failure_reason());
+    for (size_t i = 0; i < faces.size(); ++i) {
+        const auto face = faces[i].get();
+        data[i] = face.data;
+        if (!face.data && error.empty()) {
+            error = face.error;
         }
+
+        width = face.width;
+        height = face.height;
+        channels = face.channels;
+    }
+
+    if (!error.empty()) {
+        std::for_each(data.begin(), data.end(), [] (auto* ptr) { stbi_image_free(ptr); });
+        throw std::runtime_error("Failed to load texture: " + path.string() + " " + error);
     }
 
     TextureBuilder builder;
@@ -231,7 +385,7 @@ std::shared_ptr<Texture> TextureLoader::loadCubemap([[maybe_unused]] Assets& ass
 GLFWimage TextureLoader::loadGLFWImage([[maybe_unused]] Assets& assets, const fs::path& _path, const TextureLoaderFlags& flags) {
     auto path = convertPathSeparators(_path);
 
-    stbi_set_flip_vertically_on_load(static_cast<bool>(flags.origin));
+    stbi_set_flip_vertically_on_load_thread(static_cast<bool>(flags.origin));
 
     int width = 0, height = 0, channels = 0;
     unsigned char* data = stbi_load(path.string().c_str(), &width, &height, &channels, 0);
@@ -243,29 +397,41 @@ GLFWimage TextureLoader::loadGLFWImage([[maybe_unused]] Assets& assets, const fs
     }
 }
 
-void TextureLoader::setDownScale(int& width, int& height, int channels, unsigned char*& data, const TextureLoaderFlags& flags) {
-	if (flags.downscale == TextureLoaderFlags::DownScale::None) {
-		return;
-	}
+void TextureLoader::setDownScale(DecodedTexture& image, const TextureLoaderFlags& flags) {
+    const auto srgb = flags.space == TextureLoaderFlags::Space::sRGB;
 
-	if (!isPowerOfTwo(width, height)) {
-		throw texture_loader_exception("stbimage cannot resize not power of two texture!");
-	}
+    for (uint32_t i = 0; i < static_cast<uint32_t>(flags.downscale); ++i) {
+        auto mip = downsample(image.data.get(), image.width, image.height, image.channels, srgb, MipFilter::Box, &getPool());
 
-	int scaled_width, scaled_height;
-    unsigned char* resized_data;
+        // data points into vector that owns it
+        auto pixels = std::make_shared<std::vector<uint8_t>>(std::move(mip.pixels));
+        image.data = std::shared_ptr<unsigned char>(pixels, pixels->data());
+        image.width = static_cast<int>(mip.width);
+        image.height = static_cast<int>(mip.height);
+    }
+}
 
-    scaled_width = width >> static_cast<uint32_t>(flags.downscale);
-	scaled_height = height >> static_cast<uint32_t>(flags.downscale);
+void TextureLoader::setMipLevels(Texture& texture, const DecodedTexture& image, UploadStaging* staging) {
+    if (image.mips.empty()) {
+        return;
+    }
 
-    resized_data = new unsigned char[channels * scaled_height * scaled_width];
-    stbir_resize_uint8(data, width, height, 0, resized_data, scaled_width, scaled_height, 0, channels);
+    setUnpackAlignment(1);
 
-    width = scaled_width;
-    height = scaled_height;
+    for (uint32_t i = 0; i < image.mips.size(); ++i) {
+        const auto& mip = image.mips[i];
+        const glm::uvec2 size {mip.width, mip.height};
+
+        if (staging) {
+            staging->subImage(texture, i + 1, {0, 0}, size, mip.pixels.data(), mip.pixels.size());
+        } else if (texture.isMutable()) {
+            texture.image(i + 1, size, mip.pixels.data());
+        } else {
+            texture.subImage(i + 1, {0, 0}, size, mip.pixels.data());
+        }
+    }
 
-    stbi_image_free(data);
-    data = resized_data;
+    setUnpackAlignment(4);
 }
 
 void TextureLoader::setTextureParameters(TextureBuilder& builder, const TextureLoaderFlags& flags) {
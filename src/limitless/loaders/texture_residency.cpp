@@ -0,0 +1,179 @@
+#include <limitless/loaders/texture_residency.hpp>
+
+#include <algorithm>
+
+using namespace Limitless;
+
+size_t TextureResidency::Entry::getByteCount(uint32_t first) const noexcept {
+    size_t count {};
+    for (auto i = first; i < levels.size(); ++i) {
+        count += levels[i];
+    }
+    return count;
+}
+
+TextureResidency::TextureResidency(size_t _budget)
+    : budget {_budget} {
+}
+
+uint32_t TextureResidency::getLevel(glm::uvec2 size, uint32_t level_count, float screen_size) noexcept {
+    if (level_count == 0) {
+        return 0;
+    }
+
+    const auto texels = static_cast<float>(std::max(size.x, size.y));
+
+    // one texel per covered pixel
+    const auto mip = glm::floor(glm::log2(texels / std::max(screen_size, 1.0f)));
+    return static_cast<uint32_t>(glm::clamp(mip, 0.0f, static_cast<float>(level_count - 1)));
+}
+
+void TextureResidency::setResident(Entry& entry, uint32_t level) noexcept {
+    resident_bytes -= std::min(resident_bytes, entry.getByteCount(entry.resident));
+    resident_bytes += entry.getByteCount(level);
+    entry.resident = level;
+}
+
+void TextureResidency::add(Key key, std::vector<size_t> levels, uint32_t base) {
+    remove(key);
+
+    Entry entry {std::move(levels), base, base, base, 0, base, false};
+    resident_bytes += entry.getByteCount(base);
+    entries.emplace(key, std::move(entry));
+}
+
+void TextureResidency::remove(Key key) {
+    const auto it = entries.find(key);
+    if (it == entries.end()) {
+        return;
+    }
+
+    resident_bytes -= std::min(resident_bytes, it->second.getByteCount(it->second.resident));
+    if (it->second.loading) {
+        pending_bytes -= std::min(pending_bytes, it->second.getByteCount(it->second.promoted));
+    }
+    entries.erase(it);
+}
+
+void TextureResidency::request(Key key, uint32_t level) {
+    const auto it = entries.find(key);
+    if (it == entries.end()) {
+        return;
+    }
+
+    auto& entry = it->second;
+    level = std::min(level, static_cast<uint32_t>(entry.levels.size()) - 1);
+
+    if (entry.last_requested != frame) {
+        entry.last_requested = frame;
+        entry.wanted = level;
+    } else {
+        entry.wanted = std::min(entry.wanted, level);
+    }
+}
+
+void TextureResidency::evict(size_t limit, std::vector<Change>& changes) {
+    std::vector<std::pair<Key, Entry*>> candidates;
+    for (auto& [key, entry] : entries) {
+        if (!entry.loading && entry.last_requested + eviction_delay < frame && entry.resident < entry.base) {
+            candidates.emplace_back(key, &entry);
+        }
+    }
+
+    // least recently requested lose their levels first
+    std::sort(candidates.begin(), candidates.end(), [] (const auto& lhs, const auto& rhs) {
+        return lhs.second->last_requested < rhs.second->last_requested;
+    });
+
+    for (auto& [key, entry] : candidates) {
+        if (resident_bytes + pending_bytes <= limit) {
+            break;
+        }
+
+        setResident(*entry, entry->base);
+        changes.push_back({key, entry->base});
+        ++evictions;
+    }
+}
+
+TextureResidency::Plan TextureResidency::update() {
+    Plan plan;
+
+    std::vector<std::pair<Key, Entry*>> requested;
+    for (auto& [key, entry] : entries) {
+        if (entry.last_requested == frame && entry.wanted < entry.resident && !entry.loading) {
+            requested.emplace_back(key, &entry);
+        }
+    }
+
+    // closest to the camera first
+    std::sort(requested.begin(), requested.end(), [] (const auto& lhs, const auto& rhs) {
+        return lhs.second->wanted < rhs.second->wanted;
+    });
+
+    for (auto& [key, entry] : requested) {
+        const auto required = entry->getByteCount(entry->wanted) - entry->getByteCount(entry->resident);
+
+        if (resident_bytes + pending_bytes + required > budget) {
+            evict(budget > required ? budget - required : 0, plan.evictions);
+        }
+
+        // old levels stay allocated until new ones are uploaded
+        if (resident_bytes + pending_bytes + required <= budget) {
+            entry->loading = true;
+            entry->promoted = entry->wanted;
+            pending_bytes += entry->getByteCount(entry->wanted);
+            plan.promotions.push_back({key, entry->wanted});
+        }
+    }
+
+    ++frame;
+    return plan;
+}
+
+bool TextureResidency::finish(Key key, uint32_t level) {
+    const auto it = entries.find(key);
+    if (it == entries.end()) {
+        return false;
+    }
+
+    auto& entry = it->second;
+    pending_bytes -= std::min(pending_bytes, entry.getByteCount(level));
+    entry.loading = false;
+
+    // texture can be evicted meanwhile, but it is never promoted twice
+    if (level >= entry.resident) {
+        return false;
+    }
+
+    setResident(entry, level);
+    ++promotions;
+    return true;
+}
+
+std::vector<TextureResidency::Change> TextureResidency::trim(size_t bytes) {
+    std::vector<Change> changes;
+    const auto used = resident_bytes + pending_bytes;
+    evict(used > bytes ? used - bytes : 0, changes);
+    return changes;
+}
+
+bool TextureResidency::isLoading(Key key) const noexcept {
+    const auto it = entries.find(key);
+    return it != entries.end() && it->second.loading;
+}
+
+uint32_t TextureResidency::getResident(Key key) const {
+    return entries.at(key).resident;
+}
+
+TextureResidency::Stats TextureResidency::getStats() const noexcept {
+    Stats stats;
+    stats.resident_bytes = resident_bytes;
+    stats.budget = budget;
+    stats.queue_length = std::count_if(entries.begin(), entries.end(), [] (const auto& entry) { return entry.second.loading; });
+    stats.textures = entries.size();
+    stats.promotions = promotions;
+    stats.evictions = evictions;
+    return stats;
+}
@@ -0,0 +1,196 @@
+#include <limitless/loaders/texture_streamer.hpp>
+
+#include <limitless/instances/model_instance.hpp>
+#include <limitless/pipeline/shader_pass_types.hpp>
+#include <limitless/core/texture_builder.hpp>
+#include <limitless/util/byte_source.hpp>
+#include <limitless/ms/material.hpp>
+#include <limitless/camera.hpp>
+#include <algorithm>
+
+using namespace Limitless;
+
+TextureStreamer::TextureStreamer(AssetPipeline& _pipeline, size_t budget)
+    : pipeline {_pipeline}
+    , residency {budget} {
+    // notified from Pipeline::draw on main thread
+    budget_listener = GpuMemory::addBudgetListener([this] (size_t excess, [[maybe_unused]] size_t limit) {
+        trim(excess);
+    });
+}
+
+TextureStreamer::~TextureStreamer() {
+    GpuMemory::removeBudgetListener(budget_listener);
+}
+
+uint32_t TextureStreamer::getBaseLevel(const DDSImage& image) const noexcept {
+    for (uint32_t i = 0; i < image.levels.size(); ++i) {
+        const auto& size = image.levels[i].size;
+        if (std::max(size.x, size.y) <= base_size) {
+            return i;
+        }
+    }
+    return static_cast<uint32_t>(image.levels.size()) - 1;
+}
+
+std::shared_ptr<Texture> TextureStreamer::load(Assets& assets, std::shared_ptr<ByteSource> source, const TextureLoaderFlags& flags) {
+    auto path = convertPathSeparators(source->getPath());
+
+    if (assets.textures.contains(path.stem().string())) {
+        return assets.textures[path.stem().string()];
+    }
+
+    auto image = DDSLoader::parse(*source, flags);
+    const auto base = getBaseLevel(image);
+    const auto& first = image.levels[base];
+
+    TextureBuilder builder;
+    builder .setTarget(Texture::Type::Tex2D)
+            .setInternalFormat(image.internal_format)
+            .setSize(first.size)
+            .setCompressedData(first.data, first.byte_count);
+    TextureLoader::setTextureParameters(builder, flags);
+    builder.setPath(path);
+    auto texture = builder.buildMutable();
+
+    std::vector<size_t> levels;
+    for (const auto& level : image.levels) {
+        levels.emplace_back(level.byte_count);
+    }
+
+    const auto* data = first.data;
+
+    Entry entry {texture, std::move(source), std::move(image)};
+    apply(entry, base, data);
+
+    residency.add(texture.get(), std::move(levels), base);
+    entries.emplace(texture.get(), std::move(entry));
+    assets.textures.add(path.stem().string(), texture);
+    return texture;
+}
+
+void TextureStreamer::apply(Entry& entry, uint32_t level, const std::byte* data) {
+    auto& texture = *entry.texture;
+    const auto& levels = entry.image.levels;
+    const auto level_count = static_cast<uint32_t>(levels.size()) - level;
+
+    texture.reallocate({levels[level].size, texture.getSize().z}, level_count);
+
+    // levels follow each other in dds, so offsets are taken from the source
+    for (auto i = level; i < levels.size(); ++i) {
+        const auto* level_data = data + (levels[i].data - levels[level].data);
+        if (texture.isImmutable()) {
+            texture.compressedSubImage(i - level, {0, 0}, levels[i].size, level_data, levels[i].byte_count);
+        } else {
+            texture.compressedImage(i - level, levels[i].size, level_data, levels[i].byte_count);
+        }
+    }
+}
+
+void TextureStreamer::apply(const std::vector<TextureResidency::Change>& changes) {
+    for (const auto& [key, level] : changes) {
+        auto& entry = entries.at(static_cast<const Texture*>(key));
+        apply(entry, level, entry.image.levels[level].data);
+    }
+}
+
+void TextureStreamer::promote(Entry& entry, uint32_t level) {
+    const auto key = entry.texture.get();
+    const auto bytes = entry.image.getByteCount(level);
+    const auto* data = entry.image.levels[level].data;
+
+    auto levels = std::make_shared<std::vector<std::byte>>();
+
+    // copying out of mapped source reads file on worker; source is captured to stay mapped
+    const auto io = pipeline.add(entry.texture->getPath().value_or("").string(), AssetStage::IO, [levels, source = entry.source, data, bytes] {
+        levels->assign(data, data + bytes);
+    });
+
+    pipeline.upload(entry.texture->getPath().value_or("").string(), [this, key, level, levels] {
+        if (!residency.finish(key, level)) {
+            return size_t {};
+        }
+
+        apply(entries.at(key), level, levels->data());
+        return levels->size();
+    }, {io});
+}
+
+void TextureStreamer::trim(size_t bytes) {
+    apply(residency.trim(bytes));
+}
+
+void TextureStreamer::request(const Texture& texture, float screen_size) {
+    const auto it = entries.find(&texture);
+    if (it == entries.end()) {
+        return;
+    }
+
+    const auto& levels = it->second.image.levels;
+    residency.request(&texture, TextureResidency::getLevel(levels.front().size, static_cast<uint32_t>(levels.size()), screen_size));
+}
+
+void TextureStreamer::request(const MeshInstance& mesh, float screen_size) {
+    if (mesh.isHidden()) {
+        return;
+    }
+
+    const auto request_sampler = [&] (const Uniform& uniform) {
+        if (uniform.getType() == UniformType::Sampler) {
+            if (const auto& sampler = static_cast<const UniformSampler&>(uniform).getSampler(); sampler) {
+                request(*sampler, screen_size);
+            }
+        }
+    };
+
+    for (const auto& [_, material] : mesh.getMaterial()) {
+        for (const auto& [type, property] : material->getProperties()) {
+            request_sampler(*property);
+        }
+
+        for (const auto& [name, uniform] : material->getUniforms()) {
+            request_sampler(*uniform);
+        }
+    }
+}
+
+void TextureStreamer::request(const Instances& instances, const Camera& camera, glm::uvec2 viewport) {
+    const auto tan_half_fov = glm::tan(glm::radians(camera.getFov()) * 0.5f);
+
+    for (const auto& wrapper : instances) {
+        auto& instance = wrapper.get();
+
+        if (instance.getShaderType() != ModelShader::Model && instance.getShaderType() != ModelShader::Skeletal) {
+            continue;
+        }
+
+        const auto& box = instance.getBoundingBox();
+        const auto radius = glm::length(box.size) * 0.5f;
+        const auto distance = std::max(glm::distance(box.center, camera.getPosition()) - radius, camera.getNear());
+        const auto screen_size = radius / (distance * tan_half_fov) * static_cast<float>(viewport.y);
+
+        for (const auto& [_, mesh] : static_cast<const ModelInstance&>(instance).getMeshes()) {
+            request(mesh, screen_size);
+        }
+    }
+}
+
+void TextureStreamer::update() {
+    // textures released by assets are not tracked anymore
+    for (auto it = entries.begin(); it != entries.end();) {
+        if (it->second.texture.use_count() == 1 && !residency.isLoading(it->first)) {
+            residency.remove(it->first);
+            it = entries.erase(it);
+        } else {
+            ++it;
+        }
+    }
+
+    const auto plan = residency.update();
+
+    apply(plan.evictions);
+
+    for (const auto& [key, level] : plan.promotions) {
+        promote(entries.at(static_cast<const Texture*>(key)), level);
+    }
+}
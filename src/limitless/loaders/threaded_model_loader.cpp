@@ -1,4 +1,5 @@
 #include <limitless/loaders/threaded_model_loader.hpp>
+#include <limitless/loaders/assimp_io.hpp>
 
 #include <limitless/models/skeletal_model.hpp>
 #include <limitless/core/skeletal_stream.hpp>
@@ -82,6 +83,11 @@ std::function<std::shared_ptr<AbstractModel>()> ThreadedModelLoader::loadModel(A
 		scene_flags |= aiProcess_FlipWindingOrder;
 	}
 
+    // importer owns the handler
+    if (assets.getPack()) {
+        importer.SetIOHandler(new AssimpIOSystem(assets));
+    }
+
     scene = importer.ReadFile(path.string().c_str(), scene_flags);
 
     if (!scene || scene->mFlags & AI_SCENE_FLAGS_INCOMPLETE || !scene->mRootNode) {
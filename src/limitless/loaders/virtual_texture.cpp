@@ -0,0 +1,659 @@
+#include <limitless/loaders/virtual_texture.hpp>
+
+#include <limitless/core/context.hpp>
+#include <limitless/core/buffer_builder.hpp>
+#include <limitless/core/texture_builder.hpp>
+#include <limitless/util/byte_source.hpp>
+#include <algorithm>
+#include <cmath>
+
+using namespace Limitless;
+
+namespace {
+    constexpr auto PARAMETERS_BUFFER_NAME = "virtual_texture";
+    constexpr auto FEEDBACK_BUFFER_NAME = "virtual_texture_feedback";
+
+    uint32_t log2(uint32_t value) noexcept {
+        uint32_t result {};
+        while (value >>= 1u) {
+            ++result;
+        }
+        return result;
+    }
+
+    bool isSRGB(Texture::InternalFormat format) noexcept {
+        switch (format) {
+            case Texture::InternalFormat::sRGB8:
+            case Texture::InternalFormat::sRGBA8:
+            case Texture::InternalFormat::sRGB_DXT1:
+            case Texture::InternalFormat::sRGBA_DXT1:
+            case Texture::InternalFormat::sRGBA_DXT3:
+            case Texture::InternalFormat::sRGBA_DXT5:
+            case Texture::InternalFormat::sRGBA_BC7:
+                return true;
+            default:
+                return false;
+        }
+    }
+
+    std::shared_ptr<Texture> makePhysical(const VirtualTexture::Settings& settings, Texture::InternalFormat format) {
+        const auto side = settings.pool_size * (settings.page_size + 2 * settings.border);
+
+        TextureBuilder builder;
+        return builder .setTarget(Texture::Type::Tex2D)
+                       .setInternalFormat(format)
+                       .setFormat(Texture::Format::RGBA)
+                       .setDataType(Texture::DataType::UnsignedByte)
+                       .setSize(glm::uvec2{side})
+                       .setMinFilter(Texture::Filter::Linear)
+                       .setMagFilter(Texture::Filter::Linear)
+                       .setWrapS(Texture::Wrap::ClampToEdge)
+                       .setWrapT(Texture::Wrap::ClampToEdge)
+                       .setMipMap(false)
+                       .build();
+    }
+
+    std::shared_ptr<Texture> makeIndirection(const VirtualTexture::Settings& settings) {
+        TextureBuilder builder;
+        return builder .setTarget(Texture::Type::Tex2D)
+                       .setInternalFormat(Texture::InternalFormat::RGBA8)
+                       .setFormat(Texture::Format::RGBA)
+                       .setDataType(Texture::DataType::UnsignedByte)
+                       .setSize(glm::uvec2{settings.virtual_size})
+                       .setLevels(log2(settings.virtual_size) + 1)
+                       .setMinFilter(Texture::Filter::Nearest)
+                       .setMagFilter(Texture::Filter::Nearest)
+                       .setWrapS(Texture::Wrap::ClampToEdge)
+                       .setWrapT(Texture::Wrap::ClampToEdge)
+                       .setMipMap(false)
+                       .build();
+    }
+}
+
+VirtualTexture::VirtualTexture(Context& ctx, AssetPipeline& _pipeline, const Settings& _settings)
+    : pipeline {_pipeline}
+    , settings {_settings}
+    , owners(static_cast<size_t>(settings.virtual_size) * settings.virtual_size)
+    , free_blocks(log2(settings.virtual_size) + 1)
+    , tiles(settings.pool_size * settings.pool_size)
+    , physical {makePhysical(settings, Texture::InternalFormat::RGBA8)}
+    , physical_srgb {makePhysical(settings, Texture::InternalFormat::sRGBA8)}
+    , indirection {makeIndirection(settings)}
+    , physical_sampler {"_vt_physical", physical}
+    , physical_srgb_sampler {"_vt_physical_srgb", physical_srgb}
+    , indirection_sampler {"_vt_indirection", indirection} {
+    free_blocks.back().emplace_back(0, 0);
+
+    // every level starts without resident pages and is uploaded on first update
+    for (auto size = settings.virtual_size; size > 0; size /= 2) {
+        indirection_levels.push_back({size, std::vector<glm::u8vec4>(static_cast<size_t>(size) * size), 0, size});
+    }
+
+    BufferBuilder builder;
+    parameters = builder.setTarget(Buffer::Type::Uniform)
+                        .setUsage(Buffer::Usage::DynamicDraw)
+                        .setAccess(Buffer::MutableAccess::WriteOrphaning)
+                        .setDataSize(sizeof(Parameters))
+                        .build(PARAMETERS_BUFFER_NAME, ctx);
+
+    // feedback buffers rotate, so they are bound manually instead of being registered
+    marks.resize(getFeedbackSize());
+    for (auto& buffer : feedback) {
+        BufferBuilder feedback_builder;
+        buffer = feedback_builder.setTarget(Buffer::Type::ShaderStorage)
+                                 .setUsage(Buffer::Usage::StreamRead)
+                                 .setAccess(Buffer::MutableAccess::None)
+                                 .setDataSize(marks.size() * sizeof(uint32_t))
+                                 .build();
+        buffer->clearData(GL_R32UI, GL_RED_INTEGER, GL_UNSIGNED_INT, nullptr);
+    }
+}
+
+VirtualTexture::VirtualTexture(Context& ctx, AssetPipeline& _pipeline)
+    : VirtualTexture {ctx, _pipeline, Settings {}} {
+}
+
+VirtualTexture::~VirtualTexture() {
+    // fences died with context when it was destroyed first
+    if (auto* ctx = ContextState::getState(glfwGetCurrentContext()); ctx) {
+        for (auto& fence : fences) {
+            if (fence) {
+                glDeleteSync(fence);
+            }
+        }
+
+        ctx->getIndexedBuffers().remove(PARAMETERS_BUFFER_NAME, parameters);
+    }
+}
+
+uint32_t VirtualTexture::getFeedbackSize() const noexcept {
+    // one bit per page of every mip
+    const auto size = settings.virtual_size;
+    const auto bits = (size * size * 4 - 1) / 3;
+    return (bits + 31) / 32;
+}
+
+std::optional<glm::uvec2> VirtualTexture::allocate(uint32_t side) {
+    const auto level = log2(side);
+
+    auto found = level;
+    while (found < free_blocks.size() && free_blocks[found].empty()) {
+        ++found;
+    }
+
+    if (found == free_blocks.size()) {
+        return std::nullopt;
+    }
+
+    const auto block = free_blocks[found].back();
+    free_blocks[found].pop_back();
+
+    // bigger block is split into quarters down to requested size
+    while (found > level) {
+        --found;
+        const auto half = 1u << found;
+        free_blocks[found].emplace_back(block.x + half, block.y);
+        free_blocks[found].emplace_back(block.x, block.y + half);
+        free_blocks[found].emplace_back(block.x + half, block.y + half);
+    }
+
+    return block;
+}
+
+void VirtualTexture::deallocate(glm::uvec2 block, uint32_t side) {
+    auto level = log2(side);
+
+    // quarters of bigger block are merged while all of them are free
+    while (level + 1 < free_blocks.size()) {
+        const auto mask = ~((2u << level) - 1);
+        const glm::uvec2 parent {block.x & mask, block.y & mask};
+        const auto is_sibling = [&] (const glm::uvec2& other) {
+            return other != block && (other.x & mask) == parent.x && (other.y & mask) == parent.y;
+        };
+
+        auto& blocks = free_blocks[level];
+        if (std::count_if(blocks.begin(), blocks.end(), is_sibling) != 3) {
+            break;
+        }
+
+        blocks.erase(std::remove_if(blocks.begin(), blocks.end(), is_sibling), blocks.end());
+        block = parent;
+        ++level;
+    }
+
+    free_blocks[level].push_back(block);
+}
+
+void VirtualTexture::decode(Source& source) {
+    auto decoded = std::make_shared<Decoded>();
+    pipeline.add(source.path.string(), AssetStage::Decode, [decoded, path = source.path, flags = source.flags] {
+        // texture is already loaded, so failed one stays black instead of failing the pipeline
+        try {
+            decoded->image = TextureLoader::decode(FileByteSource{path}, flags);
+            decoded->state = 1;
+        } catch (...) {
+            decoded->state = 2;
+        }
+    });
+
+    source.decoded = std::move(decoded);
+    source.tiled.clear();
+}
+
+bool VirtualTexture::add(const std::shared_ptr<Texture>& texture, const TextureLoaderFlags& flags) {
+    if (!texture) {
+        return false;
+    }
+
+    if (contains(*texture)) {
+        return true;
+    }
+
+    // compressed files are not decoded on CPU
+    const auto& path = texture->getPath();
+    if (!path || path->extension() == ".dds" || !texture->is2D()) {
+        return false;
+    }
+
+    const auto size = glm::uvec2{texture->getSize()};
+    const auto pages_of = [&] (uint32_t texels) {
+        uint32_t count = 1;
+        while (count * settings.page_size < texels) {
+            count *= 2;
+        }
+        return count;
+    };
+
+    const glm::uvec2 pages {pages_of(size.x), pages_of(size.y)};
+    if (std::max(pages.x, pages.y) > settings.virtual_size) {
+        return false;
+    }
+
+    const auto origin = allocate(std::max(pages.x, pages.y));
+    if (!origin) {
+        return false;
+    }
+
+    const auto index = static_cast<uint32_t>(sources.size());
+    for (uint32_t y = origin->y; y < origin->y + pages.y; ++y) {
+        for (uint32_t x = origin->x; x < origin->x + pages.x; ++x) {
+            owners[y * settings.virtual_size + x] = index + 1;
+        }
+    }
+
+    const auto srgb = isSRGB(texture->getInternalFormat());
+
+    // mipmaps are cut into pages of coarser levels
+    auto decode_flags = flags;
+    decode_flags.space = srgb ? TextureLoaderFlags::Space::sRGB : TextureLoaderFlags::Space::Linear;
+    decode_flags.mipmap = true;
+    decode_flags.downscale = TextureLoaderFlags::DownScale::None;
+    decode_flags.compression = TextureLoaderFlags::Compression::None;
+
+    const auto max_mip = log2(std::min(pages.x, pages.y));
+    uint32_t page_count {};
+    for (uint32_t mip = 0; mip <= max_mip; ++mip) {
+        page_count += (pages.x >> mip) * (pages.y >> mip);
+    }
+
+    sources.push_back({*path, decode_flags, *origin, pages, max_mip, srgb, page_count});
+    decode(sources.back());
+    source_indices.emplace(texture.get(), index);
+    return true;
+}
+
+void VirtualTexture::remove(const Texture& texture) {
+    const auto it = source_indices.find(&texture);
+    if (it == source_indices.end()) {
+        return;
+    }
+
+    const auto index = it->second;
+    source_indices.erase(it);
+
+    // pages are released while region is still owned, so indirection entries under it are cleared
+    for (uint32_t i = 0; i < tiles.size(); ++i) {
+        const auto key = tiles[i].page;
+        if (key == NONE) {
+            continue;
+        }
+
+        const auto mip = key >> 28u;
+        const auto x = key & 0x3FFFu;
+        const auto y = (key >> 14u) & 0x3FFFu;
+        if (owners[(y << mip) * settings.virtual_size + (x << mip)] == index + 1) {
+            release(i);
+        }
+    }
+
+    auto& source = sources[index];
+    for (uint32_t y = source.origin.y; y < source.origin.y + source.pages.y; ++y) {
+        for (uint32_t x = source.origin.x; x < source.origin.x + source.pages.x; ++x) {
+            owners[y * settings.virtual_size + x] = 0;
+        }
+    }
+    deallocate(source.origin, std::max(source.pages.x, source.pages.y));
+
+    // slot is kept, so indices of other sources stay valid
+    source.decoded = nullptr;
+    source.tiled.clear();
+    source.based = true;
+}
+
+glm::vec4 VirtualTexture::getRegion(const Texture& texture) const {
+    const auto it = source_indices.find(&texture);
+    if (it == source_indices.end()) {
+        return glm::vec4{0.0f};
+    }
+
+    const auto& source = sources[it->second];
+    const auto pages = glm::vec2{source.pages};
+    return {glm::vec2{source.origin}, glm::vec2{source.srgb ? -pages.x : pages.x, pages.y}};
+}
+
+std::optional<uint32_t> VirtualTexture::acquireTile() {
+    std::optional<uint32_t> candidate;
+    for (uint32_t i = 0; i < tiles.size(); ++i) {
+        const auto& tile = tiles[i];
+        if (tile.page == NONE) {
+            return i;
+        }
+
+        // pages sampled this frame are kept
+        if (tile.locked || tile.loading || tile.last_used + 1 >= frame) {
+            continue;
+        }
+
+        if (!candidate || tile.last_used < tiles[*candidate].last_used) {
+            candidate = i;
+        }
+    }
+
+    if (candidate) {
+        release(*candidate);
+        ++stats.evictions;
+    }
+
+    return candidate;
+}
+
+void VirtualTexture::release(uint32_t tile) {
+    const auto key = tiles[tile].page;
+    pages.erase(key);
+    tiles[tile] = {NONE, 0, false, false, tiles[tile].generation};
+
+    refresh(key >> 28u, key & 0x3FFFu, (key >> 14u) & 0x3FFFu);
+}
+
+void VirtualTexture::refresh(uint32_t mip, uint32_t x, uint32_t y) {
+    const auto owner = owners[(y << mip) * settings.virtual_size + (x << mip)];
+    if (owner == 0) {
+        return;
+    }
+
+    const auto& source = sources[owner - 1];
+
+    // entries of finer levels under page fall back to the best resident ancestor
+    for (auto level = mip + 1; level-- > 0;) {
+        auto& target = indirection_levels[level];
+        const auto scale = mip - level;
+        const auto count = 1u << scale;
+        const auto first_x = x << scale;
+        const auto first_y = y << scale;
+
+        for (auto ey = first_y; ey < first_y + count; ++ey) {
+            for (auto ex = first_x; ex < first_x + count; ++ex) {
+                glm::u8vec4 entry {0};
+                for (auto k = level; k <= source.max_mip; ++k) {
+                    const auto found = pages.find(getPageKey(k, ex >> (k - level), ey >> (k - level)));
+                    if (found != pages.end() && !tiles[found->second].loading) {
+                        const auto tile = found->second;
+                        entry = glm::u8vec4(tile % settings.pool_size, tile / settings.pool_size, k, 255);
+                        break;
+                    }
+                }
+                target.entries[ey * target.size + ex] = entry;
+            }
+        }
+
+        target.dirty_begin = std::min(target.dirty_begin, first_y);
+        target.dirty_end = std::max(target.dirty_end, first_y + count);
+    }
+}
+
+void VirtualTexture::flushIndirection() {
+    for (uint32_t level = 0; level < indirection_levels.size(); ++level) {
+        auto& target = indirection_levels[level];
+        if (target.dirty_begin >= target.dirty_end) {
+            continue;
+        }
+
+        // whole rows keep upload contiguous
+        const auto rows = target.dirty_end - target.dirty_begin;
+        indirection->subImage(level, glm::uvec2{0, target.dirty_begin}, glm::uvec2{target.size, rows}, target.entries.data() + static_cast<size_t>(target.dirty_begin) * target.size);
+
+        target.dirty_begin = NONE;
+        target.dirty_end = 0;
+    }
+}
+
+void VirtualTexture::load(uint32_t source_index, uint32_t mip, uint32_t x, uint32_t y, bool locked) {
+    auto& source = sources[source_index];
+
+    // image was freed by earlier load of this frame, page is requested again after it is decoded
+    if (!source.decoded) {
+        return;
+    }
+
+    const auto key = getPageKey(mip, x, y);
+    if (const auto found = pages.find(key); found != pages.end()) {
+        tiles[found->second].locked |= locked;
+        return;
+    }
+
+    const auto tile_index = acquireTile();
+    if (!tile_index) {
+        return;
+    }
+
+    const auto generation = tiles[*tile_index].generation + 1;
+    tiles[*tile_index] = {key, frame, locked, true, generation};
+    pages.emplace(key, *tile_index);
+
+    const auto region = (source.pages >> mip) * settings.page_size;
+    const auto page = glm::uvec2{x, y} - (source.origin >> mip);
+
+    auto pixels = std::make_shared<std::vector<uint8_t>>();
+    const auto job = pipeline.add(source.path.string(), AssetStage::Decode, [pixels, decoded = source.decoded, region, page, page_size = settings.page_size, border = settings.border] {
+        *pixels = makeTile(decoded->image, region, page, page_size, border);
+    });
+
+    // tile jobs keep image alive, so it is freed after the last page is cut
+    source.tiled.insert(key);
+    if (source.tiled.size() == source.page_count) {
+        source.decoded = nullptr;
+        source.tiled.clear();
+    }
+
+    pipeline.upload(source.path.string(), [this, tile = *tile_index, generation, mip, x, y, pixels, srgb = source.srgb] {
+        // page was released while it was being cut
+        if (tiles[tile].generation != generation) {
+            return size_t {};
+        }
+
+        const auto side = settings.page_size + 2 * settings.border;
+        const glm::uvec2 offset {tile % settings.pool_size * side, tile / settings.pool_size * side};
+        (srgb ? physical_srgb : physical)->subImage(0, offset, glm::uvec2{side}, pixels->data());
+
+        tiles[tile].loading = false;
+        refresh(mip, x, y);
+        ++stats.uploads;
+        return pixels->size();
+    }, {job});
+}
+
+void VirtualTexture::readFeedback(uint32_t index) {
+    glBindBuffer(GL_COPY_READ_BUFFER, feedback[index]->getId());
+    glGetBufferSubData(GL_COPY_READ_BUFFER, 0, static_cast<GLsizeiptr>(marks.size() * sizeof(uint32_t)), marks.data());
+    glBindBuffer(GL_COPY_READ_BUFFER, 0);
+
+    struct Request {
+        uint32_t source;
+        uint32_t mip;
+        uint32_t x;
+        uint32_t y;
+    };
+    std::vector<Request> missing;
+    stats.requested_pages = 0;
+
+    const auto size = settings.virtual_size;
+    for (uint32_t mip = 0; (size >> mip) > 0; ++mip) {
+        const auto side = size >> mip;
+        const auto count = side * side;
+        const auto offset = (size * size - count) / 3 * 4;
+
+        for (uint32_t local = 0; local < count; ++local) {
+            const auto bit = offset + local;
+
+            // empty words are skipped at once
+            if ((bit & 31u) == 0 && marks[bit >> 5u] == 0 && local + 32 <= count) {
+                local += 31;
+                continue;
+            }
+
+            if (((marks[bit >> 5u] >> (bit & 31u)) & 1u) == 0) {
+                continue;
+            }
+
+            const auto x = local % side;
+            const auto y = local / side;
+            const auto owner = owners[(y << mip) * size + (x << mip)];
+            if (owner == 0 || mip > sources[owner - 1].max_mip) {
+                continue;
+            }
+
+            ++stats.requested_pages;
+            auto& source = sources[owner - 1];
+            if (const auto found = pages.find(getPageKey(mip, x, y)); found != pages.end()) {
+                tiles[found->second].last_used = frame;
+            } else if (!source.decoded) {
+                // evicted page of freed image
+                decode(source);
+            } else if (source.decoded->state == 1) {
+                missing.push_back({owner - 1, mip, x, y});
+            }
+        }
+    }
+
+    // coarse pages first, they cover more screen and are fallbacks for finer ones
+    std::stable_sort(missing.begin(), missing.end(), [] (const auto& lhs, const auto& rhs) {
+        return lhs.mip > rhs.mip;
+    });
+
+    if (missing.size() > settings.max_requests) {
+        missing.resize(settings.max_requests);
+    }
+
+    for (const auto& request : missing) {
+        load(request.source, request.mip, request.x, request.y, false);
+    }
+}
+
+void VirtualTexture::update(Context& ctx) {
+    // feedback written during previous frame is fenced for later read
+    if (frame > 0) {
+        glMemoryBarrier(GL_BUFFER_UPDATE_BARRIER_BIT);
+        auto& fence = fences[(frame - 1) % FEEDBACK_FRAMES];
+        if (fence) {
+            glDeleteSync(fence);
+        }
+        fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    }
+
+    // buffer of this frame was written FEEDBACK_FRAMES frames ago; it is skipped if GPU is still behind
+    const auto index = static_cast<uint32_t>(frame % FEEDBACK_FRAMES);
+    if (auto& fence = fences[index]; fence) {
+        const auto status = glClientWaitSync(fence, 0, 0);
+        if (status == GL_ALREADY_SIGNALED || status == GL_CONDITION_SATISFIED) {
+            readFeedback(index);
+        }
+        glDeleteSync(fence);
+        fence = nullptr;
+    }
+
+    // coarsest page of every decoded texture is always resident
+    for (uint32_t i = 0; i < sources.size(); ++i) {
+        auto& source = sources[i];
+        if (source.based) {
+            continue;
+        }
+
+        // every page was cut before coarsest one was locked, so image is needed again
+        if (!source.decoded) {
+            decode(source);
+            continue;
+        }
+
+        if (source.decoded->state == 0) {
+            continue;
+        }
+
+        source.based = true;
+        if (source.decoded->state == 1) {
+            load(i, source.max_mip, source.origin.x >> source.max_mip, source.origin.y >> source.max_mip, true);
+        }
+    }
+
+    flushIndirection();
+
+    feedback[index]->clearData(GL_R32UI, GL_RED_INTEGER, GL_UNSIGNED_INT, nullptr);
+    feedback[index]->bindBase(ctx.getIndexedBuffers().getBindingPoint(IndexedBuffer::Type::ShaderStorage, FEEDBACK_BUFFER_NAME));
+
+    const auto side = static_cast<float>(settings.pool_size * (settings.page_size + 2 * settings.border));
+    const Parameters data {
+        glm::vec2{side},
+        static_cast<float>(settings.page_size),
+        static_cast<float>(settings.border),
+        settings.virtual_size,
+        static_cast<uint32_t>(frame),
+        {}
+    };
+    parameters->mapData(&data, sizeof(Parameters));
+    parameters->bindBase(ctx.getIndexedBuffers().getBindingPoint(IndexedBuffer::Type::UniformBuffer, PARAMETERS_BUFFER_NAME));
+
+    ++frame;
+}
+
+std::vector<uint8_t> VirtualTexture::makeTile(const DecodedTexture& image, glm::uvec2 region, glm::uvec2 page, uint32_t page_size, uint32_t border) {
+    // smallest level that still has at least texels of region
+    const uint8_t* pixels = image.data.get();
+    auto size = glm::uvec2{glm::ivec2{image.width, image.height}};
+    for (const auto& mip : image.mips) {
+        if (mip.width < region.x || mip.height < region.y) {
+            break;
+        }
+        pixels = mip.pixels.data();
+        size = glm::uvec2{mip.width, mip.height};
+    }
+
+    const auto channels = static_cast<uint32_t>(image.channels);
+    const auto side = page_size + 2 * border;
+    const glm::vec2 scale = glm::vec2{size} / glm::vec2{region};
+
+    const auto wrap = [] (int32_t value, int32_t count) {
+        value %= count;
+        return value < 0 ? value + count : value;
+    };
+
+    std::vector<uint8_t> tile(static_cast<size_t>(side) * side * 4);
+    for (uint32_t ty = 0; ty < side; ++ty) {
+        // texel centers of region mapped onto source level; border texels come from neighbours
+        const auto sy = (static_cast<float>(page.y * page_size + ty) - static_cast<float>(border) + 0.5f) * scale.y - 0.5f;
+        const auto fy = std::floor(sy);
+        const auto wy = sy - fy;
+        const auto y0 = wrap(static_cast<int32_t>(fy), static_cast<int32_t>(size.y));
+        const auto y1 = wrap(static_cast<int32_t>(fy) + 1, static_cast<int32_t>(size.y));
+
+        for (uint32_t tx = 0; tx < side; ++tx) {
+            const auto sx = (static_cast<float>(page.x * page_size + tx) - static_cast<float>(border) + 0.5f) * scale.x - 0.5f;
+            const auto fx = std::floor(sx);
+            const auto wx = sx - fx;
+            const auto x0 = wrap(static_cast<int32_t>(fx), static_cast<int32_t>(size.x));
+            const auto x1 = wrap(static_cast<int32_t>(fx) + 1, static_cast<int32_t>(size.x));
+
+            const auto* p00 = pixels + (static_cast<size_t>(y0) * size.x + x0) * channels;
+            const auto* p10 = pixels + (static_cast<size_t>(y0) * size.x + x1) * channels;
+            const auto* p01 = pixels + (static_cast<size_t>(y1) * size.x + x0) * channels;
+            const auto* p11 = pixels + (static_cast<size_t>(y1) * size.x + x1) * channels;
+
+            auto* out = &tile[(static_cast<size_t>(ty) * side + tx) * 4];
+            for (uint32_t c = 0; c < 4; ++c) {
+                // missing channels read as GL does for R and RG formats
+                if (c >= channels) {
+                    out[c] = c == 3 ? 255 : 0;
+                    continue;
+                }
+
+                const auto top = p00[c] + (p10[c] - p00[c]) * wx;
+                const auto bottom = p01[c] + (p11[c] - p01[c]) * wx;
+                out[c] = static_cast<uint8_t>(top + (bottom - top) * wy + 0.5f);
+            }
+        }
+    }
+
+    return tile;
+}
+
+VirtualTexture::Stats VirtualTexture::getStats() const noexcept {
+    auto result = stats;
+    result.textures = static_cast<uint32_t>(source_indices.size());
+    result.tiles = static_cast<uint32_t>(tiles.size());
+    result.resident_pages = 0;
+    result.loading_pages = 0;
+    for (const auto& tile : tiles) {
+        if (tile.page != NONE) {
+            ++(tile.loading ? result.loading_pages : result.resident_pages);
+        }
+    }
+    return result;
+}
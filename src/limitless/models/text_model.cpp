@@ -1,6 +1,7 @@
 #include <limitless/models/text_model.hpp>
 
 #include <limitless/core/buffer_builder.hpp>
+#include <limitless/core/context_state.hpp>
 
 using namespace Limitless;
 
@@ -44,4 +45,6 @@ void TextModel::draw() const {
     vertex_array.bind();
 
     glDrawArrays(GL_TRIANGLES, 0, vertices.size());
+
+    ContextState::onDrawCall();
 }
\ No newline at end of file
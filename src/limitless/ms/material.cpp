@@ -4,6 +4,8 @@
 #include <limitless/core/bindless_texture.hpp>
 #include <limitless/core/buffer_builder.hpp>
 #include <limitless/core/texture.hpp>
+#include <limitless/loaders/virtual_texture.hpp>
+#include <plog/Log.h>
 #include <cstring>
 
 using namespace Limitless::ms;
@@ -27,6 +29,8 @@ void Limitless::ms::swap(Material& lhs, Material& rhs) noexcept {
     swap(lhs.fragment_snippet, rhs.fragment_snippet);
     swap(lhs.global_snippet, rhs.global_snippet);
     swap(lhs.tessellation_snippet, rhs.tessellation_snippet);
+    swap(lhs.virtual_texture, rhs.virtual_texture);
+    swap(lhs.regions, rhs.regions);
 }
 
 Material& Material::operator=(Material material) {
@@ -97,7 +101,9 @@ Material::Material(const Material& material)
     , uniform_offsets {material.uniform_offsets}
     , vertex_snippet {material.vertex_snippet}
     , fragment_snippet {material.fragment_snippet}
-    , global_snippet {material.global_snippet} {
+    , global_snippet {material.global_snippet}
+    , virtual_texture {material.virtual_texture}
+    , regions {material.regions} {
 
     // deep copy of properties
     for (const auto& [type, property] : material.properties) {
@@ -162,20 +168,35 @@ void Material::map(std::vector<std::byte>& block, Uniform& uniform) {
                 std::memcpy(block.data() + offset, &bindless_texture.getHandle(), sizeof(uint64_t));
             }
             break;
-        case UniformType::Time: {
-            auto& time = static_cast<UniformTime&>(uniform);
-            time.update();
+        case UniformType::Time:
             map<float>(block, uniform);
             break;
-        }
     }
 }
 
+void Material::mapRegion(std::vector<std::byte>& block, const UniformSampler& sampler) {
+    // texture set at run-time is paged in too; if it does not fit, it stays unpaged and previous texture is sampled
+    const auto& texture = sampler.getSampler();
+    if (virtual_texture->contains(*texture) || virtual_texture->add(texture)) {
+        regions[sampler.getName()] = virtual_texture->getRegion(*texture);
+    } else {
+        PLOG_WARNING << name << ": " << sampler.getName() << " does not fit into virtual texture, previous texture is kept";
+    }
+
+    const auto region = regions[sampler.getName()];
+    const auto offset = uniform_offsets.at(sampler.getName());
+    std::memcpy(block.data() + offset, &region, sizeof(glm::vec4));
+}
+
 void Material::map() {
     std::vector<std::byte> block(material_buffer->getSize());
 
     for (const auto& [property, uniform] : properties) {
-        map(block, *uniform);
+        if (virtual_texture && uniform->getType() == UniformType::Sampler) {
+            mapRegion(block, static_cast<const UniformSampler&>(*uniform));
+        } else {
+            map(block, *uniform);
+        }
     }
 
     for (const auto& [name, uniform] : uniforms) {
@@ -187,7 +208,13 @@ void Material::map() {
     material_buffer->mapData(block.data(), block.size());
 }
 
-void Material::update() {
+void Material::update(const FrameTime& time) {
+    for (const auto& [name, uniform] : uniforms) {
+        if (uniform->getType() == UniformType::Time) {
+            static_cast<UniformTime&>(*uniform).update(time);
+        }
+    }
+
     const auto properties_changed = std::any_of(properties.begin(), properties.end(), [] (auto& property) { return property.second->getChanged(); });
     const auto uniforms_changed = std::any_of(uniforms.begin(), uniforms.end(), [] (auto& uniform) { return uniform.second->getChanged(); });
 
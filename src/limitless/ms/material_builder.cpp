@@ -5,6 +5,9 @@
 #include <limitless/core/shader_program.hpp>
 #include <limitless/assets.hpp>
 #include <limitless/core/context_initializer.hpp>
+#include <limitless/loaders/virtual_texture.hpp>
+#include <limitless/util/hash.hpp>
+#include <algorithm>
 
 using namespace Limitless::ms;
 
@@ -24,9 +27,12 @@ void MaterialBuilder::initializeMaterialBuffer() {
     // https://www.khronos.org/registry/OpenGL/specs/gl/glspec45.core.pdf#page=159
 
     size_t offset = 0;
-    const auto offset_setter = [&] (const auto& container, const std::function<bool(const Uniform&)>& condition = {}) {
+    const auto offset_setter = [&] (const auto& container, const std::function<bool(const Uniform&)>& condition = {}, bool regions = false) {
         for (const auto& [key, uniform] : container) {
-            if (!ContextInitializer::isExtensionSupported("GL_ARB_bindless_texture") && uniform->getType() == UniformType::Sampler) {
+            // samplers paged into virtual texture are stored as vec4 regions
+            const auto region = regions && uniform->getType() == UniformType::Sampler;
+
+            if (!region && !ContextInitializer::isExtensionSupported("GL_ARB_bindless_texture") && uniform->getType() == UniformType::Sampler) {
                 continue;
             }
 
@@ -34,8 +40,8 @@ void MaterialBuilder::initializeMaterialBuffer() {
                 continue;
             }
 
-            const auto size = getUniformSize(*uniform);
-            const auto alignment = getUniformAlignment(*uniform);
+            const auto size = region ? sizeof(glm::vec4) : getUniformSize(*uniform);
+            const auto alignment = region ? sizeof(glm::vec4) : getUniformAlignment(*uniform);
 
             offset += offset % alignment ? alignment - offset % alignment : 0;
 
@@ -44,7 +50,7 @@ void MaterialBuilder::initializeMaterialBuffer() {
         }
     };
 
-    offset_setter(material->properties);
+    offset_setter(material->properties, {}, material->virtual_texture != nullptr);
     offset_setter(material->uniforms, [] (const Uniform& uniform) { return uniform.getType() == UniformType::Sampler; });
     offset_setter(material->uniforms, [] (const Uniform& uniform) { return uniform.getType() != UniformType::Sampler; });
 
@@ -242,24 +248,64 @@ MaterialBuilder& MaterialBuilder::removeUniform(const std::string& name) {
 }
 
 void MaterialBuilder::setMaterialIndex() {
-    std::unique_lock lock(mutex);
+    // materials that generate same shader sources share programs, custom ones too
+    auto key = MaterialCompiler::getShaderKey(*material);
+    const auto hash = hashString(key);
 
-    material->shader_index = next_shader_index++;
+    std::unique_lock lock(mutex);
 
-    if (!material->uniforms.empty() || !material->vertex_snippet.empty() || !material->fragment_snippet.empty() || !material->tessellation_snippet.empty() || !material->global_snippet.empty()) {
-        // it is custom material; makes index unique
-        material->shader_index = next_shader_index++;
+    ++material_count;
+    auto& indices = shader_indices[hash];
+    const auto found = std::find_if(indices.begin(), indices.end(), [&] (const auto& index) { return index.first == key; });
+    if (found != indices.end()) {
+        // already exist
+        material->shader_index = found->second;
     } else {
-        const auto material_type = getMaterialType();
-        if (auto found = unique_materials.find(material_type); found != unique_materials.end()) {
-            // already exist
-            material->shader_index = found->second;
-        } else {
-            // new one
-            material->shader_index = next_shader_index++;
-            unique_materials.emplace(material_type, material->shader_index);
+        // new one, or other sources with colliding hash
+        material->shader_index = next_shader_index++;
+        indices.emplace_back(std::move(key), material->shader_index);
+    }
+}
+
+void MaterialBuilder::pageTextures() {
+    // property textures are paged into virtual texture of assets material is built from
+    const auto& virtual_texture = assets.getVirtualTexture();
+    if (!virtual_texture) {
+        return;
+    }
+
+    // material either samples all property textures from atlas or none
+    std::vector<std::shared_ptr<Texture>> added;
+    bool has_samplers {};
+    for (const auto& [type, property] : material->properties) {
+        if (property->getType() != UniformType::Sampler) {
+            continue;
+        }
+
+        has_samplers = true;
+        const auto& texture = static_cast<UniformSampler&>(*property).getSampler();
+        const auto paged = texture && virtual_texture->contains(*texture);
+        if (!virtual_texture->add(texture)) {
+            // regions reserved for this material are released, textures paged by other materials stay
+            for (const auto& released : added) {
+                virtual_texture->remove(*released);
+            }
+            return;
+        }
+
+        if (!paged) {
+            added.push_back(texture);
         }
     }
+
+    if (has_samplers) {
+        material->virtual_texture = virtual_texture;
+    }
+}
+
+MaterialBuilder::ShaderSharing MaterialBuilder::getShaderSharing() noexcept {
+    std::unique_lock lock(mutex);
+    return { material_count, next_shader_index };
 }
 
 void MaterialBuilder::checkRequirements() {
@@ -283,6 +329,7 @@ void MaterialBuilder::clear() {
 std::shared_ptr<Material> MaterialBuilder::build() {
     checkRequirements();
 
+    pageTextures();
     setMaterialIndex();
     setModelShaders();
 
@@ -296,16 +343,6 @@ std::shared_ptr<Material> MaterialBuilder::build() {
     return new_material;
 }
 
-UniqueMaterial MaterialBuilder::getMaterialType() const noexcept {
-    std::set<Property> props;
-
-    std::for_each(material->properties.begin(), material->properties.end(), [&] (auto& prop) {
-        props.emplace(prop.first);
-    });
-
-    return { std::move(props), material->shading };
-}
-
 MaterialBuilder& MaterialBuilder::setModelShaders(const Limitless::ModelShaders& shaders) noexcept {
     material->model_shaders = shaders;
     return *this;
@@ -2,7 +2,9 @@
 
 #include <limitless/pipeline/render_settings.hpp>
 #include <limitless/ms/material.hpp>
+#include <limitless/util/hash.hpp>
 #include <limitless/assets.hpp>
+#include <plog/Log.h>
 
 using namespace Limitless::ms;
 
@@ -64,6 +66,10 @@ std::string MaterialCompiler::getMaterialDefines(const Material& material) noexc
         property_defines.append("#define MATERIAL_REFRACTION\n");
     }
 
+    if (material.getVirtualTexture()) {
+        property_defines.append("#define MATERIAL_VIRTUAL_TEXTURE\n");
+    }
+
     switch (material.getShading()) {
         case Shading::Lit:
             property_defines.append("#define MATERIAL_LIT\n");
@@ -117,6 +123,21 @@ std::string MaterialCompiler::getCustomMaterialSamplerUniforms(const Material& m
     return uniforms;
 }
 
+std::string MaterialCompiler::getShaderKey(const Material& material) {
+    // separators keep snippet boundaries apart
+    auto key = getMaterialDefines(material);
+    for (const auto& part : {material.getVertexSnippet(), material.getFragmentSnippet(), material.getGlobalSnippet(), material.getTessellationSnippet(),
+                             getCustomMaterialScalarUniforms(material), getCustomMaterialSamplerUniforms(material)}) {
+        key.push_back('\0');
+        key.append(part);
+    }
+    return key;
+}
+
+uint64_t MaterialCompiler::getShaderHash(const Material& material) {
+    return hashString(getShaderKey(material));
+}
+
 void MaterialCompiler::replaceMaterialSettings(Shader& shader, const Material& material, ModelShader model_shader) noexcept {
     shader.replaceKey("Limitless::MaterialType", getMaterialDefines(material));
     shader.replaceKey("Limitless::ModelType", getModelDefines(model_shader));
@@ -130,21 +151,38 @@ void MaterialCompiler::replaceMaterialSettings(Shader& shader, const Material& m
     shader.replaceKey("_MATERIAL_SAMPLER_UNIFORMS", getCustomMaterialSamplerUniforms(material));
 }
 
-void MaterialCompiler::compile(const Material& material, ShaderPass pass_shader, ModelShader model_shader) {
+std::vector<Limitless::Shader> MaterialCompiler::preprocess(const Material& material, ShaderPass pass_shader, ModelShader model_shader) const {
     const auto props = [&] (Shader& shader) {
         replaceMaterialSettings(shader, material, model_shader);
         replaceRenderSettings(shader);
     };
 
+    std::vector<Shader> sources;
     if (material.contains(Property::TessellationFactor)) {
-        *this << Shader { assets.getShaderDir() / "tesselation" / "tesselation.tcs", Shader::Type::TessControl, props }
-              << Shader { assets.getShaderDir() / "tesselation" / "tesselation.tes", Shader::Type::TessEval, props };
+        sources.emplace_back(assets.getShaderDir() / "tesselation" / "tesselation.tcs", Shader::Type::TessControl, props);
+        sources.emplace_back(assets.getShaderDir() / "tesselation" / "tesselation.tes", Shader::Type::TessEval, props);
     }
 
+    for (auto& shader : preprocess(assets.getShaderDir() / SHADER_PASS_PATH.at(pass_shader), props)) {
+        sources.emplace_back(std::move(shader));
+    }
+
+    return sources;
+}
+
+void MaterialCompiler::compile(const Material& material, ShaderPass pass_shader, ModelShader model_shader) {
 	try {
-		auto shader = compile(assets.getShaderDir() / SHADER_PASS_PATH.at(pass_shader), props);
+        for (auto& shader : preprocess(material, pass_shader, model_shader)) {
+            *this << std::move(shader);
+        }
+
+		auto shader = compile();
 		assets.shaders.add(pass_shader, model_shader, material.getShaderIndex(), shader);
 	} catch (const std::exception& e) {
-		throw material_compilation_error{material.getName() + e.what()};
+        // material that is compiled again after reload keeps its previous program
+        if (!assets.shaders.restore(pass_shader, model_shader, material.getShaderIndex())) {
+            throw material_compilation_error{material.getName() + e.what()};
+        }
+        PLOG_ERROR << material.getName() << " failed to compile, previous program is kept: " << e.what();
 	}
 }
@@ -29,18 +29,22 @@ void MaterialInstance::changeBaseMaterial(const std::shared_ptr<ms::Material>& m
 
 void MaterialInstance::changeMaterial(const std::shared_ptr<Material>& material) noexcept {
     materials[0] = std::make_shared<Material>(*material);
+    ++version;
 }
 
 void MaterialInstance::reset() noexcept {
     materials[0] = base;
+    ++version;
 }
 
 void MaterialInstance::clear() noexcept {
     materials.erase(++materials.begin(), materials.end());
+    ++version;
 }
 
 uint64_t MaterialInstance::apply(const std::shared_ptr<Material>& material) noexcept {
     materials.emplace(next_id, std::make_shared<Material>(*material));
+    ++version;
     return next_id++;
 }
 
@@ -50,6 +54,7 @@ void MaterialInstance::remove(uint64_t id) {
     }
 
     materials.erase(id);
+    ++version;
 }
 
 void MaterialInstance::setMaterialState(Context& ctx, uint64_t id, ShaderPass pass) {
@@ -93,10 +98,12 @@ void MaterialInstance::setMaterialState(Context& ctx, uint64_t id, ShaderPass pa
 
 void MaterialInstance::makeLayered() noexcept {
 	layered = true;
+	++version;
 }
 
 void MaterialInstance::makeNonLayered() noexcept {
 	layered = false;
+	++version;
 }
 
 bool MaterialInstance::isLayered() const noexcept {
@@ -1,7 +1,4 @@
 #include <limitless/pipeline/blur_pass.hpp>
-#include <limitless/pipeline/pipeline.hpp>
-#include <limitless/pipeline/deferred_framebuffer_pass.hpp>
-#include <iostream>
 
 using namespace Limitless;
 
@@ -10,8 +7,19 @@ BloomPass::BloomPass(Pipeline& pipeline, glm::uvec2 frame_size)
     , bloom {frame_size} {
 }
 
+void BloomPass::declare(RenderGraph::Builder& builder) {
+    builder.read("translucent");
+    // blur chain of bloom keeps its own textures
+    builder.import("bloom", bloom.getResult());
+    builder.write("bloom");
+}
+
+void BloomPass::realize(RenderGraph& graph) {
+    source = graph.getTexture("translucent");
+}
+
 void BloomPass::draw([[maybe_unused]] Instances& instances, Context& ctx, const Assets& assets, [[maybe_unused]] const Camera& camera, [[maybe_unused]] UniformSetter& setter) {
-    bloom.process(ctx, assets, getPreviousResult());
+    bloom.process(ctx, assets, source);
 }
 
 void BloomPass::onFramebufferChange(glm::uvec2 size) {
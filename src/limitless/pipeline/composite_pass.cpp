@@ -5,16 +5,29 @@
 #include <limitless/core/shader_program.hpp>
 #include <limitless/pipeline/blur_pass.hpp>
 #include <limitless/pipeline/pipeline.hpp>
-#include <limitless/pipeline/deferred_framebuffer_pass.hpp>
-#include <limitless/core/texture_builder.hpp>
-#include <limitless/pipeline/translucent_pass.hpp>
-#include <limitless/pipeline/deferred_lighting_pass.hpp>
 
 using namespace Limitless;
 
-CompositePass::CompositePass(Pipeline& pipeline, glm::uvec2 size)
+CompositePass::CompositePass(Pipeline& pipeline)
     : RenderPass(pipeline)
-    , framebuffer {Framebuffer::asRGB8LinearClampToEdge(size)} {
+    , framebuffer {} {
+}
+
+void CompositePass::declare(RenderGraph::Builder& builder) {
+    builder.read("translucent");
+    builder.read("bloom");
+    builder.create("composite", {Texture::InternalFormat::RGB8, Texture::Filter::Linear, glm::vec2{1.0f}, true});
+}
+
+void CompositePass::realize(RenderGraph& graph) {
+    lightened = graph.getTexture("translucent");
+    bloom = graph.getTexture("bloom");
+    bloom_pass = &pipeline.get<BloomPass>();
+
+    framebuffer.bind();
+    framebuffer << TextureAttachment{FramebufferAttachment::Color0, graph.getTexture("composite")};
+    framebuffer.checkStatus();
+    framebuffer.unbind();
 }
 
 std::shared_ptr<Texture> CompositePass::getResult() {
@@ -27,17 +40,16 @@ void CompositePass::draw([[maybe_unused]] Instances& instances, Context& ctx, co
 
     {
         ctx.setViewPort(getResult()->getSize());
-        framebuffer.clear();
+        framebuffer.bind();
 
         auto& shader = assets.shaders.get("composite");
 
-        shader << UniformSampler{"lightened", pipeline.get<TranslucentPass>().getResult()};
+        shader << UniformSampler{"lightened", lightened};
 
         {
-            auto& bloom_pass = pipeline.get<BloomPass>();
-            const auto bloom_strength = bloom_pass.getBloom().strength / static_cast<float>(bloom_pass.getBloom().blur.getIterationCount());
+            const auto bloom_strength = bloom_pass->getBloom().strength / static_cast<float>(bloom_pass->getBloom().blur.getIterationCount());
 
-            shader << UniformSampler{"bloom", bloom_pass.getResult()}
+            shader << UniformSampler{"bloom", bloom}
                    << UniformValue{"bloom_strength", bloom_strength};
         }
 
@@ -46,7 +58,3 @@ void CompositePass::draw([[maybe_unused]] Instances& instances, Context& ctx, co
         assets.meshes.at("quad")->draw();
     }
 }
-
-void CompositePass::onFramebufferChange(glm::uvec2 size) {
-    framebuffer.onFramebufferChange(size);
-}
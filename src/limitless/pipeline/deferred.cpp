@@ -4,6 +4,7 @@
 #include <limitless/ms/blending.hpp>
 
 #include <limitless/pipeline/sceneupdate_pass.hpp>
+#include <limitless/pipeline/virtual_texture_pass.hpp>
 #include <limitless/pipeline/effectupdate_pass.hpp>
 #include <limitless/pipeline/shadow_pass.hpp>
 #include <limitless/pipeline/skybox_pass.hpp>
@@ -13,6 +14,7 @@
 #include <limitless/pipeline/translucent_pass.hpp>
 #include <limitless/pipeline/gbuffer_pass.hpp>
 #include <limitless/pipeline/depth_pass.hpp>
+#include <limitless/pipeline/hiz_pass.hpp>
 #include <limitless/scene.hpp>
 #include <limitless/pipeline/blur_pass.hpp>
 #include <limitless/pipeline/composite_pass.hpp>
@@ -39,34 +41,40 @@ void Deferred::update(ContextEventObserver& ctx, const RenderSettings& settings)
 
 void Deferred::build(ContextEventObserver& ctx, const RenderSettings& settings) {
     add<SceneUpdatePass>(ctx);
+    add<VirtualTexturePass>();
     auto& fx = add<EffectUpdatePass>(ctx);
 
     if (settings.directional_cascade_shadow_mapping) {
         add<DirectionalShadowPass>(ctx, settings, fx.getRenderer());
     }
 
-    add<DeferredFramebufferPass>(size);
+    add<DeferredFramebufferPass>();
     add<DepthPass>(fx.getRenderer());
+
+    if (settings.occlusion_culling) {
+        add<HiZPass>(size);
+    }
+
     add<GBufferPass>(fx.getRenderer());
 
     add<SkyboxPass>();
 
 //    if (settings.screen_space_ambient_occlusion) {
-//        add<SSAOPass>(ctx, size);
+//        add<SSAOPass>(ctx);
 //    }
 
-    add<DeferredLightingPass>(size);
+    add<DeferredLightingPass>();
 
-    add<TranslucentPass>(fx.getRenderer(), size, get<DeferredFramebufferPass>().getDepth());
+    add<TranslucentPass>(fx.getRenderer());
 
     add<BloomPass>(size);
 
-    add<CompositePass>(size);
+    add<CompositePass>();
 
 //    add<OutlinePass>();
 
     if (settings.fast_approximate_antialiasing) {
-        add<FXAAPass>(size);
+        add<FXAAPass>();
     }
 
 //    if (settings.depth_of_field) {
@@ -74,4 +82,6 @@ void Deferred::build(ContextEventObserver& ctx, const RenderSettings& settings)
 //    }
 
     add<FinalQuadPass>(*target);
+
+    compile();
 }
@@ -1,14 +1,14 @@
 #include <limitless/pipeline/deferred_framebuffer_pass.hpp>
 
-#include <limitless/core/texture_builder.hpp>
-#include <iostream>
 
 using namespace Limitless;
 
-DeferredFramebufferPass::DeferredFramebufferPass(Pipeline& pipeline, glm::uvec2 frame_size)
+DeferredFramebufferPass::DeferredFramebufferPass(Pipeline& pipeline)
     : RenderPass(pipeline)
     , framebuffer {} {
+}
 
+void DeferredFramebufferPass::declare(RenderGraph::Builder& builder) {
     // UNSIGNED NORMALIZED [0; 1]
     // RGBA8 - RGB - base color, A - ao
 
@@ -21,18 +21,20 @@ DeferredFramebufferPass::DeferredFramebufferPass(Pipeline& pipeline, glm::uvec2
     // FLOATING POINT
     // RGB - emissive
 
-    auto albedo = TextureBuilder::asRGBA16NearestClampToEdge(frame_size);
-    auto normal = TextureBuilder::asRGB16SNORMNearestClampToEdge(frame_size);
-    auto props = TextureBuilder::asRGB16NearestClampToEdge(frame_size);
-    auto emissive = TextureBuilder::asRGB16FNearestClampToEdge(frame_size);
-    auto depth = TextureBuilder::asDepth32F(frame_size);
+    builder.create("albedo", {Texture::InternalFormat::RGBA16, Texture::Filter::Nearest, glm::vec2{1.0f}, true});
+    builder.create("normal", {Texture::InternalFormat::RGB16_SNORM, Texture::Filter::Nearest, glm::vec2{1.0f}, true});
+    builder.create("properties", {Texture::InternalFormat::RGB16, Texture::Filter::Nearest, glm::vec2{1.0f}, true});
+    builder.create("emissive", {Texture::InternalFormat::RGB16F, Texture::Filter::Nearest, glm::vec2{1.0f}, true});
+    builder.create("depth", {Texture::InternalFormat::Depth32F, Texture::Filter::Nearest, glm::vec2{1.0f}, true, glm::vec4{1.0f}});
+}
 
+void DeferredFramebufferPass::realize(RenderGraph& graph) {
     framebuffer.bind();
-    framebuffer << TextureAttachment{FramebufferAttachment::Color0, albedo}
-                << TextureAttachment{FramebufferAttachment::Color1, normal}
-                << TextureAttachment{FramebufferAttachment::Color2, props}
-                << TextureAttachment{FramebufferAttachment::Color3, emissive}
-                << TextureAttachment{FramebufferAttachment::Depth, depth};
+    framebuffer << TextureAttachment{FramebufferAttachment::Color0, graph.getTexture("albedo")}
+                << TextureAttachment{FramebufferAttachment::Color1, graph.getTexture("normal")}
+                << TextureAttachment{FramebufferAttachment::Color2, graph.getTexture("properties")}
+                << TextureAttachment{FramebufferAttachment::Color3, graph.getTexture("emissive")}
+                << TextureAttachment{FramebufferAttachment::Depth, graph.getTexture("depth")};
     framebuffer.checkStatus();
     framebuffer.unbind();
 }
@@ -52,10 +54,4 @@ void DeferredFramebufferPass::draw([[maybe_unused]] Instances& instances, Contex
         FramebufferAttachment::Color2,
         FramebufferAttachment::Color3
     });
-
-    framebuffer.clear();
-}
-
-void DeferredFramebufferPass::onFramebufferChange(glm::uvec2 size) {
-    framebuffer.onFramebufferChange(size);
 }
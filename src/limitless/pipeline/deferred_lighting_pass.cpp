@@ -4,39 +4,58 @@
 #include <limitless/core/uniform.hpp>
 #include <limitless/core/shader_program.hpp>
 #include <limitless/core/uniform_setter.hpp>
-#include <limitless/core/texture_builder.hpp>
-#include <limitless/pipeline/ssao_pass.hpp>
-#include <limitless/pipeline/pipeline.hpp>
-#include <limitless/pipeline/deferred_framebuffer_pass.hpp>
 
 using namespace Limitless;
 
-DeferredLightingPass::DeferredLightingPass(Pipeline& pipeline, glm::uvec2 frame_size)
+DeferredLightingPass::DeferredLightingPass(Pipeline& pipeline)
     : RenderPass(pipeline)
-    , framebuffer {Framebuffer::asRGB16FNearestClampToEdge(frame_size)} {
+    , framebuffer {} {
+}
+
+void DeferredLightingPass::declare(RenderGraph::Builder& builder) {
+    builder.read("albedo");
+    builder.read("normal");
+    builder.read("properties");
+    builder.read("depth");
+    builder.read("emissive");
+
+    if (builder.contains("ssao")) {
+        builder.read("ssao");
+    }
+
+    builder.create("lighting", {Texture::InternalFormat::RGB16F, Texture::Filter::Nearest, glm::vec2{1.0f}, true});
+}
+
+void DeferredLightingPass::realize(RenderGraph& graph) {
+    albedo = graph.getTexture("albedo");
+    normal = graph.getTexture("normal");
+    properties = graph.getTexture("properties");
+    depth = graph.getTexture("depth");
+    emissive = graph.getTexture("emissive");
+    ssao = graph.contains("ssao") ? graph.getTexture("ssao") : nullptr;
+
+    framebuffer.bind();
+    framebuffer << TextureAttachment{FramebufferAttachment::Color0, graph.getTexture("lighting")};
+    framebuffer.checkStatus();
+    framebuffer.unbind();
 }
 
 void DeferredLightingPass::draw([[maybe_unused]] Instances& instances, Context& ctx, [[maybe_unused]] const Assets& assets, [[maybe_unused]] const Camera& camera, UniformSetter& setter) {
     ctx.disable(Capabilities::DepthTest);
     ctx.disable(Capabilities::Blending);
 
-    framebuffer.clear();
-
-    auto& gbuffer = pipeline.get<DeferredFramebufferPass>();
+    framebuffer.bind();
 
     auto& shader = assets.shaders.get("deferred");
 
-    shader << UniformSampler{"base_texture", gbuffer.getAlbedo()}
-           << UniformSampler{"normal_texture", gbuffer.getNormal()}
-           << UniformSampler{"props_texture", gbuffer.getProperties()}
-           << UniformSampler{"depth_texture", gbuffer.getDepth()}
-           << UniformSampler{"emissive_texture", gbuffer.getEmissive()};
-
-    try {
-        auto& ssao = pipeline.get<SSAOPass>();
-        shader << UniformSampler{"ssao_texture", ssao.getResult()};
-    } catch (const pipeline_pass_not_found& e) {
-        // nothing :|
+    shader << UniformSampler{"base_texture", albedo}
+           << UniformSampler{"normal_texture", normal}
+           << UniformSampler{"props_texture", properties}
+           << UniformSampler{"depth_texture", depth}
+           << UniformSampler{"emissive_texture", emissive};
+
+    if (ssao) {
+        shader << UniformSampler{"ssao_texture", ssao};
     }
 
     setter(shader);
@@ -46,10 +65,6 @@ void DeferredLightingPass::draw([[maybe_unused]] Instances& instances, Context&
     assets.meshes.at("quad")->draw();
 }
 
-void DeferredLightingPass::onFramebufferChange(glm::uvec2 size) {
-    framebuffer.onFramebufferChange(size);
-}
-
 std::shared_ptr<Texture> DeferredLightingPass::getResult() {
     return framebuffer.get(FramebufferAttachment::Color0).texture;
 }
@@ -5,10 +5,13 @@
 #include <limitless/pipeline/shader_pass_types.hpp>
 #include <limitless/ms/blending.hpp>
 #include <limitless/util/sorter.hpp>
+#include <limitless/camera.hpp>
+#include <limitless/scene.hpp>
 #include <limitless/core/context.hpp>
 
 #include <limitless/fx/effect_renderer.hpp>
 #include <limitless/pipeline/deferred_framebuffer_pass.hpp>
+#include <limitless/pipeline/hiz_pass.hpp>
 
 using namespace Limitless;
 
@@ -17,8 +20,24 @@ DepthPass::DepthPass(Pipeline& pipeline, fx::EffectRenderer& _renderer)
     , renderer {_renderer} {
 }
 
+void DepthPass::declare(RenderGraph::Builder& builder) {
+    builder.write("depth");
+}
+
+void DepthPass::realize([[maybe_unused]] RenderGraph& graph) {
+    framebuffer = &pipeline.get<DeferredFramebufferPass>().getFramebuffer();
+    hiz = pipeline.find<HiZPass>();
+}
+
+void DepthPass::update(Scene& scene, [[maybe_unused]] Instances& instances, [[maybe_unused]] Context& ctx, [[maybe_unused]] const Camera& camera) {
+    scene_version = scene.getVersion();
+}
+
 void DepthPass::draw([[maybe_unused]] Instances& instances, Context& ctx, [[maybe_unused]] const Assets& assets, [[maybe_unused]] const Camera& camera, [[maybe_unused]] UniformSetter& setter) {
-    std::sort(instances.begin(), instances.end(), FrontToBackSorter{camera});
+    // commands of static instances are kept between frames; they are only reordered when camera moves
+    const auto moved = sorted_from != camera.getPosition();
+    sorted_from = camera.getPosition();
+    commands.update(instances, scene_version, assets, ShaderPass::Depth, ms::Blending::Opaque, FrontToBackSorter{camera}, moved);
 
     ctx.enable(Capabilities::DepthTest);
 	ctx.enable(Capabilities::StencilTest);
@@ -28,14 +47,25 @@ void DepthPass::draw([[maybe_unused]] Instances& instances, Context& ctx, [[mayb
     ctx.setStencilOp(StencilOp::Keep, StencilOp::Keep, StencilOp::Replace);
 	ctx.setStencilFunc(StencilFunc::Always, 1, 0xFF);
 
-	auto& fb = pipeline.get<DeferredFramebufferPass>().getFramebuffer();
-
-    fb.bind();
+    framebuffer->bind();
 
-    for (auto& instance : instances) {
-    	instance.get().isOutlined() ? ctx.setStencilMask(0xFF) : ctx.setStencilMask(0x00);
+    const auto outline = [&] (AbstractInstance& instance) {
+        instance.isOutlined() ? ctx.setStencilMask(0xFF) : ctx.setStencilMask(0x00);
+    };
 
-        instance.get().draw(ctx, assets, ShaderPass::Depth, ms::Blending::Opaque, setter);
+    occluded.clear();
+    if (!hiz) {
+        commands.replay(ctx, setter, outline);
+    } else {
+        // skinned bounds come from bind pose and other instances have none, so only models are tested
+        auto& tester = hiz->getOcclusionTester();
+        commands.replay(ctx, setter, outline, [&] (AbstractInstance& instance) {
+            if (instance.getShaderType() != ModelShader::Model || !tester.isOccluded(instance.getBoundingBox())) {
+                return true;
+            }
+            occluded.insert(&instance);
+            return false;
+        });
     }
 
     renderer.draw(ctx, assets, ShaderPass::Depth, ms::Blending::Opaque, setter);
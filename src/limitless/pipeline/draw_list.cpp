@@ -0,0 +1,256 @@
+#include <limitless/pipeline/draw_list.hpp>
+
+#include <limitless/instances/abstract_instance.hpp>
+#include <limitless/instances/material_instance.hpp>
+#include <limitless/models/abstract_mesh.hpp>
+#include <limitless/core/shader_program.hpp>
+#include <limitless/core/uniform_setter.hpp>
+#include <limitless/util/thread_pool.hpp>
+#include <limitless/ms/material.hpp>
+#include <limitless/assets.hpp>
+
+#include <algorithm>
+#include <exception>
+
+using namespace Limitless;
+
+namespace {
+    // entries stay almost in order between frames, so they are insertion sorted in about linear time;
+    // when too many of them moved, e.g. camera turned around, whole range is sorted instead
+    template<typename It, typename Compare>
+    void insertionSort(It begin, It end, const Compare& compare) {
+        auto budget = static_cast<size_t>(end - begin) * 4;
+        for (auto it = begin == end ? end : std::next(begin); it != end; ++it) {
+            if (!compare(*it, *std::prev(it))) {
+                continue;
+            }
+
+            auto value = std::move(*it);
+            auto hole = it;
+            do {
+                *hole = std::move(*std::prev(hole));
+                --hole;
+                if (budget-- == 0) {
+                    *hole = std::move(value);
+                    std::stable_sort(begin, end, compare);
+                    return;
+                }
+            } while (hole != begin && compare(value, *std::prev(hole)));
+            *hole = std::move(value);
+        }
+    }
+}
+
+DrawList::Segment::Segment(const DrawList& _list) noexcept
+    : list {&_list} {
+}
+
+void DrawList::Segment::add(const Command& command) {
+    commands.emplace_back(command);
+}
+
+void DrawList::Segment::addFallback(AbstractInstance& instance) {
+    Command command;
+    command.instance = &instance;
+    commands.emplace_back(command);
+}
+
+void DrawList::record(std::vector<std::reference_wrapper<AbstractInstance>>& instances, const Assets& _assets, ShaderPass _pass, ms::Blending _blending) {
+    // shader lookups are split between engine workers; calling thread records one of ranges
+    auto& pool = _assets.getWorkers();
+    const auto threads = pool.getThreadCount() + 1;
+
+    clear();
+
+    assets = &_assets;
+    pass = _pass;
+    blending = _blending;
+    shaders_version = _assets.shaders.getVersion();
+
+    const auto ranges = std::clamp<size_t>(instances.size() / RANGE_SIZE, 1, threads);
+    while (segments.size() < ranges) {
+        segments.emplace_back(*this);
+    }
+
+    entries.resize(instances.size());
+
+    const auto record_range = [&] (size_t range) {
+        auto& segment = segments[range];
+        const auto begin = instances.size() * range / ranges;
+        const auto end = instances.size() * (range + 1) / ranges;
+        for (auto i = begin; i < end; ++i) {
+            auto& instance = instances[i].get();
+            auto& entry = entries[i];
+
+            entry.instance = &instance;
+            entry.segment = &segment;
+            entry.version = instance.getVersion();
+            entry.transform_version = instance.getTransformVersion();
+            entry.begin = static_cast<uint32_t>(segment.getCommands().size());
+            instance.record(segment);
+            entry.end = static_cast<uint32_t>(segment.getCommands().size());
+        }
+    };
+
+    std::vector<std::future<void>> futures;
+    futures.reserve(ranges - 1);
+    for (size_t range = 1; range < ranges; ++range) {
+        futures.push_back(pool.add(record_range, range));
+    }
+
+    // workers use list and instances, so all of them are waited for before error is rethrown
+    std::exception_ptr error;
+    try {
+        record_range(0);
+    } catch (...) {
+        error = std::current_exception();
+    }
+
+    for (auto& future : futures) {
+        try {
+            future.get();
+        } catch (...) {
+            if (!error) {
+                error = std::current_exception();
+            }
+        }
+    }
+
+    if (error) {
+        clear();
+        std::rethrow_exception(error);
+    }
+
+    for (size_t range = 0; range < ranges; ++range) {
+        command_count += segments[range].getCommands().size();
+    }
+}
+
+void DrawList::patchEntry(Entry& entry) {
+    command_count -= entry.end - entry.begin;
+
+    entry.segment = &patch;
+    entry.version = entry.instance->getVersion();
+    entry.begin = static_cast<uint32_t>(patch.getCommands().size());
+    entry.instance->record(patch);
+    entry.end = static_cast<uint32_t>(patch.getCommands().size());
+
+    command_count += entry.end - entry.begin;
+}
+
+void DrawList::update(std::vector<std::reference_wrapper<AbstractInstance>>& instances,
+                      uint64_t version,
+                      const Assets& _assets,
+                      ShaderPass _pass,
+                      ms::Blending _blending,
+                      const Sorter& sorter,
+                      bool reorder) {
+    ++stats.updates;
+    stats.instances += instances.size();
+
+    // patch segment holds outdated commands of instances patched more than once
+    const auto valid = content_version == version &&
+                       assets == &_assets &&
+                       pass == _pass &&
+                       blending == _blending &&
+                       shaders_version == _assets.shaders.getVersion() &&
+                       patch.getCommands().size() <= std::max(command_count, RANGE_SIZE);
+
+    if (!valid) {
+        std::sort(instances.begin(), instances.end(), sorter);
+        record(instances, _assets, _pass, _blending);
+        content_version = version;
+
+        ++stats.misses;
+        stats.recorded += instances.size();
+        return;
+    }
+
+    uint64_t patched {};
+    for (auto& entry : entries) {
+        if (entry.transform_version != entry.instance->getTransformVersion()) {
+            entry.transform_version = entry.instance->getTransformVersion();
+            reorder = true;
+        }
+
+        if (entry.version != entry.instance->getVersion()) {
+            patchEntry(entry);
+            ++patched;
+        }
+    }
+
+    if (reorder) {
+        insertionSort(entries.begin(), entries.end(), [&] (const Entry& lhs, const Entry& rhs) {
+            return sorter(std::ref(*lhs.instance), std::ref(*rhs.instance));
+        });
+    }
+
+    if (patched == 0) {
+        ++stats.hits;
+    }
+    stats.recorded += patched;
+}
+
+float DrawList::getHitRate() const noexcept {
+    if (stats.instances == 0) {
+        return 0.0f;
+    }
+
+    return 1.0f - static_cast<float>(stats.recorded) / static_cast<float>(stats.instances);
+}
+
+void DrawList::replay(Context& ctx, const UniformSetter& setter, const InstanceCallback& callback, const InstanceFilter& filter) const {
+    for (const auto& entry : entries) {
+        if (entry.begin == entry.end) {
+            continue;
+        }
+
+        if (filter && !filter(*entry.instance)) {
+            continue;
+        }
+
+        if (callback) {
+            callback(*entry.instance);
+        }
+
+        const auto& commands = entry.segment->getCommands();
+        for (auto i = entry.begin; i < entry.end; ++i) {
+            const auto& command = commands[i];
+
+            if (!command.shader) {
+                command.instance->draw(ctx, *assets, pass, blending, setter);
+                continue;
+            }
+
+            // sets state for material
+            command.material->setMaterialState(ctx, command.layer_id, pass);
+
+            // updates model/material uniforms
+            auto& shader = *command.shader;
+            shader << UniformValue {"_model_transform", *command.model_matrix}
+                   << *command.layer;
+
+            // sets custom pass-dependent uniforms
+            setter(shader);
+
+            shader.use();
+
+            if (command.patches) {
+                glPatchParameteri(GL_PATCH_VERTICES, 4);
+                command.mesh->draw(VertexStreamDraw::Patches);
+            } else {
+                command.mesh->draw();
+            }
+        }
+    }
+}
+
+void DrawList::clear() noexcept {
+    for (auto& segment : segments) {
+        segment.clear();
+    }
+    patch.clear();
+    entries.clear();
+    command_count = 0;
+    content_version = std::nullopt;
+}
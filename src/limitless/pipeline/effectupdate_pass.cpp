@@ -1,5 +1,7 @@
 #include <limitless/pipeline/effectupdate_pass.hpp>
 
+#include <limitless/scene.hpp>
+
 using namespace Limitless;
 
 EffectUpdatePass::EffectUpdatePass(Pipeline& pipeline, Context& ctx)
@@ -7,6 +9,6 @@ EffectUpdatePass::EffectUpdatePass(Pipeline& pipeline, Context& ctx)
     , renderer {ctx} {
 }
 
-void EffectUpdatePass::update([[maybe_unused]] Scene& scene, Instances& instances, [[maybe_unused]] Context& ctx, [[maybe_unused]] const Camera& camera) {
-    renderer.update(instances);
+void EffectUpdatePass::update(Scene& scene, Instances& instances, [[maybe_unused]] Context& ctx, [[maybe_unused]] const Camera& camera) {
+    renderer.update(instances, scene.getTime());
 }
\ No newline at end of file
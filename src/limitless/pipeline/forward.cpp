@@ -4,6 +4,7 @@
 #include <limitless/ms/blending.hpp>
 
 #include <limitless/pipeline/sceneupdate_pass.hpp>
+#include <limitless/pipeline/virtual_texture_pass.hpp>
 #include <limitless/pipeline/effectupdate_pass.hpp>
 #include <limitless/pipeline/shadow_pass.hpp>
 #include <limitless/pipeline/framebuffer_pass.hpp>
@@ -26,6 +27,7 @@ using namespace Limitless;
 //
 //void Forward::create(ContextEventObserver& ctx, const RenderSettings& settings) {
 //    add<SceneUpdatePass>(ctx);
+//    add<VirtualTexturePass>();
 //    auto& fx = add<EffectUpdatePass>(ctx);
 //
 //    if (settings.directional_cascade_shadow_mapping) {
@@ -4,16 +4,26 @@
 #include <limitless/core/uniform.hpp>
 #include <limitless/assets.hpp>
 #include <limitless/core/shader_program.hpp>
-#include <limitless/pipeline/pipeline.hpp>
-#include <limitless/pipeline/composite_pass.hpp>
-#include <limitless/core/texture_builder.hpp>
-#include <limitless/pipeline/deferred_framebuffer_pass.hpp>
 
 using namespace Limitless;
 
-FXAAPass::FXAAPass(Pipeline& pipeline, glm::uvec2 frame_size)
+FXAAPass::FXAAPass(Pipeline& pipeline)
     : RenderPass(pipeline)
-    , framebuffer {Framebuffer::asRGB8LinearClampToEdge(frame_size)} {
+    , framebuffer {} {
+}
+
+void FXAAPass::declare(RenderGraph::Builder& builder) {
+    builder.read("composite");
+    builder.create("antialiased", {Texture::InternalFormat::RGB8, Texture::Filter::Linear, glm::vec2{1.0f}, true});
+}
+
+void FXAAPass::realize(RenderGraph& graph) {
+    scene = graph.getTexture("composite");
+
+    framebuffer.bind();
+    framebuffer << TextureAttachment{FramebufferAttachment::Color0, graph.getTexture("antialiased")};
+    framebuffer.checkStatus();
+    framebuffer.unbind();
 }
 
 void FXAAPass::draw([[maybe_unused]] Instances& instances, Context& ctx, const Assets& assets, [[maybe_unused]] const Camera& camera, [[maybe_unused]] UniformSetter& setter) {
@@ -21,17 +31,13 @@ void FXAAPass::draw([[maybe_unused]] Instances& instances, Context& ctx, const A
     ctx.disable(Capabilities::Blending);
 
     {
-        framebuffer.clear();
+        framebuffer.bind();
         auto& shader = assets.shaders.get("fxaa");
 
-        shader << UniformSampler{"scene", getPreviousResult()};
+        shader << UniformSampler{"scene", scene};
 
         shader.use();
 
         assets.meshes.at("quad")->draw();
     }
 }
-
-void FXAAPass::onFramebufferChange(glm::uvec2 size) {
-    framebuffer.onFramebufferChange(size);
-}
@@ -5,9 +5,12 @@
 #include <limitless/pipeline/pipeline.hpp>
 #include <limitless/ms/blending.hpp>
 #include <limitless/util/sorter.hpp>
+#include <limitless/camera.hpp>
+#include <limitless/scene.hpp>
 #include <limitless/core/context.hpp>
 #include <limitless/fx/effect_renderer.hpp>
 #include <limitless/pipeline/deferred_framebuffer_pass.hpp>
+#include <limitless/pipeline/depth_pass.hpp>
 #include <iostream>
 
 using namespace Limitless;
@@ -18,20 +21,42 @@ GBufferPass::GBufferPass(Pipeline& pipeline, fx::EffectRenderer& _renderer)
 
 }
 
+void GBufferPass::declare(RenderGraph::Builder& builder) {
+    builder.read("depth", RenderGraph::Access::Attachment);
+    builder.write("albedo");
+    builder.write("normal");
+    builder.write("properties");
+    builder.write("emissive");
+}
+
+void GBufferPass::realize([[maybe_unused]] RenderGraph& graph) {
+    framebuffer = &pipeline.get<DeferredFramebufferPass>().getFramebuffer();
+    depth = pipeline.find<DepthPass>();
+}
+
+void GBufferPass::update(Scene& scene, [[maybe_unused]] Instances& instances, [[maybe_unused]] Context& ctx, [[maybe_unused]] const Camera& camera) {
+    scene_version = scene.getVersion();
+}
+
 void GBufferPass::draw([[maybe_unused]] Instances& instances, Context& ctx, [[maybe_unused]] const Assets& assets, [[maybe_unused]] const Camera& camera, [[maybe_unused]] UniformSetter& setter) {
-    std::sort(instances.begin(), instances.end(), FrontToBackSorter{camera});
+    // commands of static instances are kept between frames; they are only reordered when camera moves
+    const auto moved = sorted_from != camera.getPosition();
+    sorted_from = camera.getPosition();
+    commands.update(instances, scene_version, assets, ShaderPass::GBuffer, ms::Blending::Opaque, FrontToBackSorter{camera}, moved);
 
     ctx.enable(Capabilities::DepthTest);
     ctx.disable(Capabilities::Blending);
     ctx.setDepthFunc(DepthFunc::Equal);
     ctx.setDepthMask(DepthMask::False);
 
-    auto& fb = pipeline.get<DeferredFramebufferPass>().getFramebuffer();
-
-    fb.bind();
+    framebuffer->bind();
 
-    for (auto& instance : instances) {
-        instance.get().draw(ctx, assets, ShaderPass::GBuffer, ms::Blending::Opaque, setter);
+    if (!depth) {
+        commands.replay(ctx, setter);
+    } else {
+        commands.replay(ctx, setter, {}, [&] (AbstractInstance& instance) {
+            return !depth->isOccluded(instance);
+        });
     }
 
     renderer.draw(ctx, assets, ShaderPass::GBuffer, ms::Blending::Opaque, setter);
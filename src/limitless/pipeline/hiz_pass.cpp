@@ -0,0 +1,221 @@
+#include <limitless/pipeline/hiz_pass.hpp>
+
+#include <limitless/core/texture_builder.hpp>
+#include <limitless/core/buffer_builder.hpp>
+#include <limitless/core/shader_program.hpp>
+#include <limitless/core/uniform.hpp>
+#include <limitless/core/context.hpp>
+#include <limitless/camera.hpp>
+#include <limitless/assets.hpp>
+
+using namespace Limitless;
+
+namespace {
+    glm::uvec2 getLevelSize(const Texture& texture, uint32_t level) noexcept {
+        return glm::max(glm::uvec2{texture.getSize()} >> level, glm::uvec2{1});
+    }
+
+    std::shared_ptr<Texture> makePyramid(glm::uvec2 size, uint32_t level_count) {
+        TextureBuilder builder;
+        return builder.setTarget(Texture::Type::Tex2D)
+                .setFormat(Texture::Format::RG)
+                .setInternalFormat(Texture::InternalFormat::RG32F)
+                .setDataType(Texture::DataType::Float)
+                .setSize(size)
+                .setWrapS(Texture::Wrap::ClampToEdge)
+                .setWrapT(Texture::Wrap::ClampToEdge)
+                .setMinFilter(Texture::Filter::NearestMipmapNearest)
+                .setMagFilter(Texture::Filter::Nearest)
+                .setLevels(level_count)
+                .setMipMap(true)
+                .build();
+    }
+
+    void attachLevels(std::vector<Framebuffer>& framebuffers, const std::shared_ptr<Texture>& texture, uint32_t first) {
+        for (uint32_t i = 0; i < framebuffers.size(); ++i) {
+            framebuffers[i].bind();
+            framebuffers[i] << TextureAttachment{FramebufferAttachment::Color0, texture, 0, first + i};
+            framebuffers[i].drawBuffer(FramebufferAttachment::Color0);
+            framebuffers[i].checkStatus();
+            framebuffers[i].unbind();
+        }
+    }
+}
+
+HiZPass::HiZPass(Pipeline& pipeline, glm::uvec2 frame_size)
+    : RenderPass {pipeline} {
+    build(frame_size);
+}
+
+HiZPass::~HiZPass() {
+    releaseReadbacks();
+}
+
+void HiZPass::build(glm::uvec2 frame_size) {
+    const auto size = glm::max(frame_size / 2u, glm::uvec2{1});
+    const auto level_count = static_cast<uint32_t>(glm::floor(glm::log2(static_cast<float>(glm::max(size.x, size.y))))) + 1;
+
+    pyramid = makePyramid(size, level_count);
+    scratch = makePyramid(size, level_count);
+
+    levels.clear();
+    levels.resize(level_count);
+    attachLevels(levels, pyramid, 0);
+
+    scratch_levels.clear();
+    scratch_levels.resize(level_count - 1);
+    attachLevels(scratch_levels, scratch, 1);
+
+    readback_level = 0;
+    while (readback_level + 1 < level_count && glm::max(size.x >> readback_level, size.y >> readback_level) > READBACK_SIZE) {
+        ++readback_level;
+    }
+
+    // depth of old size is not comparable with new frames
+    releaseReadbacks();
+    tester.reset();
+}
+
+void HiZPass::releaseReadbacks() noexcept {
+    for (auto& readback : readbacks) {
+        if (readback.fence) {
+            glDeleteSync(readback.fence);
+        }
+        readback = {};
+    }
+    next = 0;
+}
+
+void HiZPass::declare(RenderGraph::Builder& builder) {
+    builder.read("depth");
+    // pyramid keeps its own texture with mip levels
+    builder.import("hiz", pyramid);
+    builder.write("hiz");
+    // readback feeds occlusion tests even when nothing samples pyramid
+    builder.setSideEffect();
+}
+
+void HiZPass::realize(RenderGraph& graph) {
+    depth = graph.getTexture("depth");
+}
+
+void HiZPass::downsample(Context& ctx, const Assets& assets) {
+    ctx.disable(Capabilities::DepthTest);
+    ctx.disable(Capabilities::StencilTest);
+    ctx.disable(Capabilities::Blending);
+
+    const auto viewport = ctx.getViewPort();
+
+    auto& shader = assets.shaders.get("hiz");
+    for (uint32_t i = 0; i < levels.size(); ++i) {
+        // level 0 is reduced from depth buffer, others from previous level
+        shader << UniformSampler{"source", i == 0 ? depth : pyramid}
+               << UniformValue{"level", static_cast<int>(i == 0 ? 0 : i - 1)}
+               << UniformValue{"from_depth", static_cast<int>(i == 0)};
+
+        // pyramid cannot be attached while it is sampled, so its levels are rendered into scratch and copied back
+        auto& target = i == 0 ? levels[0] : scratch_levels[i - 1];
+        target.bind();
+        ctx.setViewPort(getLevelSize(*pyramid, i));
+
+        shader.use();
+
+        assets.meshes.at("quad")->draw();
+
+        if (i != 0) {
+            levels[i].blit(target, Texture::Filter::Nearest);
+        }
+    }
+
+    ctx.setViewPort(viewport);
+}
+
+void HiZPass::capture(const Camera& camera) {
+    auto& readback = readbacks[next];
+
+    // GPU is too far behind, this frame is not read back
+    if (readback.fence) {
+        return;
+    }
+
+    readback.size = getLevelSize(*pyramid, readback_level);
+    const auto bytes = static_cast<size_t>(readback.size.x) * readback.size.y * sizeof(float);
+
+    if (!readback.buffer || readback.buffer->getSize() != bytes) {
+        readback.buffer = BufferBuilder()
+                .setTarget(Buffer::Type::PixelPack)
+                .setUsage(Buffer::Usage::StreamRead)
+                .setAccess(Buffer::MutableAccess::None)
+                .setDataSize(bytes)
+                .build();
+    }
+
+    // only farthest depth is tested on CPU
+    levels[readback_level].bind();
+    readback.buffer->bind();
+    glReadPixels(0, 0, static_cast<GLsizei>(readback.size.x), static_cast<GLsizei>(readback.size.y), GL_GREEN, GL_FLOAT, nullptr);
+    unbindPackBuffer();
+
+    readback.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    readback.view_projection = camera.getProjection() * camera.getView();
+
+    next = (next + 1) % READBACK_COUNT;
+}
+
+void HiZPass::unbindPackBuffer() noexcept {
+    // other reads of pixels use client memory, so pack buffer cannot stay bound
+    if (auto* state = ContextState::getState(glfwGetCurrentContext()); state) {
+        auto& target = state->buffer_target[Buffer::Type::PixelPack];
+        if (target != 0) {
+            glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+            target = 0;
+        }
+    }
+}
+
+void HiZPass::poll() {
+    // readbacks finish in order they were captured, only the newest finished one is used
+    Readback* finished {};
+    for (uint32_t i = 0; i < READBACK_COUNT; ++i) {
+        auto& readback = readbacks[(next + i) % READBACK_COUNT];
+        if (!readback.fence) {
+            continue;
+        }
+
+        const auto result = glClientWaitSync(readback.fence, 0, 0);
+        if (result != GL_ALREADY_SIGNALED && result != GL_CONDITION_SATISFIED) {
+            break;
+        }
+
+        glDeleteSync(readback.fence);
+        readback.fence = {};
+        finished = &readback;
+    }
+
+    if (!finished) {
+        return;
+    }
+
+    std::vector<float> farthest(static_cast<size_t>(finished->size.x) * finished->size.y);
+
+    finished->buffer->bind();
+    glGetBufferSubData(GL_PIXEL_PACK_BUFFER, 0, static_cast<GLsizeiptr>(farthest.size() * sizeof(float)), farthest.data());
+    unbindPackBuffer();
+
+    tester.update(finished->size, std::move(farthest), finished->view_projection);
+}
+
+void HiZPass::update([[maybe_unused]] Scene& scene, [[maybe_unused]] Instances& instances, [[maybe_unused]] Context& ctx, [[maybe_unused]] const Camera& camera) {
+    // tester is updated before any pass draws, so all of them see the same depth
+    tester.onFrame();
+    poll();
+}
+
+void HiZPass::draw([[maybe_unused]] Instances& instances, Context& ctx, const Assets& assets, const Camera& camera, [[maybe_unused]] UniformSetter& setter) {
+    downsample(ctx, assets);
+    capture(camera);
+}
+
+void HiZPass::onFramebufferChange(glm::uvec2 size) {
+    build(size);
+}
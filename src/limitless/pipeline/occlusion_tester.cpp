@@ -0,0 +1,121 @@
+#include <limitless/pipeline/occlusion_tester.hpp>
+
+#include <algorithm>
+#include <stdexcept>
+#include <limits>
+
+using namespace Limitless;
+
+void OcclusionTester::update(glm::uvec2 size, std::vector<float> depth, const glm::mat4& _view_projection) {
+    if (size.x == 0 || size.y == 0 || depth.size() != static_cast<size_t>(size.x) * size.y) {
+        throw std::logic_error{"Occlusion depth does not match its size"};
+    }
+
+    levels.clear();
+    sizes.clear();
+
+    levels.emplace_back(std::move(depth));
+    sizes.emplace_back(size);
+    view_projection = _view_projection;
+
+    // same reduction as pyramid on GPU: last texel of odd row or column covers three finer ones
+    while (sizes.back().x > 1 || sizes.back().y > 1) {
+        const auto source = sizes.back();
+        const auto level = static_cast<uint32_t>(levels.size() - 1);
+        const auto reduced = glm::max(source / 2u, glm::uvec2{1});
+
+        std::vector<float> farthest(static_cast<size_t>(reduced.x) * reduced.y);
+        for (uint32_t y = 0; y < reduced.y; ++y) {
+            for (uint32_t x = 0; x < reduced.x; ++x) {
+                const auto first = glm::uvec2{x, y} * 2u;
+                const auto last = glm::uvec2{
+                    x == reduced.x - 1 ? source.x - 1 : first.x + 1,
+                    y == reduced.y - 1 ? source.y - 1 : first.y + 1
+                };
+                farthest[static_cast<size_t>(y) * reduced.x + x] = getFarthest(level, first, last);
+            }
+        }
+
+        levels.emplace_back(std::move(farthest));
+        sizes.emplace_back(reduced);
+    }
+}
+
+void OcclusionTester::reset() noexcept {
+    levels.clear();
+    sizes.clear();
+}
+
+float OcclusionTester::getFarthest(uint32_t level, glm::uvec2 first, glm::uvec2 last) const noexcept {
+    const auto& depth = levels[level];
+    const auto width = sizes[level].x;
+
+    auto farthest = 0.0f;
+    for (auto y = first.y; y <= last.y; ++y) {
+        for (auto x = first.x; x <= last.x; ++x) {
+            farthest = std::max(farthest, depth[static_cast<size_t>(y) * width + x]);
+        }
+    }
+    return farthest;
+}
+
+bool OcclusionTester::isOccluded(const BoundingBox& box) noexcept {
+    if (levels.empty()) {
+        return false;
+    }
+
+    ++frame_stats.tested;
+
+    if (box.size == glm::vec3{0.0f}) {
+        return false;
+    }
+
+    auto min = glm::vec2{std::numeric_limits<float>::max()};
+    auto max = glm::vec2{std::numeric_limits<float>::lowest()};
+    auto nearest = std::numeric_limits<float>::max();
+    for (uint32_t i = 0; i < 8; ++i) {
+        const auto corner = box.center + box.size * (glm::vec3(i & 1, (i >> 1) & 1, (i >> 2) & 1) - 0.5f);
+        const auto clip = view_projection * glm::vec4{corner, 1.0f};
+
+        // corner in front of near plane cannot be projected
+        if (clip.w <= 0.0f || clip.z < -clip.w) {
+            return false;
+        }
+
+        const auto ndc = glm::vec3{clip} / clip.w;
+        min = glm::min(min, glm::vec2{ndc});
+        max = glm::max(max, glm::vec2{ndc});
+        nearest = std::min(nearest, ndc.z * 0.5f + 0.5f);
+    }
+
+    // boxes outside of screen are left to frustum culling
+    if (max.x < -1.0f || max.y < -1.0f || min.x > 1.0f || min.y > 1.0f) {
+        return false;
+    }
+
+    const auto size = glm::vec2{sizes.front()};
+    const auto toTexel = [&] (const glm::vec2& ndc) {
+        return glm::uvec2{glm::clamp((ndc * 0.5f + 0.5f) * size, glm::vec2{0.0f}, size - 1.0f)};
+    };
+
+    auto first = toTexel(min);
+    auto last = toTexel(max);
+    uint32_t level {};
+    while (level + 1 < levels.size() && (last.x - first.x >= MAX_TEXELS || last.y - first.y >= MAX_TEXELS)) {
+        ++level;
+        first = glm::min(first / 2u, sizes[level] - 1u);
+        last = glm::min(last / 2u, sizes[level] - 1u);
+    }
+
+    if (nearest <= getFarthest(level, first, last)) {
+        return false;
+    }
+
+    ++frame_stats.occluded;
+    return true;
+}
+
+void OcclusionTester::onFrame() noexcept {
+    last_frame_stats = frame_stats;
+    frame_stats = {};
+}
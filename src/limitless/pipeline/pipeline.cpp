@@ -4,26 +4,102 @@
 #include <limitless/core/uniform_setter.hpp>
 #include <limitless/pipeline/render_pass.hpp>
 #include <limitless/core/framebuffer.hpp>
+#include <limitless/core/gpu_memory.hpp>
 #include <limitless/pipeline/quad_pass.hpp>
 
+#include <limitless/core/profiler.hpp>
+
+#include <plog/Log.h>
+
+#include <typeinfo>
+#include <sstream>
+#include <cstdlib>
+
+#ifdef __GNUG__
+    #include <cxxabi.h>
+#endif
+
 using namespace Limitless;
 
+namespace {
+    // class name of pass without namespaces
+    std::string getPassName(const RenderPass& pass) {
+        std::string name = typeid(pass).name();
+#ifdef __GNUG__
+        int status {};
+        std::unique_ptr<char, decltype(&std::free)> demangled {abi::__cxa_demangle(name.c_str(), nullptr, nullptr, &status), &std::free};
+        if (status == 0) {
+            name = demangled.get();
+        }
+#endif
+        if (const auto pos = name.rfind("::"); pos != std::string::npos) {
+            name.erase(0, pos + 2);
+        }
+        return name;
+    }
+}
+
 Pipeline::Pipeline(glm::uvec2 size, RenderTarget& target) noexcept
     : target {&target}
     , size {size} {
 }
 
 void Pipeline::draw(Context& context, const Assets& assets, Scene& scene, Camera& camera) {
-    Instances instances;
+    context.onFrame();
+    context.getTextureBinder().onFrame();
+    context.getFrameRing().onFrame();
+    GpuMemory::onFrame();
+    profiler.onFrame();
 
-    for (const auto& pass : passes) {
-        pass->update(scene, instances, context, camera);
+    // passes added after pipeline was built
+    if (graph.getPassCount() != passes.size()) {
+        compile();
+    }
+
+    {
+        ProfilerScope update_scope {"update"};
+        for (uint32_t i = 0; i < passes.size(); ++i) {
+            if (!graph.isCulled(i)) {
+                ProfilerScope scope {graph.getName(i)};
+                passes[i]->update(scene, instances, context, camera);
+            }
+        }
     }
 
+    ProfilerScope draw_scope {"draw"};
     UniformSetter setter;
+    for (uint32_t i = 0; i < passes.size(); ++i) {
+        if (graph.isCulled(i)) {
+            continue;
+        }
+
+        ProfilerScope scope {graph.getName(i)};
+        graph.begin(i, context);
+        passes[i]->draw(instances, context, assets, camera, setter);
+        passes[i]->addSetter(setter);
+    }
+}
+
+void Pipeline::compile() {
+    graph.reset();
+
     for (const auto& pass : passes) {
-        pass->draw(instances, context, assets, camera, setter);
-        pass->addSetter(setter);
+        auto builder = graph.addPass(getPassName(*pass));
+        pass->declare(builder);
+    }
+
+    graph.compile(size);
+
+#ifdef GL_DEBUG
+    std::stringstream report;
+    graph.report(report);
+    PLOG_DEBUG << report.str();
+#endif
+
+    for (uint32_t i = 0; i < passes.size(); ++i) {
+        if (!graph.isCulled(i)) {
+            passes[i]->realize(graph);
+        }
     }
 }
 
@@ -32,15 +108,21 @@ void Pipeline::update([[maybe_unused]] ContextEventObserver& ctx, [[maybe_unused
 
 void Pipeline::clear() {
     passes.clear();
+    graph.reset();
+    instances.clear();
 }
 
 void Pipeline::onFramebufferChange(glm::uvec2 frame_size) {
     size = frame_size;
 
+    // passes resize textures they import into graph before it is compiled again
     for (const auto& pass : passes) {
         pass->onFramebufferChange(size);
     }
 
+    // transient textures are reallocated by graph
+    compile();
+
     target->onFramebufferChange(size);
 }
 
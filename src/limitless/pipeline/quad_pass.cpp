@@ -20,6 +20,12 @@ FinalQuadPass::FinalQuadPass(Pipeline& pipeline, RenderTarget& _target)
 	, target {&_target} {
 }
 
+void FinalQuadPass::declare(RenderGraph::Builder& builder) {
+    // draws to target outside of graph
+    builder.setSideEffect();
+    builder.readPrevious();
+}
+
 void FinalQuadPass::draw([[maybe_unused]] Instances& instances, Context& ctx, const Assets& assets, [[maybe_unused]] const Camera& camera, [[maybe_unused]] UniformSetter& setter) {
     ctx.disable(Capabilities::DepthTest);
     ctx.disable(Capabilities::Blending);
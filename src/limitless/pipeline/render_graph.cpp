@@ -0,0 +1,427 @@
+#include <limitless/pipeline/render_graph.hpp>
+
+#include <limitless/core/context.hpp>
+#include <limitless/core/framebuffer.hpp>
+#include <limitless/core/texture_builder.hpp>
+#include <limitless/core/context_initializer.hpp>
+#include <algorithm>
+#include <numeric>
+
+using namespace Limitless;
+
+namespace {
+    GLbitfield getBarrier(RenderGraph::Access access) noexcept {
+        switch (access) {
+            case RenderGraph::Access::Sampled: return GL_TEXTURE_FETCH_BARRIER_BIT;
+            case RenderGraph::Access::Attachment: return GL_FRAMEBUFFER_BARRIER_BIT;
+            case RenderGraph::Access::Storage: return GL_SHADER_IMAGE_ACCESS_BARRIER_BIT;
+        }
+        return 0;
+    }
+
+    bool isCompatible(const RenderGraph::TextureDescriptor& a, const RenderGraph::TextureDescriptor& b) noexcept {
+        return a.format == b.format && a.filter == b.filter;
+    }
+}
+
+RenderGraph::Builder::Builder(RenderGraph& _graph, PassId _pass) noexcept
+    : graph {_graph}
+    , pass {_pass} {
+}
+
+RenderGraph::ResourceId RenderGraph::Builder::create(const std::string& name, const TextureDescriptor& descriptor) {
+    const auto id = graph.add(name);
+    graph.resources[id].descriptor = descriptor;
+    return write(name);
+}
+
+RenderGraph::ResourceId RenderGraph::Builder::import(const std::string& name, std::shared_ptr<Texture> texture) {
+    const auto id = graph.add(name);
+    graph.resources[id].imported = std::move(texture);
+    return id;
+}
+
+RenderGraph::ResourceId RenderGraph::Builder::read(const std::string& name, Access access) {
+    const auto id = graph.getId(name);
+    graph.passes[pass].reads.push_back({id, access});
+    return id;
+}
+
+RenderGraph::ResourceId RenderGraph::Builder::write(const std::string& name, Access access) {
+    const auto id = graph.getId(name);
+    graph.passes[pass].writes.push_back({id, access});
+    graph.resources[id].last_writer = pass;
+    return id;
+}
+
+std::optional<RenderGraph::ResourceId> RenderGraph::Builder::readPrevious(Access access) {
+    std::optional<ResourceId> previous;
+    std::optional<PassId> writer;
+
+    for (ResourceId id = 0; id < graph.resources.size(); ++id) {
+        const auto& last = graph.resources[id].last_writer;
+        if (last && *last < pass && (!writer || *last >= *writer)) {
+            writer = last;
+            previous = id;
+        }
+    }
+
+    if (previous) {
+        graph.passes[pass].reads.push_back({*previous, access});
+    }
+
+    return previous;
+}
+
+bool RenderGraph::Builder::contains(const std::string& name) const noexcept {
+    return graph.contains(name);
+}
+
+void RenderGraph::Builder::setSideEffect() noexcept {
+    graph.passes[pass].side_effect = true;
+}
+
+RenderGraph::RenderGraph() = default;
+RenderGraph::~RenderGraph() = default;
+
+RenderGraph::Builder RenderGraph::addPass(std::string name) {
+    passes.push_back({std::move(name)});
+    return {*this, static_cast<PassId>(passes.size() - 1)};
+}
+
+RenderGraph::ResourceId RenderGraph::add(const std::string& name) {
+    if (contains(name)) {
+        throw render_graph_error{"Resource " + name + " is already declared!"};
+    }
+
+    const auto id = static_cast<ResourceId>(resources.size());
+    resources.push_back({name});
+    names.emplace(name, id);
+    return id;
+}
+
+RenderGraph::ResourceId RenderGraph::getId(const std::string& name) const {
+    if (auto found = names.find(name); found != names.end()) {
+        return found->second;
+    }
+
+    throw render_graph_error{"There is no resource " + name + " in graph!"};
+}
+
+void RenderGraph::reset() noexcept {
+    passes.clear();
+    resources.clear();
+    names.clear();
+    stats = {};
+}
+
+void RenderGraph::cull() {
+    // walks passes backwards; pass is needed when later needed pass reads anything it writes
+    std::vector<bool> needed(resources.size());
+
+    for (auto i = passes.size(); i-- > 0;) {
+        auto& pass = passes[i];
+
+        pass.culled = !pass.side_effect && std::none_of(pass.writes.begin(), pass.writes.end(), [&] (const Use& use) {
+            return needed[use.resource];
+        });
+
+        if (!pass.culled) {
+            for (const auto& use : pass.reads) {
+                needed[use.resource] = true;
+            }
+        }
+    }
+}
+
+void RenderGraph::computeLifetimes() {
+    for (PassId id = 0; id < passes.size(); ++id) {
+        if (passes[id].culled) {
+            continue;
+        }
+
+        for (const auto* uses : {&passes[id].reads, &passes[id].writes}) {
+            for (const auto& use : *uses) {
+                auto& resource = resources[use.resource];
+                if (!resource.first) {
+                    resource.first = id;
+                }
+                resource.last = std::max(resource.last, id);
+            }
+        }
+    }
+}
+
+void RenderGraph::alias() {
+    std::vector<ResourceId> order(resources.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&] (ResourceId a, ResourceId b) {
+        return resources[a].first < resources[b].first;
+    });
+
+    for (const auto id : order) {
+        auto& resource = resources[id];
+        if (resource.imported || !resource.first) {
+            continue;
+        }
+
+        const auto size = getSize(resource.descriptor);
+        stats.requested += Texture::getTexelSize(resource.descriptor.format) * size.x * size.y;
+
+        // first physical texture that is free since before resource is created
+        auto found = std::find_if(physicals.begin(), physicals.end(), [&] (const Physical& physical) {
+            return physical.last < *resource.first && physical.size == size && isCompatible(physical.descriptor, resource.descriptor);
+        });
+
+        if (found == physicals.end()) {
+            physicals.push_back({resource.descriptor, size});
+            found = std::prev(physicals.end());
+            stats.allocated += Texture::getTexelSize(resource.descriptor.format) * size.x * size.y;
+        }
+
+        found->last = resource.last;
+        resource.physical = static_cast<uint32_t>(std::distance(physicals.begin(), found));
+        ++stats.resources;
+    }
+
+    stats.textures = static_cast<uint32_t>(physicals.size());
+}
+
+void RenderGraph::schedule() {
+    // hazards are tracked per memory, so aliased textures see writes of previous owner
+    const auto getSlot = [&] (ResourceId id) {
+        const auto& resource = resources[id];
+        return resource.physical ? *resource.physical : physicals.size() + id;
+    };
+
+    std::vector<std::optional<Access>> written(physicals.size() + resources.size());
+    std::vector<bool> touched(resources.size());
+
+    for (auto& pass : passes) {
+        pass.clears.clear();
+        pass.barriers = 0;
+
+        if (pass.culled) {
+            ++stats.culled;
+            continue;
+        }
+
+        for (const auto* uses : {&pass.reads, &pass.writes}) {
+            for (const auto& use : *uses) {
+                if (written[getSlot(use.resource)] == Access::Storage) {
+                    pass.barriers |= getBarrier(use.access);
+                }
+            }
+        }
+
+        for (const auto& use : pass.writes) {
+            const auto& resource = resources[use.resource];
+            if (!touched[use.resource] && resource.descriptor.clear && !resource.imported &&
+                std::find(pass.clears.begin(), pass.clears.end(), use.resource) == pass.clears.end()) {
+                pass.clears.push_back(use.resource);
+            }
+        }
+
+        for (const auto* uses : {&pass.reads, &pass.writes}) {
+            for (const auto& use : *uses) {
+                touched[use.resource] = true;
+            }
+        }
+
+        for (const auto& use : pass.writes) {
+            written[getSlot(use.resource)] = use.access;
+        }
+
+        ++stats.passes;
+    }
+}
+
+void RenderGraph::realize() {
+    for (auto& physical : physicals) {
+        if (!physical.texture) {
+            physical.texture = build(physical.descriptor, physical.size);
+        }
+    }
+}
+
+void RenderGraph::compile(glm::uvec2 size) {
+    frame_size = size;
+
+    // textures of previous compilation are reused when they fit
+    auto pool = std::move(physicals);
+    physicals.clear();
+
+    stats = {};
+
+    cull();
+    computeLifetimes();
+    alias();
+    schedule();
+
+    for (auto& physical : physicals) {
+        auto found = std::find_if(pool.begin(), pool.end(), [&] (const Physical& old) {
+            return old.texture && old.size == physical.size && isCompatible(old.descriptor, physical.descriptor);
+        });
+
+        if (found != pool.end()) {
+            physical.texture = std::move(found->texture);
+        }
+    }
+
+    realize();
+}
+
+void RenderGraph::begin(PassId id, Context& ctx) {
+    const auto& pass = passes.at(id);
+
+    if (pass.barriers != 0) {
+        glMemoryBarrier(pass.barriers);
+    }
+
+    for (const auto resource : pass.clears) {
+        clear(resources[resource], ctx);
+    }
+}
+
+void RenderGraph::clear(const ResourceNode& resource, Context& ctx) {
+    const auto& texture = physicals[*resource.physical].texture;
+    const auto& value = resource.descriptor.clear_value;
+    const auto depth = isDepth(resource.descriptor.format);
+    const auto stencil = resource.descriptor.format == Texture::InternalFormat::Depth24Stencil8;
+
+    if (ContextInitializer::isExtensionSupported("GL_ARB_clear_texture")) {
+        if (stencil) {
+            // 24 bits of depth above 8 bits of stencil
+            const auto packed = static_cast<GLuint>(glm::clamp(value.x, 0.0f, 1.0f) * 16777215.0f + 0.5f) << 8u
+                              | (static_cast<GLuint>(value.y) & 0xFFu);
+            glClearTexImage(texture->getId(), 0, GL_DEPTH_STENCIL, GL_UNSIGNED_INT_24_8, &packed);
+        } else {
+            glClearTexImage(texture->getId(), 0, depth ? GL_DEPTH_COMPONENT : GL_RGBA, GL_FLOAT, &value.x);
+        }
+        return;
+    }
+
+    // clearing through framebuffer respects masks
+    Framebuffer framebuffer;
+    if (stencil) {
+        framebuffer << TextureAttachment{FramebufferAttachment::DepthStencil, texture};
+        ctx.setDepthMask(DepthMask::True);
+        ctx.setStencilMask(0xFF);
+        glClearBufferfi(GL_DEPTH_STENCIL, 0, value.x, static_cast<GLint>(value.y));
+    } else if (depth) {
+        framebuffer << TextureAttachment{FramebufferAttachment::Depth, texture};
+        ctx.setDepthMask(DepthMask::True);
+        glClearBufferfv(GL_DEPTH, 0, &value.x);
+    } else {
+        framebuffer << TextureAttachment{FramebufferAttachment::Color0, texture};
+        framebuffer.drawBuffer(FramebufferAttachment::Color0);
+        glClearBufferfv(GL_COLOR, 0, &value.x);
+    }
+}
+
+const std::shared_ptr<Texture>& RenderGraph::getTexture(const std::string& name) const {
+    static const std::shared_ptr<Texture> none;
+
+    const auto& resource = resources[getId(name)];
+    if (resource.imported) {
+        return resource.imported;
+    }
+
+    return resource.physical ? physicals[*resource.physical].texture : none;
+}
+
+glm::uvec2 RenderGraph::getSize(const TextureDescriptor& descriptor) const noexcept {
+    return glm::max(glm::uvec2{glm::vec2{frame_size} * descriptor.scale}, glm::uvec2{1});
+}
+
+bool RenderGraph::isDepth(Texture::InternalFormat format) noexcept {
+    switch (format) {
+        case Texture::InternalFormat::Depth:
+        case Texture::InternalFormat::Depth16:
+        case Texture::InternalFormat::Depth24:
+        case Texture::InternalFormat::Depth32:
+        case Texture::InternalFormat::Depth32F:
+        case Texture::InternalFormat::Depth24Stencil8:
+            return true;
+        default:
+            return false;
+    }
+}
+
+std::shared_ptr<Texture> RenderGraph::build(const TextureDescriptor& descriptor, glm::uvec2 size) {
+    // format and type only describe absent data, they have to be valid for internal format though
+    const auto [format, type] = [&] () -> std::pair<Texture::Format, Texture::DataType> {
+        switch (descriptor.format) {
+            case Texture::InternalFormat::Depth24Stencil8:
+                return {Texture::Format::DepthStencil, Texture::DataType::Uint24_8};
+            case Texture::InternalFormat::R:
+            case Texture::InternalFormat::R8:
+                return {Texture::Format::Red, Texture::DataType::UnsignedByte};
+            case Texture::InternalFormat::RG8:
+                return {Texture::Format::RG, Texture::DataType::UnsignedByte};
+            case Texture::InternalFormat::RG8_SNORM:
+                return {Texture::Format::RG, Texture::DataType::Byte};
+            case Texture::InternalFormat::RG32F:
+                return {Texture::Format::RG, Texture::DataType::Float};
+            case Texture::InternalFormat::RGB8:
+            case Texture::InternalFormat::RGB16:
+            case Texture::InternalFormat::sRGB8:
+                return {Texture::Format::RGB, Texture::DataType::UnsignedByte};
+            case Texture::InternalFormat::RGB8_SNORM:
+            case Texture::InternalFormat::RGB16_SNORM:
+                return {Texture::Format::RGB, Texture::DataType::Byte};
+            case Texture::InternalFormat::RGB16F:
+            case Texture::InternalFormat::RGB32F:
+                return {Texture::Format::RGB, Texture::DataType::Float};
+            case Texture::InternalFormat::RGBA8_SNORM:
+            case Texture::InternalFormat::RGBA16_SNORM:
+                return {Texture::Format::RGBA, Texture::DataType::Byte};
+            case Texture::InternalFormat::RGBA16F:
+                return {Texture::Format::RGBA, Texture::DataType::Float};
+            default:
+                return isDepth(descriptor.format)
+                    ? std::pair{Texture::Format::DepthComponent, Texture::DataType::Float}
+                    : std::pair{Texture::Format::RGBA, Texture::DataType::UnsignedByte};
+        }
+    }();
+
+    auto texture = TextureBuilder()
+            .setTarget(Texture::Type::Tex2D)
+            .setInternalFormat(descriptor.format)
+            .setFormat(format)
+            .setDataType(type)
+            .setSize(size)
+            .setMinFilter(descriptor.filter)
+            .setMagFilter(descriptor.filter)
+            .setWrapS(Texture::Wrap::ClampToEdge)
+            .setWrapT(Texture::Wrap::ClampToEdge)
+            .setMipMap(false)
+            .build();
+
+    texture->setMemoryCategory(GpuMemory::Category::RenderTarget);
+
+    return texture;
+}
+
+void RenderGraph::report(std::ostream& stream) const {
+    stream << "render graph: " << stats.passes << " passes, " << stats.culled << " culled" << std::endl;
+
+    for (const auto& pass : passes) {
+        stream << (pass.culled ? "  [culled] " : "  ") << pass.name << std::endl;
+    }
+
+    for (const auto& resource : resources) {
+        stream << "  " << resource.name << " -> ";
+        if (resource.imported) {
+            stream << "imported";
+        } else if (resource.physical) {
+            stream << "texture " << *resource.physical << " [" << *resource.first << "; " << resource.last << "]";
+        } else {
+            stream << "unused";
+        }
+        stream << std::endl;
+    }
+
+    stream << "transient memory: " << stats.requested << " bytes requested, "
+           << stats.allocated << " bytes allocated in " << stats.textures << " textures" << std::endl;
+}
@@ -11,6 +11,14 @@ RenderPass::RenderPass(Pipeline& _pipeline) noexcept
     : pipeline {_pipeline} {
 }
 
+void RenderPass::declare(RenderGraph::Builder& builder) {
+    builder.setSideEffect();
+}
+
+void RenderPass::realize([[maybe_unused]] RenderGraph& graph) {
+
+}
+
 void RenderPass::addSetter([[maybe_unused]] UniformSetter& setter) {
 
 }
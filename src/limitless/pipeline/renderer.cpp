@@ -9,34 +9,92 @@
 #include <limitless/instances/effect_instance.hpp>
 #include <limitless/pipeline/forward.hpp>
 #include <limitless/pipeline/deferred.hpp>
+#include <limitless/pipeline/depth_pass.hpp>
+#include <limitless/instances/abstract_instance.hpp>
+#include <limitless/camera.hpp>
+#include <limitless/loaders/texture_streamer.hpp>
+#include <limitless/scene.hpp>
 
 #include <limitless/core/profiler.hpp>
 
+#include <algorithm>
+#include <array>
+
 using namespace Limitless;
 
+namespace {
+    // box is outside when all its corners lie outside of the same clip plane; unknown bounds are never outside
+    bool isOutsideFrustum(const glm::mat4& view_projection, const BoundingBox& box) noexcept {
+        if (box.size == glm::vec3{0.0f}) {
+            return false;
+        }
+
+        std::array<uint32_t, 6> outside {};
+        for (uint32_t i = 0; i < 8; ++i) {
+            const auto corner = box.center + box.size * (glm::vec3(i & 1, (i >> 1) & 1, (i >> 2) & 1) - 0.5f);
+            const auto clip = view_projection * glm::vec4{corner, 1.0f};
+
+            for (int axis = 0; axis < 3; ++axis) {
+                outside[axis * 2] += clip[axis] < -clip.w;
+                outside[axis * 2 + 1] += clip[axis] > clip.w;
+            }
+        }
+
+        return std::any_of(outside.begin(), outside.end(), [] (auto count) { return count == 8; });
+    }
+}
+
 Renderer::Renderer(std::unique_ptr<Pipeline> _pipeline, const RenderSettings& _settings)
     : settings {_settings}
     , pipeline {std::move(_pipeline)} {
+    profiler.setEnabled(settings.profiler);
 }
 
 Renderer::Renderer(ContextEventObserver& ctx, const RenderSettings& _settings)
 	: settings {_settings}
 	, pipeline {std::make_unique<Deferred>(ctx, ctx.getSize(), settings)} {
+    profiler.setEnabled(settings.profiler);
 }
 
 Renderer::Renderer(ContextEventObserver& ctx)
     : settings {}
     , pipeline {std::make_unique<Deferred>(ctx, ctx.getSize(), settings)} {
+    profiler.setEnabled(settings.profiler);
 }
 
-void Renderer::draw(Context& context, const Assets& assets, Scene& scene, Camera& camera) {
+void Renderer::draw(Context& context, Assets& assets, Scene& scene, Camera& camera) {
+    assets.shaders.update(context);
+
     pipeline->draw(context, assets, scene, camera);
 
-    //profiler.draw(context, assets);
+    // bounding boxes are updated by pipeline; levels are scheduled by AssetManager::doDelayedJob
+    // only instances that are outside of view or were occluded by depth pass do not request levels
+    if (streamer) {
+        ProfilerScope scope {"texture streaming"};
+
+        const auto* depth = pipeline->find<DepthPass>();
+        const auto view_projection = camera.getProjection() * camera.getView();
+
+        visible.clear();
+        for (const auto& wrapper : scene.getWrappers()) {
+            auto& instance = wrapper.get();
+            if ((depth && depth->isOccluded(instance)) || isOutsideFrustum(view_projection, instance.getBoundingBox())) {
+                continue;
+            }
+            visible.emplace_back(wrapper);
+        }
+
+        streamer->request(visible, camera, context.getSize());
+    }
+
+    if (settings.profiler) {
+        profiler.draw(context, assets);
+    }
 }
 
 void Renderer::updatePipeline(ContextEventObserver& ctx) {
     pipeline->update(ctx, settings);
+    profiler.setEnabled(settings.profiler);
 }
 
 void Renderer::update(ContextEventObserver& ctx, Assets& assets) {
@@ -1,8 +1,8 @@
 #include <limitless/pipeline/scene_data.hpp>
 
 #include <limitless/core/context.hpp>
-#include <limitless/core/buffer_builder.hpp>
 #include <limitless/camera.hpp>
+#include <cstring>
 
 using namespace Limitless;
 
@@ -10,21 +10,6 @@ namespace {
     constexpr auto SCENE_DATA_BUFFER_NAME = "scene_data";
 }
 
-SceneDataStorage::SceneDataStorage(Context& ctx) {
-    BufferBuilder builder;
-    buffer = builder.setTarget(Buffer::Type::Uniform)
-                    .setUsage(Buffer::Usage::DynamicDraw)
-                    .setAccess(Buffer::MutableAccess::WriteOrphaning)
-                    .setDataSize(sizeof(SceneData))
-                    .build(SCENE_DATA_BUFFER_NAME, ctx);
-}
-
-SceneDataStorage::~SceneDataStorage() {
-    if (auto* ctx = ContextState::getState(glfwGetCurrentContext()); ctx) {
-        ctx->getIndexedBuffers().remove(SCENE_DATA_BUFFER_NAME, buffer);
-    }
-}
-
 void SceneDataStorage::update(Context& context, const Camera& camera) {
     scene_data.projection = camera.getProjection();
     scene_data.projection_inverse = glm::inverse(camera.getProjection());
@@ -35,9 +20,13 @@ void SceneDataStorage::update(Context& context, const Camera& camera) {
     scene_data.camera_position = { camera.getPosition(), 1.0f };
     scene_data.far_plane = camera.getFar();
     scene_data.near_plane = camera.getNear();
-    buffer->mapData(&scene_data, sizeof(SceneData));
 
-    buffer->bindBase(context.getIndexedBuffers().getBindingPoint(IndexedBuffer::Type::UniformBuffer, SCENE_DATA_BUFFER_NAME));
+    // every camera of a frame gets its own copy, so earlier draws keep their data
+    auto& ring = context.getFrameRing();
+    const auto allocation = ring.allocate(Buffer::Type::Uniform, sizeof(SceneData));
+    std::memcpy(allocation.data, &scene_data, sizeof(SceneData));
+
+    ring.bind(allocation, Buffer::Type::Uniform, context.getIndexedBuffers().getBindingPoint(IndexedBuffer::Type::UniformBuffer, SCENE_DATA_BUFFER_NAME));
 }
 
 void SceneDataStorage::onFramebufferChange(glm::uvec2 size) {
@@ -4,16 +4,18 @@
 
 using namespace Limitless;
 
-SceneUpdatePass::SceneUpdatePass(Pipeline& pipeline, Context& ctx)
-    : RenderPass(pipeline)
-    , scene_data {ctx} {
+SceneUpdatePass::SceneUpdatePass(Pipeline& pipeline, [[maybe_unused]] Context& ctx)
+    : RenderPass(pipeline) {
 }
 
 void SceneUpdatePass::update(Scene& scene, Instances& instances, Context& ctx, const Camera& camera) {
     scene.update(ctx, camera);
     scene_data.update(ctx, camera);
 
-    instances = scene.getWrappers();
+    if (instances_version != scene.getVersion()) {
+        instances = scene.getWrappers();
+        instances_version = scene.getVersion();
+    }
 }
 
 void SceneUpdatePass::onFramebufferChange(glm::uvec2 size) {
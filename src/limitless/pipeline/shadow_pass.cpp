@@ -1,7 +1,7 @@
 #include <limitless/pipeline/shadow_pass.hpp>
 
 #include <limitless/scene.hpp>
-#include <limitless/core/uniform_setter.hpp>
+#include <limitless/core/context.hpp>
 
 using namespace Limitless;
 
@@ -19,14 +19,11 @@ DirectionalShadowPass::DirectionalShadowPass(Pipeline& pipeline, Context& ctx, c
 void DirectionalShadowPass::draw(Instances& instances, Context& ctx, const Assets& assets, const Camera& camera, [[maybe_unused]] UniformSetter& setter) {
     if (light) {
         shadows.draw(instances, *light, ctx, assets, camera, effect_renderer);
-        shadows.mapData();
     }
-}
 
-void DirectionalShadowPass::addSetter(UniformSetter& setter) {
-    setter.add([&] (ShaderProgram& shader) {
-        shadows.setUniform(shader);
-    });
+    // seen by every later program of frame without per-draw setters
+    shadows.upload(ctx);
+    ctx.getSharedSamplers().set("_dir_shadows", shadows.getShadowMap());
 }
 
 void DirectionalShadowPass::update(Scene& scene, [[maybe_unused]] Instances& instances, [[maybe_unused]] Context& ctx, [[maybe_unused]] const Camera& camera) {
@@ -8,13 +8,14 @@ using namespace Limitless;
 
 void SkyboxPass::draw([[maybe_unused]] Instances& instances, Context& ctx, const Assets& assets, [[maybe_unused]] const Camera& camera, [[maybe_unused]] UniformSetter& setter) {
     if (skybox) {
-    	skybox->getMaterial().update();
+    	skybox->getMaterial().update(time);
         skybox->draw(ctx, assets);
     }
 }
 
 void SkyboxPass::update(Scene& scene, [[maybe_unused]] Instances& instances, [[maybe_unused]] Context& ctx, [[maybe_unused]] const Camera& camera) {
     skybox = scene.getSkybox().get();
+    time = scene.getTime();
 }
 
 SkyboxPass::SkyboxPass(Pipeline& pipeline)
@@ -14,7 +14,6 @@
 #include <limitless/camera.hpp>
 #include <limitless/pipeline/gbuffer_pass.hpp>
 #include <limitless/pipeline/pipeline.hpp>
-#include <limitless/pipeline/deferred_framebuffer_pass.hpp>
 #include <limitless/core/buffer_builder.hpp>
 
 using namespace Limitless;
@@ -26,64 +25,26 @@ namespace {
 SSAOPass::SSAOPass(Pipeline& pipeline, ContextEventObserver& ctx)
     : RenderPass(pipeline)
     , framebuffer {} {
-    TextureBuilder builder;
-    auto ssao = builder     .setTarget(Texture::Type::Tex2D)
-                            .setInternalFormat(Texture::InternalFormat::RGB8)
-                            .setSize(ctx.getSize())
-                            .setMinFilter(Texture::Filter::Nearest)
-                            .setMagFilter(Texture::Filter::Nearest)
-                            .setWrapS(Texture::Wrap::ClampToEdge)
-                            .setWrapT(Texture::Wrap::ClampToEdge)
-                            .build();
-
-    auto blurred = builder  .setTarget(Texture::Type::Tex2D)
-                            .setInternalFormat(Texture::InternalFormat::RGB8)
-                            .setSize(ctx.getSize())
-                            .setMinFilter(Texture::Filter::Nearest)
-                            .setMagFilter(Texture::Filter::Nearest)
-                            .setWrapS(Texture::Wrap::ClampToEdge)
-                            .setWrapT(Texture::Wrap::ClampToEdge)
-                            .build();
-
-    framebuffer.bind();
-    framebuffer << TextureAttachment{FramebufferAttachment::Color0, ssao}
-                << TextureAttachment{FramebufferAttachment::Color1, blurred};
-    framebuffer.checkStatus();
-    framebuffer.unbind();
-
     generateNoise();
     generateKernel(ctx);
 }
 
-SSAOPass::SSAOPass(Pipeline& pipeline, ContextEventObserver& ctx, glm::uvec2 frame_size)
-    : RenderPass(pipeline) {
-    TextureBuilder builder;
-    auto ssao = builder.setTarget(Texture::Type::Tex2D)
-            .setInternalFormat(Texture::InternalFormat::RGB8)
-            .setSize(frame_size)
-            .setMinFilter(Texture::Filter::Nearest)
-            .setMagFilter(Texture::Filter::Nearest)
-            .setWrapS(Texture::Wrap::ClampToEdge)
-            .setWrapT(Texture::Wrap::ClampToEdge)
-            .build();
-
-    auto blurred = builder.setTarget(Texture::Type::Tex2D)
-            .setInternalFormat(Texture::InternalFormat::RGB8)
-            .setSize(frame_size)
-            .setMinFilter(Texture::Filter::Nearest)
-            .setMagFilter(Texture::Filter::Nearest)
-            .setWrapS(Texture::Wrap::ClampToEdge)
-            .setWrapT(Texture::Wrap::ClampToEdge)
-            .build();
+void SSAOPass::declare(RenderGraph::Builder& builder) {
+    builder.read("normal");
+    builder.read("depth");
+    builder.create("ssao_raw", {Texture::InternalFormat::RGB8});
+    builder.create("ssao", {Texture::InternalFormat::RGB8});
+}
+
+void SSAOPass::realize(RenderGraph& graph) {
+    normal = graph.getTexture("normal");
+    depth = graph.getTexture("depth");
 
     framebuffer.bind();
-    framebuffer << TextureAttachment{FramebufferAttachment::Color0, ssao}
-                << TextureAttachment{FramebufferAttachment::Color1, blurred};
+    framebuffer << TextureAttachment{FramebufferAttachment::Color0, graph.getTexture("ssao_raw")}
+                << TextureAttachment{FramebufferAttachment::Color1, graph.getTexture("ssao")};
     framebuffer.checkStatus();
     framebuffer.unbind();
-
-    generateNoise();
-    generateKernel(ctx);
 }
 
 void SSAOPass::generateNoise() {
@@ -136,16 +97,8 @@ void SSAOPass::generateKernel(Context& ctx) {
 }
 
 void SSAOPass::draw([[maybe_unused]] Instances& instances, Context& ctx, [[maybe_unused]] const Assets& assets, [[maybe_unused]] const Camera& camera, [[maybe_unused]] UniformSetter& setter) {
-    {
-        ctx.disable(Capabilities::DepthTest);
-        ctx.disable(Capabilities::Blending);
-
-        framebuffer.drawBuffers({
-            FramebufferAttachment::Color0,
-            FramebufferAttachment::Color1
-        });
-        framebuffer.clear();
-    }
+    ctx.disable(Capabilities::DepthTest);
+    ctx.disable(Capabilities::Blending);
 
     {
         framebuffer.drawBuffer(FramebufferAttachment::Color0);
@@ -153,10 +106,9 @@ void SSAOPass::draw([[maybe_unused]] Instances& instances, Context& ctx, [[maybe
         buffer->bindBase(ctx.getIndexedBuffers().getBindingPoint(IndexedBuffer::Type::ShaderStorage, SSAO_BUFFER_NAME));
 
         auto& shader = assets.shaders.get("ssao");
-        auto& gbuffer = pipeline.get<DeferredFramebufferPass>();
 
-        shader << UniformSampler{"normal_texture", gbuffer.getNormal()}
-               << UniformSampler{"depth_texture", gbuffer.getDepth()}
+        shader << UniformSampler{"normal_texture", normal}
+               << UniformSampler{"depth_texture", depth}
                << UniformSampler{"noise", noise};
 
         shader.use();
@@ -176,7 +128,3 @@ void SSAOPass::draw([[maybe_unused]] Instances& instances, Context& ctx, [[maybe
         assets.meshes.at("quad")->draw();
     }
 }
-
-void SSAOPass::onFramebufferChange(glm::uvec2 size) {
-    framebuffer.onFramebufferChange(size);
-}
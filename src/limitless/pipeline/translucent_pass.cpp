@@ -8,19 +8,36 @@
 #include <limitless/core/uniform.hpp>
 #include <limitless/core/shader_program.hpp>
 #include <limitless/core/uniform_setter.hpp>
-#include <limitless/core/texture_builder.hpp>
 #include <stdexcept>
 #include <limitless/pipeline/pipeline.hpp>
 #include <limitless/pipeline/deferred_lighting_pass.hpp>
 
 using namespace Limitless;
 
-TranslucentPass::TranslucentPass(Pipeline& pipeline, fx::EffectRenderer& _renderer, glm::uvec2 frame_size, std::shared_ptr<Texture> depth)
+TranslucentPass::TranslucentPass(Pipeline& pipeline, fx::EffectRenderer& _renderer)
     : RenderPass(pipeline)
-    , framebuffer {Framebuffer::asRGB16FNearestClampToEdgeWithDepth(frame_size, depth)}
+    , framebuffer {}
     , renderer {_renderer} {
 }
 
+void TranslucentPass::declare(RenderGraph::Builder& builder) {
+    builder.read("lighting");
+    builder.read("depth", RenderGraph::Access::Attachment);
+    // whole texture is overwritten by blit of lighting
+    builder.create("translucent", {Texture::InternalFormat::RGB16F});
+}
+
+void TranslucentPass::realize(RenderGraph& graph) {
+    lighting = &pipeline.get<DeferredLightingPass>().getFramebuffer();
+    refraction = graph.getTexture("lighting");
+
+    framebuffer.bind();
+    framebuffer << TextureAttachment{FramebufferAttachment::Color0, graph.getTexture("translucent")}
+                << TextureAttachment{FramebufferAttachment::Depth, graph.getTexture("depth")};
+    framebuffer.checkStatus();
+    framebuffer.unbind();
+}
+
 void TranslucentPass::sort(Instances& instances, const Camera& camera, ms::Blending blending) {
     switch (blending) {
         case ms::Blending::Opaque:
@@ -44,11 +61,9 @@ void TranslucentPass::draw(Instances& instances, Context& ctx, const Assets& ass
         ms::Blending::Translucent
     };
 
-    framebuffer.blit(pipeline.get<DeferredLightingPass>().getFramebuffer(), Texture::Filter::Nearest);
+    framebuffer.blit(*lighting, Texture::Filter::Nearest);
 
-    setter.add([&] (ShaderProgram& shader) {
-        shader << UniformSampler{"refraction_texture", getPreviousResult()};
-    });
+    ctx.getSharedSamplers().set("refraction_texture", refraction);
 
     for (const auto& blending : transparent) {
         sort(instances, camera, blending);
@@ -64,7 +79,3 @@ void TranslucentPass::draw(Instances& instances, Context& ctx, const Assets& ass
 std::shared_ptr<Texture> TranslucentPass::getResult() {
     return framebuffer.get(FramebufferAttachment::Color0).texture;
 }
-
-void TranslucentPass::onFramebufferChange(glm::uvec2 size) {
-    framebuffer.onFramebufferChange(size);
-}
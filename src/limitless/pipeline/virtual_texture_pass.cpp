@@ -0,0 +1,16 @@
+#include <limitless/pipeline/virtual_texture_pass.hpp>
+
+#include <limitless/loaders/virtual_texture.hpp>
+#include <limitless/assets.hpp>
+
+using namespace Limitless;
+
+VirtualTexturePass::VirtualTexturePass(Pipeline& pipeline)
+    : RenderPass(pipeline) {
+}
+
+void VirtualTexturePass::draw([[maybe_unused]] Instances& instances, Context& ctx, const Assets& assets, [[maybe_unused]] const Camera& camera, [[maybe_unused]] UniformSetter& setter) {
+    if (const auto& virtual_texture = assets.getVirtualTexture(); virtual_texture) {
+        virtual_texture->update(ctx);
+    }
+}
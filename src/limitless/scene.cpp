@@ -11,13 +11,18 @@ Scene::Scene(Context& context)
 AbstractInstance& Scene::operator[](uint64_t id) noexcept { return *instances[id]; }
 AbstractInstance& Scene::at(uint64_t id) { return *instances.at(id); }
 
-void Scene::remove(uint64_t id) { instances.erase(id); }
+void Scene::remove(uint64_t id) {
+    instances.erase(id);
+    version = ++next_version;
+}
 
 void Scene::setSkybox(std::shared_ptr<Skybox> _skybox) {
     skybox = std::move(_skybox);
 }
 
 void Scene::update(Context& context, const Camera& camera) {
+    const auto& time = clock.tick();
+
     lighting.update();
 
     removeDeadInstances();
@@ -25,13 +30,13 @@ void Scene::update(Context& context, const Camera& camera) {
     //TODO: why is here two updates?
     for (auto& [_, instance] : instances) {
         if (instance->getShaderType() != ModelShader::Effect) {
-            instance->update(context, camera);
+            instance->update(context, camera, time);
         }
     }
 
     for (auto& [_, instance] : instances) {
         if (instance->getShaderType() == ModelShader::Effect) {
-            instance->update(context, camera);
+            instance->update(context, camera, time);
         }
     }
 }
@@ -40,31 +45,52 @@ void Scene::removeDeadInstances() noexcept {
     for (auto it = instances.cbegin(); it != instances.cend(); ) {
         if (it->second->isKilled()) {
             it = instances.erase(it);
+            version = ++next_version;
         } else {
             ++it;
         }
     }
 }
 
-Instances Scene::getWrappers() noexcept {
-    Instances wrappers;
+uint64_t Scene::getVersion() noexcept {
+    // attachments of this scene's instances were attached or detached
+    if (attachments_version != structure_version) {
+        attachments_version = structure_version;
+        version = ++next_version;
+    }
+    return version;
+}
+
+const Instances& Scene::getWrappers() {
+    if (wrappers_version == getVersion()) {
+        return wrappers;
+    }
+
+    wrappers.clear();
     wrappers.reserve(instances.size());
 
-    const std::function<void(AbstractInstance&)> visitor = [&] (AbstractInstance& instance) {
-	    wrappers.emplace_back(std::ref(instance));
+    // attachments follow their instance in depth-first order
+    std::vector<AbstractInstance*> stack;
+    for (const auto& [_, instance] : instances) {
+        stack.emplace_back(instance.get());
+
+        while (!stack.empty()) {
+            auto* current = stack.back();
+            stack.pop_back();
 
-	    for (auto& [_, attachment] : instance.getAttachments()) {
-	    	visitor(*attachment);
-	    }
-    };
+            wrappers.emplace_back(std::ref(*current));
 
-	for (const auto& [_, instance] : instances) {
-		visitor(*instance);
-	}
+            for (auto& [_, attachment] : current->getAttachments()) {
+                stack.emplace_back(attachment.get());
+            }
+        }
+    }
 
+    wrappers_version = getVersion();
     return wrappers;
 }
 
 void Scene::clear() {
 	instances.clear();
+	version = ++next_version;
 }
@@ -1,6 +1,8 @@
 #include <limitless/shader_storage.hpp>
 #include <limitless/core/shader_compiler.hpp>
+#include <limitless/core/shader_program.hpp>
 #include <limitless/pipeline/render_settings.hpp>
+#include <plog/Log.h>
 
 using namespace Limitless;
 
@@ -9,24 +11,44 @@ bool Limitless::operator<(const ShaderKey& lhs, const ShaderKey& rhs) noexcept {
 }
 
 ShaderProgram& ShaderStorage::get(const std::string& name) const {
-    try {
-        return *shaders.at(name);
-    } catch (const std::out_of_range& e) {
-        throw shader_storage_error("No such shader " + name);
+    std::shared_lock lock(mutex);
+    if (const auto it = shaders.find(name); it != shaders.end()) {
+        return *it->second;
+    }
+
+    // program is being compiled again
+    if (const auto it = replaced_shaders.find(name); it != replaced_shaders.end()) {
+        return *it->second;
     }
+
+    throw shader_storage_error("No such shader " + name);
 }
 
 ShaderProgram& ShaderStorage::get(ShaderPass material_type, ModelShader model_type, uint64_t material_index) const {
-    try {
-        return *materials.at({material_type, model_type, material_index});
-    } catch (const std::out_of_range& e) {
-        throw shader_storage_error("No such material shader");
+    std::shared_lock lock(mutex);
+    const auto it = materials.find({material_type, model_type, material_index});
+    if (it != materials.end() && it->second) {
+        return *it->second;
+    }
+
+    if (const auto replaced = replaced_materials.find({material_type, model_type, material_index}); replaced != replaced_materials.end()) {
+        return *replaced->second;
     }
+
+    // variant is reserved but still compiling or failed to compile
+    if (it != materials.end()) {
+        if (const auto fallback = fallbacks.find({material_type, model_type}); fallback != fallbacks.end()) {
+            return *fallback->second;
+        }
+    }
+
+    throw shader_storage_error("No such material shader");
 }
 
 void ShaderStorage::add(std::string name, std::shared_ptr<ShaderProgram> program) {
     std::unique_lock lock(mutex);
 
+    replaced_shaders.erase(name);
     const auto result = shaders.emplace(std::move(name), std::move(program));
     if (!result.second) {
         throw shader_storage_error{"Shader already exists"};
@@ -41,11 +63,205 @@ void ShaderStorage::add(ShaderPass material_type, ModelShader model_type, uint64
     if (!result.second) {
         if (!materials[key]) {
             materials[key] = std::move(program);
+            pending.erase(key);
+            replaced_materials.erase(key);
+            ++version;
             return;
         }
 
         throw shader_storage_error{"Shader already exists"};
     }
+    replaced_materials.erase(key);
+    ++version;
+}
+
+void ShaderStorage::add(ShaderPass material_type, ModelShader model_type, uint64_t material_index, PendingProgram program) {
+    std::unique_lock lock(mutex);
+    const auto key = ShaderKey{material_type, model_type, material_index};
+
+    if (const auto it = materials.find(key); it != materials.end() && it->second) {
+        throw shader_storage_error{"Shader already exists"};
+    }
+
+    materials.emplace(key, nullptr);
+    pending.insert_or_assign(key, std::move(program));
+}
+
+void ShaderStorage::setFallback(ShaderPass material_type, ModelShader model_type, uint64_t material_index) {
+    std::unique_lock lock(mutex);
+    const auto it = materials.find({material_type, model_type, material_index});
+    if (it == materials.end() || !it->second) {
+        throw shader_storage_error{"Fallback shader is not compiled"};
+    }
+
+    fallbacks[{material_type, model_type}] = it->second;
+    ++version;
+}
+
+namespace {
+    // matching programs are kept aside, so that they are drawn until compiled again
+    template<typename Map, typename Predicate>
+    uint32_t replaceIf(Map& map, Map& replaced, Predicate&& predicate) {
+        uint32_t count {};
+        for (auto it = map.begin(); it != map.end();) {
+            if (it->second && predicate(*it->second)) {
+                replaced.insert_or_assign(it->first, std::move(it->second));
+                it = map.erase(it);
+                ++count;
+            } else {
+                ++it;
+            }
+        }
+        return count;
+    }
+
+    template<typename Map, typename Key>
+    bool restoreReplaced(Map& map, Map& replaced, const Key& key) {
+        const auto it = replaced.find(key);
+        if (it == replaced.end()) {
+            return false;
+        }
+
+        map.insert_or_assign(key, std::move(it->second));
+        replaced.erase(it);
+        return true;
+    }
+}
+
+template<typename Predicate>
+uint32_t ShaderStorage::erasePending(Predicate&& predicate) {
+    uint32_t count {};
+    for (auto it = pending.begin(); it != pending.end();) {
+        if (predicate(it->second)) {
+            // reserved entry is removed too, so that variant is submitted again
+            materials.erase(it->first);
+            it = pending.erase(it);
+            ++count;
+        } else {
+            ++it;
+        }
+    }
+    return count;
+}
+
+uint32_t ShaderStorage::removeOutdated(const RenderSettings& settings) {
+    std::unique_lock lock(mutex);
+
+    const auto outdated = [&] (const auto& program) {
+        return !program.getSettingsMacros().empty() &&
+               ShaderCompiler::getSettingsDefines(settings, program.getSettingsMacros()) != program.getSettingsDefines();
+    };
+
+    ++version;
+    return erasePending(outdated) + replaceIf(shaders, replaced_shaders, outdated) + replaceIf(materials, replaced_materials, outdated) + replaceIf(emitters, replaced_emitters, outdated);
+}
+
+uint32_t ShaderStorage::removeDependent(const fs::path& file) {
+    std::unique_lock lock(mutex);
+
+    const auto normal = file.lexically_normal();
+    const auto dependent = [&] (const auto& program) {
+        return program.getDependencies().count(normal) != 0;
+    };
+
+    ++version;
+    return erasePending(dependent) + replaceIf(shaders, replaced_shaders, dependent) + replaceIf(materials, replaced_materials, dependent) + replaceIf(emitters, replaced_emitters, dependent);
+}
+
+bool ShaderStorage::restore(const std::string& name) {
+    std::unique_lock lock(mutex);
+    return restoreReplaced(shaders, replaced_shaders, name);
+}
+
+bool ShaderStorage::restore(ShaderPass material_type, ModelShader model_type, uint64_t material_index) {
+    std::unique_lock lock(mutex);
+    const auto key = ShaderKey{material_type, model_type, material_index};
+
+    if (!restoreReplaced(materials, replaced_materials, key)) {
+        return false;
+    }
+
+    pending.erase(key);
+    ++version;
+    return true;
+}
+
+bool ShaderStorage::restore(const fx::UniqueEmitterShaderKey& emitter_type) {
+    std::unique_lock lock(mutex);
+    return restoreReplaced(emitters, replaced_emitters, emitter_type);
+}
+
+std::set<fs::path> ShaderStorage::getDependencies() const {
+    std::set<fs::path> files;
+    const auto collect = [&] (const auto& map) {
+        for (const auto& [_, program] : map) {
+            if (program) {
+                files.insert(program->getDependencies().begin(), program->getDependencies().end());
+            }
+        }
+    };
+
+    collect(shaders);
+    collect(materials);
+    collect(emitters);
+
+    for (const auto& [_, program] : pending) {
+        files.insert(program.getDependencies().begin(), program.getDependencies().end());
+    }
+
+    return files;
+}
+
+void ShaderStorage::finish(ShaderCompiler& compiler, const ShaderKey& key, PendingProgram& program) {
+    try {
+        materials[key] = compiler.finish(program);
+        replaced_materials.erase(key);
+        ++version;
+        return;
+    } catch (const shader_compilation_error& e) {
+        PLOG_ERROR << "Material shader variant failed to compile: " << e.what();
+    } catch (const shader_linking_error& e) {
+        PLOG_ERROR << "Material shader variant failed to link: " << e.what();
+    }
+
+    // failed variant keeps drawing with program it was compiled to replace, or with fallback
+    if (restoreReplaced(materials, replaced_materials, key)) {
+        ++version;
+    }
+}
+
+void ShaderStorage::update(Context& ctx) {
+    std::unique_lock lock(mutex);
+    if (pending.empty()) {
+        return;
+    }
+
+    ShaderCompiler compiler {ctx};
+    for (auto it = pending.begin(); it != pending.end();) {
+        if (!it->second.isReady()) {
+            ++it;
+            continue;
+        }
+
+        const auto key = it->first;
+        auto program = std::move(it->second);
+        it = pending.erase(it);
+
+        finish(compiler, key, program);
+    }
+}
+
+void ShaderStorage::wait(Context& ctx) {
+    std::unique_lock lock(mutex);
+
+    ShaderCompiler compiler {ctx};
+    while (!pending.empty()) {
+        const auto key = pending.begin()->first;
+        auto program = std::move(pending.begin()->second);
+        pending.erase(pending.begin());
+
+        finish(compiler, key, program);
+    }
 }
 
 bool ShaderStorage::contains(ShaderPass material_type, ModelShader model_type, uint64_t material_index) noexcept {
@@ -81,15 +297,21 @@ bool ShaderStorage::reserveIfNotContains(const fx::UniqueEmitterShaderKey& emitt
 }
 
 ShaderProgram& ShaderStorage::get(const fx::UniqueEmitterShaderKey& emitter_type) const {
-    try {
-        return *emitters.at(emitter_type);
-    } catch (const std::out_of_range& e) {
-        throw shader_storage_error("No such sprite emitter shader");
+    std::shared_lock lock(mutex);
+    if (const auto it = emitters.find(emitter_type); it != emitters.end() && it->second) {
+        return *it->second;
     }
+
+    if (const auto it = replaced_emitters.find(emitter_type); it != replaced_emitters.end()) {
+        return *it->second;
+    }
+
+    throw shader_storage_error("No such sprite emitter shader");
 }
 
 void ShaderStorage::add(const fx::UniqueEmitterShaderKey& emitter_type, std::shared_ptr<ShaderProgram> program) {
     std::unique_lock lock(mutex);
+    replaced_emitters.erase(emitter_type);
     const auto result = emitters.emplace(emitter_type, program);
     if (!result.second) {
         if (!emitters[emitter_type]) {
@@ -104,43 +326,72 @@ void ShaderStorage::add(const fx::UniqueEmitterShaderKey& emitter_type, std::sha
 void ShaderStorage::initialize(Context& ctx, const RenderSettings& settings, const fs::path& shader_dir) {
     ShaderCompiler compiler {ctx, settings};
 
+    // programs that were kept after settings change are not compiled again
+    const auto compile = [&] (const std::string& name, const fs::path& path) {
+        if (contains(name)) {
+            return;
+        }
+
+        try {
+            add(name, compiler.compile(shader_dir / path));
+        } catch (const std::exception& e) {
+            // program that is compiled again after reload keeps drawing
+            if (!restore(name)) {
+                throw;
+            }
+            PLOG_ERROR << "Shader " << name << " failed to compile, previous program is kept: " << e.what();
+        }
+    };
+
     if (settings.pipeline == RenderPipeline::Forward) {
-        add("blur", compiler.compile(shader_dir / "postprocessing/blur"));
-        add("brightness", compiler.compile(shader_dir / "postprocessing/bloom/brightness"));
-        add("postprocess", compiler.compile(shader_dir / "postprocessing/postprocess"));
+        compile("blur", "postprocessing/blur");
+        compile("brightness", "postprocessing/bloom/brightness");
+        compile("postprocess", "postprocessing/postprocess");
     }
 
     if (settings.pipeline == RenderPipeline::Deferred) {
-        add("deferred", compiler.compile(shader_dir / "pipeline/deferred/deferred"));
-        add("composite", compiler.compile(shader_dir / "pipeline/deferred/composite"));
-        add("ssao", compiler.compile(shader_dir / "postprocessing/ssao"));
-        add("ssao_blur", compiler.compile(shader_dir / "postprocessing/ssao_blur"));
-
-        add("blur_downsample", compiler.compile(shader_dir / "postprocessing/bloom/blur_downsample"));
-        add("blur_upsample", compiler.compile(shader_dir / "postprocessing/bloom/blur_upsample"));
-        add("brightness", compiler.compile(shader_dir / "postprocessing/bloom/brightness"));
+        compile("deferred", "pipeline/deferred/deferred");
+        compile("composite", "pipeline/deferred/composite");
+        compile("ssao", "postprocessing/ssao");
+        compile("ssao_blur", "postprocessing/ssao_blur");
+
+        compile("blur_downsample", "postprocessing/bloom/blur_downsample");
+        compile("blur_upsample", "postprocessing/bloom/blur_upsample");
+        compile("brightness", "postprocessing/bloom/brightness");
     }
 
     if (settings.fast_approximate_antialiasing) {
-        add("fxaa", compiler.compile(shader_dir / "postprocessing/fxaa"));
+        compile("fxaa", "postprocessing/fxaa");
     }
 
     if (settings.depth_of_field) {
-	    add("dof", compiler.compile(shader_dir / "postprocessing/dof"));
+	    compile("dof", "postprocessing/dof");
+    }
+
+    if (settings.pipeline == RenderPipeline::Deferred && settings.occlusion_culling) {
+        compile("hiz", "pipeline/deferred/hiz");
     }
 
-    add("quad", compiler.compile(shader_dir / "pipeline/quad"));
-    add("text", compiler.compile(shader_dir / "text/text"));
-    add("text_selection", compiler.compile(shader_dir / "text/text_selection"));
+    compile("quad", "pipeline/quad");
+    compile("text", "text/text");
+    compile("text_selection", "text/text_selection");
 }
 
 void ShaderStorage::clear() {
+    std::unique_lock lock(mutex);
+    ++version;
+    pending.clear();
+    fallbacks.clear();
+    replaced_shaders.clear();
+    replaced_materials.clear();
+    replaced_emitters.clear();
     materials.clear();
     emitters.clear();
     shaders.clear();
 }
 
 void ShaderStorage::add(const ShaderStorage& other) {
+    std::unique_lock lock(mutex);
     for (auto&& [key, value] : other.shaders) {
         shaders.emplace(key, value);
     }
@@ -148,6 +399,7 @@ void ShaderStorage::add(const ShaderStorage& other) {
     for (auto&& [key, value] : other.materials) {
         materials.emplace(key, value);
     }
+    ++version;
 
     for (auto&& [key, value] : other.emitters) {
         emitters.emplace(key, value);
@@ -163,5 +415,7 @@ void ShaderStorage::remove(ShaderPass material_type, ModelShader model_type, uin
 
     const auto key = ShaderKey{material_type, model_type, material_index};
 
+    pending.erase(key);
     materials.erase(key);
+    ++version;
 }
@@ -0,0 +1,503 @@
+#include <limitless/util/block_compression.hpp>
+
+#include <limitless/util/thread_pool.hpp>
+#include <algorithm>
+#include <climits>
+#include <limits>
+#include <cstring>
+#include <cmath>
+#include <array>
+
+#if defined(__SSE2__) || defined(_M_X64)
+    #include <emmintrin.h>
+    #define LIMITLESS_BLOCK_SSE2
+#endif
+
+using namespace Limitless;
+
+namespace {
+    using Pixels = float[16][4];
+
+    constexpr std::array<uint32_t, 16> BC7_WEIGHTS = {0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64};
+
+    class BitWriter {
+    private:
+        std::byte* out;
+        uint32_t position {};
+    public:
+        explicit BitWriter(std::byte* _out) noexcept : out {_out} {}
+
+        void write(uint32_t value, uint32_t bits) noexcept {
+            for (uint32_t i = 0; i < bits; ++i, ++position) {
+                out[position / 8] |= static_cast<std::byte>(((value >> i) & 1u) << (position % 8));
+            }
+        }
+    };
+
+    // nearest palette entry for each of 16 rgba8 pixels; returns sum of squared distances
+    uint32_t selectIndices(const uint8_t* pixels, const uint8_t* palette, uint32_t count, uint8_t* indices) noexcept {
+        uint32_t error {};
+
+    #ifdef LIMITLESS_BLOCK_SSE2
+        // 4 pixels at once; channel differences are 16-bit, madd sums channel pairs
+        const auto zero = _mm_setzero_si128();
+        for (uint32_t i = 0; i < 16; i += 4) {
+            const auto quad = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pixels + i * 4));
+            const auto lo = _mm_unpacklo_epi8(quad, zero);
+            const auto hi = _mm_unpackhi_epi8(quad, zero);
+
+            auto best = _mm_set1_epi32(INT_MAX);
+            auto best_index = _mm_setzero_si128();
+            for (uint32_t p = 0; p < count; ++p) {
+                int32_t entry;
+                std::memcpy(&entry, palette + p * 4, sizeof(entry));
+                const auto color = _mm_unpacklo_epi8(_mm_set1_epi32(entry), zero);
+
+                const auto dlo = _mm_sub_epi16(lo, color);
+                const auto dhi = _mm_sub_epi16(hi, color);
+                const auto slo = _mm_castsi128_ps(_mm_madd_epi16(dlo, dlo));
+                const auto shi = _mm_castsi128_ps(_mm_madd_epi16(dhi, dhi));
+                const auto distance = _mm_add_epi32(_mm_castps_si128(_mm_shuffle_ps(slo, shi, _MM_SHUFFLE(2, 0, 2, 0))),
+                                                    _mm_castps_si128(_mm_shuffle_ps(slo, shi, _MM_SHUFFLE(3, 1, 3, 1))));
+
+                const auto closer = _mm_cmplt_epi32(distance, best);
+                best = _mm_or_si128(_mm_and_si128(closer, distance), _mm_andnot_si128(closer, best));
+                best_index = _mm_or_si128(_mm_and_si128(closer, _mm_set1_epi32(static_cast<int32_t>(p))), _mm_andnot_si128(closer, best_index));
+            }
+
+            alignas(16) int32_t distances[4];
+            alignas(16) int32_t nearest[4];
+            _mm_store_si128(reinterpret_cast<__m128i*>(distances), best);
+            _mm_store_si128(reinterpret_cast<__m128i*>(nearest), best_index);
+
+            for (uint32_t k = 0; k < 4; ++k) {
+                indices[i + k] = static_cast<uint8_t>(nearest[k]);
+                error += static_cast<uint32_t>(distances[k]);
+            }
+        }
+    #else
+        for (uint32_t i = 0; i < 16; ++i) {
+            uint32_t best = UINT_MAX;
+            for (uint32_t p = 0; p < count; ++p) {
+                uint32_t distance {};
+                for (uint32_t c = 0; c < 4; ++c) {
+                    const auto d = static_cast<int32_t>(pixels[i * 4 + c]) - palette[p * 4 + c];
+                    distance += static_cast<uint32_t>(d * d);
+                }
+
+                if (distance < best) {
+                    best = distance;
+                    indices[i] = static_cast<uint8_t>(p);
+                }
+            }
+            error += best;
+        }
+    #endif
+
+        return error;
+    }
+
+    float clampChannel(float value) noexcept {
+        return std::clamp(value, 0.0f, 255.0f);
+    }
+
+    // endpoints on principal axis of block colors, slightly inset to reduce error of extremes
+    void getEndpoints(const Pixels& pixels, uint32_t channels, float (&e0)[4], float (&e1)[4]) noexcept {
+        float mean[4] {};
+        float min[4] = {255.0f, 255.0f, 255.0f, 255.0f};
+        float max[4] {};
+        for (const auto& pixel : pixels) {
+            for (uint32_t c = 0; c < channels; ++c) {
+                mean[c] += pixel[c] / 16.0f;
+                min[c] = std::min(min[c], pixel[c]);
+                max[c] = std::max(max[c], pixel[c]);
+            }
+        }
+
+        float covariance[4][4] {};
+        for (const auto& pixel : pixels) {
+            for (uint32_t a = 0; a < channels; ++a) {
+                for (uint32_t b = 0; b < channels; ++b) {
+                    covariance[a][b] += (pixel[a] - mean[a]) * (pixel[b] - mean[b]);
+                }
+            }
+        }
+
+        // power iteration from diagonal of bounding box
+        float axis[4] {};
+        for (uint32_t c = 0; c < channels; ++c) {
+            axis[c] = max[c] - min[c];
+        }
+
+        for (uint32_t iteration = 0; iteration < 8; ++iteration) {
+            float next[4] {};
+            float length {};
+            for (uint32_t a = 0; a < channels; ++a) {
+                for (uint32_t b = 0; b < channels; ++b) {
+                    next[a] += covariance[a][b] * axis[b];
+                }
+                length = std::max(length, std::abs(next[a]));
+            }
+
+            if (length < 1e-6f) {
+                break;
+            }
+
+            for (uint32_t c = 0; c < channels; ++c) {
+                axis[c] = next[c] / length;
+            }
+        }
+
+        float axis_length {};
+        for (uint32_t c = 0; c < channels; ++c) {
+            axis_length += axis[c] * axis[c];
+        }
+
+        float t_min {};
+        float t_max {};
+        if (axis_length > 1e-12f) {
+            t_min = std::numeric_limits<float>::max();
+            t_max = std::numeric_limits<float>::lowest();
+            for (const auto& pixel : pixels) {
+                float t {};
+                for (uint32_t c = 0; c < channels; ++c) {
+                    t += (pixel[c] - mean[c]) * axis[c];
+                }
+                t_min = std::min(t_min, t / axis_length);
+                t_max = std::max(t_max, t / axis_length);
+            }
+        }
+
+        for (uint32_t c = 0; c < 4; ++c) {
+            const auto inset = (t_max - t_min) * axis[c] / 16.0f;
+            e0[c] = c < channels ? clampChannel(mean[c] + axis[c] * t_min + inset) : 0.0f;
+            e1[c] = c < channels ? clampChannel(mean[c] + axis[c] * t_max - inset) : 0.0f;
+        }
+    }
+
+    // least squares endpoints for fixed interpolation weights of pixels, weight 0 is e0
+    bool fitEndpoints(const Pixels& pixels, const float (&weights)[16], uint32_t channels, float (&e0)[4], float (&e1)[4]) noexcept {
+        float a {}, b {}, c {};
+        float x0[4] {}, x1[4] {};
+        for (uint32_t i = 0; i < 16; ++i) {
+            const auto t = weights[i];
+            a += (1.0f - t) * (1.0f - t);
+            b += t * (1.0f - t);
+            c += t * t;
+            for (uint32_t k = 0; k < channels; ++k) {
+                x0[k] += (1.0f - t) * pixels[i][k];
+                x1[k] += t * pixels[i][k];
+            }
+        }
+
+        const auto det = a * c - b * b;
+        if (std::abs(det) < 1e-6f) {
+            return false;
+        }
+
+        for (uint32_t k = 0; k < channels; ++k) {
+            e0[k] = clampChannel((c * x0[k] - b * x1[k]) / det);
+            e1[k] = clampChannel((a * x1[k] - b * x0[k]) / det);
+        }
+        return true;
+    }
+
+    void toFloat(const uint8_t* rgba, Pixels& pixels) noexcept {
+        for (uint32_t i = 0; i < 16; ++i) {
+            for (uint32_t c = 0; c < 4; ++c) {
+                pixels[i][c] = rgba[i * 4 + c];
+            }
+        }
+    }
+
+    uint16_t to565(const float (&color)[4]) noexcept {
+        const auto r = static_cast<uint16_t>(std::lround(color[0] * 31.0f / 255.0f));
+        const auto g = static_cast<uint16_t>(std::lround(color[1] * 63.0f / 255.0f));
+        const auto b = static_cast<uint16_t>(std::lround(color[2] * 31.0f / 255.0f));
+        return static_cast<uint16_t>((r << 11) | (g << 5) | b);
+    }
+
+    void from565(uint16_t color, uint8_t* rgba) noexcept {
+        const auto r = (color >> 11) & 31;
+        const auto g = (color >> 5) & 63;
+        const auto b = color & 31;
+        rgba[0] = static_cast<uint8_t>((r << 3) | (r >> 2));
+        rgba[1] = static_cast<uint8_t>((g << 2) | (g >> 4));
+        rgba[2] = static_cast<uint8_t>((b << 3) | (b >> 2));
+        rgba[3] = 0;
+    }
+
+    struct ColorBlock {
+        uint16_t c0;
+        uint16_t c1;
+        uint8_t indices[16];
+        uint32_t error;
+    };
+
+    // four-color mode only, so block decodes the same as color part of BC3
+    ColorBlock encodeColor(const uint8_t* opaque, uint16_t c0, uint16_t c1) noexcept {
+        ColorBlock block {std::max(c0, c1), std::min(c0, c1), {}, 0};
+
+        uint8_t palette[16];
+        from565(block.c0, palette);
+        from565(block.c1, palette + 4);
+        for (uint32_t c = 0; c < 3; ++c) {
+            palette[8 + c] = static_cast<uint8_t>((2 * palette[c] + palette[4 + c] + 1) / 3);
+            palette[12 + c] = static_cast<uint8_t>((palette[c] + 2 * palette[4 + c] + 1) / 3);
+        }
+        palette[11] = palette[15] = 0;
+
+        // equal endpoints would mean three-color mode in BC1, index 0 is valid in both
+        block.error = selectIndices(opaque, palette, block.c0 == block.c1 ? 1 : 4, block.indices);
+        return block;
+    }
+
+    void compressColor(const uint8_t* rgba, std::byte* out) noexcept {
+        // alpha does not take part in color error
+        uint8_t opaque[64];
+        std::memcpy(opaque, rgba, sizeof(opaque));
+        for (uint32_t i = 0; i < 16; ++i) {
+            opaque[i * 4 + 3] = 0;
+        }
+
+        Pixels pixels;
+        toFloat(opaque, pixels);
+
+        float e0[4], e1[4];
+        getEndpoints(pixels, 3, e0, e1);
+        auto block = encodeColor(opaque, to565(e1), to565(e0));
+
+        // one refinement step with weights of selected indices
+        constexpr float weights[4] = {0.0f, 1.0f, 1.0f / 3.0f, 2.0f / 3.0f};
+        float t[16];
+        for (uint32_t i = 0; i < 16; ++i) {
+            t[i] = weights[block.indices[i]];
+        }
+
+        if (block.c0 != block.c1 && fitEndpoints(pixels, t, 3, e0, e1)) {
+            if (const auto refined = encodeColor(opaque, to565(e0), to565(e1)); refined.error < block.error) {
+                block = refined;
+            }
+        }
+
+        uint32_t indices {};
+        for (uint32_t i = 0; i < 16; ++i) {
+            indices |= static_cast<uint32_t>(block.indices[i]) << (i * 2);
+        }
+
+        std::memcpy(out, &block.c0, 2);
+        std::memcpy(out + 2, &block.c1, 2);
+        std::memcpy(out + 4, &indices, 4);
+    }
+
+    // single channel with stride 4, eight interpolated values
+    void compressChannel(const uint8_t* values, std::byte* out) noexcept {
+        uint8_t min = 255;
+        uint8_t max = 0;
+        for (uint32_t i = 0; i < 16; ++i) {
+            min = std::min(min, values[i * 4]);
+            max = std::max(max, values[i * 4]);
+        }
+
+        uint8_t palette[8] = {max, min};
+        for (uint32_t k = 2; k < 8; ++k) {
+            palette[k] = static_cast<uint8_t>(((8 - k) * max + (k - 1) * min + 3) / 7);
+        }
+
+        uint64_t indices {};
+        if (max != min) {
+            for (uint32_t i = 0; i < 16; ++i) {
+                uint32_t best = UINT_MAX;
+                uint64_t index {};
+                for (uint32_t k = 0; k < 8; ++k) {
+                    const auto d = static_cast<uint32_t>(std::abs(static_cast<int32_t>(values[i * 4]) - palette[k]));
+                    if (d < best) {
+                        best = d;
+                        index = k;
+                    }
+                }
+                indices |= index << (i * 3);
+            }
+        }
+
+        out[0] = static_cast<std::byte>(max);
+        out[1] = static_cast<std::byte>(min);
+        for (uint32_t i = 0; i < 6; ++i) {
+            out[2 + i] = static_cast<std::byte>((indices >> (i * 8)) & 0xFF);
+        }
+    }
+
+    struct BC7Block {
+        uint8_t endpoints[2][4];
+        uint8_t pbits[2];
+        uint8_t indices[16];
+        uint32_t error {UINT_MAX};
+    };
+
+    // tries all p-bit combinations for endpoints
+    void encodeBC7(const uint8_t* rgba, const float (&e0)[4], const float (&e1)[4], BC7Block& best) noexcept {
+        for (uint8_t p0 = 0; p0 < 2; ++p0) {
+            for (uint8_t p1 = 0; p1 < 2; ++p1) {
+                BC7Block block {};
+                block.pbits[0] = p0;
+                block.pbits[1] = p1;
+
+                uint8_t ends[2][4];
+                for (uint32_t c = 0; c < 4; ++c) {
+                    block.endpoints[0][c] = static_cast<uint8_t>(std::clamp<long>(std::lround((e0[c] - p0) / 2.0f), 0, 127));
+                    block.endpoints[1][c] = static_cast<uint8_t>(std::clamp<long>(std::lround((e1[c] - p1) / 2.0f), 0, 127));
+                    ends[0][c] = static_cast<uint8_t>((block.endpoints[0][c] << 1) | p0);
+                    ends[1][c] = static_cast<uint8_t>((block.endpoints[1][c] << 1) | p1);
+                }
+
+                uint8_t palette[64];
+                for (uint32_t k = 0; k < 16; ++k) {
+                    for (uint32_t c = 0; c < 4; ++c) {
+                        palette[k * 4 + c] = static_cast<uint8_t>(((64 - BC7_WEIGHTS[k]) * ends[0][c] + BC7_WEIGHTS[k] * ends[1][c] + 32) >> 6);
+                    }
+                }
+
+                block.error = selectIndices(rgba, palette, 16, block.indices);
+                if (block.error < best.error) {
+                    best = block;
+                }
+            }
+        }
+    }
+
+    // mode 6: one subset, rgba 7.7.7.7 endpoints with unique p-bits, 4-bit indices
+    void compressBC7(const uint8_t* rgba, std::byte* out) noexcept {
+        Pixels pixels;
+        toFloat(rgba, pixels);
+
+        float e0[4], e1[4];
+        getEndpoints(pixels, 4, e0, e1);
+
+        BC7Block block;
+        encodeBC7(rgba, e0, e1, block);
+
+        float t[16];
+        for (uint32_t i = 0; i < 16; ++i) {
+            t[i] = static_cast<float>(BC7_WEIGHTS[block.indices[i]]) / 64.0f;
+        }
+
+        if (block.error != 0 && fitEndpoints(pixels, t, 4, e0, e1)) {
+            encodeBC7(rgba, e0, e1, block);
+        }
+
+        // msb of first index is implicit zero
+        if (block.indices[0] >= 8) {
+            std::swap(block.endpoints[0], block.endpoints[1]);
+            std::swap(block.pbits[0], block.pbits[1]);
+            for (auto& index : block.indices) {
+                index = static_cast<uint8_t>(15 - index);
+            }
+        }
+
+        std::memset(out, 0, 16);
+        BitWriter writer {out};
+        writer.write(1u << 6, 7);
+        for (uint32_t c = 0; c < 4; ++c) {
+            writer.write(block.endpoints[0][c], 7);
+            writer.write(block.endpoints[1][c], 7);
+        }
+        writer.write(block.pbits[0], 1);
+        writer.write(block.pbits[1], 1);
+        writer.write(block.indices[0], 3);
+        for (uint32_t i = 1; i < 16; ++i) {
+            writer.write(block.indices[i], 4);
+        }
+    }
+
+    // 4x4 block at x, y as rgba8; edges are clamped
+    void fetchBlock(const uint8_t* pixels, uint32_t width, uint32_t height, uint32_t channels, uint32_t x, uint32_t y, uint8_t* rgba) noexcept {
+        for (uint32_t j = 0; j < 4; ++j) {
+            const auto* row = pixels + static_cast<size_t>(std::min(y + j, height - 1)) * width * channels;
+            for (uint32_t i = 0; i < 4; ++i) {
+                const auto* pixel = row + static_cast<size_t>(std::min(x + i, width - 1)) * channels;
+                auto* target = rgba + (j * 4 + i) * 4;
+
+                target[0] = pixel[0];
+                target[1] = channels > 1 ? pixel[1] : 0;
+                target[2] = channels > 2 ? pixel[2] : 0;
+                target[3] = channels > 3 ? pixel[3] : 255;
+            }
+        }
+    }
+}
+
+size_t Limitless::getBlockSize(BlockFormat format) noexcept {
+    switch (format) {
+        case BlockFormat::BC1:
+        case BlockFormat::BC4:
+            return 8;
+        case BlockFormat::BC3:
+        case BlockFormat::BC5:
+        case BlockFormat::BC7:
+            return 16;
+    }
+    return 0;
+}
+
+size_t Limitless::getCompressedSize(BlockFormat format, uint32_t width, uint32_t height) noexcept {
+    return static_cast<size_t>((width + 3) / 4) * ((height + 3) / 4) * getBlockSize(format);
+}
+
+void Limitless::compressBlock(BlockFormat format, const uint8_t* rgba, std::byte* out) noexcept {
+    switch (format) {
+        case BlockFormat::BC1:
+            compressColor(rgba, out);
+            break;
+        case BlockFormat::BC3:
+            compressChannel(rgba + 3, out);
+            compressColor(rgba, out + 8);
+            break;
+        case BlockFormat::BC4:
+            compressChannel(rgba, out);
+            break;
+        case BlockFormat::BC5:
+            compressChannel(rgba, out);
+            compressChannel(rgba + 1, out + 8);
+            break;
+        case BlockFormat::BC7:
+            compressBC7(rgba, out);
+            break;
+    }
+}
+
+std::vector<std::byte> Limitless::compressImage(BlockFormat format, const uint8_t* pixels, uint32_t width, uint32_t height, uint32_t channels, ThreadPool* pool) {
+    const auto block_size = getBlockSize(format);
+    const auto blocks_x = (width + 3) / 4;
+    const auto blocks_y = (height + 3) / 4;
+
+    std::vector<std::byte> out(getCompressedSize(format, width, height));
+
+    const auto compressRows = [&, format] (uint32_t begin, uint32_t end) {
+        uint8_t rgba[64];
+        for (auto by = begin; by < end; ++by) {
+            for (uint32_t bx = 0; bx < blocks_x; ++bx) {
+                fetchBlock(pixels, width, height, channels, bx * 4, by * 4, rgba);
+                compressBlock(format, rgba, out.data() + (static_cast<size_t>(by) * blocks_x + bx) * block_size);
+            }
+        }
+    };
+
+    // small levels are not worth scheduling
+    const auto bands = pool ? std::min(blocks_y, std::max(std::thread::hardware_concurrency(), 1u) * 4) : 1u;
+    if (bands <= 1 || static_cast<size_t>(blocks_x) * blocks_y < 256) {
+        compressRows(0, blocks_y);
+        return out;
+    }
+
+    std::vector<std::future<void>> futures;
+    futures.reserve(bands);
+    for (uint32_t band = 0; band < bands; ++band) {
+        futures.push_back(pool->add(compressRows, blocks_y * band / bands, blocks_y * (band + 1) / bands));
+    }
+
+    for (auto& future : futures) {
+        future.get();
+    }
+
+    return out;
+}
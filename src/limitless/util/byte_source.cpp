@@ -0,0 +1,26 @@
+#include <limitless/util/byte_source.hpp>
+
+#include <limitless/util/bytebuffer.hpp>
+
+using namespace Limitless;
+
+ByteBuffer ByteSource::view() const {
+    return ByteBuffer::view(getData(), getSize());
+}
+
+FileByteSource::FileByteSource(const fs::path& _path)
+    : ByteSource {_path}
+    , file {_path} {
+}
+
+MemoryByteSource::MemoryByteSource(fs::path _path, std::vector<std::byte>&& _bytes) noexcept
+    : ByteSource {std::move(_path)}
+    , bytes {std::move(_bytes)} {
+}
+
+ViewByteSource::ViewByteSource(fs::path _path, std::shared_ptr<const void> _owner, const std::byte* _data, size_t _size) noexcept
+    : ByteSource {std::move(_path)}
+    , owner {std::move(_owner)}
+    , data {_data}
+    , size {_size} {
+}
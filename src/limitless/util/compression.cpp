@@ -0,0 +1,183 @@
+#include <limitless/util/compression.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <cstdint>
+
+using namespace Limitless;
+
+namespace {
+    constexpr size_t MIN_MATCH = 4;
+    // block must end with literals, match cannot start closer to the end
+    constexpr size_t LAST_LITERALS = 5;
+    constexpr size_t MF_LIMIT = 12;
+    constexpr size_t MAX_OFFSET = 65535;
+    constexpr uint32_t HASH_BITS = 16;
+
+    uint32_t read32(const uint8_t* ptr) noexcept {
+        uint32_t value;
+        std::memcpy(&value, ptr, sizeof(value));
+        return value;
+    }
+
+    uint32_t hash(uint32_t sequence) noexcept {
+        return (sequence * 2654435761u) >> (32 - HASH_BITS);
+    }
+
+    void writeLength(std::vector<uint8_t>& out, size_t length) {
+        while (length >= 255) {
+            out.push_back(255);
+            length -= 255;
+        }
+        out.push_back(static_cast<uint8_t>(length));
+    }
+
+    void writeSequence(std::vector<uint8_t>& out, const uint8_t* literals, size_t literal_count, size_t offset, size_t match_length) {
+        const auto token = out.size();
+        out.push_back(0);
+
+        out[token] = static_cast<uint8_t>(std::min<size_t>(literal_count, 15) << 4);
+        if (literal_count >= 15) {
+            writeLength(out, literal_count - 15);
+        }
+        out.insert(out.end(), literals, literals + literal_count);
+
+        // last sequence has no match
+        if (match_length == 0) {
+            return;
+        }
+
+        out.push_back(static_cast<uint8_t>(offset & 0xFF));
+        out.push_back(static_cast<uint8_t>(offset >> 8));
+
+        const auto length = match_length - MIN_MATCH;
+        out[token] |= static_cast<uint8_t>(std::min<size_t>(length, 15));
+        if (length >= 15) {
+            writeLength(out, length - 15);
+        }
+    }
+
+    size_t readLength(const uint8_t* data, size_t size, size_t& position) {
+        size_t length {};
+        uint8_t byte;
+        do {
+            if (position >= size) {
+                throw compression_error("LZ4 stream is truncated");
+            }
+            byte = data[position++];
+            length += byte;
+        } while (byte == 255);
+        return length;
+    }
+}
+
+std::vector<std::byte> Limitless::compressLZ4(const std::byte* data, size_t size) {
+    const auto* in = reinterpret_cast<const uint8_t*>(data);
+
+    std::vector<uint8_t> out;
+    out.reserve(size + size / 255 + 16);
+
+    size_t anchor {};
+
+    if (size >= MF_LIMIT) {
+        // stores position + 1, zero means empty slot
+        std::vector<uint32_t> table(1u << HASH_BITS, 0);
+
+        const size_t match_limit = size - MF_LIMIT;
+        size_t position {};
+
+        while (position <= match_limit) {
+            const auto sequence = read32(in + position);
+            auto& slot = table[hash(sequence)];
+            const auto candidate = slot;
+            slot = static_cast<uint32_t>(position + 1);
+
+            if (candidate == 0 || position - (candidate - 1) > MAX_OFFSET || read32(in + candidate - 1) != sequence) {
+                ++position;
+                continue;
+            }
+
+            const size_t reference = candidate - 1;
+            const size_t max_length = size - LAST_LITERALS - position;
+
+            size_t length = MIN_MATCH;
+            while (length < max_length && in[reference + length] == in[position + length]) {
+                ++length;
+            }
+
+            writeSequence(out, in + anchor, position - anchor, position - reference, length);
+
+            position += length;
+            anchor = position;
+        }
+    }
+
+    writeSequence(out, in + anchor, size - anchor, 0, 0);
+
+    std::vector<std::byte> result(out.size());
+    std::memcpy(result.data(), out.data(), out.size());
+    return result;
+}
+
+void Limitless::decompressLZ4(const std::byte* data, size_t size, std::byte* out, size_t out_size) {
+    const auto* in = reinterpret_cast<const uint8_t*>(data);
+    auto* dst = reinterpret_cast<uint8_t*>(out);
+
+    size_t position {};
+    size_t written {};
+
+    while (position < size) {
+        const auto token = in[position++];
+
+        size_t literal_count = token >> 4;
+        if (literal_count == 15) {
+            literal_count += readLength(in, size, position);
+        }
+
+        if (position + literal_count > size || written + literal_count > out_size) {
+            throw compression_error("LZ4 literals are out of range");
+        }
+
+        if (literal_count != 0) {
+            std::memcpy(dst + written, in + position, literal_count);
+        }
+        position += literal_count;
+        written += literal_count;
+
+        if (position == size) {
+            break;
+        }
+
+        if (position + 2 > size) {
+            throw compression_error("LZ4 stream is truncated");
+        }
+
+        const size_t offset = in[position] | (in[position + 1] << 8);
+        position += 2;
+
+        if (offset == 0 || offset > written) {
+            throw compression_error("LZ4 match offset is out of range");
+        }
+
+        size_t match_length = token & 0x0F;
+        if (match_length == 15) {
+            match_length += readLength(in, size, position);
+        }
+        match_length += MIN_MATCH;
+
+        if (written + match_length > out_size) {
+            throw compression_error("LZ4 match is out of range");
+        }
+
+        // matches can overlap the output, so copy byte by byte
+        const auto* match = dst + written - offset;
+        for (size_t i = 0; i < match_length; ++i) {
+            dst[written + i] = match[i];
+        }
+        written += match_length;
+    }
+
+    if (written != out_size) {
+        throw compression_error("LZ4 decompressed size mismatch");
+    }
+}
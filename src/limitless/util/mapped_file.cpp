@@ -0,0 +1,144 @@
+#include <limitless/util/mapped_file.hpp>
+
+#ifdef WIN32
+    #include <windows.h>
+#else
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <fcntl.h>
+    #include <unistd.h>
+#endif
+
+#include <utility>
+
+using namespace Limitless;
+
+#ifdef WIN32
+MappedFile::MappedFile(const fs::path& path) {
+    file = CreateFileW(path.wstring().c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        file = nullptr;
+        throw mapped_file_error("Failed to open " + path.string());
+    }
+
+    LARGE_INTEGER file_size {};
+    GetFileSizeEx(file, &file_size);
+    size = static_cast<size_t>(file_size.QuadPart);
+
+    // zero-sized files cannot be mapped
+    if (size == 0) {
+        return;
+    }
+
+    mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (!mapping) {
+        close();
+        throw mapped_file_error("Failed to map " + path.string());
+    }
+
+    data = static_cast<const std::byte*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+    if (!data) {
+        close();
+        throw mapped_file_error("Failed to map " + path.string());
+    }
+}
+
+void MappedFile::close() noexcept {
+    if (data) {
+        UnmapViewOfFile(data);
+    }
+
+    if (mapping) {
+        CloseHandle(mapping);
+    }
+
+    if (file) {
+        CloseHandle(file);
+    }
+
+    data = nullptr;
+    mapping = nullptr;
+    file = nullptr;
+    size = 0;
+}
+
+MappedFile::MappedFile(MappedFile&& rhs) noexcept
+    : data {std::exchange(rhs.data, nullptr)}
+    , size {std::exchange(rhs.size, 0)}
+    , file {std::exchange(rhs.file, nullptr)}
+    , mapping {std::exchange(rhs.mapping, nullptr)} {
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& rhs) noexcept {
+    if (this != &rhs) {
+        close();
+        data = std::exchange(rhs.data, nullptr);
+        size = std::exchange(rhs.size, 0);
+        file = std::exchange(rhs.file, nullptr);
+        mapping = std::exchange(rhs.mapping, nullptr);
+    }
+    return *this;
+}
+#else
+MappedFile::MappedFile(const fs::path& path) {
+    descriptor = ::open(path.c_str(), O_RDONLY);
+    if (descriptor == -1) {
+        throw mapped_file_error("Failed to open " + path.string());
+    }
+
+    struct stat info {};
+    if (::fstat(descriptor, &info) == -1) {
+        close();
+        throw mapped_file_error("Failed to stat " + path.string());
+    }
+
+    size = static_cast<size_t>(info.st_size);
+
+    // zero-sized files cannot be mapped
+    if (size == 0) {
+        return;
+    }
+
+    auto* ptr = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, descriptor, 0);
+    if (ptr == MAP_FAILED) {
+        close();
+        throw mapped_file_error("Failed to map " + path.string());
+    }
+
+    data = static_cast<const std::byte*>(ptr);
+}
+
+void MappedFile::close() noexcept {
+    if (data) {
+        ::munmap(const_cast<std::byte*>(data), size);
+    }
+
+    if (descriptor != -1) {
+        ::close(descriptor);
+    }
+
+    data = nullptr;
+    size = 0;
+    descriptor = -1;
+}
+
+MappedFile::MappedFile(MappedFile&& rhs) noexcept
+    : data {std::exchange(rhs.data, nullptr)}
+    , size {std::exchange(rhs.size, 0)}
+    , descriptor {std::exchange(rhs.descriptor, -1)} {
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& rhs) noexcept {
+    if (this != &rhs) {
+        close();
+        data = std::exchange(rhs.data, nullptr);
+        size = std::exchange(rhs.size, 0);
+        descriptor = std::exchange(rhs.descriptor, -1);
+    }
+    return *this;
+}
+#endif
+
+MappedFile::~MappedFile() {
+    close();
+}
@@ -0,0 +1,247 @@
+#include <limitless/util/mipmap.hpp>
+
+#include <limitless/util/thread_pool.hpp>
+#include <glm/gtc/constants.hpp>
+#include <algorithm>
+#include <cmath>
+#include <array>
+
+#if defined(__SSE2__) || defined(_M_X64)
+    #include <emmintrin.h>
+    #define LIMITLESS_MIPMAP_SSE2
+#endif
+
+using namespace Limitless;
+
+namespace {
+    // taps are source pixels 2x + first .. 2x + first + weights.size() - 1 for output pixel x
+    struct Kernel {
+        int32_t first;
+        std::vector<float> weights;
+    };
+
+    constexpr float KAISER_ALPHA = 4.0f;
+    constexpr float KAISER_WIDTH = 1.5f;
+    constexpr uint32_t SRGB_TABLE_SIZE = 1u << 16u;
+
+    // modified bessel function of the first kind, order 0
+    float bessel(float x) noexcept {
+        float sum = 1.0f;
+        float term = 1.0f;
+        for (uint32_t k = 1; k < 16; ++k) {
+            term *= (x / (2.0f * k)) * (x / (2.0f * k));
+            sum += term;
+        }
+        return sum;
+    }
+
+    Kernel makeKernel(MipFilter filter) {
+        switch (filter) {
+            case MipFilter::Box:
+                return {0, {0.5f, 0.5f}};
+            case MipFilter::Kaiser: {
+                // distances from output pixel center in output pixels are +-0.25, +-0.75, +-1.25
+                Kernel kernel {-2, {}};
+                float sum {};
+                for (int32_t k = 0; k < 6; ++k) {
+                    const auto x = (static_cast<float>(k) - 2.5f) / 2.0f;
+                    const auto sinc = std::sin(glm::pi<float>() * x) / (glm::pi<float>() * x);
+                    const auto window = bessel(KAISER_ALPHA * std::sqrt(1.0f - (x / KAISER_WIDTH) * (x / KAISER_WIDTH))) / bessel(KAISER_ALPHA);
+                    kernel.weights.push_back(sinc * window);
+                    sum += kernel.weights.back();
+                }
+
+                for (auto& weight : kernel.weights) {
+                    weight /= sum;
+                }
+                return kernel;
+            }
+        }
+        return {0, {0.5f, 0.5f}};
+    }
+
+    // clamped source pixels and their weights for every output pixel along one axis
+    struct Taps {
+        int32_t count;
+        std::vector<uint32_t> sources;
+        std::vector<float> weights;
+    };
+
+    Taps makeTaps(const Kernel& kernel, uint32_t size, uint32_t mip_size) {
+        // one more tap for box, so that last output pixel of odd size also covers third pixel
+        const auto count = std::max(static_cast<int32_t>(kernel.weights.size()), 3);
+        Taps taps {count, std::vector<uint32_t>(static_cast<size_t>(mip_size) * count), std::vector<float>(static_cast<size_t>(mip_size) * count)};
+
+        for (uint32_t x = 0; x < mip_size; ++x) {
+            for (int32_t k = 0; k < count; ++k) {
+                taps.sources[x * count + k] = std::clamp(static_cast<int32_t>(x * 2) + kernel.first + k, 0, static_cast<int32_t>(size) - 1);
+                taps.weights[x * count + k] = k < static_cast<int32_t>(kernel.weights.size()) ? kernel.weights[k] : 0.0f;
+            }
+        }
+
+        // wider kernels reach that pixel already
+        const auto extra = (size & 1u) != 0 && size > 1;
+        if (extra && kernel.weights.size() < 3) {
+            auto* weights = &taps.weights[(mip_size - 1) * count];
+            std::fill(weights, weights + 3, 1.0f / 3.0f);
+        }
+
+        return taps;
+    }
+
+    const std::array<float, 256>& getLinearTable() {
+        static const auto table = [] {
+            std::array<float, 256> values {};
+            for (uint32_t i = 0; i < values.size(); ++i) {
+                const auto c = static_cast<float>(i) / 255.0f;
+                values[i] = c <= 0.04045f ? c / 12.92f : std::pow((c + 0.055f) / 1.055f, 2.4f);
+            }
+            return values;
+        }();
+        return table;
+    }
+
+    // linear value quantized to 16 bits to srgb byte
+    const std::vector<uint8_t>& getSRGBTable() {
+        static const auto table = [] {
+            std::vector<uint8_t> values(SRGB_TABLE_SIZE);
+            for (uint32_t i = 0; i < values.size(); ++i) {
+                const auto l = static_cast<float>(i) / (SRGB_TABLE_SIZE - 1);
+                const auto c = l <= 0.0031308f ? l * 12.92f : 1.055f * std::pow(l, 1.0f / 2.4f) - 0.055f;
+                values[i] = static_cast<uint8_t>(std::lround(std::clamp(c, 0.0f, 1.0f) * 255.0f));
+            }
+            return values;
+        }();
+        return table;
+    }
+
+    // splits rows into bands for pool threads; small images are done at once
+    template<typename F>
+    void forRows(ThreadPool* pool, uint32_t rows, size_t row_size, const F& function) {
+        const auto bands = pool ? std::min(rows, std::max(std::thread::hardware_concurrency(), 1u) * 2) : 1u;
+        if (bands <= 1 || rows * row_size < 64 * 1024) {
+            function(0u, rows);
+            return;
+        }
+
+        std::vector<std::future<void>> futures;
+        futures.reserve(bands);
+        for (uint32_t band = 0; band < bands; ++band) {
+            futures.push_back(pool->add(function, rows * band / bands, rows * (band + 1) / bands));
+        }
+
+        for (auto& future : futures) {
+            future.get();
+        }
+    }
+}
+
+MipLevel Limitless::downsample(const uint8_t* pixels, uint32_t width, uint32_t height, uint32_t channels, bool srgb, MipFilter filter, ThreadPool* pool) {
+    const auto kernel = makeKernel(filter);
+    const auto& linear = getLinearTable();
+    const auto& encode = getSRGBTable();
+
+    // alpha and one or two channel images are linear
+    const auto color_channels = srgb && channels >= 3 ? 3u : 0u;
+
+    MipLevel mip {std::max(width / 2, 1u), std::max(height / 2, 1u), {}};
+    mip.pixels.resize(static_cast<size_t>(mip.width) * mip.height * channels);
+
+    const auto stride = static_cast<size_t>(mip.width) * channels;
+    const auto columns = makeTaps(kernel, width, mip.width);
+    const auto rows = makeTaps(kernel, height, mip.height);
+    const auto taps = columns.count;
+
+    // horizontal pass on every source row into linear floats
+    std::vector<float> horizontal(stride * height);
+    forRows(pool, height, static_cast<size_t>(width) * channels, [&] (uint32_t begin, uint32_t end) {
+        std::vector<float> row(static_cast<size_t>(width) * channels);
+
+        for (auto y = begin; y < end; ++y) {
+            const auto* source = pixels + static_cast<size_t>(y) * width * channels;
+            for (size_t i = 0; i < row.size(); i += channels) {
+                for (uint32_t c = 0; c < channels; ++c) {
+                    row[i + c] = c < color_channels ? linear[source[i + c]] : source[i + c] * (1.0f / 255.0f);
+                }
+            }
+
+            auto* out = horizontal.data() + y * stride;
+            for (uint32_t x = 0; x < mip.width; ++x) {
+                const auto* column = &columns.sources[x * taps];
+                const auto* weights = &columns.weights[x * taps];
+            #ifdef LIMITLESS_MIPMAP_SSE2
+                if (channels == 4) {
+                    auto sum = _mm_setzero_ps();
+                    for (int32_t k = 0; k < taps; ++k) {
+                        sum = _mm_add_ps(sum, _mm_mul_ps(_mm_set1_ps(weights[k]), _mm_loadu_ps(&row[column[k] * 4])));
+                    }
+                    _mm_storeu_ps(out + x * 4, sum);
+                    continue;
+                }
+            #endif
+
+                for (uint32_t c = 0; c < channels; ++c) {
+                    float sum {};
+                    for (int32_t k = 0; k < taps; ++k) {
+                        sum += weights[k] * row[column[k] * channels + c];
+                    }
+                    out[x * channels + c] = sum;
+                }
+            }
+        }
+    });
+
+    // vertical pass over whole rows, then back to 8 bits
+    forRows(pool, mip.height, stride * 2, [&] (uint32_t begin, uint32_t end) {
+        std::vector<float> row(stride);
+        std::vector<const float*> sources(taps);
+
+        for (auto y = begin; y < end; ++y) {
+            const auto* weights = &rows.weights[y * taps];
+            for (int32_t k = 0; k < taps; ++k) {
+                sources[k] = horizontal.data() + rows.sources[y * taps + k] * stride;
+            }
+
+            size_t i {};
+        #ifdef LIMITLESS_MIPMAP_SSE2
+            const auto zero = _mm_setzero_ps();
+            const auto one = _mm_set1_ps(1.0f);
+            for (; i + 4 <= stride; i += 4) {
+                auto sum = _mm_setzero_ps();
+                for (int32_t k = 0; k < taps; ++k) {
+                    sum = _mm_add_ps(sum, _mm_mul_ps(_mm_set1_ps(weights[k]), _mm_loadu_ps(sources[k] + i)));
+                }
+                _mm_storeu_ps(&row[i], _mm_min_ps(_mm_max_ps(sum, zero), one));
+            }
+        #endif
+            for (; i < stride; ++i) {
+                float sum {};
+                for (int32_t k = 0; k < taps; ++k) {
+                    sum += weights[k] * sources[k][i];
+                }
+                row[i] = std::clamp(sum, 0.0f, 1.0f);
+            }
+
+            auto* out = mip.pixels.data() + y * stride;
+            for (i = 0; i < stride; i += channels) {
+                for (uint32_t c = 0; c < channels; ++c) {
+                    const auto value = row[i + c];
+                    out[i + c] = c < color_channels ? encode[static_cast<uint32_t>(value * (SRGB_TABLE_SIZE - 1) + 0.5f)] : static_cast<uint8_t>(value * 255.0f + 0.5f);
+                }
+            }
+        }
+    });
+
+    return mip;
+}
+
+std::vector<MipLevel> Limitless::generateMipChain(const uint8_t* pixels, uint32_t width, uint32_t height, uint32_t channels, bool srgb, MipFilter filter, ThreadPool* pool) {
+    std::vector<MipLevel> levels;
+    while (width > 1 || height > 1) {
+        auto mip = downsample(levels.empty() ? pixels : levels.back().pixels.data(), width, height, channels, srgb, filter, pool);
+        width = mip.width;
+        height = mip.height;
+        levels.push_back(std::move(mip));
+    }
+    return levels;
+}
@@ -36,7 +36,7 @@ void RendererHelper::renderLightsVolume(Context& context, const Lighting& lighti
     for (const auto& light : lighting.point_lights) {
         sphere_instance.setPosition(light.position);
         sphere_instance.setScale(glm::vec3(light.radius));
-        sphere_instance.update(context, camera);
+        sphere_instance.update(context, camera, FrameTime {});
         sphere_instance.draw(context, assets, ShaderPass::Forward, ms::Blending::Opaque);
     }
 
@@ -51,7 +51,7 @@ void RendererHelper::renderLightsVolume(Context& context, const Lighting& lighti
         auto angle = glm::acos(glm::dot(y, glm::vec3{light.direction}));
 
         cone_instance.setRotation(a * angle);
-        cone_instance.update(context, camera);
+        cone_instance.update(context, camera, FrameTime {});
         cone_instance.draw(context, assets, ShaderPass::Forward, ms::Blending::Opaque);
     }
 
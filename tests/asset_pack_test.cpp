@@ -0,0 +1,109 @@
+#include "catch_amalgamated.hpp"
+
+#include <limitless/loaders/asset_pack.hpp>
+#include <limitless/util/compression.hpp>
+
+#include <fstream>
+#include <cstring>
+#include <cstddef>
+#include <limits>
+
+using namespace Limitless;
+
+namespace {
+    void writeFile(const fs::path& path, const std::string& content) {
+        std::ofstream stream(path, std::ios::binary);
+        stream.write(content.data(), content.size());
+    }
+
+    std::string read(const ByteSource& source) {
+        return {reinterpret_cast<const char*>(source.getData()), source.getSize()};
+    }
+}
+
+TEST_CASE("lz4 round trip") {
+    std::string text;
+    for (int i = 0; i < 1000; ++i) {
+        text += "limitless " + std::to_string(i % 7);
+    }
+
+    const auto* data = reinterpret_cast<const std::byte*>(text.data());
+    auto compressed = compressLZ4(data, text.size());
+
+    std::string decompressed(text.size(), '\0');
+    decompressLZ4(compressed.data(), compressed.size(), reinterpret_cast<std::byte*>(decompressed.data()), decompressed.size());
+
+    REQUIRE(compressed.size() < text.size());
+    REQUIRE(decompressed == text);
+    REQUIRE_THROWS_AS(decompressLZ4(compressed.data(), compressed.size() / 2, reinterpret_cast<std::byte*>(decompressed.data()), decompressed.size()), compression_error);
+}
+
+TEST_CASE("asset pack round trip") {
+    const auto root = fs::temp_directory_path() / "limitless_pack_test";
+    fs::create_directories(root / "textures");
+
+    const std::string repeated(4096, 'a');
+    writeFile(root / "material", "material data");
+    writeFile(root / "textures" / "texture", repeated);
+
+    const auto pack_path = root.string() + AssetPack::EXTENSION;
+
+    AssetPackBuilder builder;
+    builder .setAlignment(64)
+            .addDirectory(root, PackCompression::LZ4)
+            .build(pack_path);
+
+    const AssetPack pack {pack_path};
+
+    REQUIRE(pack.getEntries().size() == 2);
+    REQUIRE(pack.contains("textures/texture"));
+    REQUIRE(pack.at("textures/texture").compression == PackCompression::LZ4);
+    REQUIRE(pack.at("material").compression == PackCompression::None);
+    REQUIRE(pack.at("material").offset % 64 == 0);
+
+    REQUIRE(read(*pack.open("material")) == "material data");
+    REQUIRE(read(*pack.open("textures/texture")) == repeated);
+    REQUIRE(pack.open("material", "assets/material")->getPath() == "assets/material");
+    REQUIRE_THROWS_AS(pack.open("missing"), asset_pack_error);
+
+    // stamps key caches of packed entries, which have no file of their own
+    REQUIRE(pack.getStamp("material") == pack.getStamp("material"));
+    REQUIRE(pack.getStamp("material") != pack.getStamp("textures/texture"));
+    REQUIRE_THROWS_AS(pack.getStamp("missing"), asset_pack_error);
+
+    fs::remove_all(root);
+    fs::remove(pack_path);
+}
+
+TEST_CASE("asset pack rejects entries out of range") {
+    const auto root = fs::temp_directory_path() / "limitless_pack_range_test";
+    fs::create_directories(root);
+    writeFile(root / "material", "material data");
+
+    const auto pack_path = root.string() + AssetPack::EXTENSION;
+    AssetPackBuilder {}.addDirectory(root).build(pack_path);
+
+    // header, then name length, name and entry of the only entry
+    const auto entry_offset = 24 + sizeof(size_t) + std::strlen("material");
+
+    std::string bytes;
+    {
+        std::ifstream stream(pack_path, std::ios::binary);
+        bytes.assign(std::istreambuf_iterator<char>(stream), {});
+    }
+
+    // index is written as is, so padding of entry must not carry garbage
+    uint32_t padding {};
+    std::memcpy(&padding, bytes.data() + entry_offset + offsetof(AssetPack::Entry, padding), sizeof(padding));
+    REQUIRE(padding == 0);
+
+    // offset + size wraps around
+    const uint64_t offset = std::numeric_limits<uint64_t>::max() - 4;
+    std::memcpy(bytes.data() + entry_offset + offsetof(AssetPack::Entry, offset), &offset, sizeof(offset));
+    writeFile(pack_path, bytes);
+
+    REQUIRE_THROWS_AS(AssetPack {pack_path}, asset_pack_error);
+
+    fs::remove_all(root);
+    fs::remove(pack_path);
+}
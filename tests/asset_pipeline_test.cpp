@@ -0,0 +1,93 @@
+#include "catch_amalgamated.hpp"
+
+#include <limitless/loaders/asset_pipeline.hpp>
+
+#include <atomic>
+
+using namespace Limitless;
+
+TEST_CASE("asset pipeline runs jobs after dependencies") {
+    AssetPipeline pipeline {4};
+
+    std::mutex mutex;
+    std::vector<std::string> order;
+    auto record = [&] (std::string name) {
+        return [&, name = std::move(name)] {
+            std::unique_lock lock {mutex};
+            order.push_back(name);
+        };
+    };
+
+    const auto io = pipeline.add("io", AssetStage::IO, record("io"));
+    const auto decode = pipeline.add("decode", AssetStage::Decode, record("decode"), {io});
+    const auto other = pipeline.add("other", AssetStage::IO, record("other"));
+
+    pipeline.upload("upload", [&] () -> size_t { record("upload")(); return 16; }, {decode, other});
+
+    pipeline.wait();
+
+    REQUIRE(pipeline.isDone());
+    REQUIRE(order.size() == 4);
+    REQUIRE(order.back() == "upload");
+    REQUIRE(std::find(order.begin(), order.end(), "io") < std::find(order.begin(), order.end(), "decode"));
+
+    const auto progress = pipeline.getProgress();
+    REQUIRE(progress.total == 4);
+    REQUIRE(progress.done == 4);
+    REQUIRE(progress.getRatio() == 1.0f);
+    REQUIRE(pipeline.getStats(AssetStage::IO).done == 2);
+    REQUIRE(pipeline.getStats(AssetStage::Upload).bytes == 16);
+}
+
+TEST_CASE("asset pipeline limits uploads per update") {
+    AssetPipeline pipeline {1};
+    pipeline.setUploadBudget({100, std::chrono::seconds{1}});
+
+    std::atomic<uint32_t> count {};
+    for (int i = 0; i < 4; ++i) {
+        pipeline.upload("upload", [&] () -> size_t { ++count; return 60; });
+    }
+
+    REQUIRE(pipeline.getUploadQueueSize() == 4);
+    REQUIRE(pipeline.update() == 120);
+    REQUIRE(count == 2);
+    REQUIRE(pipeline.update() == 120);
+    REQUIRE(pipeline.isDone());
+}
+
+TEST_CASE("asset pipeline propagates failure") {
+    AssetPipeline pipeline {2};
+
+    bool dependent_ran {};
+    const auto broken = pipeline.add("broken", AssetStage::Decode, [] { throw std::runtime_error("broken"); });
+    const auto dependent = pipeline.upload("dependent", [&] () -> size_t { dependent_ran = true; return 0; }, {broken});
+
+    REQUIRE_THROWS_AS(pipeline.wait(), std::runtime_error);
+    REQUIRE_FALSE(dependent_ran);
+    REQUIRE_FALSE(pipeline.isDone(dependent));
+    REQUIRE(pipeline.getProgress().failed == 2);
+
+    const auto late = pipeline.add("late", AssetStage::Bake, [] {}, {broken});
+    REQUIRE_FALSE(pipeline.isDone(late));
+    REQUIRE(pipeline.isDone());
+
+    REQUIRE_THROWS_AS(pipeline.add("unknown", AssetStage::IO, [] {}, {100}), asset_pipeline_error);
+}
+
+TEST_CASE("asset pipeline runs jobs on their own pool") {
+    // single pipeline worker would deadlock if it waited for job of other pool
+    AssetPipeline pipeline {1};
+    ThreadPool pool {1};
+
+    std::thread::id pool_thread;
+    pool.add([&] { pool_thread = std::this_thread::get_id(); }).get();
+
+    std::thread::id job_thread;
+    const auto io = pipeline.add("io", AssetStage::IO, [] {});
+    const auto decode = pipeline.add("decode", AssetStage::Decode, [&] { job_thread = std::this_thread::get_id(); }, {io}, &pool);
+    pipeline.upload("upload", [] () -> size_t { return 0; }, {decode});
+
+    pipeline.wait();
+    REQUIRE(job_thread == pool_thread);
+    REQUIRE(pipeline.isDone());
+}
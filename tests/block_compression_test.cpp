@@ -0,0 +1,202 @@
+#include "catch_amalgamated.hpp"
+
+#include <limitless/util/block_compression.hpp>
+#include <limitless/util/thread_pool.hpp>
+
+#include <cstring>
+#include <random>
+#include <cmath>
+
+using namespace Limitless;
+
+namespace {
+    uint32_t readBits(const std::byte* data, uint32_t& position, uint32_t bits) {
+        uint32_t value {};
+        for (uint32_t i = 0; i < bits; ++i, ++position) {
+            value |= ((static_cast<uint32_t>(data[position / 8]) >> (position % 8)) & 1u) << i;
+        }
+        return value;
+    }
+
+    void decodeColor(const std::byte* block, uint8_t* rgba) {
+        uint16_t c[2];
+        uint32_t indices;
+        std::memcpy(c, block, 4);
+        std::memcpy(&indices, block + 4, 4);
+
+        uint8_t palette[4][3];
+        for (uint32_t k = 0; k < 2; ++k) {
+            const auto r = (c[k] >> 11) & 31, g = (c[k] >> 5) & 63, b = c[k] & 31;
+            palette[k][0] = static_cast<uint8_t>((r << 3) | (r >> 2));
+            palette[k][1] = static_cast<uint8_t>((g << 2) | (g >> 4));
+            palette[k][2] = static_cast<uint8_t>((b << 3) | (b >> 2));
+        }
+        for (uint32_t ch = 0; ch < 3; ++ch) {
+            palette[2][ch] = static_cast<uint8_t>((2 * palette[0][ch] + palette[1][ch]) / 3);
+            palette[3][ch] = static_cast<uint8_t>((palette[0][ch] + 2 * palette[1][ch]) / 3);
+        }
+
+        for (uint32_t i = 0; i < 16; ++i) {
+            std::memcpy(rgba + i * 4, palette[(indices >> (i * 2)) & 3], 3);
+        }
+    }
+
+    void decodeChannel(const std::byte* block, uint8_t* values) {
+        const auto a0 = static_cast<uint32_t>(block[0]);
+        const auto a1 = static_cast<uint32_t>(block[1]);
+
+        uint32_t palette[8] = {a0, a1};
+        for (uint32_t k = 2; k < 8; ++k) {
+            palette[k] = a0 > a1 ? ((8 - k) * a0 + (k - 1) * a1) / 7 : (k < 6 ? ((6 - k) * a0 + (k - 1) * a1) / 5 : (k == 6 ? 0 : 255));
+        }
+
+        uint32_t position = 16;
+        for (uint32_t i = 0; i < 16; ++i) {
+            values[i * 4] = static_cast<uint8_t>(palette[readBits(block, position, 3)]);
+        }
+    }
+
+    void decodeBC7(const std::byte* block, uint8_t* rgba) {
+        constexpr uint32_t weights[16] = {0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64};
+
+        uint32_t position {};
+        REQUIRE(readBits(block, position, 7) == 1u << 6);
+
+        uint32_t ends[2][4];
+        for (uint32_t c = 0; c < 4; ++c) {
+            ends[0][c] = readBits(block, position, 7);
+            ends[1][c] = readBits(block, position, 7);
+        }
+        const auto p0 = readBits(block, position, 1);
+        const auto p1 = readBits(block, position, 1);
+        for (uint32_t c = 0; c < 4; ++c) {
+            ends[0][c] = (ends[0][c] << 1) | p0;
+            ends[1][c] = (ends[1][c] << 1) | p1;
+        }
+
+        for (uint32_t i = 0; i < 16; ++i) {
+            const auto w = weights[readBits(block, position, i == 0 ? 3 : 4)];
+            for (uint32_t c = 0; c < 4; ++c) {
+                rgba[i * 4 + c] = static_cast<uint8_t>(((64 - w) * ends[0][c] + w * ends[1][c] + 32) >> 6);
+            }
+        }
+    }
+
+    // smooth gradients with noise, as in photographed textures
+    std::vector<uint8_t> makeImage(uint32_t width, uint32_t height) {
+        std::mt19937 random {42};
+        std::uniform_int_distribution<int> noise {-12, 12};
+
+        std::vector<uint8_t> pixels(static_cast<size_t>(width) * height * 4);
+        for (uint32_t y = 0; y < height; ++y) {
+            for (uint32_t x = 0; x < width; ++x) {
+                auto* pixel = &pixels[(static_cast<size_t>(y) * width + x) * 4];
+                pixel[0] = static_cast<uint8_t>(std::clamp(static_cast<int>(x * 255 / width) + noise(random), 0, 255));
+                pixel[1] = static_cast<uint8_t>(std::clamp(static_cast<int>(y * 255 / height) + noise(random), 0, 255));
+                pixel[2] = static_cast<uint8_t>(std::clamp(static_cast<int>(128 + 100 * std::sin(x * 0.05f)) + noise(random), 0, 255));
+                pixel[3] = static_cast<uint8_t>(std::clamp(static_cast<int>((x + y) * 255 / (width + height)) + noise(random), 0, 255));
+            }
+        }
+        return pixels;
+    }
+
+    // peak signal to noise over channels in mask of a 4-channel image
+    double getPSNR(BlockFormat format, const std::vector<uint8_t>& pixels, uint32_t width, uint32_t height, const std::vector<std::byte>& blocks) {
+        const auto block_size = getBlockSize(format);
+        double error {};
+        uint32_t count {};
+
+        for (uint32_t by = 0; by < height / 4; ++by) {
+            for (uint32_t bx = 0; bx < width / 4; ++bx) {
+                const auto* block = blocks.data() + (by * (width / 4) + bx) * block_size;
+
+                uint8_t decoded[64] {};
+                std::vector<uint32_t> channels;
+                switch (format) {
+                    case BlockFormat::BC1: decodeColor(block, decoded); channels = {0, 1, 2}; break;
+                    case BlockFormat::BC3: decodeChannel(block, decoded + 3); decodeColor(block + 8, decoded); channels = {0, 1, 2, 3}; break;
+                    case BlockFormat::BC4: decodeChannel(block, decoded); channels = {0}; break;
+                    case BlockFormat::BC5: decodeChannel(block, decoded); decodeChannel(block + 8, decoded + 1); channels = {0, 1}; break;
+                    case BlockFormat::BC7: decodeBC7(block, decoded); channels = {0, 1, 2, 3}; break;
+                }
+
+                for (uint32_t i = 0; i < 16; ++i) {
+                    const auto* source = &pixels[((by * 4 + i / 4) * width + bx * 4 + i % 4) * 4];
+                    for (const auto c : channels) {
+                        const double d = static_cast<double>(source[c]) - decoded[i * 4 + c];
+                        error += d * d;
+                        ++count;
+                    }
+                }
+            }
+        }
+
+        return 10.0 * std::log10(255.0 * 255.0 / std::max(error / count, 1e-9));
+    }
+}
+
+TEST_CASE("compressImage quality") {
+    constexpr uint32_t size = 64;
+    const auto pixels = makeImage(size, size);
+
+    // noise alone limits psnr to about 33 dB
+    const auto [format, min_psnr] = GENERATE(table<BlockFormat, double>({
+        {BlockFormat::BC1, 30.0},
+        {BlockFormat::BC3, 30.0},
+        {BlockFormat::BC4, 36.0},
+        {BlockFormat::BC5, 36.0},
+        {BlockFormat::BC7, 32.0},
+    }));
+
+    const auto blocks = compressImage(format, pixels.data(), size, size, 4);
+    REQUIRE(blocks.size() == getCompressedSize(format, size, size));
+    REQUIRE(getPSNR(format, pixels, size, size, blocks) > min_psnr);
+}
+
+TEST_CASE("compressImage constant block") {
+    uint8_t rgba[64];
+    for (uint32_t i = 0; i < 16; ++i) {
+        rgba[i * 4 + 0] = 200;
+        rgba[i * 4 + 1] = 100;
+        rgba[i * 4 + 2] = 50;
+        rgba[i * 4 + 3] = 255;
+    }
+
+    std::byte block[16];
+    uint8_t decoded[64];
+
+    // p-bit is shared by channels of endpoint
+    compressBlock(BlockFormat::BC7, rgba, block);
+    decodeBC7(block, decoded);
+    for (uint32_t i = 0; i < 64; ++i) {
+        REQUIRE(std::abs(rgba[i] - decoded[i]) <= 1);
+    }
+
+    compressBlock(BlockFormat::BC4, rgba, block);
+    decodeChannel(block, decoded);
+    REQUIRE(decoded[0] == 200);
+}
+
+TEST_CASE("compressImage threads produce same output") {
+    constexpr uint32_t width = 250;
+    constexpr uint32_t height = 130;
+    const auto pixels = makeImage(width, height);
+
+    ThreadPool pool {4};
+    REQUIRE(compressImage(BlockFormat::BC7, pixels.data(), width, height, 4, &pool) == compressImage(BlockFormat::BC7, pixels.data(), width, height, 4));
+}
+
+TEST_CASE("compressImage throughput per core", "[!benchmark]") {
+    constexpr uint32_t size = 512;
+    const auto pixels = makeImage(size, size);
+
+    // megapixels per second of one thread
+    for (const auto format : {BlockFormat::BC1, BlockFormat::BC3, BlockFormat::BC4, BlockFormat::BC5, BlockFormat::BC7}) {
+        const auto start = std::chrono::steady_clock::now();
+        const auto blocks = compressImage(format, pixels.data(), size, size, 4);
+        const std::chrono::duration<double> time = std::chrono::steady_clock::now() - start;
+
+        WARN("format " << static_cast<int>(format) << ": " << size * size / time.count() / 1e6 << " MPix/s, "
+             << getPSNR(format, pixels, size, size, blocks) << " dB");
+    }
+}
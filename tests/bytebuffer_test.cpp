@@ -1,6 +1,7 @@
 #include "catch_amalgamated.hpp"
 
 #include <util/bytebuffer.hpp>
+#include <glm/glm.hpp>
 
 using namespace Limitless;
 
@@ -24,3 +25,67 @@ TEST_CASE("bytebuffer") {
     REQUIRE(f == f1);
     REQUIRE(i == i1);
 }
+
+TEST_CASE("bytebuffer containers") {
+    ByteBuffer buffer;
+
+    std::vector<int> v {1, 2, 3};
+    std::map<int, std::string> m {{1, "one"}, {2, "two"}};
+
+    buffer << v << m;
+
+    std::vector<int> v1;
+    std::map<int, std::string> m1;
+
+    buffer >> v1 >> m1;
+
+    REQUIRE(v == v1);
+    REQUIRE(m == m1);
+    REQUIRE(buffer.size() == 0);
+    REQUIRE_THROWS_AS(buffer >> v1, bytebuffer_error);
+}
+
+TEST_CASE("bytebuffer view") {
+    ByteBuffer buffer;
+    std::string test {"shrek!"};
+    buffer << test << 1;
+
+    auto view = ByteBuffer::view(buffer.data(), buffer.size());
+
+    std::string test1;
+    int i {};
+    view >> test1 >> i;
+
+    REQUIRE(view.isView());
+    REQUIRE(test == test1);
+    REQUIRE(i == 1);
+    REQUIRE(buffer.size() == view.capacity());
+}
+
+TEST_CASE("bytebuffer throughput") {
+    constexpr auto COUNT = 100000;
+
+    ByteBuffer source;
+    for (int i = 0; i < COUNT; ++i) {
+        source << std::string{"property"} << glm::vec4{1.0f} << i;
+    }
+
+    BENCHMARK("write") {
+        ByteBuffer buffer;
+        for (int i = 0; i < COUNT; ++i) {
+            buffer << std::string{"property"} << glm::vec4{1.0f} << i;
+        }
+        return buffer.size();
+    };
+
+    BENCHMARK("read") {
+        auto buffer = ByteBuffer::view(source.data(), source.size());
+        std::string name;
+        glm::vec4 value;
+        int index {};
+        for (int i = 0; i < COUNT; ++i) {
+            buffer >> name >> value >> index;
+        }
+        return index;
+    };
+}
@@ -0,0 +1,119 @@
+#include "../catch_amalgamated.hpp"
+
+#include "../opengl_debug.hpp"
+
+#include <limitless/core/context.hpp>
+#include <limitless/core/buffer_builder.hpp>
+#include <limitless/core/texture_builder.hpp>
+
+using namespace Limitless;
+
+TEST_CASE("ContextState lookup follows current context") {
+    Context first = {"Title", {1, 1}, {{WindowHint::Visible, false}}};
+    Context second = {"Title", {1, 1}, first, {{WindowHint::Visible, false}}};
+
+    first.makeCurrent();
+    REQUIRE(ContextState::getState(glfwGetCurrentContext()) == &first);
+
+    second.makeCurrent();
+    REQUIRE(ContextState::getState(glfwGetCurrentContext()) == &second);
+    REQUIRE(ContextState::getState(first) == &first);
+
+    // moved context keeps its window registered under new state
+    Context moved = std::move(second);
+    REQUIRE(ContextState::getState(moved) == &moved);
+    REQUIRE(ContextState::getState(nullptr) == nullptr);
+
+    first.makeCurrent();
+    check_opengl_state();
+}
+
+TEST_CASE("ContextState caches indexed buffer bindings") {
+    Context context = {"Title", {1, 1}, {{WindowHint::Visible, false}}};
+
+    auto buffer = BufferBuilder()
+            .setTarget(Buffer::Type::Uniform)
+            .setUsage(Buffer::Usage::DynamicDraw)
+            .setAccess(Buffer::MutableAccess::Write)
+            .setDataSize(64)
+            .build();
+
+    buffer->bindBase(3);
+    GLint bound {};
+    glGetIntegeri_v(GL_UNIFORM_BUFFER_BINDING, 3, &bound);
+    REQUIRE(static_cast<GLuint>(bound) == buffer->getId());
+
+    // deleted buffer is forgotten by cache, so new one is bound even with reused id
+    buffer.reset();
+    auto other = BufferBuilder()
+            .setTarget(Buffer::Type::Uniform)
+            .setUsage(Buffer::Usage::DynamicDraw)
+            .setAccess(Buffer::MutableAccess::Write)
+            .setDataSize(64)
+            .build();
+    other->bindBase(3);
+    glGetIntegeri_v(GL_UNIFORM_BUFFER_BINDING, 3, &bound);
+    REQUIRE(static_cast<GLuint>(bound) == other->getId());
+
+    check_opengl_state();
+}
+
+TEST_CASE("ContextState counts only state changes reaching driver") {
+    Context context = {"Title", {1, 1}, {{WindowHint::Visible, false}}};
+    context.onFrame();
+
+    context.enable(Capabilities::DepthTest);
+    context.enable(Capabilities::DepthTest);
+    context.setDepthFunc(DepthFunc::Lequal);
+    context.setDepthFunc(DepthFunc::Lequal);
+
+    REQUIRE(context.getFrameStats().state_changes == 2);
+    REQUIRE(context.getFrameStats().draw_calls == 0);
+
+    ContextState::onDrawCall();
+    context.onFrame();
+
+    REQUIRE(context.getLastFrameStats().state_changes == 2);
+    REQUIRE(context.getLastFrameStats().draw_calls == 1);
+    REQUIRE(context.getFrameStats().state_changes == 0);
+
+    check_opengl_state();
+}
+
+TEST_CASE("ContextState redundant bind benchmark", "[!benchmark]") {
+    Context context = {"Title", {1, 1}, {{WindowHint::Visible, false}}};
+
+    auto buffer = BufferBuilder()
+            .setTarget(Buffer::Type::ShaderStorage)
+            .setUsage(Buffer::Usage::DynamicDraw)
+            .setAccess(Buffer::MutableAccess::Write)
+            .setDataSize(64)
+            .build();
+
+    auto texture = TextureBuilder()
+            .setTarget(Texture::Type::Tex2D)
+            .setInternalFormat(Texture::InternalFormat::RGBA8)
+            .setSize(glm::uvec2{1})
+            .setFormat(Texture::Format::RGBA)
+            .setDataType(Texture::DataType::UnsignedByte)
+            .build();
+
+    BENCHMARK("state lookup") {
+        return ContextState::getState(glfwGetCurrentContext());
+    };
+
+    BENCHMARK("redundant buffer bind") {
+        buffer->bindBase(1);
+    };
+
+    BENCHMARK("redundant texture bind") {
+        texture->bind(1);
+    };
+
+    std::vector<Texture*> textures {texture.get()};
+    BENCHMARK("texture binder hit") {
+        return context.getTextureBinder().bind(textures).front();
+    };
+
+    check_opengl_state();
+}
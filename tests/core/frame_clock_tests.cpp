@@ -0,0 +1,63 @@
+#include "../catch_amalgamated.hpp"
+
+#include <limitless/core/frame_clock.hpp>
+
+using namespace Limitless;
+
+TEST_CASE("FrameClock advances by given delta") {
+    FrameClock clock;
+
+    REQUIRE(clock.advance(FrameClock::Duration {0.1f}).frame == 0);
+    const auto& time = clock.advance(FrameClock::Duration {0.2f});
+
+    REQUIRE(time.frame == 1);
+    REQUIRE(time.getDelta() == Catch::Approx(0.2f));
+    REQUIRE(time.time.count() == Catch::Approx(0.3));
+    REQUIRE(time.steps == 0);
+
+    // long stall does not jump simulation
+    REQUIRE(clock.advance(FrameClock::Duration {10.0f}).getDelta() == Catch::Approx(0.25f));
+
+    clock.setPaused(true);
+    REQUIRE(clock.advance(FrameClock::Duration {0.1f}).getDelta() == 0.0f);
+
+    clock.setPaused(false);
+    clock.setScale(0.5f);
+    REQUIRE(clock.advance(FrameClock::Duration {0.1f}).getDelta() == Catch::Approx(0.05f));
+
+    clock.reset();
+    REQUIRE(clock.getTime().frame == 0);
+    REQUIRE(clock.getTime().time.count() == 0.0);
+}
+
+TEST_CASE("FrameClock accumulates fixed steps") {
+    FrameClock clock;
+    clock.setStep(FrameClock::Duration {0.01f});
+
+    auto time = clock.advance(FrameClock::Duration {0.025f});
+    REQUIRE(time.steps == 2);
+    REQUIRE(time.getDelta() == Catch::Approx(0.02f));
+    REQUIRE(time.alpha == Catch::Approx(0.5f));
+
+    // remainder is carried to next frame
+    time = clock.advance(FrameClock::Duration {0.006f});
+    REQUIRE(time.steps == 1);
+    REQUIRE(time.alpha == Catch::Approx(0.1f).margin(0.001f));
+
+    time = clock.advance(FrameClock::Duration {0.0f});
+    REQUIRE(time.steps == 0);
+    REQUIRE(time.getDelta() == 0.0f);
+    REQUIRE(time.time.count() == Catch::Approx(0.03).margin(0.0001));
+}
+
+TEST_CASE("FrameClock uses frame delta instead of measured time") {
+    FrameClock clock;
+    clock.setFrameDelta(FrameClock::Duration {1.0f / 60.0f});
+
+    for (uint32_t i = 0; i < 60; ++i) {
+        clock.tick();
+    }
+
+    REQUIRE(clock.getTime().frame == 59);
+    REQUIRE(clock.getTime().time.count() == Catch::Approx(1.0).margin(0.0001));
+}
@@ -0,0 +1,56 @@
+#include "../catch_amalgamated.hpp"
+
+#include "../opengl_debug.hpp"
+
+#include <limitless/core/context.hpp>
+#include <limitless/core/context_initializer.hpp>
+#include <limitless/core/frame_ring.hpp>
+
+using namespace Limitless;
+
+TEST_CASE("FrameRing allocates aligned memory of current frame") {
+    Context context = {"Title", {1, 1}, {{WindowHint::Visible, false}}};
+    FrameRing ring {64 * 1024};
+
+    const auto first = ring.allocate(Buffer::Type::Uniform, 100);
+    const auto second = ring.allocate(Buffer::Type::Uniform, 100);
+
+    const auto alignment = static_cast<GLintptr>(ContextInitializer::limits.uniform_buffer_offset_alignment);
+    REQUIRE(second.offset % alignment == 0);
+    REQUIRE(second.offset >= first.offset + 100);
+    REQUIRE(second.data - first.data == second.offset - first.offset);
+    REQUIRE(ring.isCurrent(first));
+
+    std::fill_n(second.data, second.size, std::byte{1});
+    ring.bind(second, Buffer::Type::Uniform, 0);
+
+    ring.onFrame();
+    REQUIRE(!ring.isCurrent(first));
+    REQUIRE(ring.getLastFrameStats().allocations == 2);
+    REQUIRE(ring.getLastFrameStats().uploaded == 200);
+
+    // next frame writes to next segment
+    const auto next = ring.allocate(Buffer::Type::Uniform, 100);
+    REQUIRE(next.offset == static_cast<GLintptr>(ring.getSegmentSize()));
+
+    check_opengl_state();
+}
+
+TEST_CASE("FrameRing grows when frame does not fit into segment") {
+    Context context = {"Title", {1, 1}, {{WindowHint::Visible, false}}};
+    FrameRing ring {1024};
+
+    const auto small = ring.allocate(16, 16);
+    const auto big = ring.allocate(ring.getSegmentSize() + 1, 16);
+
+    REQUIRE(big.buffer != small.buffer);
+    REQUIRE(ring.getSegmentSize() > big.size);
+    REQUIRE(ring.getFrameStats().growths == 1);
+
+    for (uint32_t i = 0; i < FrameRing::FRAME_COUNT * 2; ++i) {
+        (void) ring.allocate(16, 16);
+        ring.onFrame();
+    }
+
+    check_opengl_state();
+}
@@ -0,0 +1,74 @@
+#include "../catch_amalgamated.hpp"
+
+#include "../opengl_debug.hpp"
+
+#include <limitless/core/context.hpp>
+#include <limitless/core/profiler.hpp>
+
+#include <sstream>
+
+using namespace Limitless;
+
+TEST_CASE("Profiler records nested CPU scopes and exports them") {
+    Profiler cpu_profiler {false};
+    cpu_profiler.setEnabled(true);
+
+    for (uint32_t i = 0; i < 3; ++i) {
+        ProfilerScope frame {cpu_profiler, "frame"};
+        {
+            ProfilerScope pass {cpu_profiler, "pass \"quoted\""};
+        }
+        const auto now = Profiler::Clock::now();
+        cpu_profiler.add("job", now, now + std::chrono::milliseconds{1});
+    }
+    cpu_profiler.onFrame();
+
+    const auto frames = cpu_profiler.getFrames();
+    REQUIRE(frames.size() == 1);
+    REQUIRE(frames.front().scopes.size() == 9);
+
+    const auto& pass = frames.front().scopes.front();
+    REQUIRE(pass.path == "frame/pass \"quoted\"");
+    REQUIRE(pass.depth == 1);
+    REQUIRE(!pass.gpu_begin);
+
+    std::stringstream trace;
+    cpu_profiler.exportChromeTrace(trace);
+    REQUIRE(trace.str().find(R"("name":"pass \"quoted\"")") != std::string::npos);
+
+    std::stringstream csv;
+    cpu_profiler.exportCsv(csv);
+    REQUIRE(csv.str().find("\"frame/job\",3,1.0000,1.0000,,") != std::string::npos);
+}
+
+TEST_CASE("Profiler reads GPU timestamps without waiting") {
+    Context context = {"Title", {1, 1}, {{WindowHint::Visible, false}}};
+    Profiler gpu_profiler;
+    gpu_profiler.setEnabled(true);
+
+    // first frame sets thread owning context
+    gpu_profiler.onFrame();
+
+    for (uint32_t i = 0; i < Profiler::FRAME_LATENCY * 2; ++i) {
+        {
+            ProfilerScope scope {gpu_profiler, "clear"};
+            glClear(GL_COLOR_BUFFER_BIT);
+        }
+        gpu_profiler.onFrame();
+    }
+
+    const auto frames = gpu_profiler.getFrames();
+    REQUIRE(frames.size() >= Profiler::FRAME_LATENCY);
+
+    // frames are finished in order they were issued
+    for (size_t i = 1; i < frames.size(); ++i) {
+        REQUIRE(frames[i].index == frames[i - 1].index + 1);
+    }
+
+    const auto& scope = frames.back().scopes.front();
+    if (scope.gpu_begin) {
+        REQUIRE(*scope.gpu_end >= *scope.gpu_begin);
+    }
+
+    check_opengl_state();
+}
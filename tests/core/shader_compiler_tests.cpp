@@ -0,0 +1,40 @@
+#include "../catch_amalgamated.hpp"
+
+#include <limitless/core/shader_compiler.hpp>
+#include <limitless/pipeline/render_settings.hpp>
+
+using namespace Limitless;
+
+TEST_CASE("ShaderCompiler finds settings macros in source") {
+    const auto macros = ShaderCompiler::getSettingsMacros(
+        "#ifdef DIRECTIONAL_CSM\n"
+        "    for (int i = 0; i < DIRECTIONAL_SPLIT_COUNT; ++i) {}\n"
+        "#endif\n"
+    );
+
+    REQUIRE(macros == std::set<std::string>{"DIRECTIONAL_CSM", "DIRECTIONAL_SPLIT_COUNT"});
+}
+
+TEST_CASE("ShaderCompiler settings defines are restricted to used macros") {
+    RenderSettings settings;
+    settings.directional_cascade_shadow_mapping = true;
+    settings.directional_split_count = 3;
+    settings.directional_pcf = true;
+    settings.micro_shadowing = true;
+
+    const auto defines = ShaderCompiler::getSettingsDefines(settings, {"DIRECTIONAL_CSM", "DIRECTIONAL_SPLIT_COUNT"});
+    REQUIRE(defines == "#define DIRECTIONAL_CSM\n#define DIRECTIONAL_SPLIT_COUNT 3\n");
+
+    SECTION("unused setting does not change defines") {
+        settings.directional_pcf = false;
+        settings.micro_shadowing = false;
+
+        REQUIRE(ShaderCompiler::getSettingsDefines(settings, {"DIRECTIONAL_CSM", "DIRECTIONAL_SPLIT_COUNT"}) == defines);
+    }
+
+    SECTION("used setting changes defines") {
+        settings.directional_split_count = 4;
+
+        REQUIRE(ShaderCompiler::getSettingsDefines(settings, {"DIRECTIONAL_CSM", "DIRECTIONAL_SPLIT_COUNT"}) != defines);
+    }
+}
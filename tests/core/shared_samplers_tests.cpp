@@ -0,0 +1,122 @@
+#include "../catch_amalgamated.hpp"
+
+#include "../opengl_debug.hpp"
+
+#include <limitless/core/context.hpp>
+#include <limitless/core/context_initializer.hpp>
+#include <limitless/core/texture_builder.hpp>
+#include <limitless/core/bindless_texture.hpp>
+#include <limitless/core/shader_compiler.hpp>
+#include <limitless/core/shader_program.hpp>
+
+#include <fstream>
+
+using namespace Limitless;
+
+namespace {
+    std::shared_ptr<Texture> makeTexture() {
+        TextureBuilder builder;
+        return builder.setTarget(Texture::Type::Tex2D)
+                      .setInternalFormat(Texture::InternalFormat::RGBA8)
+                      .setSize(glm::uvec2{1})
+                      .setFormat(Texture::Format::RGBA)
+                      .setDataType(Texture::DataType::UnsignedByte)
+                      .build();
+    }
+
+    void writeFile(const fs::path& path, const std::string& content) {
+        fs::create_directories(path.parent_path());
+        std::ofstream stream(path, std::ios::binary);
+        stream.write(content.data(), content.size());
+    }
+
+    // program sampling only "shadows" of shared samplers
+    std::shared_ptr<ShaderProgram> makeProgram(Context& context) {
+        const auto dir = fs::temp_directory_path() / "limitless_shared_samplers_test";
+        fs::remove_all(dir);
+
+        writeFile(dir / "shared.vs", "Limitless::GLSL_VERSION\nLimitless::Extensions\nvoid main() { gl_Position = vec4(0.0); }\n");
+        writeFile(dir / "shared.fs", "Limitless::GLSL_VERSION\nLimitless::Extensions\nuniform sampler2D shadows;\nout vec4 color;\nvoid main() { color = texture(shadows, vec2(0.0)); }\n");
+
+        ShaderCompiler compiler {context};
+        return compiler.compile(dir / "shared");
+    }
+
+    // texture program sampler reads from after use()
+    void requireSampled(Context& context, ShaderProgram& program, Texture& texture) {
+        const auto location = glGetUniformLocation(program.getId(), "shadows");
+        REQUIRE(location != -1);
+
+        if (ContextInitializer::isExtensionSupported("GL_ARB_bindless_texture")) {
+            GLuint64 handle {};
+            glGetUniformui64vARB(program.getId(), location, &handle);
+            REQUIRE(handle == static_cast<BindlessTexture&>(texture.getExtensionTexture()).getHandle());
+        } else {
+            GLint unit {};
+            glGetUniformiv(program.getId(), location, &unit);
+            REQUIRE(context.getTextureBound().at(unit) == texture.getId());
+        }
+    }
+}
+
+TEST_CASE("SharedSamplers changes version only when samplers change") {
+    Context context = {"Title", {1, 1}, {{WindowHint::Visible, false}}};
+    SharedSamplers samplers;
+
+    const auto first = makeTexture();
+    const auto second = makeTexture();
+
+    auto version = samplers.getVersion();
+    samplers.set("shadows", first);
+    REQUIRE(samplers.getVersion() != version);
+    REQUIRE(samplers.getSamplers().size() == 1);
+
+    // same texture under same name is not a change
+    version = samplers.getVersion();
+    samplers.set("shadows", first);
+    REQUIRE(samplers.getVersion() == version);
+
+    // name is reused for new texture
+    samplers.set("shadows", second);
+    REQUIRE(samplers.getVersion() != version);
+    REQUIRE(samplers.getSamplers().size() == 1);
+    REQUIRE(samplers.getSamplers().front().second == second);
+
+    version = samplers.getVersion();
+    samplers.remove("refraction");
+    REQUIRE(samplers.getVersion() == version);
+
+    samplers.remove("shadows");
+    REQUIRE(samplers.getVersion() != version);
+    REQUIRE(samplers.getSamplers().empty());
+
+    check_opengl_state();
+}
+
+TEST_CASE("ShaderProgram binds shared samplers it declares") {
+    Context context = {"Title", {1, 1}, {{WindowHint::Visible, false}}};
+    const auto program = makeProgram(context);
+
+    const auto first = makeTexture();
+    const auto second = makeTexture();
+    auto& shared = context.getSharedSamplers();
+
+    // refraction is not declared by program
+    shared.set("shadows", first);
+    shared.set("refraction", second);
+    program->use();
+    requireSampled(context, *program, *first);
+
+    // unchanged samplers are kept between uses
+    program->use();
+    requireSampled(context, *program, *first);
+
+    shared.set("shadows", second);
+    program->use();
+    requireSampled(context, *program, *second);
+
+    shared.remove("shadows");
+    shared.remove("refraction");
+
+    check_opengl_state();
+}
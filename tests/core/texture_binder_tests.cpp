@@ -0,0 +1,98 @@
+#include "../catch_amalgamated.hpp"
+
+#include "../opengl_debug.hpp"
+
+#include <limitless/core/context.hpp>
+#include <limitless/core/context_initializer.hpp>
+#include <limitless/core/texture_builder.hpp>
+
+using namespace Limitless;
+
+namespace {
+    std::vector<std::shared_ptr<Texture>> makeTextures(size_t count) {
+        std::vector<std::shared_ptr<Texture>> textures;
+        for (size_t i = 0; i < count; ++i) {
+            TextureBuilder builder;
+            textures.push_back(builder.setTarget(Texture::Type::Tex2D)
+                                      .setInternalFormat(Texture::InternalFormat::RGBA8)
+                                      .setSize(glm::uvec2{1})
+                                      .setFormat(Texture::Format::RGBA)
+                                      .setDataType(Texture::DataType::UnsignedByte)
+                                      .build());
+        }
+        return textures;
+    }
+
+    std::vector<Texture*> get(const std::vector<std::shared_ptr<Texture>>& textures) {
+        std::vector<Texture*> result;
+        for (const auto& texture : textures) {
+            result.push_back(texture.get());
+        }
+        return result;
+    }
+}
+
+TEST_CASE("TextureBinder keeps bound textures in their units") {
+    Context context = {"Title", {1, 1}, {{WindowHint::Visible, false}}};
+    auto& binder = context.getTextureBinder();
+
+    const auto textures = makeTextures(3);
+    const auto first = binder.bind(get(textures));
+    binder.onFrame();
+
+    const auto second = binder.bind(get(textures));
+    REQUIRE(first == second);
+    REQUIRE(binder.getFrameStats().hits == 3);
+    REQUIRE(binder.getFrameStats().binds == 0);
+
+    for (size_t i = 0; i < textures.size(); ++i) {
+        REQUIRE(context.getTextureBound().at(second[i]) == textures[i]->getId());
+    }
+
+    check_opengl_state();
+}
+
+TEST_CASE("TextureBinder replaces least recently used unit") {
+    Context context = {"Title", {1, 1}, {{WindowHint::Visible, false}}};
+    auto& binder = context.getTextureBinder();
+
+    const auto units = static_cast<size_t>(ContextInitializer::limits.max_texture_units);
+    const auto textures = makeTextures(units + 1);
+
+    // fills every unit, the first texture is used again afterwards
+    std::vector<GLint> assigned;
+    for (size_t i = 0; i < units; ++i) {
+        assigned.push_back(binder.bind({textures[i].get()}).front());
+    }
+    (void) binder.bind({textures[0].get()});
+    binder.onFrame();
+
+    // second texture is the least recently used one now
+    const auto unit = binder.bind({textures[units].get()}).front();
+    REQUIRE(unit == assigned[1]);
+    REQUIRE(binder.getFrameStats().evictions == 1);
+    REQUIRE(binder.bind({textures[0].get()}).front() == assigned[0]);
+
+    binder.onFrame();
+    REQUIRE(binder.getLastFrameStats().requests == 2);
+    REQUIRE(binder.getLastFrameStats().hits == 1);
+
+    check_opengl_state();
+}
+
+TEST_CASE("TextureBinder notices units bound outside") {
+    Context context = {"Title", {1, 1}, {{WindowHint::Visible, false}}};
+    auto& binder = context.getTextureBinder();
+
+    const auto textures = makeTextures(2);
+    const auto unit = binder.bind({textures[0].get()}).front();
+
+    textures[1]->bind(unit);
+    const auto rebound = binder.bind({textures[0].get()}).front();
+    REQUIRE(context.getTextureBound().at(rebound) == textures[0]->getId());
+    REQUIRE(binder.getFrameStats().binds == 2);
+
+    REQUIRE_THROWS(binder.bind(std::vector<Texture*>(ContextInitializer::limits.max_texture_units + 1, textures[0].get())));
+
+    check_opengl_state();
+}
@@ -0,0 +1,109 @@
+#include "catch_amalgamated.hpp"
+
+#include <limitless/core/gpu_memory.hpp>
+
+using namespace Limitless;
+
+TEST_CASE("GpuAllocation accounts size per category") {
+    const auto before = GpuMemory::getUsage(GpuMemory::Category::VertexBuffer);
+    const auto total = GpuMemory::getTotal();
+
+    {
+        GpuAllocation allocation;
+        allocation.set(GpuMemory::Category::VertexBuffer, 1024);
+
+        auto usage = GpuMemory::getUsage(GpuMemory::Category::VertexBuffer);
+        REQUIRE(usage.bytes == before.bytes + 1024);
+        REQUIRE(usage.count == before.count + 1);
+        REQUIRE(GpuMemory::getTotal() == total + 1024);
+
+        // reallocation replaces size
+        allocation.set(GpuMemory::Category::VertexBuffer, 4096);
+        usage = GpuMemory::getUsage(GpuMemory::Category::VertexBuffer);
+        REQUIRE(usage.bytes == before.bytes + 4096);
+        REQUIRE(usage.count == before.count + 1);
+        REQUIRE(usage.peak >= before.bytes + 4096);
+
+        // retagging moves bytes to other category
+        allocation.set(GpuMemory::Category::RenderTarget, 4096);
+        REQUIRE(GpuMemory::getUsage(GpuMemory::Category::VertexBuffer).bytes == before.bytes);
+
+        GpuAllocation moved = std::move(allocation);
+        REQUIRE(moved);
+        REQUIRE(!allocation);
+    }
+
+    REQUIRE(GpuMemory::getTotal() == total);
+    REQUIRE(GpuMemory::getPeak() >= total + 4096);
+}
+
+TEST_CASE("GpuMemory closes churn every frame") {
+    GpuMemory::onFrame();
+
+    {
+        GpuAllocation allocation;
+        allocation.set(GpuMemory::Category::UniformBuffer, 256);
+        allocation.set(GpuMemory::Category::UniformBuffer, 512);
+        GpuMemory::orphan(512);
+    }
+
+    const auto churn = GpuMemory::getFrameChurn();
+    REQUIRE(churn.allocations == 2);
+    REQUIRE(churn.frees == 2);
+    REQUIRE(churn.allocated_bytes == 768);
+    REQUIRE(churn.freed_bytes == 768);
+    REQUIRE(churn.orphanings == 1);
+    REQUIRE(churn.orphaned_bytes == 512);
+
+    GpuMemory::onFrame();
+    REQUIRE(GpuMemory::getLastFrameChurn().allocations == 2);
+    REQUIRE(GpuMemory::getFrameChurn().allocations == 0);
+}
+
+TEST_CASE("GpuMemory lists named allocations biggest first") {
+    GpuAllocation small;
+    small.set(GpuMemory::Category::Texture, 16);
+    small.setName("small");
+
+    GpuAllocation big;
+    big.set(GpuMemory::Category::Texture, 1 << 20);
+    big.setName("big");
+
+    const auto allocations = GpuMemory::getAllocations();
+    REQUIRE(allocations.size() >= 2);
+    REQUIRE(allocations.front().name == "big");
+    REQUIRE(big.getName() == "big");
+}
+
+TEST_CASE("GpuMemory notifies budget listeners when budget is exceeded") {
+    size_t excess {};
+    size_t calls {};
+
+    GpuAllocation allocation;
+    const auto listener = GpuMemory::addBudgetListener([&] (size_t bytes, size_t) {
+        excess = bytes;
+        ++calls;
+        // listener is allowed to free memory
+        allocation.reset();
+    });
+
+    GpuMemory::setBudget(GpuMemory::getTotal() + 1000);
+    allocation.set(GpuMemory::Category::StorageBuffer, 1500);
+
+    GpuMemory::onFrame();
+    REQUIRE(calls == 1);
+    REQUIRE(excess == 500);
+    REQUIRE(!allocation);
+
+    GpuMemory::onFrame();
+    REQUIRE(calls == 1);
+
+    // removed listener is not notified anymore
+    GpuMemory::removeBudgetListener(listener);
+    allocation.set(GpuMemory::Category::StorageBuffer, 1500);
+    GpuMemory::onFrame();
+    REQUIRE(calls == 1);
+
+    allocation.reset();
+    GpuMemory::setBudget(0);
+}
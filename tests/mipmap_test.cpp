@@ -0,0 +1,129 @@
+#include "catch_amalgamated.hpp"
+
+#include <limitless/util/mipmap.hpp>
+#include <limitless/util/thread_pool.hpp>
+#include <limitless/util/byte_source.hpp>
+#include <limitless/loaders/texture_loader.hpp>
+
+#include <random>
+#include <chrono>
+
+using namespace Limitless;
+
+namespace {
+    std::vector<uint8_t> makeImage(uint32_t width, uint32_t height, uint32_t channels) {
+        std::mt19937 random {7};
+        std::uniform_int_distribution<int> value {0, 255};
+
+        std::vector<uint8_t> pixels(static_cast<size_t>(width) * height * channels);
+        for (auto& pixel : pixels) {
+            pixel = static_cast<uint8_t>(value(random));
+        }
+        return pixels;
+    }
+}
+
+TEST_CASE("downsample keeps constant image") {
+    const auto filter = GENERATE(MipFilter::Box, MipFilter::Kaiser);
+    const auto srgb = GENERATE(false, true);
+
+    std::vector<uint8_t> pixels(16 * 8 * 4);
+    for (size_t i = 0; i < pixels.size(); ++i) {
+        pixels[i] = static_cast<uint8_t>(40 + (i % 4) * 50);
+    }
+
+    const auto mip = downsample(pixels.data(), 16, 8, 4, srgb, filter);
+    REQUIRE(mip.width == 8);
+    REQUIRE(mip.height == 4);
+    for (size_t i = 0; i < mip.pixels.size(); ++i) {
+        REQUIRE(mip.pixels[i] == pixels[i % 4]);
+    }
+}
+
+TEST_CASE("downsample averages srgb colors in linear space") {
+    // black and white checker
+    const std::vector<uint8_t> pixels = {
+        0, 0, 0, 0,     255, 255, 255, 255,
+        255, 255, 255, 255,     0, 0, 0, 0,
+    };
+
+    const auto linear = downsample(pixels.data(), 2, 2, 4, false, MipFilter::Box);
+    REQUIRE(linear.pixels == std::vector<uint8_t>{128, 128, 128, 128});
+
+    // alpha stays linear
+    const auto srgb = downsample(pixels.data(), 2, 2, 4, true, MipFilter::Box);
+    REQUIRE(srgb.pixels == std::vector<uint8_t>{188, 188, 188, 128});
+}
+
+TEST_CASE("downsample keeps last pixel of odd sizes") {
+    // last output pixel covers three source pixels, as in hi-z pyramid
+    const std::vector<uint8_t> row = {0, 0, 255};
+    const auto horizontal = downsample(row.data(), 3, 1, 1, false, MipFilter::Box);
+    REQUIRE(horizontal.width == 1);
+    REQUIRE(horizontal.pixels == std::vector<uint8_t>{85});
+
+    const auto vertical = downsample(row.data(), 1, 3, 1, false, MipFilter::Box);
+    REQUIRE(vertical.height == 1);
+    REQUIRE(vertical.pixels == std::vector<uint8_t>{85});
+
+    // even part is not affected
+    const std::vector<uint8_t> pixels = {10, 20, 30, 40, 255};
+    const auto mip = downsample(pixels.data(), 5, 1, 1, false, MipFilter::Box);
+    REQUIRE(mip.pixels == std::vector<uint8_t>{15, 108});
+}
+
+TEST_CASE("generateMipChain sizes") {
+    const auto pixels = makeImage(13, 5, 3);
+    const auto levels = generateMipChain(pixels.data(), 13, 5, 3, true, MipFilter::Kaiser);
+
+    const std::vector<std::pair<uint32_t, uint32_t>> sizes = {{6, 2}, {3, 1}, {1, 1}};
+    REQUIRE(levels.size() == sizes.size());
+    for (size_t i = 0; i < levels.size(); ++i) {
+        REQUIRE(levels[i].width == sizes[i].first);
+        REQUIRE(levels[i].height == sizes[i].second);
+        REQUIRE(levels[i].pixels.size() == sizes[i].first * sizes[i].second * 3);
+    }
+}
+
+TEST_CASE("downsample threads produce same output") {
+    const auto channels = GENERATE(1u, 3u, 4u);
+    const auto pixels = makeImage(522, 300, channels);
+
+    ThreadPool pool {4};
+    const auto serial = downsample(pixels.data(), 522, 300, channels, true, MipFilter::Kaiser);
+    const auto threaded = downsample(pixels.data(), 522, 300, channels, true, MipFilter::Kaiser, &pool);
+    REQUIRE(serial.pixels == threaded.pixels);
+}
+
+TEST_CASE("generateMipChain throughput", "[!benchmark]") {
+    // sample textures shipped with assets
+    std::vector<DecodedTexture> images;
+    for (const auto& entry : fs::recursive_directory_iterator("../assets/textures")) {
+        const auto extension = entry.path().extension();
+        if (entry.is_regular_file() && (extension == ".png" || extension == ".jpg" || extension == ".tga")) {
+            images.push_back(TextureLoader::decode(FileByteSource {entry.path()}));
+        }
+    }
+    REQUIRE(!images.empty());
+
+    uint64_t pixel_count {};
+    for (const auto& image : images) {
+        pixel_count += static_cast<uint64_t>(image.width) * image.height;
+    }
+
+    ThreadPool pool {std::max(std::thread::hardware_concurrency(), 1u)};
+
+    // megapixels of source images per second
+    for (const auto filter : {MipFilter::Box, MipFilter::Kaiser}) {
+        for (auto* threads : {static_cast<ThreadPool*>(nullptr), &pool}) {
+            const auto start = std::chrono::steady_clock::now();
+            for (const auto& image : images) {
+                generateMipChain(image.data.get(), image.width, image.height, image.channels, true, filter, threads);
+            }
+            const std::chrono::duration<double> time = std::chrono::steady_clock::now() - start;
+
+            WARN((filter == MipFilter::Box ? "box" : "kaiser") << (threads ? " threaded: " : " serial: ")
+                 << pixel_count / time.count() / 1e6 << " MPix/s over " << images.size() << " textures");
+        }
+    }
+}
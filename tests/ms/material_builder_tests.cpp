@@ -0,0 +1,44 @@
+#include "../catch_amalgamated.hpp"
+
+#include <limitless/ms/material_builder.hpp>
+#include <limitless/core/context.hpp>
+#include <limitless/assets.hpp>
+
+using namespace Limitless;
+using namespace Limitless::ms;
+
+TEST_CASE("MaterialBuilder shares shader index between equal materials") {
+    Context context = {"Title", {1, 1}, {{WindowHint::Visible, false}}};
+    Assets assets {"../assets"};
+    MaterialBuilder builder {assets};
+
+    const auto build = [&] (const std::string& name, const glm::vec4& color, const std::string& fragment_snippet) {
+        return builder.setName(name)
+                      .add(Property::Color, color)
+                      .setShading(Shading::Lit)
+                      .setFragmentSnippet(fragment_snippet)
+                      .build();
+    };
+
+    const auto first = build("first", glm::vec4{1.0f}, "mctx.color.rgb *= 0.5;");
+    const auto second = build("second", glm::vec4{0.5f}, "mctx.color.rgb *= 0.5;");
+    const auto third = build("third", glm::vec4{1.0f}, "mctx.color.rgb *= 0.25;");
+
+    // property values are uniforms, they do not change the program
+    REQUIRE(first->getShaderIndex() == second->getShaderIndex());
+    REQUIRE(first->getShaderIndex() != third->getShaderIndex());
+
+    SECTION("refraction changes defines") {
+        const auto refractive = builder.setName("refractive")
+                                       .add(Property::Color, glm::vec4{1.0f})
+                                       .setShading(Shading::Lit)
+                                       .setRefraction(true)
+                                       .setFragmentSnippet("mctx.color.rgb *= 0.5;")
+                                       .build();
+
+        REQUIRE(refractive->getShaderIndex() != first->getShaderIndex());
+    }
+
+    const auto sharing = MaterialBuilder::getShaderSharing();
+    REQUIRE(sharing.materials > sharing.shaders);
+}
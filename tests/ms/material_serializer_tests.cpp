@@ -0,0 +1,73 @@
+#include "../catch_amalgamated.hpp"
+
+#include <limitless/serialization/material_serializer.hpp>
+#include <limitless/serialization/effect_serializer.hpp>
+#include <limitless/instances/effect_instance.hpp>
+#include <limitless/fx/emitters/sprite_emitter.hpp>
+#include <limitless/fx/effect_builder.hpp>
+#include <limitless/ms/material_builder.hpp>
+#include <limitless/util/bytebuffer.hpp>
+#include <limitless/core/context.hpp>
+#include <limitless/assets.hpp>
+
+using namespace Limitless;
+using namespace Limitless::ms;
+using namespace Limitless::fx;
+
+TEST_CASE("Material and effect serialization round trip") {
+    Context context = {"Title", {1, 1}, {{WindowHint::Visible, false}}};
+    Assets assets {"../assets"};
+
+    MaterialBuilder material_builder {assets};
+    const auto material = material_builder.setName("serialized")
+                                          .add(Property::Color, glm::vec4{0.7f, 0.3f, 0.5f, 1.0f})
+                                          .add(Property::Roughness, 0.5f)
+                                          .setShading(Shading::Lit)
+                                          .setFragmentSnippet("mctx.color.rgb *= 0.5;")
+                                          .build();
+
+    EffectBuilder effect_builder {assets};
+    const auto effect = effect_builder.create("serialized")
+                                      .createEmitter<SpriteEmitter>("sprite")
+                                          .addLifetime(std::make_unique<RangeDistribution<float>>(0.2f, 1.0f))
+                                          .addInitialSize(std::make_unique<RangeDistribution<float>>(1.0f, 25.0f))
+                                          .addInitialColor(std::make_unique<RangeDistribution<glm::vec4>>(glm::vec4{0.0f}, glm::vec4{2.0f}))
+                                          .setMaterial(material)
+                                          .setSpawnMode(EmitterSpawn::Mode::Spray)
+                                          .setMaxCount(100)
+                                          .setSpawnRate(100.0f)
+                                      .build();
+
+    MaterialSerializer material_serializer;
+    EffectSerializer effect_serializer;
+
+    // deserialized assets are registered again under their names
+    const auto material_round_trip = [&] {
+        auto buffer = material_serializer.serialize(*material);
+        assets.materials.remove("serialized");
+        return material_serializer.deserialize(assets, buffer);
+    };
+
+    const auto effect_round_trip = [&] {
+        auto buffer = effect_serializer.serialize(*effect);
+        assets.effects.remove("serialized");
+        return effect_serializer.deserialize(assets, buffer);
+    };
+
+    const auto deserialized_material = material_round_trip();
+    REQUIRE(deserialized_material->getName() == "serialized");
+    REQUIRE(deserialized_material->getColor().getValue() == glm::vec4{0.7f, 0.3f, 0.5f, 1.0f});
+    REQUIRE(deserialized_material->getShaderIndex() == material->getShaderIndex());
+
+    const auto deserialized_effect = effect_round_trip();
+    REQUIRE(deserialized_effect->getName() == "serialized");
+    REQUIRE(deserialized_effect->getEmitters().size() == 1);
+
+    BENCHMARK("material") {
+        return material_round_trip();
+    };
+
+    BENCHMARK("effect") {
+        return effect_round_trip();
+    };
+}
@@ -17,9 +17,10 @@ namespace Limitless {
             REQUIRE(state->getActiveTexture() == (query.geti(QueryState::ActiveTexture) - GL_TEXTURE0));
 
             const auto last_active_texture = state->getActiveTexture();
-            for (const auto& [unit, id] : state->getTextureBound()) {
+            const auto& bound = state->getTextureBound();
+            for (GLuint unit = 0; unit < bound.size(); ++unit) {
                 StateTexture::activate(unit);
-                REQUIRE(id == query.geti(QueryState::TextureBinding2D));
+                REQUIRE(bound[unit] == query.geti(QueryState::TextureBinding2D));
             }
             StateTexture::activate(last_active_texture);
         }
@@ -0,0 +1,113 @@
+#include "../catch_amalgamated.hpp"
+
+#include <limitless/pipeline/draw_list.hpp>
+#include <limitless/pipeline/render_pass.hpp>
+#include <limitless/pipeline/shader_pass_types.hpp>
+#include <limitless/instances/abstract_instance.hpp>
+#include <limitless/ms/blending.hpp>
+#include <limitless/assets.hpp>
+
+#include <thread>
+#include <mutex>
+#include <set>
+
+using namespace Limitless;
+
+namespace {
+    // records fallback command and remembers threads it was recorded on
+    class RecordedInstance : public AbstractInstance {
+    private:
+        std::set<std::thread::id>& threads;
+        std::mutex& mutex;
+    protected:
+        void updateBoundingBox() noexcept override {}
+    public:
+        RecordedInstance(std::set<std::thread::id>& _threads, std::mutex& _mutex)
+            : AbstractInstance(ModelShader::Model, glm::vec3{0.0f})
+            , threads {_threads}
+            , mutex {_mutex} {
+        }
+
+        AbstractInstance* clone() noexcept override { return nullptr; }
+
+        using AbstractInstance::draw;
+        void draw(Context&, const Assets&, ShaderPass, ms::Blending, const UniformSetter&) override {}
+
+        void record(DrawList::Segment& segment) override {
+            {
+                std::unique_lock lock(mutex);
+                threads.emplace(std::this_thread::get_id());
+            }
+            AbstractInstance::record(segment);
+        }
+    };
+}
+
+TEST_CASE("DrawList splits recording of instances across threads") {
+    Assets assets {"."};
+    std::set<std::thread::id> threads;
+    std::mutex mutex;
+
+    std::vector<RecordedInstance> storage;
+    storage.reserve(DrawList::RANGE_SIZE * 8);
+    for (size_t i = 0; i < DrawList::RANGE_SIZE * 8; ++i) {
+        storage.emplace_back(threads, mutex);
+    }
+
+    Instances instances {storage.begin(), storage.end()};
+
+    DrawList list;
+    list.record(instances, assets, ShaderPass::Depth, ms::Blending::Opaque);
+
+    REQUIRE(list.getCommandCount() == instances.size());
+    REQUIRE(list.getPass() == ShaderPass::Depth);
+    if (std::thread::hardware_concurrency() > 1) {
+        REQUIRE(threads.size() > 1);
+    }
+
+    // records again into reused segments
+    instances.erase(instances.begin() + 3, instances.end());
+    list.record(instances, assets, ShaderPass::GBuffer, ms::Blending::Opaque);
+    REQUIRE(list.getCommandCount() == 3);
+
+    list.clear();
+    REQUIRE(list.getCommandCount() == 0);
+}
+
+TEST_CASE("DrawList update records only changed instances") {
+    Assets assets {"."};
+    std::set<std::thread::id> threads;
+    std::mutex mutex;
+
+    std::vector<RecordedInstance> storage;
+    storage.reserve(4);
+    for (size_t i = 0; i < 4; ++i) {
+        storage.emplace_back(threads, mutex);
+    }
+
+    Instances instances {storage.begin(), storage.end()};
+    const auto by_id = [] (const auto& lhs, const auto& rhs) {
+        return lhs.get().getId() < rhs.get().getId();
+    };
+
+    DrawList list;
+    list.update(instances, 1, assets, ShaderPass::Depth, ms::Blending::Opaque, by_id, false);
+    REQUIRE(list.getStats().misses == 1);
+
+    list.update(instances, 1, assets, ShaderPass::Depth, ms::Blending::Opaque, by_id, false);
+    REQUIRE(list.getStats().hits == 1);
+    REQUIRE(list.getStats().recorded == 4);
+
+    // hidden instance is recorded again
+    storage[2].hide();
+    list.update(instances, 1, assets, ShaderPass::Depth, ms::Blending::Opaque, by_id, false);
+    REQUIRE(list.getStats().hits == 1);
+    REQUIRE(list.getStats().misses == 1);
+    REQUIRE(list.getStats().recorded == 5);
+    REQUIRE(list.getCommandCount() == 4);
+
+    // changed set of instances records whole list
+    list.update(instances, 2, assets, ShaderPass::Depth, ms::Blending::Opaque, by_id, false);
+    REQUIRE(list.getStats().misses == 2);
+    REQUIRE(list.getHitRate() == Catch::Approx(1.0f - 9.0f / 16.0f));
+}
@@ -0,0 +1,64 @@
+#include "../catch_amalgamated.hpp"
+
+#include <limitless/pipeline/occlusion_tester.hpp>
+
+using namespace Limitless;
+
+namespace {
+    // with identity view projection depth of box is z * 0.5 + 0.5
+    BoundingBox box(glm::vec2 position, float z, float size = 0.1f) {
+        return {glm::vec3{position, z}, glm::vec3{size}};
+    }
+}
+
+TEST_CASE("OcclusionTester rejects boxes behind depth") {
+    OcclusionTester tester;
+
+    // nothing is occluded before first readback
+    REQUIRE(!tester.isOccluded(box({0.0f, 0.0f}, 0.9f)));
+    REQUIRE(tester.getFrameStats().tested == 0);
+
+    std::vector<float> depth(8 * 8, 0.5f);
+    // upper right texel sees far plane
+    depth[7 * 8 + 7] = 1.0f;
+    tester.update({8, 8}, std::move(depth), glm::mat4{1.0f});
+
+    REQUIRE(tester.isOccluded(box({0.0f, 0.0f}, 0.5f)));
+    REQUIRE(!tester.isOccluded(box({0.0f, 0.0f}, -0.5f)));
+
+    // part of box is visible through hole
+    REQUIRE(tester.isOccluded(box({-0.875f, -0.875f}, 0.5f)));
+    REQUIRE(!tester.isOccluded(box({0.875f, 0.875f}, 0.5f)));
+
+    // box covering whole screen is tested at coarse level that still keeps hole
+    REQUIRE(!tester.isOccluded(box({0.0f, 0.0f}, 0.5f, 1.9f)));
+
+    // boxes crossing near plane, outside of screen or without bounds are kept
+    REQUIRE(!tester.isOccluded(box({0.0f, 0.0f}, -1.0f, 0.5f)));
+    REQUIRE(!tester.isOccluded(box({3.0f, 0.0f}, 0.5f)));
+    REQUIRE(!tester.isOccluded(BoundingBox{glm::vec3{0.0f, 0.0f, 0.5f}, glm::vec3{0.0f}}));
+
+    REQUIRE(tester.getFrameStats().tested == 8);
+    REQUIRE(tester.getFrameStats().occluded == 2);
+
+    tester.onFrame();
+    REQUIRE(tester.getLastFrameStats().occluded == 2);
+    REQUIRE(tester.getFrameStats().tested == 0);
+
+    tester.reset();
+    REQUIRE(!tester.isAvailable());
+    REQUIRE(!tester.isOccluded(box({0.0f, 0.0f}, 0.5f)));
+}
+
+TEST_CASE("OcclusionTester reduction keeps last texel of odd size") {
+    OcclusionTester tester;
+
+    std::vector<float> depth(5 * 3, 0.5f);
+    depth[2 * 5 + 4] = 1.0f;
+    tester.update({5, 3}, std::move(depth), glm::mat4{1.0f});
+
+    REQUIRE(!tester.isOccluded(box({0.0f, 0.0f}, 0.5f, 1.9f)));
+    REQUIRE(tester.isOccluded(box({-0.5f, -0.5f}, 0.5f, 0.8f)));
+
+    REQUIRE_THROWS_AS(tester.update({4, 4}, std::vector<float>(3), glm::mat4{1.0f}), std::logic_error);
+}
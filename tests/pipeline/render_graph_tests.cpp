@@ -0,0 +1,125 @@
+#include "../catch_amalgamated.hpp"
+
+#include "../opengl_debug.hpp"
+
+#include <limitless/core/context.hpp>
+#include <limitless/pipeline/render_graph.hpp>
+
+using namespace Limitless;
+
+TEST_CASE("RenderGraph culls passes whose outputs are not read") {
+    Context context = {"Title", {1, 1}, {{WindowHint::Visible, false}}};
+    RenderGraph graph;
+
+    graph.addPass("used").create("used", {});
+    graph.addPass("unused").create("unused", {});
+
+    auto present = graph.addPass("present");
+    present.read("used");
+    present.setSideEffect();
+
+    graph.compile({64, 64});
+
+    REQUIRE(!graph.isCulled(0));
+    REQUIRE(graph.isCulled(1));
+    REQUIRE(!graph.isCulled(2));
+    REQUIRE(graph.getTexture("used"));
+    REQUIRE(!graph.getTexture("unused"));
+    REQUIRE(graph.getStats().culled == 1);
+
+    REQUIRE_THROWS_AS(graph.addPass("missing").read("missing"), render_graph_error);
+
+    check_opengl_state();
+}
+
+TEST_CASE("RenderGraph aliases textures with disjoint lifetimes") {
+    Context context = {"Title", {1, 1}, {{WindowHint::Visible, false}}};
+    RenderGraph graph;
+
+    const RenderGraph::TextureDescriptor hdr {Texture::InternalFormat::RGB16F};
+
+    graph.addPass("first").create("first", hdr);
+
+    auto second = graph.addPass("second");
+    second.read("first");
+    second.create("second", hdr);
+
+    auto third = graph.addPass("third");
+    third.read("second");
+    third.create("third", hdr);
+    // different format never shares memory
+    third.create("mask", {Texture::InternalFormat::R8});
+
+    auto present = graph.addPass("present");
+    present.read("third");
+    present.read("mask");
+    present.setSideEffect();
+
+    graph.compile({64, 32});
+
+    REQUIRE(graph.getTexture("first") == graph.getTexture("third"));
+    REQUIRE(graph.getTexture("first") != graph.getTexture("second"));
+    REQUIRE(graph.getTexture("third")->getSize() == glm::uvec3{64, 32, 0});
+
+    const auto& stats = graph.getStats();
+    REQUIRE(stats.resources == 4);
+    REQUIRE(stats.textures == 3);
+    REQUIRE(stats.requested == 3 * 64 * 32 * 6 + 64 * 32);
+    REQUIRE(stats.allocated == 2 * 64 * 32 * 6 + 64 * 32);
+
+    // recompiling with same size keeps textures
+    const auto texture = graph.getTexture("second");
+    graph.compile({64, 32});
+    REQUIRE(graph.getTexture("second") == texture);
+
+    check_opengl_state();
+}
+
+TEST_CASE("RenderGraph clears texture before first write") {
+    Context context = {"Title", {1, 1}, {{WindowHint::Visible, false}}};
+    RenderGraph graph;
+
+    graph.addPass("clear").create("color", {Texture::InternalFormat::RGBA8, Texture::Filter::Nearest, glm::vec2{1.0f}, true, glm::vec4{1.0f, 0.0f, 0.0f, 1.0f}});
+
+    auto present = graph.addPass("present");
+    present.read("color");
+    present.setSideEffect();
+
+    graph.compile({4, 4});
+    graph.begin(0, context);
+    graph.begin(1, context);
+
+    std::array<uint8_t, 4 * 4 * 4> pixels {};
+    graph.getTexture("color")->bind(0);
+    glGetTexImage(GL_TEXTURE_2D, 0, GL_RGBA, GL_UNSIGNED_BYTE, pixels.data());
+
+    REQUIRE(pixels[0] == 255);
+    REQUIRE(pixels[1] == 0);
+    REQUIRE(pixels[3] == 255);
+
+    check_opengl_state();
+}
+
+TEST_CASE("RenderGraph clears depth and stencil of packed texture") {
+    Context context = {"Title", {1, 1}, {{WindowHint::Visible, false}}};
+    RenderGraph graph;
+
+    graph.addPass("clear").create("depth", {Texture::InternalFormat::Depth24Stencil8, Texture::Filter::Nearest, glm::vec2{1.0f}, true, glm::vec4{1.0f, 3.0f, 0.0f, 0.0f}});
+
+    auto present = graph.addPass("present");
+    present.read("depth");
+    present.setSideEffect();
+
+    graph.compile({4, 4});
+    graph.begin(0, context);
+    graph.begin(1, context);
+
+    std::array<uint32_t, 4 * 4> pixels {};
+    graph.getTexture("depth")->bind(0);
+    glGetTexImage(GL_TEXTURE_2D, 0, GL_DEPTH_STENCIL, GL_UNSIGNED_INT_24_8, pixels.data());
+
+    REQUIRE(pixels[0] >> 8u == 0xFFFFFFu);
+    REQUIRE((pixels[0] & 0xFFu) == 3);
+
+    check_opengl_state();
+}
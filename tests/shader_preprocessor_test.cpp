@@ -0,0 +1,194 @@
+#include "catch_amalgamated.hpp"
+
+#include <limitless/core/shader_preprocessor.hpp>
+
+#include <fstream>
+#include <sstream>
+
+#ifndef ENGINE_SHADERS_DIR
+    #define ENGINE_SHADERS_DIR "shaders/"
+#endif
+
+using namespace Limitless;
+
+namespace {
+    void writeFile(const fs::path& path, const std::string& content) {
+        fs::create_directories(path.parent_path());
+        std::ofstream stream(path, std::ios::binary);
+        stream.write(content.data(), content.size());
+    }
+
+    std::string readFile(const fs::path& path) {
+        std::ifstream file(path, std::ios::binary);
+        if (!file) {
+            throw shader_file_not_found(path.string());
+        }
+
+        std::stringstream stream;
+        stream << file.rdbuf();
+        return stream.str();
+    }
+
+    // include resolution and key replacement done by repeated find/replace, as shaders were preprocessed before
+    void resolveIncludes(const fs::path& base_dir, std::string& src) {
+        size_t found {};
+        while ((found = src.find("#include", found)) != std::string::npos) {
+            const auto begin = found + 10;
+            const auto end = src.find('"', begin);
+            const fs::path name = src.substr(begin, end - begin);
+
+            auto include = readFile(base_dir / name);
+            resolveIncludes(base_dir / name.parent_path(), include);
+            src.replace(found, end + 1 - found, include);
+        }
+    }
+
+    std::string preprocessByReplace(const fs::path& path, const ShaderPreprocessor::Keys& keys) {
+        auto src = readFile(path);
+        resolveIncludes(path.parent_path(), src);
+        for (const auto& [key, value] : keys) {
+            size_t found {};
+            while ((found = src.find(key, found)) != std::string::npos) {
+                src.replace(found, key.size(), value);
+            }
+        }
+        return src;
+    }
+
+    std::vector<fs::path> getShaderSet() {
+        static const std::set<std::string> stages = {".vs", ".tcs", ".tes", ".gs", ".fs", ".cs"};
+
+        std::vector<fs::path> shaders;
+        if (fs::exists(ENGINE_SHADERS_DIR)) {
+            for (const auto& entry : fs::recursive_directory_iterator(ENGINE_SHADERS_DIR)) {
+                if (stages.count(entry.path().extension().string()) != 0) {
+                    shaders.push_back(entry.path());
+                }
+            }
+        }
+        return shaders;
+    }
+
+    const ShaderPreprocessor::Keys shader_set_keys = {
+        {"Limitless::GLSL_VERSION", "#version 330 core"},
+        {"Limitless::Extensions", "#extension GL_ARB_shader_storage_buffer_object : require\n"},
+        {"Limitless::Settings", "#define DIRECTIONAL_CSM\n#define DIRECTIONAL_SPLIT_COUNT 3\n"},
+        {"Limitless::MaterialType", "#define MATERIAL_COLOR\n#define MATERIAL_LIT\n"},
+        {"Limitless::ModelType", "#define SIMPLE_MODEL\n"},
+        {"Limitless::EmitterType", ""},
+        {"_MATERIAL_VERTEX_SNIPPET", ""},
+        {"_MATERIAL_FRAGMENT_SNIPPET", "mctx.color.rgb *= 0.5;"},
+        {"_MATERIAL_GLOBAL_DEFINITIONS", ""},
+        {"_MATERIAL_TESSELLATION_SNIPPET", ""},
+        {"_MATERIAL_SCALAR_UNIFORMS", ""},
+        {"_MATERIAL_SAMPLER_UNIFORMS", ""},
+    };
+}
+
+TEST_CASE("ShaderPreprocessor expands includes and keys") {
+    const auto dir = fs::temp_directory_path() / "limitless_preprocessor_test";
+    fs::remove_all(dir);
+
+    writeFile(dir / "main.fs", "Limitless::GLSL_VERSION\n#include \"lib/a.glsl\"\nvoid main() { _MATERIAL_FRAGMENT_SNIPPET }\nLimitless::Unknown\n");
+    writeFile(dir / "lib/a.glsl", "#include \"b.glsl\"\nfloat a;\n");
+    writeFile(dir / "lib/b.glsl", "float b; // Limitless::GLSL_VERSION\n");
+    ShaderPreprocessor::clear();
+
+    std::set<fs::path> dependencies;
+    const auto source = ShaderPreprocessor::expand(dir / "main.fs", {{"Limitless::GLSL_VERSION", "#version 330 core"}, {"_MATERIAL_FRAGMENT_SNIPPET", "x = 1;"}}, dependencies);
+
+    REQUIRE(source == "#version 330 core\nfloat b; // #version 330 core\n\nfloat a;\n\nvoid main() { x = 1; }\nLimitless::Unknown\n");
+    REQUIRE(dependencies == std::set<fs::path>{(dir / "lib/a.glsl").lexically_normal(), (dir / "lib/b.glsl").lexically_normal()});
+
+    SECTION("missing files") {
+        writeFile(dir / "broken.fs", "#include \"missing.glsl\"\n");
+
+        REQUIRE_THROWS_AS(ShaderPreprocessor::expand(dir / "none.fs", {}, dependencies), shader_file_not_found);
+        REQUIRE_THROWS_AS(ShaderPreprocessor::expand(dir / "broken.fs", {}, dependencies), shader_include_not_found);
+
+        // created include stays missing until missing files are invalidated
+        writeFile(dir / "missing.glsl", "float m;\n");
+        REQUIRE_THROWS_AS(ShaderPreprocessor::expand(dir / "broken.fs", {}, dependencies), shader_include_not_found);
+
+        ShaderPreprocessor::invalidateMissing();
+        REQUIRE(ShaderPreprocessor::expand(dir / "broken.fs", {}, dependencies) == "float m;\n\n");
+    }
+
+    SECTION("recursive include") {
+        writeFile(dir / "self.glsl", "#include \"self.glsl\"\n");
+
+        REQUIRE_THROWS_AS(ShaderPreprocessor::expand(dir / "self.glsl", {}, dependencies), shader_include_not_found);
+    }
+
+    SECTION("cached file is read again only after invalidation") {
+        writeFile(dir / "lib/b.glsl", "float c;\n");
+        REQUIRE(ShaderPreprocessor::expand(dir / "lib/a.glsl", {}, dependencies) == "float b; // Limitless::GLSL_VERSION\n\nfloat a;\n");
+
+        ShaderPreprocessor::invalidate(dir / "lib/b.glsl");
+        REQUIRE(ShaderPreprocessor::expand(dir / "lib/a.glsl", {}, dependencies) == "float c;\n\nfloat a;\n");
+    }
+
+    SECTION("refers to") {
+        REQUIRE(ShaderPreprocessor::refersTo(dir / "main.fs", {}, "float b"));
+        REQUIRE(ShaderPreprocessor::refersTo(dir / "main.fs", {{"key", "DIRECTIONAL_CSM"}}, "DIRECTIONAL_CSM"));
+        REQUIRE_FALSE(ShaderPreprocessor::refersTo(dir / "main.fs", {}, "DIRECTIONAL_CSM"));
+    }
+
+    fs::remove_all(dir);
+}
+
+TEST_CASE("ShaderPreprocessor matches find and replace on shader set") {
+    for (const auto& path : getShaderSet()) {
+        std::set<fs::path> dependencies;
+        CAPTURE(path);
+
+        std::string expected;
+        try {
+            expected = preprocessByReplace(path, shader_set_keys);
+        } catch (const shader_file_not_found&) {
+            // some shaders of unused pipelines refer to missing files
+            REQUIRE_THROWS_AS(ShaderPreprocessor::expand(path, shader_set_keys, dependencies), shader_include_not_found);
+            continue;
+        }
+
+        REQUIRE(ShaderPreprocessor::expand(path, shader_set_keys, dependencies) == expected);
+    }
+}
+
+TEST_CASE("ShaderPreprocessor throughput on shader set", "[!benchmark]") {
+    const auto shaders = getShaderSet();
+
+    BENCHMARK("find and replace") {
+        size_t size {};
+        for (const auto& path : shaders) {
+            try {
+                size += preprocessByReplace(path, shader_set_keys).size();
+            } catch (const shader_file_not_found&) {}
+        }
+        return size;
+    };
+
+    BENCHMARK("cold cache") {
+        ShaderPreprocessor::clear();
+
+        size_t size {};
+        for (const auto& path : shaders) {
+            std::set<fs::path> dependencies;
+            try {
+                size += ShaderPreprocessor::expand(path, shader_set_keys, dependencies).size();
+            } catch (const shader_include_not_found&) {}
+        }
+        return size;
+    };
+
+    BENCHMARK("warm cache") {
+        size_t size {};
+        for (const auto& path : shaders) {
+            std::set<fs::path> dependencies;
+            try {
+                size += ShaderPreprocessor::expand(path, shader_set_keys, dependencies).size();
+            } catch (const shader_include_not_found&) {}
+        }
+        return size;
+    };
+}
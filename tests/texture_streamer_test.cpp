@@ -0,0 +1,129 @@
+#include "catch_amalgamated.hpp"
+
+#include <limitless/loaders/texture_residency.hpp>
+
+using namespace Limitless;
+
+namespace {
+    // bytes of 8x8 BC1 texture with its mips; base level 4x4 and smaller ones are always resident
+    const std::vector<size_t> LEVELS {64, 16, 8, 8};
+    constexpr uint32_t BASE = 1;
+    constexpr size_t BASE_BYTES = 16 + 8 + 8;
+    constexpr size_t FULL_BYTES = 64 + BASE_BYTES;
+
+    int a, b, c;
+
+    // requests full texture and finishes its promotion in one frame
+    void promote(TextureResidency& residency, TextureResidency::Key key) {
+        residency.request(key, 0);
+        const auto plan = residency.update();
+        REQUIRE(plan.promotions.size() == 1);
+        REQUIRE(residency.finish(key, 0));
+    }
+}
+
+TEST_CASE("TextureResidency selects level from screen size") {
+    REQUIRE(TextureResidency::getLevel({1024, 512}, 11, 1024.0f) == 0);
+    REQUIRE(TextureResidency::getLevel({1024, 512}, 11, 512.0f) == 1);
+    REQUIRE(TextureResidency::getLevel({1024, 512}, 11, 100.0f) == 3);
+
+    // larger than texture on screen and smaller than a pixel are clamped
+    REQUIRE(TextureResidency::getLevel({1024, 512}, 11, 4096.0f) == 0);
+    REQUIRE(TextureResidency::getLevel({1024, 512}, 11, 0.0f) == 10);
+    REQUIRE(TextureResidency::getLevel({1024, 512}, 4, 1.0f) == 3);
+}
+
+TEST_CASE("TextureResidency accounts resident and pending bytes") {
+    TextureResidency residency {1024};
+
+    residency.add(&a, LEVELS, BASE);
+    residency.add(&b, LEVELS, BASE);
+    REQUIRE(residency.getStats().resident_bytes == 2 * BASE_BYTES);
+    REQUIRE(residency.getStats().textures == 2);
+
+    // finest level of the frame wins
+    residency.request(&a, 2);
+    residency.request(&a, 0);
+    residency.request(&b, BASE);
+
+    const auto plan = residency.update();
+    REQUIRE(plan.evictions.empty());
+    REQUIRE(plan.promotions.size() == 1);
+    REQUIRE(plan.promotions.front().key == &a);
+    REQUIRE(plan.promotions.front().level == 0);
+
+    // level is resident only after it was loaded
+    REQUIRE(residency.isLoading(&a));
+    REQUIRE(residency.getStats().queue_length == 1);
+    REQUIRE(residency.getStats().resident_bytes == 2 * BASE_BYTES);
+
+    // loading texture is not promoted twice
+    residency.request(&a, 0);
+    REQUIRE(residency.update().promotions.empty());
+
+    REQUIRE(residency.finish(&a, 0));
+    REQUIRE(residency.getResident(&a) == 0);
+    REQUIRE(residency.getStats().resident_bytes == FULL_BYTES + BASE_BYTES);
+    REQUIRE(residency.getStats().queue_length == 0);
+    REQUIRE(residency.getStats().promotions == 1);
+
+    // late upload of coarser level is dropped
+    REQUIRE(!residency.finish(&a, BASE));
+
+    residency.remove(&a);
+    REQUIRE(residency.getStats().resident_bytes == BASE_BYTES);
+    REQUIRE(!residency.finish(&a, 0));
+}
+
+TEST_CASE("TextureResidency evicts least recently requested textures within budget") {
+    TextureResidency residency {2 * FULL_BYTES + BASE_BYTES};
+    residency.setEvictionDelay(0);
+
+    residency.add(&a, LEVELS, BASE);
+    residency.add(&b, LEVELS, BASE);
+    residency.add(&c, LEVELS, BASE);
+
+    promote(residency, &a);
+    promote(residency, &b);
+    REQUIRE(residency.getStats().resident_bytes == 2 * FULL_BYTES + BASE_BYTES);
+
+    // third texture fits only when the oldest one loses its levels
+    residency.request(&c, 0);
+    const auto plan = residency.update();
+
+    REQUIRE(plan.evictions.size() == 1);
+    REQUIRE(plan.evictions.front().key == &a);
+    REQUIRE(plan.evictions.front().level == BASE);
+    REQUIRE(plan.promotions.size() == 1);
+    REQUIRE(plan.promotions.front().key == &c);
+
+    REQUIRE(residency.getResident(&a) == BASE);
+    REQUIRE(residency.getResident(&b) == 0);
+    REQUIRE(residency.getStats().evictions == 1);
+
+    REQUIRE(residency.finish(&c, 0));
+    REQUIRE(residency.getStats().resident_bytes == 2 * FULL_BYTES + BASE_BYTES);
+
+    // trim evicts in the same order
+    const auto trimmed = residency.trim(1);
+    REQUIRE(trimmed.size() == 1);
+    REQUIRE(trimmed.front().key == &b);
+    REQUIRE(residency.getStats().resident_bytes == FULL_BYTES + 2 * BASE_BYTES);
+}
+
+TEST_CASE("TextureResidency keeps recently requested textures") {
+    TextureResidency residency {FULL_BYTES + BASE_BYTES};
+
+    residency.add(&a, LEVELS, BASE);
+    residency.add(&b, LEVELS, BASE);
+
+    promote(residency, &a);
+
+    // a was requested within eviction delay, so b does not fit
+    residency.request(&b, 0);
+    const auto plan = residency.update();
+    REQUIRE(plan.evictions.empty());
+    REQUIRE(plan.promotions.empty());
+    REQUIRE(residency.getResident(&a) == 0);
+    REQUIRE(residency.getResident(&b) == BASE);
+}
@@ -0,0 +1,59 @@
+#include "catch_amalgamated.hpp"
+
+#include <limitless/loaders/virtual_texture.hpp>
+
+using namespace Limitless;
+
+namespace {
+    DecodedTexture makeImage(int width, int height, int channels, const std::vector<uint8_t>& pixels) {
+        DecodedTexture image;
+        image.width = width;
+        image.height = height;
+        image.channels = channels;
+        image.data = std::shared_ptr<unsigned char>(new unsigned char[pixels.size()], std::default_delete<unsigned char[]>());
+        std::copy(pixels.begin(), pixels.end(), image.data.get());
+        return image;
+    }
+}
+
+TEST_CASE("makeTile copies page with wrapped border") {
+    // 4x4 single channel image, texel value is its index
+    std::vector<uint8_t> pixels(16);
+    for (uint8_t i = 0; i < pixels.size(); ++i) {
+        pixels[i] = i * 10;
+    }
+    const auto image = makeImage(4, 4, 1, pixels);
+
+    // second page of 2x2 pages, region equals image size
+    const auto tile = VirtualTexture::makeTile(image, {4, 4}, {1, 0}, 2, 1);
+    REQUIRE(tile.size() == 4 * 4 * 4);
+
+    const auto at = [&] (uint32_t x, uint32_t y) { return &tile[(y * 4 + x) * 4]; };
+
+    // inner texels are image texels 2..3 of rows 0..1
+    REQUIRE(at(1, 1)[0] == pixels[2]);
+    REQUIRE(at(2, 1)[0] == pixels[3]);
+    REQUIRE(at(1, 2)[0] == pixels[6]);
+
+    // right border wraps to first column, top border to last row
+    REQUIRE(at(3, 1)[0] == pixels[0]);
+    REQUIRE(at(1, 0)[0] == pixels[14]);
+
+    // missing channels read as zero, alpha as one
+    REQUIRE(at(1, 1)[1] == 0);
+    REQUIRE(at(1, 1)[2] == 0);
+    REQUIRE(at(1, 1)[3] == 255);
+}
+
+TEST_CASE("makeTile samples mip closest to region") {
+    auto image = makeImage(4, 4, 4, std::vector<uint8_t>(64, 200));
+    image.mips.push_back({2, 2, std::vector<uint8_t>(16, 100)});
+    image.mips.push_back({1, 1, std::vector<uint8_t>(4, 50)});
+
+    const auto half = VirtualTexture::makeTile(image, {2, 2}, {0, 0}, 2, 1);
+    REQUIRE(std::all_of(half.begin(), half.end(), [] (auto value) { return value == 100; }));
+
+    // regions between levels take the bigger one
+    const auto full = VirtualTexture::makeTile(image, {3, 3}, {0, 0}, 3, 0);
+    REQUIRE(std::all_of(full.begin(), full.end(), [] (auto value) { return value == 200; }));
+}
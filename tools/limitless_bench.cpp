@@ -0,0 +1,493 @@
+#include <limitless/core/context_observer.hpp>
+#include <limitless/core/gpu_memory.hpp>
+#include <limitless/core/profiler.hpp>
+#include <limitless/pipeline/renderer.hpp>
+#include <limitless/pipeline/deferred.hpp>
+#include <limitless/pipeline/hiz_pass.hpp>
+#include <limitless/instances/model_instance.hpp>
+#include <limitless/instances/skeletal_instance.hpp>
+#include <limitless/instances/effect_instance.hpp>
+#include <limitless/models/skeletal_model.hpp>
+#include <limitless/loaders/model_loader.hpp>
+#include <limitless/ms/material_builder.hpp>
+#include <limitless/fx/effect_builder.hpp>
+#include <limitless/fx/emitters/sprite_emitter.hpp>
+#include <limitless/fx/modules/distribution.hpp>
+#include <limitless/camera.hpp>
+#include <limitless/scene.hpp>
+#include <limitless/assets.hpp>
+
+#include <algorithm>
+#include <iostream>
+#include <fstream>
+#include <optional>
+#include <string>
+#include <chrono>
+#include <cmath>
+#include <map>
+
+using namespace Limitless;
+
+/*
+ * renders synthetic scene in hidden window for fixed number of frames and prints results as JSON
+ *
+ * window is never shown, so it runs on machines without display when context is created through EGL or OSMesa;
+ * with GLFW built with null platform --headless does not need window system at all
+ */
+namespace {
+    struct Options {
+        RenderPipeline pipeline {RenderPipeline::Deferred};
+        int api {GLFW_NATIVE_CONTEXT_API};
+        bool headless {};
+        glm::uvec2 size {1280, 720};
+        uint32_t frames {300};
+        uint32_t warmup {30};
+        uint32_t instances {1000};
+        uint32_t lights {64};
+        uint32_t emitters {8};
+        uint32_t skinned {};
+        bool occlusion_culling {};
+        fs::path skinned_model {fs::path{ENGINE_ASSETS_DIR} / "models/boblamp/boblampclean.md5mesh"};
+        fs::path output;
+    };
+
+    // scene is kept inside far plane of default camera
+    constexpr auto SCENE_SIZE = 60.0f;
+
+    struct PassTimings {
+        uint32_t count {};
+        double cpu {};
+        double cpu_max {};
+        uint32_t gpu_count {};
+        double gpu {};
+        double gpu_max {};
+    };
+
+    struct Counters {
+        ContextState::Stats context;
+        TextureBinder::Stats textures;
+        OcclusionTester::Stats occlusion;
+        uint64_t allocated_bytes {};
+    };
+
+    void usage() {
+        std::cerr << "usage: limitless_bench [--pipeline deferred] [--api native|egl|osmesa] [--headless]" << std::endl
+                  << "                       [--size <width> <height>] [--frames <count>] [--warmup <count>]" << std::endl
+                  << "                       [--instances <count>] [--lights <count>] [--emitters <count>]" << std::endl
+                  << "                       [--skinned <count>] [--skinned-model <path>] [--occlusion-culling]" << std::endl
+                  << "                       [--output <file.json>]" << std::endl;
+    }
+
+    std::optional<Options> parse(int argc, char** argv) {
+        Options options;
+
+        for (int i = 1; i < argc; ++i) {
+            const std::string arg = argv[i];
+            const auto has = [&] (int count) { return i + count < argc; };
+            const auto number = [&] { return static_cast<uint32_t>(std::stoul(argv[++i])); };
+
+            if (arg == "--pipeline" && has(1)) {
+                const std::string name = argv[++i];
+                if (name == "deferred") {
+                    options.pipeline = RenderPipeline::Deferred;
+                } else if (name == "forward") {
+                    options.pipeline = RenderPipeline::Forward;
+                } else {
+                    return std::nullopt;
+                }
+            } else if (arg == "--api" && has(1)) {
+                const std::string name = argv[++i];
+                if (name == "native") {
+                    options.api = GLFW_NATIVE_CONTEXT_API;
+                } else if (name == "egl") {
+                    options.api = GLFW_EGL_CONTEXT_API;
+                } else if (name == "osmesa") {
+                    options.api = GLFW_OSMESA_CONTEXT_API;
+                } else {
+                    return std::nullopt;
+                }
+            } else if (arg == "--headless") {
+                options.headless = true;
+            } else if (arg == "--size" && has(2)) {
+                options.size.x = number();
+                options.size.y = number();
+            } else if (arg == "--frames" && has(1)) {
+                options.frames = std::max(number(), 1u);
+            } else if (arg == "--warmup" && has(1)) {
+                options.warmup = number();
+            } else if (arg == "--instances" && has(1)) {
+                options.instances = number();
+            } else if (arg == "--lights" && has(1)) {
+                options.lights = number();
+            } else if (arg == "--emitters" && has(1)) {
+                options.emitters = number();
+            } else if (arg == "--skinned" && has(1)) {
+                options.skinned = number();
+            } else if (arg == "--skinned-model" && has(1)) {
+                options.skinned_model = argv[++i];
+            } else if (arg == "--occlusion-culling") {
+                options.occlusion_culling = true;
+            } else if (arg == "--output" && has(1)) {
+                options.output = argv[++i];
+            } else {
+                return std::nullopt;
+            }
+        }
+
+        return options;
+    }
+
+    std::unique_ptr<Pipeline> makePipeline(ContextEventObserver& context, const RenderSettings& settings) {
+        switch (settings.pipeline) {
+            case RenderPipeline::Deferred:
+                return std::make_unique<Deferred>(context, context.getSize(), settings);
+            case RenderPipeline::Forward:
+                break;
+        }
+
+        throw std::runtime_error("Forward pipeline is not implemented");
+    }
+
+    void loadAssets(Assets& assets, const Options& options) {
+        using namespace ms;
+        using namespace fx;
+
+        MaterialBuilder builder {assets};
+        builder .setName("bench_lit")
+                .add(Property::Color, glm::vec4(0.8f, 0.8f, 0.8f, 1.0f))
+                .add(Property::Roughness, 0.5f)
+                .add(Property::Metallic, 0.1f)
+                .setShading(Shading::Lit)
+                .addModelShader(ModelShader::Model)
+                .build();
+
+        builder .setName("bench_particle")
+                .add(Property::EmissiveColor, glm::vec4(2.0f, 1.0f, 0.5f, 1.0f))
+                .setShading(Shading::Unlit)
+                .setBlending(Blending::Additive)
+                .addModelShader(ModelShader::Effect)
+                .build();
+
+        EffectBuilder effect_builder {assets};
+        effect_builder.create("bench_sparks")
+                .createEmitter<SpriteEmitter>("sparks")
+                    .setSpawnRate(500.0f)
+                    .setMaxCount(500)
+                    .addLifetime(std::make_unique<ConstDistribution<float>>(1.0f))
+                    .addInitialSize(std::make_unique<RangeDistribution<float>>(16.0f, 32.0f))
+                    .addInitialVelocity(std::make_unique<RangeDistribution<glm::vec3>>(glm::vec3(-0.5f, 1.0f, -0.5f), glm::vec3(0.5f, 2.0f, 0.5f)))
+                    .addInitialColor(std::make_unique<ConstDistribution<glm::vec4>>(glm::vec4(1.0f)))
+                    .setMaterial(assets.materials.at("bench_particle"))
+                .build();
+
+        if (options.skinned != 0) {
+            auto model = ModelLoader::loadModel(assets, options.skinned_model);
+            if (!dynamic_cast<SkeletalModel*>(model.get())) {
+                throw std::runtime_error(options.skinned_model.string() + " is not skeletal model");
+            }
+            assets.models.add("bench_skinned", std::move(model));
+        }
+    }
+
+    // position of i-th of count objects spread over square floor
+    glm::vec3 getGridPosition(uint32_t i, uint32_t count, float height) {
+        const auto side = std::max(static_cast<uint32_t>(std::ceil(std::sqrt(static_cast<float>(count)))), 1u);
+        const auto spacing = SCENE_SIZE / static_cast<float>(side);
+        return {(static_cast<float>(i % side) + 0.5f) * spacing, height, (static_cast<float>(i / side) + 0.5f) * spacing};
+    }
+
+    void addScene(Scene& scene, const Assets& assets, const Options& options) {
+        for (uint32_t i = 0; i < options.instances; ++i) {
+            const auto& model = assets.models.at(i % 2 == 0 ? "sphere" : "cube");
+            scene.add<ModelInstance>(model, assets.materials.at("bench_lit"), getGridPosition(i, options.instances, 0.5f));
+        }
+
+        for (uint32_t i = 0; i < options.lights; ++i) {
+            const auto hue = static_cast<float>(i) / static_cast<float>(options.lights);
+            const glm::vec4 color {0.5f + 0.5f * std::cos(hue * 6.28f), 0.5f + 0.5f * std::sin(hue * 6.28f), 1.0f - hue, 2.0f};
+            scene.lighting.point_lights.emplace_back(getGridPosition(i, options.lights, 1.5f), color, SCENE_SIZE / std::sqrt(static_cast<float>(options.lights)));
+        }
+
+        for (uint32_t i = 0; i < options.emitters; ++i) {
+            scene.add<EffectInstance>(assets.effects.at("bench_sparks"), getGridPosition(i, options.emitters, 1.0f));
+        }
+
+        if (options.skinned != 0) {
+            const auto& model = assets.models.at("bench_skinned");
+            const auto& animations = dynamic_cast<const SkeletalModel&>(*model).getAnimations();
+
+            for (uint32_t i = 0; i < options.skinned; ++i) {
+                auto& instance = scene.add<SkeletalInstance>(model, getGridPosition(i, options.skinned, 0.0f));
+                instance.setScale(glm::vec3(0.025f));
+                if (!animations.empty()) {
+                    instance.play(animations.front().name);
+                }
+            }
+        }
+
+        scene.lighting.directional_light = {glm::vec4(1.0f, -1.0f, 0.5f, 1.0f), glm::vec4{1.0f}};
+    }
+
+    double toMs(std::chrono::nanoseconds duration) {
+        return std::chrono::duration<double, std::milli>(duration).count();
+    }
+
+    // adds finished frames that were not collected yet
+    void collect(std::map<std::string, PassTimings>& passes, std::optional<uint64_t>& last_frame) {
+        for (const auto& frame : profiler.getFrames()) {
+            if (last_frame && frame.index <= *last_frame) {
+                continue;
+            }
+            last_frame = frame.index;
+
+            for (const auto& scope : frame.scopes) {
+                auto& timings = passes[scope.path];
+                const auto cpu = toMs(scope.cpu_end - scope.cpu_begin);
+
+                ++timings.count;
+                timings.cpu += cpu;
+                timings.cpu_max = std::max(timings.cpu_max, cpu);
+
+                if (scope.gpu_begin && scope.gpu_end) {
+                    const auto gpu = toMs(*scope.gpu_end - *scope.gpu_begin);
+
+                    ++timings.gpu_count;
+                    timings.gpu += gpu;
+                    timings.gpu_max = std::max(timings.gpu_max, gpu);
+                }
+            }
+        }
+    }
+
+    std::string quote(std::string_view text) {
+        std::string quoted {"\""};
+        for (const auto c : text) {
+            switch (c) {
+                case '"': quoted += "\\\""; break;
+                case '\\': quoted += "\\\\"; break;
+                case '\n': quoted += "\\n"; break;
+                default:
+                    if (static_cast<unsigned char>(c) >= 0x20) {
+                        quoted += c;
+                    }
+            }
+        }
+        return quoted + "\"";
+    }
+
+    std::string getString(GLenum name) {
+        const auto* value = glGetString(name);
+        return value ? reinterpret_cast<const char*>(value) : "";
+    }
+
+    void writeJson(std::ostream& stream,
+                   const Options& options,
+                   std::vector<double> frame_times,
+                   const std::map<std::string, PassTimings>& passes,
+                   const Counters& counters) {
+        const auto frames = static_cast<double>(frame_times.size());
+        std::sort(frame_times.begin(), frame_times.end());
+
+        double total {};
+        for (const auto time : frame_times) {
+            total += time;
+        }
+
+        const auto percentile = [&] (double p) {
+            return frame_times[std::min(static_cast<size_t>(p * frames), frame_times.size() - 1)];
+        };
+
+        stream << "{\n"
+               << "  \"pipeline\": " << quote(options.pipeline == RenderPipeline::Deferred ? "deferred" : "forward") << ",\n"
+               << "  \"renderer\": " << quote(getString(GL_RENDERER)) << ",\n"
+               << "  \"version\": " << quote(getString(GL_VERSION)) << ",\n"
+               << "  \"resolution\": [" << options.size.x << ", " << options.size.y << "],\n"
+               << "  \"scene\": {\"instances\": " << options.instances << ", \"lights\": " << options.lights
+               << ", \"emitters\": " << options.emitters << ", \"skinned\": " << options.skinned
+               << ", \"occlusion_culling\": " << (options.occlusion_culling ? "true" : "false") << "},\n"
+               << "  \"frames\": " << frame_times.size() << ",\n"
+               << "  \"warmup\": " << options.warmup << ",\n"
+               << "  \"frame_ms\": {\"average\": " << total / frames << ", \"min\": " << frame_times.front()
+               << ", \"p50\": " << percentile(0.5) << ", \"p95\": " << percentile(0.95) << ", \"max\": " << frame_times.back() << "},\n";
+
+        stream << "  \"passes\": [";
+        bool first = true;
+        for (const auto& [path, timings] : passes) {
+            stream << (first ? "\n" : ",\n")
+                   << "    {\"path\": " << quote(path) << ", \"count\": " << timings.count
+                   << ", \"cpu_ms\": " << timings.cpu / timings.count << ", \"cpu_max_ms\": " << timings.cpu_max;
+            if (timings.gpu_count != 0) {
+                stream << ", \"gpu_ms\": " << timings.gpu / timings.gpu_count << ", \"gpu_max_ms\": " << timings.gpu_max;
+            } else {
+                stream << ", \"gpu_ms\": null, \"gpu_max_ms\": null";
+            }
+            stream << "}";
+            first = false;
+        }
+        stream << "\n  ],\n";
+
+        // per frame averages
+        stream << "  \"per_frame\": {"
+               << "\"draw_calls\": " << counters.context.draw_calls / frames
+               << ", \"state_changes\": " << counters.context.state_changes / frames
+               << ", \"binds\": " << counters.context.binds / frames
+               << ", \"texture_binds\": " << counters.textures.binds / frames
+               << ", \"texture_requests\": " << counters.textures.requests / frames
+               << ", \"occlusion_tested\": " << counters.occlusion.tested / frames
+               << ", \"occlusion_culled\": " << counters.occlusion.occluded / frames
+               << ", \"allocated_bytes\": " << counters.allocated_bytes / frames << "},\n";
+
+        stream << "  \"memory\": {\"total\": " << GpuMemory::getTotal() << ", \"peak\": " << GpuMemory::getPeak() << ", \"categories\": {";
+        for (size_t i = 0; i < GpuMemory::CATEGORY_COUNT; ++i) {
+            const auto category = static_cast<GpuMemory::Category>(i);
+            const auto usage = GpuMemory::getUsage(category);
+            stream << (i == 0 ? "\n" : ",\n")
+                   << "    " << quote(GpuMemory::getCategoryName(category))
+                   << ": {\"bytes\": " << usage.bytes << ", \"peak\": " << usage.peak << ", \"count\": " << usage.count << "}";
+        }
+        stream << "\n  }}\n"
+               << "}" << std::endl;
+    }
+
+    void run(const Options& options, std::ostream& stream) {
+        if (options.headless) {
+#ifdef GLFW_PLATFORM_NULL
+            glfwInitHint(GLFW_PLATFORM, GLFW_PLATFORM_NULL);
+#else
+            throw std::runtime_error("--headless requires GLFW with null platform");
+#endif
+        }
+
+        ContextEventObserver context {"limitless-bench", options.size, {
+            {WindowHint::Visible, false},
+            {WindowHint::Resizable, false},
+            {WindowHint::ContextCreationApi, options.api}
+        }};
+
+        if (!ContextInitializer::checkMinimumRequirements()) {
+            throw std::runtime_error("Minimum requirements are not met");
+        }
+
+        context.setSwapInterval(0);
+
+        RenderSettings settings;
+        settings.pipeline = options.pipeline;
+        settings.occlusion_culling = options.occlusion_culling;
+
+        Renderer renderer {makePipeline(context, settings), settings};
+
+        Assets assets {ENGINE_ASSETS_DIR};
+        assets.load(context);
+        loadAssets(assets, options);
+
+        // every variant is ready before first measured frame
+        assets.compileShaders(context, renderer.getSettings());
+        assets.shaders.wait(context);
+
+        Scene scene {context};
+        addScene(scene, assets, options);
+
+        // every run simulates the same frames whatever time they took
+        scene.getClock().setFrameDelta(FrameClock::Duration {1.0f / 60.0f});
+
+        Camera camera {options.size};
+        camera.setPosition({-SCENE_SIZE * 0.1f, SCENE_SIZE * 0.25f, -SCENE_SIZE * 0.1f});
+        camera.setFront(glm::normalize(glm::vec3{SCENE_SIZE * 0.5f, 0.0f, SCENE_SIZE * 0.5f} - camera.getPosition()));
+
+        profiler.setEnabled(true);
+
+        for (uint32_t i = 0; i < options.warmup; ++i) {
+            renderer.draw(context, assets, scene, camera);
+            context.swapBuffers();
+        }
+
+        // drops warm-up frame that is still open
+        profiler.clear();
+
+        std::map<std::string, PassTimings> passes;
+        std::optional<uint64_t> last_frame;
+        std::vector<double> frame_times;
+        Counters counters;
+
+        frame_times.reserve(options.frames);
+
+        for (uint32_t i = 0; i < options.frames; ++i) {
+            const auto begin = Profiler::Clock::now();
+
+            renderer.draw(context, assets, scene, camera);
+            context.swapBuffers();
+            context.pollEvents();
+
+            frame_times.push_back(toMs(Profiler::Clock::now() - begin));
+
+            // frame statistics are closed at start of next draw
+            const auto& stats = context.getFrameStats();
+            counters.context.draw_calls += stats.draw_calls;
+            counters.context.state_changes += stats.state_changes;
+            counters.context.binds += stats.binds;
+
+            const auto& textures = context.getTextureBinder().getFrameStats();
+            counters.textures.requests += textures.requests;
+            counters.textures.binds += textures.binds;
+
+            counters.allocated_bytes += GpuMemory::getFrameChurn().allocated_bytes;
+
+            // boxes are tested by G-buffer pass after pyramid of frame is built
+            if (const auto* hiz = renderer.getPipeline().find<HiZPass>(); hiz) {
+                const auto& occlusion = hiz->getOcclusionTester().getFrameStats();
+                counters.occlusion.tested += occlusion.tested;
+                counters.occlusion.occluded += occlusion.occluded;
+            }
+
+            // history keeps only last frames
+            if (i % (Profiler::HISTORY_SIZE / 2) == 0) {
+                collect(passes, last_frame);
+            }
+        }
+
+        // closes last frame and lets GPU finish timestamps of frames in flight
+        profiler.onFrame();
+        glFinish();
+        for (uint32_t i = 0; i < Profiler::FRAME_LATENCY; ++i) {
+            profiler.onFrame();
+        }
+        collect(passes, last_frame);
+
+        // queries belong to context destroyed at end of run
+        profiler.release();
+
+        writeJson(stream, options, std::move(frame_times), passes, counters);
+    }
+}
+
+int main(int argc, char** argv) {
+    std::optional<Options> options;
+
+    try {
+        options = parse(argc, argv);
+    } catch (const std::exception&) {
+        options = std::nullopt;
+    }
+
+    if (!options) {
+        usage();
+        return 1;
+    }
+
+    try {
+        if (options->output.empty()) {
+            run(*options, std::cout);
+        } else {
+            std::ofstream file {options->output};
+            if (!file) {
+                throw std::runtime_error("Failed to open " + options->output.string());
+            }
+            run(*options, file);
+        }
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,60 @@
+#include <limitless/loaders/asset_pack.hpp>
+
+#include <iostream>
+#include <string>
+
+using namespace Limitless;
+
+namespace {
+    void usage() {
+        std::cerr << "usage: limitless_pack <directory> <output" << AssetPack::EXTENSION << "> [--lz4] [--align <bytes>]" << std::endl;
+    }
+}
+
+int main(int argc, char** argv) {
+    if (argc < 3) {
+        usage();
+        return 1;
+    }
+
+    const fs::path directory = argv[1];
+    const fs::path output = argv[2];
+    auto compression = PackCompression::None;
+    uint32_t alignment = 16;
+
+    for (int i = 3; i < argc; ++i) {
+        const std::string arg = argv[i];
+        if (arg == "--lz4") {
+            compression = PackCompression::LZ4;
+        } else if (arg == "--align" && i + 1 < argc) {
+            alignment = static_cast<uint32_t>(std::stoul(argv[++i]));
+        } else {
+            usage();
+            return 1;
+        }
+    }
+
+    try {
+        AssetPackBuilder builder;
+        builder .setAlignment(alignment)
+                .addDirectory(directory, compression)
+                .build(output);
+
+        const AssetPack pack {output};
+
+        uint64_t original {};
+        uint64_t stored {};
+        for (const auto& [_, entry] : pack.getEntries()) {
+            original += entry.original_size;
+            stored += entry.size;
+        }
+
+        std::cout << output.string() << ": " << pack.getEntries().size() << " entries, "
+                  << original << " -> " << stored << " bytes" << std::endl;
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}